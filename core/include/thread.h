@@ -203,11 +203,14 @@ struct _thread {
                                          to this thread's message queue */
 #endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
-    || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_THREADSTAT) \
+    || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
 #endif
 #if defined(DEVELHELP) || defined(DOXYGEN)
     const char *name;               /**< thread's name                  */
+#endif
+#if defined(DEVELHELP) || defined(MODULE_THREADSTAT) || defined(DOXYGEN)
     int stack_size;                 /**< thread's stack size            */
 #endif
 #ifdef HAVE_THREAD_ARCH_T
@@ -490,7 +493,7 @@ void thread_add_to_list(list_node_t *list, thread_t *thread);
  */
 const char *thread_getname(kernel_pid_t pid);
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_THREADSTAT)
 /**
  * @brief Measures the stack usage of a stack
  *
@@ -501,7 +504,7 @@ const char *thread_getname(kernel_pid_t pid);
  * @return          the amount of unused space of the thread's stack
  */
 uintptr_t thread_measure_stack_free(char *stack);
-#endif /* DEVELHELP */
+#endif /* DEVELHELP || MODULE_THREADSTAT */
 
 /**
  * @brief   Get the number of bytes used on the ISR stack
@@ -37,6 +37,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_THREADSTAT
+#include "threadstat.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -123,6 +127,10 @@ int __attribute__((used)) sched_run(void)
 #endif
     }
 
+#ifdef MODULE_THREADSTAT
+    threadstat_switch(active_thread, next_thread);
+#endif
+
 #ifdef MODULE_SCHEDSTATISTICS
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
     next_stat->laststart = now;
@@ -160,6 +168,10 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 
 void sched_set_status(thread_t *process, unsigned int status)
 {
+#ifdef MODULE_THREADSTAT
+    threadstat_set_status(process, status);
+#endif
+
     if (status >= STATUS_ON_RUNQUEUE) {
         if (!(process->status >= STATUS_ON_RUNQUEUE)) {
             DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu8 ".\n",
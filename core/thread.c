@@ -127,7 +127,7 @@ void thread_add_to_list(list_node_t *list, thread_t *thread)
     list->next = new_node;
 }
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_THREADSTAT)
 uintptr_t thread_measure_stack_free(char *stack)
 {
     uintptr_t *stackp = (uintptr_t *)stack;
@@ -149,9 +149,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
         return -EINVAL;
     }
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_THREADSTAT)
     int total_stacksize = stacksize;
-#else
+#endif
+#ifndef DEVELHELP
     (void) name;
 #endif
 
@@ -175,7 +176,7 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     /* allocate our thread control block at the top of our stackspace */
     thread_t *cb = (thread_t *) (stack + stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_THREADSTAT)
     if (flags & THREAD_CREATE_STACKTEST) {
         /* assign each int of the stack the value of it's address */
         uintptr_t *stackmax = (uintptr_t *) (stack + stacksize);
@@ -214,12 +215,15 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->pid = pid;
     cb->sp = thread_stack_init(function, arg, stack, stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_THREADSTAT)
     cb->stack_start = stack;
 #endif
 
-#ifdef DEVELHELP
+#if defined(DEVELHELP) || defined(MODULE_THREADSTAT)
     cb->stack_size = total_stacksize;
+#endif
+#ifdef DEVELHELP
     cb->name = name;
 #endif
 
@@ -19,24 +19,72 @@
 
 #include <err.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
 
-static int _next_index;
-static int _fds[ASYNC_READ_NUMOF];
-static void *_args[ASYNC_READ_NUMOF];
-static native_async_read_callback_t _native_async_read_callbacks[ASYNC_READ_NUMOF];
+typedef struct {
+    native_async_read_callback_t cb;
+    void *arg;
+    int next_pending;
+    bool pending;
+#ifdef __MACH__
+    pid_t sigio_child_pid;
+#endif
+} _handler_t;
+
+/* handlers, indexed by their file descriptor */
+static _handler_t *_handlers;
+static int _handlers_numof;
+
+/* file descriptors with data left after their last read */
+static int _pending = -1;
+
+#ifdef __linux__
+static int _epoll_fd = -1;
+#endif
 
 #ifdef __MACH__
-static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+static void _dispatch(int fd)
+{
+    _handlers[fd].cb(fd, _handlers[fd].arg);
+}
+
 static void _async_io_isr(void) {
+    int fd = _pending;
+
+    /* fds added by the callbacks are handled with the next signal */
+    _pending = -1;
+    while (fd >= 0) {
+        int next = _handlers[fd].next_pending;
+
+        _handlers[fd].pending = false;
+        _dispatch(fd);
+        fd = next;
+    }
+
+#ifdef __linux__
+    struct epoll_event events[ASYNC_READ_EVENTS_NUMOF];
+    int res;
+
+    do {
+        res = epoll_wait(_epoll_fd, events, ASYNC_READ_EVENTS_NUMOF, 0);
+        for (int i = 0; i < res; i++) {
+            _dispatch(events[i].data.fd);
+        }
+    } while (res == ASYNC_READ_EVENTS_NUMOF);
+#else
     fd_set rfds;
 
     FD_ZERO(&rfds);
@@ -45,62 +93,106 @@ static void _async_io_isr(void) {
 
     struct timeval timeout = { .tv_usec = 0 };
 
-    for (int i = 0; i < _next_index; i++) {
-        FD_SET(_fds[i], &rfds);
-
-        if (max_fd < _fds[i]) {
-            max_fd = _fds[i];
+    for (fd = 0; fd < _handlers_numof; fd++) {
+        if (_handlers[fd].cb != NULL) {
+            FD_SET(fd, &rfds);
+            max_fd = fd;
         }
     }
 
     if (real_select(max_fd + 1, &rfds, NULL, NULL, &timeout) > 0) {
-        for (int i = 0; i < _next_index; i++) {
-            if (FD_ISSET(_fds[i], &rfds)) {
-                _native_async_read_callbacks[i](_fds[i], _args[i]);
+        for (fd = 0; fd <= max_fd; fd++) {
+            if (FD_ISSET(fd, &rfds)) {
+                _dispatch(fd);
             }
         }
     }
+#endif
 }
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epoll_fd < 0) {
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+        }
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
 void native_async_read_cleanup(void) {
     unregister_interrupt(SIGIO);
 
-    for (int i = 0; i < _next_index; i++) {
+    for (int fd = 0; fd < _handlers_numof; fd++) {
+        if (_handlers[fd].cb == NULL) {
+            continue;
+        }
 #ifdef __MACH__
-        kill(_sigio_child_pids[i], SIGKILL);
+        kill(_handlers[fd].sigio_child_pid, SIGKILL);
 #endif
-        real_close(_fds[i]);
+        real_close(fd);
     }
+#ifdef __linux__
+    if (_epoll_fd >= 0) {
+        real_close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
-    (void) fd;
-#ifdef __MACH__
-    for (int i = 0; i < _next_index; i++) {
-        if (_fds[i] == fd) {
-            kill(_sigio_child_pids[i], SIGCONT);
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    if ((fd >= _handlers_numof) || (_handlers[fd].cb == NULL)) {
+        return;
+    }
+
+    _native_in_syscall++; /* no switching here */
+
+    if (real_poll(&pfd, 1, 0) == 1) {
+        /* dispatch fd again with the next signal, edge-triggered
+         * readiness would not report the data left */
+        if (!_handlers[fd].pending) {
+            _handlers[fd].pending = true;
+            _handlers[fd].next_pending = _pending;
+            _pending = fd;
         }
+
+        int sig = SIGIO;
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+    }
+#ifdef __MACH__
+    else {
+        kill(_handlers[fd].sigio_child_pid, SIGCONT);
     }
 #endif
+
+    _native_in_syscall--;
 }
 
 void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
-    if (_next_index >= ASYNC_READ_NUMOF) {
-        err(EXIT_FAILURE, "native_async_read_add_handler(): too many callbacks");
+    if (fd >= _handlers_numof) {
+        _handler_t *handlers = real_realloc(_handlers, (fd + 1) * sizeof(_handler_t));
+
+        if (handlers == NULL) {
+            err(EXIT_FAILURE, "native_async_read_add_handler(): realloc");
+        }
+        memset(&handlers[_handlers_numof], 0,
+               (fd + 1 - _handlers_numof) * sizeof(_handler_t));
+        _handlers = handlers;
+        _handlers_numof = fd + 1;
     }
 
-    _fds[_next_index] = fd;
-    _args[_next_index] = arg;
-    _native_async_read_callbacks[_next_index] = handler;
+    _handlers[fd].arg = arg;
+    _handlers[fd].cb = handler;
 
 #ifdef __MACH__
     /* tuntap signalled IO is not working in OSX,
      * * check http://sourceforge.net/p/tuntaposx/bugs/17/ */
-    _sigio_child(_next_index);
+    _sigio_child(fd);
 #else
     /* configure fds to send signals on io */
     if (real_fcntl(fd, F_SETOWN, _native_pid) == -1) {
@@ -111,21 +203,25 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETFL)");
     }
 #endif /* not OSX */
+#ifdef __linux__
+    struct epoll_event event = { .events = EPOLLIN | EPOLLET, .data.fd = fd };
 
-    _next_index++;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
 }
 
 #ifdef __MACH__
-static void _sigio_child(int index)
+static void _sigio_child(int fd)
 {
-    int fd = _fds[index];
     pid_t parent = _native_pid;
     pid_t child;
     if ((child = real_fork()) == -1) {
         err(EXIT_FAILURE, "sigio_child: fork");
     }
     if (child > 0) {
-        _sigio_child_pids[index] = child;
+        _handlers[fd].sigio_child_pid = child;
 
         /* return in parent process */
         return;
@@ -135,8 +135,6 @@ static void _callback_can_sigio(int sockfd, void *arg)
         dev->candev.event_callback(&dev->candev, CANDEV_EVENT_ISR, NULL);
     }
 
-    native_async_read_continue(sockfd);
-
     if (sched_context_switch_request) {
         thread_yield_higher();
     }
@@ -233,6 +231,7 @@ static void _isr(candev_t *candev)
 
     DEBUG("candev_native _isr: CAN SIGIO interrupt received, sock = %i\n", dev->sock);
     nbytes = real_read(dev->sock, &rcv_frame, sizeof(struct can_frame));
+    native_async_read_continue(dev->sock);
 
     if (nbytes < 0) {   /* SIGIO signal was probably due to an error with the socket */
         DEBUG("candev_native _isr: read: error during read\n");
@@ -429,8 +428,7 @@ static int _get(candev_t *candev, canopt_t opt, void *value, size_t max_len)
         }
         struct can_filter *list = value;
         size_t i;
-        for (i = 0; (i < CANDEV_LINUX_MAX_FILTERS_RX)
-             && (dev->filters[i].can_id != 0)
+        for (i = 0; (i < dev->filters_numof)
              && (i < (max_len / sizeof(struct can_filter))); i++) {
             list[i] = dev->filters[i];
         }
@@ -457,36 +455,30 @@ static int _set_filter(candev_t *candev, const struct can_filter *filter)
     DEBUG("candev_native: _set_filter: candev=%p, filter: f=%x m=%x on sock: %i\n",
           (void *)candev, filter->can_id, filter->can_mask, dev->sock
     );
-    uint32_t i;
-    for (i = 0; i < CANDEV_LINUX_MAX_FILTERS_RX; i++) {
-        if (dev->filters[i].can_id == filter->can_id) {
+    /* Only 29 bits must be used for masks in SocketCAN */
+    canid_t mask = filter->can_mask & CAN_EFF_MASK;
+    for (unsigned i = 0; i < dev->filters_numof; i++) {
+        if ((dev->filters[i].can_id == filter->can_id) &&
+            (dev->filters[i].can_mask == mask)) {
             DEBUG("candev_native: _set_filter: filter already set\n");
             return 0;
         }
-        else if (dev->filters[i].can_id == 0) {
-            break;
-        }
     }
-    if (i == CANDEV_LINUX_MAX_FILTERS_RX) {
+    if (dev->filters_numof == CANDEV_LINUX_MAX_FILTERS_RX) {
         DEBUG("candev_native: _set_filter: no more filters available\n");
         return -EOVERFLOW;
     }
-    for (i = 0; i < CANDEV_LINUX_MAX_FILTERS_RX; i++) {
-        if (dev->filters[i].can_id == 0) {
-            /* Only 29 bits must be used for masks in SocketCAN */
-            dev->filters[i] = *filter;
-            dev->filters[i].can_mask &= CAN_EFF_MASK;
-            DEBUG("candev_native: _set_filter: filter:ID=0x%x\n", filter->can_id);
-            DEBUG("candev_native: _set_filter: mask=0x%x\n", filter->can_mask);
-            break;
-        }
-    }
-    i++;
-    DEBUG("%" PRIu32 " filters will be set\n", i);
+    dev->filters[dev->filters_numof].can_id = filter->can_id;
+    dev->filters[dev->filters_numof].can_mask = mask;
+    dev->filters_numof++;
+    DEBUG("candev_native: _set_filter: filter:ID=0x%x\n", filter->can_id);
+    DEBUG("candev_native: _set_filter: mask=0x%x\n", filter->can_mask);
+
+    DEBUG("%u filters will be set\n", dev->filters_numof);
     real_setsockopt(dev->sock, SOL_CAN_RAW, CAN_RAW_FILTER, dev->filters,
-                    sizeof(struct can_filter) * i);
+                    sizeof(struct can_filter) * dev->filters_numof);
 
-    return i;
+    return dev->filters_numof;
 }
 
 static int _remove_filter(candev_t *candev, const struct can_filter *filter)
@@ -498,38 +490,26 @@ static int _remove_filter(candev_t *candev, const struct can_filter *filter)
         return -EOVERFLOW;
     }
 
-    uint32_t i;
-    for (i = 0; i < CANDEV_LINUX_MAX_FILTERS_RX; i++) {
-        if ((dev->filters[i].can_id == filter->can_id )
+    unsigned i;
+    for (i = 0; i < dev->filters_numof; i++) {
+        if ((dev->filters[i].can_id == filter->can_id)
                 && (dev->filters[i].can_mask == (filter->can_mask & CAN_EFF_MASK))) {
-            if (i < CANDEV_LINUX_MAX_FILTERS_RX - 1) {
-                memmove(&dev->filters[i], &dev->filters[i + 1],
-                        sizeof(dev->filters[i]) * (CANDEV_LINUX_MAX_FILTERS_RX - i - 1));
-            }
-            dev->filters[CANDEV_LINUX_MAX_FILTERS_RX - 1].can_id = 0;
             break;
-
-        }
-        else if (dev->filters[i].can_id == 0) {
-            DEBUG("candev_native: _remove_filter: error filter not found\n");
-            return -EOVERFLOW;
         }
     }
 
-    if (i == CANDEV_LINUX_MAX_FILTERS_RX) {
+    if (i == dev->filters_numof) {
         DEBUG("candev_native: _remove_filter: error filter not found\n");
         return -EOVERFLOW;
     }
 
-    for (i = 0; i < CANDEV_LINUX_MAX_FILTERS_RX; i++) {
-        if (dev->filters[i].can_id == 0) {
-            break;
-        }
-    }
+    dev->filters_numof--;
+    memmove(&dev->filters[i], &dev->filters[i + 1],
+            sizeof(dev->filters[i]) * (dev->filters_numof - i));
 
-    DEBUG("%" PRIu32 " filters will be set\n", i);
+    DEBUG("%u filters will be set\n", dev->filters_numof);
     real_setsockopt(dev->sock, SOL_CAN_RAW, CAN_RAW_FILTER, dev->filters,
-                    sizeof(struct can_filter) * i);
+                    sizeof(struct can_filter) * dev->filters_numof);
 
     return 0;
 }
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Fuzzing driver for native
+ *
+ * @}
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "xtimer.h"
+#include "native_fuzzing.h"
+
+#include "native_internal.h"
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+} _input_t;
+
+static native_fuzzing_target_t _target;
+
+/**
+ * returns a copy of the arguments after "--", argv[0] is the program
+ */
+static char **_args(int *argc)
+{
+    char **argv;
+    int i;
+
+    *argc = 0;
+    for (i = 1; _native_argv[i] != NULL; i++) {
+        if (strcmp(_native_argv[i], "--") == 0) {
+            break;
+        }
+    }
+    if (_native_argv[i] == NULL) {
+        return NULL;
+    }
+    while (_native_argv[i + 1 + *argc] != NULL) {
+        (*argc)++;
+    }
+    argv = malloc((*argc + 2) * sizeof(char *));
+    if (argv == NULL) {
+        *argc = 0;
+        return NULL;
+    }
+    argv[0] = _native_argv[0];
+    memcpy(&argv[1], &_native_argv[i + 1], (*argc + 1) * sizeof(char *));
+    (*argc)++;
+    return argv;
+}
+
+/**
+ * passes a copy of data of its exact size to the target
+ */
+static void _run(const uint8_t *data, size_t len)
+{
+    /* malloc(0) may return NULL, still give the target a valid pointer */
+    uint8_t *copy = malloc(len ? len : 1);
+
+    if (copy == NULL) {
+        return;
+    }
+    memcpy(copy, data, len);
+    _target(copy, len);
+    free(copy);
+}
+
+#ifdef NATIVE_FUZZING_LIBFUZZER
+int LLVMFuzzerRunDriver(int *argc, char ***argv,
+                        int (*cb)(const uint8_t *data, size_t size));
+
+static int _libfuzzer_cb(const uint8_t *data, size_t size)
+{
+    _run(data, size);
+    return 0;
+}
+
+void native_fuzzing_run(native_fuzzing_target_t target)
+{
+    char *no_args[] = { _native_argv[0], NULL };
+    int argc;
+    char **argv = _args(&argc);
+
+    if (argv == NULL) {
+        argv = no_args;
+        argc = 1;
+    }
+    _target = target;
+    /* usually exits by itself, when done or told to, e.g. by -runs */
+    real_exit(LLVMFuzzerRunDriver(&argc, &argv, _libfuzzer_cb));
+}
+#else
+static uint8_t _buf[NATIVE_FUZZING_MAX_LEN];
+
+static ssize_t _read_all(int fd)
+{
+    size_t len = 0;
+
+    while (len < sizeof(_buf)) {
+        ssize_t res;
+
+        _native_syscall_enter();
+        res = real_read(fd, &_buf[len], sizeof(_buf) - len);
+        /* leaving the syscall may run interrupts, which change errno */
+        res = (res < 0) ? -errno : res;
+        _native_syscall_leave();
+        if (res == -EINTR) {
+            continue;
+        }
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            break;
+        }
+        len += res;
+    }
+    return len;
+}
+
+static int _add_file(_input_t **inputs, unsigned *numof, const char *path)
+{
+    _input_t *input;
+    ssize_t len;
+    int fd;
+
+    _native_syscall_enter();
+    fd = real_open(path, O_RDONLY);
+    fd = (fd < 0) ? -errno : fd;
+    _native_syscall_leave();
+    if (fd < 0) {
+        return fd;
+    }
+    len = _read_all(fd);
+    _native_syscall_enter();
+    real_close(fd);
+    _native_syscall_leave();
+    if (len < 0) {
+        return len;
+    }
+
+    input = realloc(*inputs, (*numof + 1) * sizeof(_input_t));
+    if (input == NULL) {
+        return -ENOMEM;
+    }
+    *inputs = input;
+    input = &input[*numof];
+    input->data = malloc(len ? len : 1);
+    if (input->data == NULL) {
+        return -ENOMEM;
+    }
+    memcpy(input->data, _buf, len);
+    input->len = len;
+    (*numof)++;
+    return 0;
+}
+
+static int _add_path(_input_t **inputs, unsigned *numof, const char *path)
+{
+    struct dirent *entry;
+    struct stat st;
+    DIR *dir;
+    int res = 0;
+
+    _native_syscall_enter();
+    if (stat(path, &st) < 0) {
+        res = -errno;
+    }
+    else if (S_ISDIR(st.st_mode) && ((dir = opendir(path)) == NULL)) {
+        res = -errno;
+    }
+    _native_syscall_leave();
+    if (res < 0) {
+        return res;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return _add_file(inputs, numof, path);
+    }
+
+    while (res == 0) {
+        char file[PATH_MAX];
+
+        _native_syscall_enter();
+        entry = readdir(dir);
+        _native_syscall_leave();
+        if (entry == NULL) {
+            break;
+        }
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+        res = _add_file(inputs, numof, file);
+    }
+    _native_syscall_enter();
+    closedir(dir);
+    _native_syscall_leave();
+    return res;
+}
+
+static int _bench(int argc, char **argv)
+{
+    _input_t *inputs = NULL;
+    unsigned numof = 0;
+    uint64_t bytes = 0, start, usec;
+    int res = 0;
+
+    for (int i = 1; (i < argc) && (res == 0); i++) {
+        res = _add_path(&inputs, &numof, argv[i]);
+        if (res < 0) {
+            printf("fuzzing: reading %s failed: %s\n", argv[i],
+                   strerror(-res));
+        }
+    }
+    if ((res == 0) && (numof > 0)) {
+        for (unsigned i = 0; i < numof; i++) {
+            bytes += inputs[i].len;
+        }
+        printf("fuzzing: %u inputs, %" PRIu64 " bytes, %u rounds\n", numof,
+               bytes, NATIVE_FUZZING_BENCH_ROUNDS);
+
+        start = xtimer_now_usec64();
+        for (unsigned round = 0; round < NATIVE_FUZZING_BENCH_ROUNDS; round++) {
+            for (unsigned i = 0; i < numof; i++) {
+                _run(inputs[i].data, inputs[i].len);
+            }
+        }
+        usec = xtimer_now_usec64() - start;
+        if (usec == 0) {
+            usec = 1;
+        }
+
+        uint64_t runs = (uint64_t)numof * NATIVE_FUZZING_BENCH_ROUNDS;
+
+        printf("fuzzing: %" PRIu64 " inputs/s, %" PRIu64 " kB/s, "
+               "%" PRIu64 " ns/input\n", (runs * US_PER_SEC) / usec,
+               (bytes * NATIVE_FUZZING_BENCH_ROUNDS * US_PER_SEC) /
+               (usec * 1024), (usec * 1000) / runs);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        free(inputs[i].data);
+    }
+    free(inputs);
+    return res;
+}
+
+void native_fuzzing_run(native_fuzzing_target_t target)
+{
+    int argc;
+    char **argv = _args(&argc);
+
+    _target = target;
+    if (argv != NULL) {
+        int res = _bench(argc, argv);
+
+        free(argv);
+        real_exit((res < 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+#ifdef __AFL_LOOP
+    while (__AFL_LOOP(NATIVE_FUZZING_AFL_LOOP))
+#endif
+    {
+        ssize_t len = _read_all(STDIN_FILENO);
+
+        if (len < 0) {
+            real_exit(EXIT_FAILURE);
+        }
+        _run(_buf, len);
+    }
+    real_exit(EXIT_SUCCESS);
+}
+#endif
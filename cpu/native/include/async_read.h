@@ -23,10 +23,14 @@ extern "C" {
 #endif
 
 /**
- * @brief   Maximum number of file descriptors
+ * @brief   Maximum number of readiness events fetched at once
+ *
+ * On Linux the file descriptors are watched with epoll, so an interrupt only
+ * costs time for the file descriptors that are ready. The number of file
+ * descriptors is not limited.
  */
-#ifndef ASYNC_READ_NUMOF
-#define ASYNC_READ_NUMOF 2
+#ifndef ASYNC_READ_EVENTS_NUMOF
+#define ASYNC_READ_EVENTS_NUMOF 16
 #endif
 
 /**
@@ -51,7 +55,9 @@ void native_async_read_cleanup(void);
 /**
  * @brief   resume monitoring of file descriptors
  *
- * Call this function after reading file descriptors.
+ * Call this function after reading file descriptors. If data is left, the
+ * callback of @p fd is called again without waiting for new data to arrive,
+ * so only call it after reading from @p fd.
  *
  * @param[in] fd  The file descriptor to monitor
  */
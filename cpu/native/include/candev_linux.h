@@ -77,6 +77,7 @@ typedef struct candev_linux {
     const candev_linux_conf_t *conf;  /**< device configuration */
     /** filter list */
     struct can_filter filters[CANDEV_LINUX_MAX_FILTERS_RX];
+    unsigned filters_numof;           /**< number of filters in the list */
 } candev_linux_t;
 
 /**
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Fuzzing driver for native
+ *
+ * The `native_fuzzing` module passes inputs to a target function of the
+ * application, which typically feeds them to a parser directly. Where the
+ * inputs come from depends on the build and the arguments given after `--`:
+ *
+ * - no arguments: one input is read from stdin, as expected by AFL. When
+ *   built with afl-clang-fast, the inputs are read in a persistent loop
+ *   instead of starting native for each of them.
+ * - built with `-DNATIVE_FUZZING_LIBFUZZER` and linked with libFuzzer's
+ *   driver: libFuzzer generates the inputs, the arguments are passed to it.
+ * - files or directories: the inputs are read from them and the target is
+ *   benchmarked with them, e.g. on a corpus of real captures.
+ *
+ * The input is copied into a buffer allocated to its exact size, so reads
+ * beyond its end are caught by AddressSanitizer, and the target may modify
+ * it.
+ */
+
+#ifndef NATIVE_FUZZING_H
+#define NATIVE_FUZZING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum size of an input read from stdin or a file
+ */
+#ifndef NATIVE_FUZZING_MAX_LEN
+#define NATIVE_FUZZING_MAX_LEN      (4096U)
+#endif
+
+/**
+ * @brief   Inputs per AFL persistent loop before native is restarted
+ */
+#ifndef NATIVE_FUZZING_AFL_LOOP
+#define NATIVE_FUZZING_AFL_LOOP     (1000U)
+#endif
+
+/**
+ * @brief   Times all inputs are passed to the target when benchmarking
+ */
+#ifndef NATIVE_FUZZING_BENCH_ROUNDS
+#define NATIVE_FUZZING_BENCH_ROUNDS (100U)
+#endif
+
+/**
+ * @brief   Function the inputs are passed to
+ *
+ * @param[in] data  input, may be modified
+ * @param[in] len   length of @p data
+ */
+typedef void (*native_fuzzing_target_t)(uint8_t *data, size_t len);
+
+/**
+ * @brief   Pass the inputs to a target and exit native
+ *
+ * native keeps running when `main()` returns, so this exits the process
+ * once all inputs were passed, with `EXIT_FAILURE` if reading them failed.
+ *
+ * @param[in] target    function to pass the inputs to
+ */
+NORETURN void native_fuzzing_run(native_fuzzing_target_t target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_FUZZING_H */
+/** @} */
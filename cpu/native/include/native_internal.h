@@ -43,6 +43,7 @@
 #endif
 #endif /* BSD/Linux */
 #include <netdb.h>
+#include <poll.h>
 #include <ifaddrs.h>
 #include <time.h>
 #include <sys/time.h>
@@ -105,6 +106,7 @@ extern int (*real_execve)(const char *, char *const[], char *const[]);
 extern int (*real_feof)(FILE *stream);
 extern int (*real_ferror)(FILE *stream);
 extern int (*real_fork)(void);
+extern int (*real_fstat)(int fd, struct stat *buf);
 /* The ... is a hack to save includes: */
 extern int (*real_getaddrinfo)(const char *node, ...);
 extern int (*real_getifaddrs)(struct ifaddrs **ifap);
@@ -115,6 +117,10 @@ extern int (*real_listen)(int socket, int backlog);
 extern int (*real_open)(const char *path, int oflag, ...);
 extern int (*real_pause)(void);
 extern int (*real_pipe)(int[2]);
+extern int (*real_poll)(struct pollfd *fds, nfds_t nfds, int timeout);
+extern ssize_t (*real_sendto)(int socket, const void *buf, size_t len,
+                              int flags, const struct sockaddr *dest_addr,
+                              socklen_t addrlen);
 /* The ... is a hack to save includes: */
 extern int (*real_select)(int nfds, ...);
 extern int (*real_setitimer)(int which, const struct itimerval
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Packet capture of native to a host file
+ *
+ * With the `gnrc_pktcap` module and the `--pcap=<file>` option, native
+ * captures the frames of all interfaces from start-up on to a pcapng file
+ * on the host, see @ref net_gnrc_pktcap. The file can be opened with
+ * Wireshark while native is running.
+ */
+
+#ifndef NATIVE_PKTCAP_H
+#define NATIVE_PKTCAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   File given with `--pcap`, NULL if not capturing
+ */
+extern const char *_native_pktcap_path;
+
+/**
+ * @brief   Start capturing to @ref _native_pktcap_path
+ *
+ * Called by auto_init after the writer thread of @ref net_gnrc_pktcap was
+ * started.
+ */
+void auto_init_native_pktcap(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_PKTCAP_H */
+/** @} */
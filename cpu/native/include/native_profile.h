@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Sampling profiler for native
+ *
+ * With the `native_profile` module and the `--profile=<file>` option, native
+ * samples its call stack on every SIGPROF, i.e. every
+ * @ref NATIVE_PROFILE_INTERVAL µs of CPU time the process consumed. Each
+ * sample is attributed to the RIOT thread that was running, or to `isr` if
+ * native was handling an interrupt, so the time spent idle does not show up.
+ *
+ * On exit the samples are written to the file in the folded stack format of
+ * flamegraph tools, one line per distinct stack:
+ *
+ *     <thread>;<outermost function>;...;<innermost function> <samples>
+ *
+ * e.g. to be rendered with `flamegraph.pl <file> > profile.svg`. Functions
+ * are resolved from the symbol table of the executable, so static functions
+ * show up as well, and with dladdr() for shared libraries.
+ */
+
+#ifndef NATIVE_PROFILE_H
+#define NATIVE_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   CPU time between two samples in µs
+ */
+#ifndef NATIVE_PROFILE_INTERVAL
+#define NATIVE_PROFILE_INTERVAL     (1000U)
+#endif
+
+/**
+ * @brief   Maximum number of frames per sample, deeper frames are cut off
+ */
+#ifndef NATIVE_PROFILE_DEPTH
+#define NATIVE_PROFILE_DEPTH        (32U)
+#endif
+
+/**
+ * @brief   Maximum number of distinct stacks, power of 2
+ *
+ * Samples of further stacks are counted as dropped.
+ */
+#ifndef NATIVE_PROFILE_STACKS
+#define NATIVE_PROFILE_STACKS       (4096U)
+#endif
+
+/**
+ * @brief   File given with `--profile`, NULL if not profiling
+ */
+extern const char *_native_profile_path;
+
+/**
+ * @brief   Start sampling
+ *
+ * Called on start-up if `--profile` was given. The samples are written to
+ * @ref _native_profile_path on exit.
+ */
+void native_profile_start(void);
+
+/**
+ * @brief   Stop sampling
+ *
+ * The samples taken so far are kept.
+ */
+void native_profile_stop(void);
+
+/**
+ * @brief   Write the samples in folded stack format
+ *
+ * @param[in] path  file to write
+ *
+ * @return  number of distinct stacks written
+ * @return  -errno on error
+ */
+int native_profile_dump(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_PROFILE_H */
+/** @} */
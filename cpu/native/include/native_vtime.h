@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Virtual time for native
+ *
+ * With the `native_vtime` module and the `--vtime=<socket>` option, native
+ * does not use the host's clock. Instead, all instances connected to the
+ * controller `dist/tools/vtime/vtime.py` share a simulated clock. When all
+ * instances are idle, the controller advances the clock to the next timer of
+ * any instance, so idle periods take no real time.
+ *
+ * The controller listens on a Unix socket of type SOCK_SEQPACKET and
+ * exchanges @ref native_vtime_msg_t with the instances. The current time is
+ * published in the file `<socket>.clock`, which the instances map into their
+ * memory.
+ */
+
+#ifndef NATIVE_VTIME_H
+#define NATIVE_VTIME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Virtual time that passes with every read of the timer in µs
+ *
+ * The clock does not advance while an instance is busy, so busy waiting on the
+ * timer would never end otherwise.
+ */
+#ifndef NATIVE_VTIME_READ_COST
+#define NATIVE_VTIME_READ_COST      (1U)
+#endif
+
+/**
+ * @brief   Time of an instance without a pending timer
+ */
+#define NATIVE_VTIME_NONE           (UINT64_MAX)
+
+/**
+ * @brief   Message types
+ */
+enum {
+    NATIVE_VTIME_MSG_IDLE = 0,      /**< instance is idle until time */
+    NATIVE_VTIME_MSG_BUSY,          /**< instance is running */
+    NATIVE_VTIME_MSG_ADVANCE,       /**< clock advanced to time */
+};
+
+/**
+ * @brief   Message between an instance and the controller
+ */
+typedef struct {
+    uint32_t type;                  /**< message type */
+    uint32_t reserved;              /**< padding, 0 */
+    uint64_t time;                  /**< time in µs */
+} native_vtime_msg_t;
+
+/**
+ * @brief   Path of the controller socket, NULL to use the host's clock
+ */
+extern const char *_native_vtime_path;
+
+/**
+ * @brief   Connect to the controller
+ *
+ * @param[in] timer_isr     called in interrupt context when the time set with
+ *                          native_vtime_set() is reached
+ */
+void native_vtime_init(void (*timer_isr)(void));
+
+/**
+ * @brief   Check if virtual time is used
+ *
+ * @return  true, if native_vtime_init() connected to the controller
+ */
+bool native_vtime_enabled(void);
+
+/**
+ * @brief   Read the virtual time
+ *
+ * @return  virtual time in µs
+ */
+uint64_t native_vtime_now(void);
+
+/**
+ * @brief   Set the timer
+ *
+ * @param[in] offset    time from now in µs, 0 to clear the timer
+ */
+void native_vtime_set(uint32_t offset);
+
+/**
+ * @brief   Wait for an interrupt and let the controller advance the clock
+ */
+void native_vtime_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_VTIME_H */
+/** @} */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     drivers_netdev
+ * @brief       Ethernet driver for host interfaces using memory mapped
+ *              AF_PACKET rings
+ * @{
+ *
+ * @file
+ * @brief       Definitions for @ref netdev ethernet driver for host system's
+ *              interfaces using TPACKET_V3 rings (Linux only)
+ *
+ * Unlike @ref netdev_tap.h "netdev_tap", which reads and writes every frame
+ * with its own system call, this driver shares a receive and a transmit ring
+ * with the kernel. Received frames are handed over in blocks, all frames of a
+ * block are passed up after one signal. Sent frames are put into the transmit
+ * ring and the kernel is only asked to send them when the network interface
+ * thread has no further messages queued or when @ref NETDEV_PACKET_TX_BATCH
+ * frames are pending.
+ *
+ * The socket is bound to an existing host interface, usually one end of a
+ * veth pair, and requires CAP_NET_RAW.
+ */
+#ifndef NETDEV_PACKET_H
+#define NETDEV_PACKET_H
+
+#include <stdint.h>
+
+#include "net/netdev.h"
+#include "net/ethernet/hdr.h"
+#include "net/if.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Ring configuration
+ * @{
+ */
+#ifndef NETDEV_PACKET_BLOCK_SIZE
+#define NETDEV_PACKET_BLOCK_SIZE    (1U << 16)  /**< size of a ring block */
+#endif
+#ifndef NETDEV_PACKET_RX_BLOCKS
+#define NETDEV_PACKET_RX_BLOCKS     (16U)       /**< blocks of the RX ring */
+#endif
+#ifndef NETDEV_PACKET_TX_BLOCKS
+#define NETDEV_PACKET_TX_BLOCKS     (4U)        /**< blocks of the TX ring */
+#endif
+#ifndef NETDEV_PACKET_FRAME_SIZE
+#define NETDEV_PACKET_FRAME_SIZE    (2048U)     /**< size of a TX frame slot */
+#endif
+#ifndef NETDEV_PACKET_RX_TIMEOUT
+#define NETDEV_PACKET_RX_TIMEOUT    (1U)        /**< ms until the kernel hands
+                                                 *   over a partially filled
+                                                 *   block */
+#endif
+#ifndef NETDEV_PACKET_TX_BATCH
+#define NETDEV_PACKET_TX_BATCH      (32U)       /**< pending frames that
+                                                 *   trigger a send */
+#endif
+/** @} */
+
+/**
+ * @brief   packet interface state
+ */
+typedef struct {
+    netdev_t netdev;                    /**< netdev internal member */
+    char if_name[IFNAMSIZ];             /**< host interface to bind to */
+    int sock_fd;                        /**< AF_PACKET socket */
+    uint8_t *rx_ring;                   /**< mapped RX ring */
+    uint8_t *tx_ring;                   /**< mapped TX ring */
+    uint8_t *rx_frame;                  /**< next frame of the current block,
+                                         *   NULL if no block is held */
+    unsigned rx_block;                  /**< current block of the RX ring */
+    unsigned rx_left;                   /**< frames left in the block */
+    unsigned tx_frame;                  /**< next frame of the TX ring */
+    unsigned tx_pending;                /**< frames queued but not sent */
+    uint8_t addr[ETHERNET_ADDR_LEN];    /**< MAC address of the device */
+    uint8_t promiscuous;                /**< flag for promiscuous mode */
+} netdev_packet_t;
+
+/**
+ * @brief   packet interface initialization parameters
+ */
+typedef struct {
+    const char *if_name;                /**< host interface to bind to */
+} netdev_packet_params_t;
+
+/**
+ * @brief   Setup netdev_packet_t structure
+ *
+ * @param dev       the preallocated netdev_packet device handle to setup
+ * @param params    initialization parameters
+ */
+void netdev_packet_setup(netdev_packet_t *dev,
+                         const netdev_packet_params_t *params);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */
+#endif /* NETDEV_PACKET_H */
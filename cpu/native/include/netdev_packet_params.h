@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     drivers_netdev
+ * @{
+ *
+ * @file
+ * @brief       Default configuration for the netdev_packet driver
+ */
+#ifndef NETDEV_PACKET_PARAMS_H
+#define NETDEV_PACKET_PARAMS_H
+
+#include "netdev_packet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of allocated parameters at @ref netdev_packet_params
+ */
+#ifndef NETDEV_PACKET_MAX
+#define NETDEV_PACKET_MAX           (1)
+#endif
+
+/**
+ * @brief   Configuration parameters for @ref netdev_packet_t
+ *
+ * @note    This variable is set on native start-up based on arguments provided
+ */
+extern netdev_packet_params_t netdev_packet_params[NETDEV_PACKET_MAX];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETDEV_PACKET_PARAMS_H */
+/** @} */
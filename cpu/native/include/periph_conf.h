@@ -20,13 +20,6 @@
  extern "C" {
 #endif
 
-/**
- * @name hardware timer clock skew avoidance
- * @{
- */
-#define NATIVE_TIMER_MIN_RES 200
-/** @} */
-
 /**
  * @name Random Number Generator configuration
  * @{
@@ -45,8 +38,10 @@
  * @name Timer peripheral configuration
  * @{
  */
-#define TIMER_NUMOF        (1U)
+#define TIMER_NUMOF        (2U)
+#define TIMER_CHANNELS     (4U)
 #define TIMER_0_EN         1
+#define TIMER_1_EN         1
 
 /**
  * @brief xtimer configuration
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_shm_radio  Shared memory radio medium
+ * @ingroup     drivers_netdev
+ * @brief       IEEE 802.15.4 device of native instances sharing a medium in
+ *              shared memory
+ *
+ * All instances map the same medium file, created with
+ * `dist/tools/shm_radio/shm_radio.py`. A sent frame is written once into the
+ * ring of the medium, each receiver reads it from there with its own read
+ * index. Receivers that drained the ring are woken up with a signal, so bursts
+ * of frames cost one signal per receiver.
+ *
+ * The medium holds the quality of the links between all nodes, from 0 (no
+ * link) to 255 (no loss). A frame of a link with quality q is received with a
+ * probability of q / 255. Collisions are not simulated.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Shared memory radio medium definitions
+ */
+#ifndef SHM_RADIO_H
+#define SHM_RADIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of a medium file ("RSHM")
+ */
+#define SHM_RADIO_MAGIC         (0x4d485352U)
+
+/**
+ * @brief   Version of the medium layout
+ */
+#define SHM_RADIO_VERSION       (1U)
+
+/**
+ * @brief   Header of the medium file
+ *
+ * Followed by the nodes_numof @ref shm_radio_node_t, the nodes_numof *
+ * nodes_numof link qualities (row of the sender first) padded to 4 bytes and
+ * the slots_numof @ref shm_radio_slot_t of the ring.
+ */
+typedef struct {
+    uint32_t magic;                 /**< @ref SHM_RADIO_MAGIC */
+    uint16_t version;               /**< @ref SHM_RADIO_VERSION */
+    uint16_t nodes_numof;           /**< number of nodes */
+    uint32_t slots_numof;           /**< slots in the ring, power of 2 */
+    volatile uint32_t head;         /**< index of the next frame */
+} shm_radio_medium_t;
+
+/**
+ * @brief   State of a node in the medium
+ */
+typedef struct {
+    volatile int32_t pid;           /**< process of the node, 0 if none */
+    volatile uint32_t armed;        /**< the node waits for a signal */
+} shm_radio_node_t;
+
+/**
+ * @brief   Frame in the ring
+ */
+typedef struct {
+    volatile uint32_t seq;          /**< index of the frame + 1, 0 while it
+                                     *   is written */
+    uint16_t sender;                /**< node that sent the frame */
+    uint8_t chan;                   /**< channel */
+    uint8_t len;                    /**< length of psdu */
+    uint8_t psdu[IEEE802154_FRAME_LEN_MAX]; /**< frame without FCS */
+    uint8_t padding;                /**< padding to 4 bytes */
+} shm_radio_slot_t;
+
+/**
+ * @brief   Shared memory radio device state
+ */
+typedef struct {
+    netdev_ieee802154_t netdev;     /**< netdev internal member */
+    shm_radio_medium_t *medium;     /**< mapped medium */
+    shm_radio_node_t *nodes;        /**< nodes of the medium */
+    const uint8_t *links;           /**< link qualities of the medium */
+    shm_radio_slot_t *slots;        /**< ring of the medium */
+    uint32_t rx_idx;                /**< index of the next frame to read */
+    uint16_t node;                  /**< index of this node */
+    uint8_t rx_lqi;                 /**< LQI of the accepted frame */
+    bool rx_accepted;               /**< frame at rx_idx passed the filters */
+    netdev_event_t last_event;      /**< event triggered */
+} shm_radio_t;
+
+/**
+ * @brief   Shared memory radio parameters
+ */
+typedef struct {
+    const char *medium;             /**< path of the medium file */
+    unsigned node;                  /**< index of the node in the medium */
+} shm_radio_params_t;
+
+/**
+ * @brief   Setup a shared memory radio device
+ *
+ * @param[out] dev      device to set up
+ * @param[in] params    parameters of the device
+ */
+void shm_radio_setup(shm_radio_t *dev, const shm_radio_params_t *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_RADIO_H */
+/** @} */
@@ -37,6 +37,9 @@
 #include "irq.h"
 #include "cpu.h"
 #include "periph/pm.h"
+#ifdef MODULE_THREADSTAT
+#include "threadstat.h"
+#endif
 
 #include "native_internal.h"
 
@@ -254,6 +257,9 @@ void native_irq_handler(void)
 {
     DEBUG("\n\n\t\tnative_irq_handler\n\n");
 
+#ifdef MODULE_THREADSTAT
+    threadstat_isr_enter();
+#endif
     while (_native_sigpend > 0) {
         int sig = _native_popsig();
         _native_sigpend--;
@@ -270,6 +276,10 @@ void native_irq_handler(void)
         }
     }
 
+#ifdef MODULE_THREADSTAT
+    threadstat_isr_exit();
+#endif
+
     DEBUG("native_irq_handler: return\n");
     cpu_switch_context_exit();
 }
@@ -497,6 +507,16 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: sigdelset");
     }
 
+#ifdef MODULE_NATIVE_PROFILE
+    /* the profiler samples critical sections and interrupts as well */
+    if (sigdelset(&_native_sig_set, SIGPROF) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigdelset");
+    }
+    if (sigdelset(&_native_sig_set_dint, SIGPROF) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigdelset");
+    }
+#endif
+
     /* SIGUSR1 is handled like a regular interrupt */
     if (sigaction(SIGUSR1, &sa, NULL)) {
         err(EXIT_FAILURE, "native_interrupt_init: sigaction");
@@ -0,0 +1,459 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/*
+ * @ingroup drivers_netdev
+ * @{
+ * @brief   Ethernet driver for host interfaces using TPACKET_V3 rings
+ * @}
+ */
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+/* needs to be included before native's declarations of ntohl etc. */
+#include "byteorder.h"
+
+#include <net/if.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+
+#include "native_internal.h"
+
+#include "async_read.h"
+
+#include "iolist.h"
+#include "msg.h"
+#include "net/netdev.h"
+#include "net/netdev/eth.h"
+#include "net/ethernet.h"
+#include "net/ethernet/hdr.h"
+#include "netdev_packet.h"
+#include "net/netopt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define RX_RING_SIZE    (NETDEV_PACKET_BLOCK_SIZE * NETDEV_PACKET_RX_BLOCKS)
+#define TX_RING_SIZE    (NETDEV_PACKET_BLOCK_SIZE * NETDEV_PACKET_TX_BLOCKS)
+#define TX_FRAMES_NUMOF (TX_RING_SIZE / NETDEV_PACKET_FRAME_SIZE)
+/* the kernel expects the frame of a TX slot behind the aligned header */
+#define TX_DATA_OFFSET  (TPACKET_ALIGN(sizeof(struct tpacket3_hdr)))
+
+static int _init(netdev_t *netdev);
+static int _send(netdev_t *netdev, const iolist_t *iolist);
+static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+
+static inline bool _is_addr_broadcast(const uint8_t *addr)
+{
+    return ((addr[0] == 0xff) && (addr[1] == 0xff) && (addr[2] == 0xff) &&
+            (addr[3] == 0xff) && (addr[4] == 0xff) && (addr[5] == 0xff));
+}
+
+static inline bool _is_addr_multicast(const uint8_t *addr)
+{
+    return (addr[0] & 0x01);
+}
+
+static inline struct tpacket_block_desc *_rx_block(netdev_packet_t *dev)
+{
+    return (struct tpacket_block_desc *)(dev->rx_ring +
+                                         (dev->rx_block *
+                                          NETDEV_PACKET_BLOCK_SIZE));
+}
+
+static inline struct tpacket3_hdr *_tx_slot(netdev_packet_t *dev)
+{
+    return (struct tpacket3_hdr *)(dev->tx_ring +
+                                   (dev->tx_frame *
+                                    NETDEV_PACKET_FRAME_SIZE));
+}
+
+static void _rx_release_block(netdev_packet_t *dev)
+{
+    __atomic_store_n(&_rx_block(dev)->hdr.bh1.block_status, TP_STATUS_KERNEL,
+                     __ATOMIC_RELEASE);
+    dev->rx_block = (dev->rx_block + 1) % NETDEV_PACKET_RX_BLOCKS;
+    dev->rx_frame = NULL;
+}
+
+static void _rx_advance(netdev_packet_t *dev)
+{
+    struct tpacket3_hdr *hdr = (struct tpacket3_hdr *)dev->rx_frame;
+
+    if (--dev->rx_left == 0) {
+        _rx_release_block(dev);
+    }
+    else {
+        dev->rx_frame += hdr->tp_next_offset;
+    }
+}
+
+static bool _rx_accept(netdev_packet_t *dev, struct tpacket3_hdr *hdr)
+{
+    const struct sockaddr_ll *sll;
+    const ethernet_hdr_t *eth;
+
+    sll = (const struct sockaddr_ll *)((uint8_t *)hdr +
+                                       TPACKET_ALIGN(sizeof(*hdr)));
+    if (sll->sll_pkttype == PACKET_OUTGOING) {
+        /* our own frames or frames of the host side */
+        return false;
+    }
+    if (hdr->tp_snaplen < sizeof(ethernet_hdr_t)) {
+        return false;
+    }
+    eth = (const ethernet_hdr_t *)((uint8_t *)hdr + hdr->tp_mac);
+    if (!(dev->promiscuous) && !_is_addr_multicast(eth->dst) &&
+        !_is_addr_broadcast(eth->dst) &&
+        (memcmp(eth->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        DEBUG("netdev_packet: frame not for me => dropped\n");
+        return false;
+    }
+    return true;
+}
+
+/* returns the next frame to pass up, or NULL if the ring is drained */
+static struct tpacket3_hdr *_rx_next(netdev_packet_t *dev)
+{
+    while (1) {
+        if (dev->rx_frame == NULL) {
+            struct tpacket_block_desc *block = _rx_block(dev);
+
+            if (!(__atomic_load_n(&block->hdr.bh1.block_status,
+                                  __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+                return NULL;
+            }
+            dev->rx_left = block->hdr.bh1.num_pkts;
+            if (dev->rx_left == 0) {
+                _rx_release_block(dev);
+                continue;
+            }
+            dev->rx_frame = (uint8_t *)block +
+                            block->hdr.bh1.offset_to_first_pkt;
+        }
+        if (_rx_accept(dev, (struct tpacket3_hdr *)dev->rx_frame)) {
+            return (struct tpacket3_hdr *)dev->rx_frame;
+        }
+        _rx_advance(dev);
+    }
+}
+
+/* asks the kernel to send all frames queued in the TX ring */
+static int _tx_flush(netdev_packet_t *dev, bool wait)
+{
+    int res;
+
+    if ((dev->tx_pending == 0) && !wait) {
+        return 0;
+    }
+    _native_in_syscall++;
+    res = real_sendto(dev->sock_fd, NULL, 0, wait ? 0 : MSG_DONTWAIT, NULL, 0);
+    _native_in_syscall--;
+    if ((res < 0) && (errno != EAGAIN) && (errno != ENOBUFS)) {
+        DEBUG("netdev_packet: sendto: %s\n", strerror(errno));
+        return -errno;
+    }
+    dev->tx_pending = 0;
+    return 0;
+}
+
+static inline void _isr(netdev_t *netdev)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+
+    /* pass up all frames of the blocks handed over by the kernel */
+    while (netdev->event_callback) {
+        uint8_t *frame = (uint8_t *)_rx_next(dev);
+
+        if (frame == NULL) {
+            break;
+        }
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        if (dev->rx_frame == frame) {
+            /* the frame was not received by the upper layer */
+            break;
+        }
+    }
+    native_async_read_continue(dev->sock_fd);
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+    int res;
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            if (max_len < ETHERNET_ADDR_LEN) {
+                res = -EINVAL;
+            }
+            else {
+                memcpy(value, dev->addr, ETHERNET_ADDR_LEN);
+                res = ETHERNET_ADDR_LEN;
+            }
+            break;
+        case NETOPT_PROMISCUOUSMODE:
+            *((bool *)value) = (bool)dev->promiscuous;
+            res = sizeof(bool);
+            break;
+        default:
+            res = netdev_eth_get(netdev, opt, value, max_len);
+            break;
+    }
+
+    return res;
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+    int res;
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            assert(value_len >= ETHERNET_ADDR_LEN);
+            memcpy(dev->addr, value, ETHERNET_ADDR_LEN);
+            res = ETHERNET_ADDR_LEN;
+            break;
+        case NETOPT_PROMISCUOUSMODE:
+            dev->promiscuous = ((const bool *)value)[0];
+            res = sizeof(netopt_enable_t);
+            break;
+        default:
+            res = netdev_eth_set(netdev, opt, value, value_len);
+            break;
+    }
+
+    return res;
+}
+
+static const netdev_driver_t netdev_driver_packet = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+    struct tpacket3_hdr *hdr = _rx_next(dev);
+    int size;
+
+    (void)info;
+    if (hdr == NULL) {
+        return 0;
+    }
+    size = hdr->tp_snaplen;
+    if (buf == NULL) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev_packet: discarding the frame\n");
+            _rx_advance(dev);
+        }
+        return size;
+    }
+    if ((size_t)size > len) {
+        _rx_advance(dev);
+        return -ENOBUFS;
+    }
+    memcpy(buf, (uint8_t *)hdr + hdr->tp_mac, size);
+    _rx_advance(dev);
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += size;
+#endif
+    return size;
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+    struct tpacket3_hdr *hdr = _tx_slot(dev);
+    size_t bytes = iolist_size(iolist);
+    uint8_t *pos;
+
+    if (bytes > NETDEV_PACKET_FRAME_SIZE - TX_DATA_OFFSET) {
+        return -EOVERFLOW;
+    }
+    if (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) !=
+        TP_STATUS_AVAILABLE) {
+        /* ring is full, wait for the kernel to send the queued frames */
+        _tx_flush(dev, true);
+        if (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) !=
+            TP_STATUS_AVAILABLE) {
+            return -EBUSY;
+        }
+    }
+
+    pos = (uint8_t *)hdr + TX_DATA_OFFSET;
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        memcpy(pos, iol->iol_base, iol->iol_len);
+        pos += iol->iol_len;
+    }
+    hdr->tp_len = bytes;
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST,
+                     __ATOMIC_RELEASE);
+    dev->tx_frame = (dev->tx_frame + 1) % TX_FRAMES_NUMOF;
+    dev->tx_pending++;
+
+    /* more frames are likely to follow while the network interface thread
+     * has messages queued, so only those frames are sent in one go */
+    if ((dev->tx_pending >= NETDEV_PACKET_TX_BATCH) || (msg_avail() == 0)) {
+        int res = _tx_flush(dev, false);
+
+        if (res < 0) {
+            return res;
+        }
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += bytes;
+#endif
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+    }
+    return bytes;
+}
+
+void netdev_packet_setup(netdev_packet_t *dev,
+                         const netdev_packet_params_t *params)
+{
+    memset(dev, 0, sizeof(netdev_packet_t));
+    dev->netdev.driver = &netdev_driver_packet;
+    dev->sock_fd = -1;
+    strncpy(dev->if_name, params->if_name, IFNAMSIZ - 1);
+    dev->if_name[IFNAMSIZ - 1] = '\0';
+}
+
+static void _packet_isr(int fd, void *arg)
+{
+    (void)fd;
+
+    netdev_t *netdev = (netdev_t *)arg;
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    }
+    else {
+        puts("netdev_packet: _isr: no event callback.");
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    netdev_packet_t *dev = (netdev_packet_t *)netdev;
+    int version = TPACKET_V3;
+    struct tpacket_req3 req;
+    struct sockaddr_ll sll;
+    struct packet_mreq mreq;
+    struct ifreq ifr;
+    uint8_t *ring;
+
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (dev->sock_fd >= 0) {
+        /* reinitialization keeps the rings */
+        return 0;
+    }
+
+    _native_syscall_enter();
+    dev->sock_fd = real_socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (dev->sock_fd == -1) {
+        err(EXIT_FAILURE, "netdev_packet: socket");
+    }
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, dev->if_name, IFNAMSIZ - 1);
+    if (real_ioctl(dev->sock_fd, SIOCGIFINDEX, &ifr) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: interface %s", dev->if_name);
+    }
+    if (real_setsockopt(dev->sock_fd, SOL_PACKET, PACKET_VERSION, &version,
+                        sizeof(version)) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: TPACKET_V3");
+    }
+
+    /* the kernel hands over RX blocks when they are full or timed out */
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = NETDEV_PACKET_BLOCK_SIZE;
+    req.tp_block_nr = NETDEV_PACKET_RX_BLOCKS;
+    req.tp_frame_size = NETDEV_PACKET_FRAME_SIZE;
+    req.tp_frame_nr = RX_RING_SIZE / NETDEV_PACKET_FRAME_SIZE;
+    req.tp_retire_blk_tov = NETDEV_PACKET_RX_TIMEOUT;
+    if (real_setsockopt(dev->sock_fd, SOL_PACKET, PACKET_RX_RING, &req,
+                        sizeof(req)) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: PACKET_RX_RING");
+    }
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = NETDEV_PACKET_BLOCK_SIZE;
+    req.tp_block_nr = NETDEV_PACKET_TX_BLOCKS;
+    req.tp_frame_size = NETDEV_PACKET_FRAME_SIZE;
+    req.tp_frame_nr = TX_FRAMES_NUMOF;
+    if (real_setsockopt(dev->sock_fd, SOL_PACKET, PACKET_TX_RING, &req,
+                        sizeof(req)) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: PACKET_TX_RING");
+    }
+    ring = mmap(NULL, RX_RING_SIZE + TX_RING_SIZE, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_LOCKED, dev->sock_fd, 0);
+    if (ring == MAP_FAILED) {
+        /* locking may exceed RLIMIT_MEMLOCK */
+        ring = mmap(NULL, RX_RING_SIZE + TX_RING_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, dev->sock_fd, 0);
+        if (ring == MAP_FAILED) {
+            err(EXIT_FAILURE, "netdev_packet: mmap");
+        }
+    }
+    dev->rx_ring = ring;
+    dev->tx_ring = ring + RX_RING_SIZE;
+
+    memset(&sll, 0, sizeof(sll));
+    sll.sll_family = AF_PACKET;
+    sll.sll_protocol = htons(ETH_P_ALL);
+    sll.sll_ifindex = ifr.ifr_ifindex;
+    if (real_bind(dev->sock_fd, (struct sockaddr *)&sll, sizeof(sll)) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: bind(%s)", dev->if_name);
+    }
+    /* the device has its own MAC address on the host interface */
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = ifr.ifr_ifindex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    if (real_setsockopt(dev->sock_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP,
+                        &mreq, sizeof(mreq)) == -1) {
+        warn("netdev_packet: PACKET_MR_PROMISC");
+    }
+
+    /* get MAC address and change it so it differs from the host's */
+    if (real_ioctl(dev->sock_fd, SIOCGIFHWADDR, &ifr) == -1) {
+        err(EXIT_FAILURE, "netdev_packet: SIOCGIFHWADDR");
+    }
+    memcpy(dev->addr, ifr.ifr_hwaddr.sa_data, ETHERNET_ADDR_LEN);
+    dev->addr[5]++;
+    _native_syscall_leave();
+    DEBUG("netdev_packet: addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
+          dev->addr[0], dev->addr[1], dev->addr[2],
+          dev->addr[3], dev->addr[4], dev->addr[5]);
+
+    /* configure signal handler for fds */
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock_fd, netdev, _packet_isr);
+
+#ifdef MODULE_NETSTATS_L2
+    memset(&netdev->stats, 0, sizeof(netstats_t));
+#endif
+    return 0;
+}
@@ -25,6 +25,9 @@
 #include "native_internal.h"
 #include "async_read.h"
 #include "tty_uart.h"
+#ifdef MODULE_NATIVE_VTIME
+#include "native_vtime.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -32,7 +35,15 @@
 void pm_set_lowest(void)
 {
     _native_in_syscall++; /* no switching here */
-    real_pause();
+#ifdef MODULE_NATIVE_VTIME
+    if (native_vtime_enabled()) {
+        native_vtime_idle();
+    }
+    else
+#endif
+    {
+        real_pause();
+    }
     _native_in_syscall--;
 
     if (_native_sigpend > 0) {
@@ -15,10 +15,15 @@
  * @file
  * @brief       Native CPU periph/timer.h implementation
  *
- * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
+ * Uses the monotonic clock and a POSIX per-process timer to mimic hardware.
+ *
+ * All channels of all timers keep an absolute deadline on the host's
+ * monotonic clock. A single host timer is armed with the earliest deadline,
+ * its signal runs the callbacks of all channels that are due. On Linux the
+ * host timer is backed by an hrtimer, so deadlines are met with the
+ * resolution of the host instead of being rounded to the itimer.
  *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
- * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
@@ -38,6 +43,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,99 +53,250 @@
 #include "cpu_conf.h"
 #include "native_internal.h"
 #include "periph/timer.h"
+#ifdef MODULE_NATIVE_VTIME
+#include "native_vtime.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 #define NATIVE_TIMER_SPEED 1000000
 
-static unsigned long time_null;
+/**
+ * @brief   Marks a channel without deadline
+ */
+#define DEADLINE_NONE   (UINT64_MAX)
+
+typedef struct {
+    timer_cb_t cb;                      /**< callback, NULL if not initialized */
+    void *arg;                          /**< argument of the callback */
+    uint64_t time_null;                 /**< host time of tick 0 */
+    uint64_t stopped;                   /**< host time of timer_stop(), 0 if
+                                         *   running */
+    uint64_t deadline[TIMER_CHANNELS];  /**< host time the channels fire */
+} _timer_t;
+
+static _timer_t _timers[TIMER_NUMOF];
 
-static timer_cb_t _callback;
-static void *_cb_arg;
+/* the host timer is armed once after all due callbacks ran */
+static bool _in_isr;
 
-static struct itimerval itv;
+#ifndef __MACH__
+static timer_t _host_timer;
+static bool _host_timer_created;
+#endif
 
 /**
  * returns ticks for give timespec
  */
-static unsigned long ts2ticks(struct timespec *tp)
+static uint64_t ts2ticks(struct timespec *tp)
 {
-    /* TODO: check for overflow */
-    return((tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
+    return (((uint64_t)tp->tv_sec * NATIVE_TIMER_SPEED) +
+            (tp->tv_nsec / 1000));
+}
+
+/**
+ * returns the host time in ticks
+ */
+static uint64_t _host_now(void)
+{
+    struct timespec t;
+
+#ifdef MODULE_NATIVE_VTIME
+    if (native_vtime_enabled()) {
+        return native_vtime_now();
+    }
+#endif
+
+    _native_syscall_enter();
+#ifdef __MACH__
+    clock_serv_t cclock;
+    mach_timespec_t mts;
+    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
+    clock_get_time(cclock, &mts);
+    mach_port_deallocate(mach_task_self(), cclock);
+    t.tv_sec = mts.tv_sec;
+    t.tv_nsec = mts.tv_nsec;
+#else
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "timer_read: clock_gettime");
+    }
+
+#endif
+    _native_syscall_leave();
+
+    return ts2ticks(&t);
+}
+
+/**
+ * arms the host timer with the earliest deadline of all running channels
+ */
+static void _arm(void)
+{
+    uint64_t next = DEADLINE_NONE;
+
+    if (_in_isr) {
+        return;
+    }
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        if ((_timers[i].cb == NULL) || _timers[i].stopped) {
+            continue;
+        }
+        for (unsigned chan = 0; chan < TIMER_CHANNELS; chan++) {
+            if (_timers[i].deadline[chan] < next) {
+                next = _timers[i].deadline[chan];
+            }
+        }
+    }
+
+#ifdef MODULE_NATIVE_VTIME
+    if (native_vtime_enabled()) {
+        uint64_t now = native_vtime_now();
+
+        if (next == DEADLINE_NONE) {
+            native_vtime_set(0);
+        }
+        else {
+            /* offset 0 disarms, so due deadlines are set 1 tick ahead */
+            native_vtime_set((next > now) ? (uint32_t)(next - now) : 1);
+        }
+        return;
+    }
+#endif
+
+    DEBUG("timer: arming at %llu\n", (unsigned long long)next);
+
+#ifdef __MACH__
+    struct itimerval itv;
+
+    memset(&itv, 0, sizeof(itv));
+    if (next != DEADLINE_NONE) {
+        uint64_t now = _host_now();
+        /* the itimer is relative, a zero offset would disarm it */
+        uint64_t offset = (next > now) ? (next - now) : 1;
+
+        itv.it_value.tv_sec = offset / NATIVE_TIMER_SPEED;
+        itv.it_value.tv_usec = offset % NATIVE_TIMER_SPEED;
+    }
+    _native_syscall_enter();
+    if (real_setitimer(ITIMER_REAL, &itv, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: setitimer");
+    }
+#else
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    if (next != DEADLINE_NONE) {
+        its.it_value.tv_sec = next / NATIVE_TIMER_SPEED;
+        its.it_value.tv_nsec = (next % NATIVE_TIMER_SPEED) * 1000;
+    }
+    _native_syscall_enter();
+    if (timer_settime(_host_timer, TIMER_ABSTIME, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+#endif
+    _native_syscall_leave();
 }
 
 /**
  * native timer signal handler
  *
- * set new system timer, call timer interrupt handler
+ * call the callbacks of all channels that are due, set new system timer
  */
 void native_isr_timer(void)
 {
+    uint64_t now = _host_now();
+
     DEBUG("%s\n", __func__);
 
-    _callback(_cb_arg, 0);
+    _in_isr = true;
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        _timer_t *timer = &_timers[i];
+
+        if ((timer->cb == NULL) || timer->stopped) {
+            continue;
+        }
+        for (unsigned chan = 0; chan < TIMER_CHANNELS; chan++) {
+            if (timer->deadline[chan] <= now) {
+                timer->deadline[chan] = DEADLINE_NONE;
+                timer->cb(timer->arg, chan);
+            }
+        }
+    }
+    _in_isr = false;
+    _arm();
 }
 
-int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
+static void _init_host_timer(void)
 {
-    (void)freq;
-    DEBUG("%s\n", __func__);
-    if (dev >= TIMER_NUMOF) {
-        return -1;
+#ifdef MODULE_NATIVE_VTIME
+    native_vtime_init(native_isr_timer);
+    if (native_vtime_enabled()) {
+        return;
     }
-    if (freq != NATIVE_TIMER_SPEED) {
-        return -1;
+#endif
+#ifndef __MACH__
+    if (!_host_timer_created) {
+        struct sigevent sev;
+
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = SIGALRM;
+        _native_syscall_enter();
+        if (timer_create(CLOCK_MONOTONIC, &sev, &_host_timer) == -1) {
+            err(EXIT_FAILURE, "timer_init: timer_create");
+        }
+        _native_syscall_leave();
+        _host_timer_created = true;
     }
-
-    /* initialize time delta */
-    time_null = 0;
-    time_null = timer_read(0);
-
-    _callback = cb;
-    _cb_arg = arg;
+#endif
     if (register_interrupt(SIGALRM, native_isr_timer) != 0) {
         DEBUG("darn!\n\n");
     }
-
-    return 0;
 }
 
-static void do_timer_set(unsigned int offset)
+int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
 {
     DEBUG("%s\n", __func__);
-
-    if (offset && offset < NATIVE_TIMER_MIN_RES) {
-        offset = NATIVE_TIMER_MIN_RES;
+    if (dev >= TIMER_NUMOF) {
+        return -1;
+    }
+    if (freq != NATIVE_TIMER_SPEED) {
+        return -1;
     }
 
-    memset(&itv, 0, sizeof(itv));
-    itv.it_value.tv_sec = (offset / 1000000);
-    itv.it_value.tv_usec = offset % 1000000;
+    _init_host_timer();
 
-    DEBUG("timer_set(): setting %u.%06u\n", (unsigned)itv.it_value.tv_sec, (unsigned)itv.it_value.tv_usec);
+    _timer_t *timer = &_timers[dev];
 
-    _native_syscall_enter();
-    if (real_setitimer(ITIMER_REAL, &itv, NULL) == -1) {
-        err(EXIT_FAILURE, "timer_arm: setitimer");
+    timer->cb = cb;
+    timer->arg = arg;
+    timer->stopped = 0;
+    for (unsigned chan = 0; chan < TIMER_CHANNELS; chan++) {
+        timer->deadline[chan] = DEADLINE_NONE;
     }
-    _native_syscall_leave();
+    /* initialize time delta */
+    timer->time_null = _host_now();
+    _arm();
+
+    return 0;
 }
 
 int timer_set(tim_t dev, int channel, unsigned int offset)
 {
-    (void)dev;
     DEBUG("%s\n", __func__);
 
-    if (channel != 0) {
+    if ((dev >= TIMER_NUMOF) || (channel < 0) ||
+        (channel >= (int)TIMER_CHANNELS)) {
         return -1;
     }
 
-    if (!offset) {
-        offset = NATIVE_TIMER_MIN_RES;
-    }
+    _timer_t *timer = &_timers[dev];
+    uint64_t now = timer->stopped ? timer->stopped : _host_now();
 
-    do_timer_set(offset);
+    timer->deadline[channel] = now + offset;
+    _arm();
 
     return 1;
 }
@@ -147,29 +304,57 @@ int timer_set(tim_t dev, int channel, unsigned int offset)
 int timer_set_absolute(tim_t dev, int channel, unsigned int value)
 {
     uint32_t now = timer_read(dev);
+
+    /* like a compare register, a value just passed fires after the counter
+     * wrapped around */
     return timer_set(dev, channel, value - now);
 }
 
 int timer_clear(tim_t dev, int channel)
 {
-    (void)dev;
-    (void)channel;
+    if ((dev >= TIMER_NUMOF) || (channel < 0) ||
+        (channel >= (int)TIMER_CHANNELS)) {
+        return -1;
+    }
 
-    do_timer_set(0);
+    _timers[dev].deadline[channel] = DEADLINE_NONE;
+    _arm();
 
     return 1;
 }
 
 void timer_start(tim_t dev)
 {
-    (void)dev;
     DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || !_timers[dev].stopped) {
+        return;
+    }
+
+    _timer_t *timer = &_timers[dev];
+    uint64_t paused = _host_now() - timer->stopped;
+
+    /* the counter did not advance while the timer was stopped */
+    timer->time_null += paused;
+    for (unsigned chan = 0; chan < TIMER_CHANNELS; chan++) {
+        if (timer->deadline[chan] != DEADLINE_NONE) {
+            timer->deadline[chan] += paused;
+        }
+    }
+    timer->stopped = 0;
+    _arm();
 }
 
 void timer_stop(tim_t dev)
 {
-    (void)dev;
     DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || _timers[dev].stopped) {
+        return;
+    }
+
+    _timers[dev].stopped = _host_now();
+    _arm();
 }
 
 unsigned int timer_read(tim_t dev)
@@ -178,27 +363,11 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
-    _native_syscall_enter();
-#ifdef __MACH__
-    clock_serv_t cclock;
-    mach_timespec_t mts;
-    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
-    clock_get_time(cclock, &mts);
-    mach_port_deallocate(mach_task_self(), cclock);
-    t.tv_sec = mts.tv_sec;
-    t.tv_nsec = mts.tv_nsec;
-#else
-
-    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
-        err(EXIT_FAILURE, "timer_read: clock_gettime");
-    }
-
-#endif
-    _native_syscall_leave();
+    _timer_t *timer = &_timers[dev];
+    uint64_t now = timer->stopped ? timer->stopped : _host_now();
 
-    return ts2ticks(&t) - time_null;
+    /* the counter wraps around like a 32-bit hardware counter */
+    return (uint32_t)(now - timer->time_null);
 }
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Packet capture of native to a host file
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "net/gnrc/pktcap.h"
+#include "native_pktcap.h"
+
+#include "native_internal.h"
+
+const char *_native_pktcap_path;
+
+static ssize_t _write(void *arg, const void *data, size_t len)
+{
+    int fd = (int)(intptr_t)arg;
+    const uint8_t *pos = data;
+    size_t left = len;
+
+    while (left > 0) {
+        ssize_t res;
+
+        _native_syscall_enter();
+        res = real_write(fd, pos, left);
+        /* leaving the syscall may run interrupts, which change errno */
+        res = (res < 0) ? -errno : res;
+        _native_syscall_leave();
+        if (res == -EINTR) {
+            continue;
+        }
+        if (res < 0) {
+            return res;
+        }
+        pos += res;
+        left -= res;
+    }
+    return len;
+}
+
+static void _close(void *arg)
+{
+    _native_syscall_enter();
+    real_close((int)(intptr_t)arg);
+    _native_syscall_leave();
+}
+
+void auto_init_native_pktcap(void)
+{
+    gnrc_pktcap_sink_t sink = { .write = _write, .close = _close };
+    int fd, res;
+
+    if (_native_pktcap_path == NULL) {
+        return;
+    }
+    _native_syscall_enter();
+    fd = real_open(_native_pktcap_path, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    fd = (fd < 0) ? -errno : fd;
+    _native_syscall_leave();
+    if (fd < 0) {
+        real_printf("native_pktcap: cannot open %s: %s\n", _native_pktcap_path,
+                    strerror(-fd));
+        return;
+    }
+    sink.arg = (void *)(intptr_t)fd;
+    if ((res = gnrc_pktcap_start(&sink)) < 0) {
+        real_printf("native_pktcap: cannot start capture: %s\n",
+                    strerror(-res));
+        _close(sink.arg);
+    }
+}
@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Sampling profiler for native
+ *
+ * The SIGPROF handler only walks the stack with backtrace() and counts the
+ * stack in a table allocated at start, so it neither allocates nor takes
+ * locks. Addresses are resolved to function names when the table is dumped.
+ *
+ * @}
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#ifndef __MACH__
+#include <elf.h>
+#include <link.h>
+#endif
+#include <err.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "sched.h"
+#include "thread.h"
+#include "native_profile.h"
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Context of samples taken in an interrupt
+ */
+#define CTX_ISR             (-1)
+
+/**
+ * @brief   Frames of backtrace() that belong to the signal handler at most
+ */
+#define HANDLER_FRAMES      (4U)
+
+/**
+ * @brief   Size of a line of the dump
+ */
+#define LINE_SIZE           (4096U)
+
+typedef struct {
+    uint32_t count;                             /**< samples, 0 if unused */
+    kernel_pid_t ctx;                           /**< thread or CTX_ISR */
+    uint16_t depth;                             /**< frames used */
+    void *frames[NATIVE_PROFILE_DEPTH];         /**< innermost frame first */
+} _stack_t;
+
+typedef struct {
+    char *stack;                                /**< folded stack */
+    uint32_t count;                             /**< samples */
+} _line_t;
+
+#ifndef __MACH__
+typedef struct {
+    uintptr_t addr;                             /**< start of the function */
+    size_t size;                                /**< size of the function */
+    const char *name;                           /**< name in the strtab */
+} _sym_t;
+#endif
+
+const char *_native_profile_path;
+
+static _stack_t *_stacks;
+static volatile bool _running;
+static uint32_t _samples, _dropped;
+
+static uintptr_t _interrupted_pc(void *context)
+{
+    /* see native_isr_entry() */
+#ifdef __MACH__
+    return ((ucontext_t *)context)->uc_mcontext->__ss.__eip;
+#elif defined(__FreeBSD__)
+    return ((struct sigcontext *)context)->sc_eip;
+#else /* Linux */
+#if defined(__arm__)
+    return ((ucontext_t *)context)->uc_mcontext.arm_pc;
+#else /* Linux/x86 */
+    return ((ucontext_t *)context)->uc_mcontext.gregs[REG_EIP];
+#endif
+#endif
+}
+
+static uint32_t _hash(kernel_pid_t ctx, void **frames, unsigned depth)
+{
+    /* FNV-1a over the frame addresses */
+    uint32_t hash = 2166136261U ^ (uint16_t)ctx;
+
+    for (unsigned i = 0; i < depth; i++) {
+        hash = (hash ^ (uintptr_t)frames[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static void _sample(int sig, siginfo_t *info, void *context)
+{
+    void *frames[NATIVE_PROFILE_DEPTH + HANDLER_FRAMES];
+    int saved_errno = errno;
+    unsigned skip = 2;
+    (void)sig;
+    (void)info;
+
+    if (!_running) {
+        return;
+    }
+
+    int depth = backtrace(frames, sizeof(frames) / sizeof(frames[0]));
+    uintptr_t pc = _interrupted_pc(context);
+
+    /* the handler and the signal trampoline come before the interrupted
+     * function */
+    for (int i = 0; (i < depth) && (i < (int)HANDLER_FRAMES); i++) {
+        if ((uintptr_t)frames[i] == pc) {
+            skip = i;
+            break;
+        }
+    }
+    depth = (depth > (int)skip) ? (depth - skip) : 0;
+    if (depth > (int)NATIVE_PROFILE_DEPTH) {
+        depth = NATIVE_PROFILE_DEPTH;
+    }
+
+    kernel_pid_t ctx = _native_in_isr ? CTX_ISR : sched_active_pid;
+    uint32_t idx = _hash(ctx, &frames[skip], depth);
+
+    _samples++;
+    for (unsigned probe = 0; probe < NATIVE_PROFILE_STACKS; probe++) {
+        _stack_t *stack = &_stacks[(idx + probe) & (NATIVE_PROFILE_STACKS - 1)];
+
+        if (stack->count == 0) {
+            stack->ctx = ctx;
+            stack->depth = depth;
+            memcpy(stack->frames, &frames[skip], depth * sizeof(void *));
+            stack->count = 1;
+            errno = saved_errno;
+            return;
+        }
+        if ((stack->ctx == ctx) && (stack->depth == depth) &&
+            (memcmp(stack->frames, &frames[skip],
+                    depth * sizeof(void *)) == 0)) {
+            stack->count++;
+            errno = saved_errno;
+            return;
+        }
+    }
+    _dropped++;
+    errno = saved_errno;
+}
+
+static void _set_interval(unsigned usec)
+{
+    struct itimerval itv;
+
+    itv.it_interval.tv_sec = usec / 1000000;
+    itv.it_interval.tv_usec = usec % 1000000;
+    itv.it_value = itv.it_interval;
+    if (real_setitimer(ITIMER_PROF, &itv, NULL) == -1) {
+        err(EXIT_FAILURE, "native_profile: setitimer");
+    }
+}
+
+static void _dump_at_exit(void)
+{
+    int res = native_profile_dump(_native_profile_path);
+
+    if (res < 0) {
+        errno = -res;
+        warn("native_profile: %s", _native_profile_path);
+    }
+}
+
+void native_profile_start(void)
+{
+    struct sigaction sa;
+    void *frame;
+
+    _native_syscall_enter();
+    if (_stacks == NULL) {
+        _stacks = real_calloc(NATIVE_PROFILE_STACKS, sizeof(_stack_t));
+        if (_stacks == NULL) {
+            err(EXIT_FAILURE, "native_profile: calloc");
+        }
+        /* the unwinder is loaded on the first call, which allocates, so do
+         * it before the signal handler needs it */
+        backtrace(&frame, 1);
+        if (_native_profile_path != NULL) {
+            atexit(_dump_at_exit);
+        }
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = _sample;
+    /* SIGPROF interrupts native's signal handlers as well, so they are
+     * sampled, but is not interrupted itself */
+    sigfillset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART | SA_SIGINFO | SA_ONSTACK;
+    if (sigaction(SIGPROF, &sa, NULL) == -1) {
+        err(EXIT_FAILURE, "native_profile: sigaction");
+    }
+    _running = true;
+    _set_interval(NATIVE_PROFILE_INTERVAL);
+    _native_syscall_leave();
+}
+
+void native_profile_stop(void)
+{
+    _native_syscall_enter();
+    _set_interval(0);
+    _running = false;
+    _native_syscall_leave();
+}
+
+#ifndef __MACH__
+static _sym_t *_syms;
+static size_t _syms_numof;
+static char *_image;
+static uintptr_t _load_bias;
+static void *_exe_base;
+
+static int _sym_cmp(const void *a, const void *b)
+{
+    const _sym_t *sym_a = a, *sym_b = b;
+
+    return (sym_a->addr > sym_b->addr) - (sym_a->addr < sym_b->addr);
+}
+
+static int _first_object(struct dl_phdr_info *info, size_t size, void *data)
+{
+    (void)size;
+    (void)data;
+
+    /* the executable itself is reported first */
+    _load_bias = info->dlpi_addr;
+    return 1;
+}
+
+/**
+ * reads the function symbols of the executable
+ *
+ * dladdr() only knows exported symbols, which misses all static functions.
+ */
+static void _load_syms(void)
+{
+#ifdef __linux__
+    const char *path = "/proc/self/exe";
+#else
+    const char *path = _progname;
+#endif
+    struct stat st;
+    Dl_info info;
+    int fd = real_open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return;
+    }
+    /* any object of the executable tells where it is mapped */
+    if (dladdr(&_stacks, &info)) {
+        _exe_base = info.dli_fbase;
+    }
+    if ((real_fstat(fd, &st) < 0) ||
+        ((size_t)st.st_size < sizeof(ElfW(Ehdr))) ||
+        ((_image = real_malloc(st.st_size)) == NULL)) {
+        real_close(fd);
+        return;
+    }
+    for (off_t pos = 0; pos < st.st_size;) {
+        ssize_t res = real_read(fd, _image + pos, st.st_size - pos);
+
+        if (res <= 0) {
+            real_close(fd);
+            return;
+        }
+        pos += res;
+    }
+    real_close(fd);
+
+    const ElfW(Ehdr) *ehdr = (const ElfW(Ehdr) *)_image;
+
+    if ((memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0) ||
+        (ehdr->e_shoff + (size_t)ehdr->e_shnum * sizeof(ElfW(Shdr)) >
+         (size_t)st.st_size)) {
+        return;
+    }
+
+    const ElfW(Shdr) *shdrs = (const ElfW(Shdr) *)(_image + ehdr->e_shoff);
+
+    for (unsigned i = 0; i < ehdr->e_shnum; i++) {
+        if ((shdrs[i].sh_type != SHT_SYMTAB) ||
+            (shdrs[i].sh_link >= ehdr->e_shnum)) {
+            continue;
+        }
+
+        const ElfW(Sym) *syms = (const ElfW(Sym) *)(_image + shdrs[i].sh_offset);
+        const char *strtab = _image + shdrs[shdrs[i].sh_link].sh_offset;
+        size_t numof = shdrs[i].sh_size / sizeof(ElfW(Sym));
+
+        _syms = real_calloc(numof, sizeof(_sym_t));
+        if (_syms == NULL) {
+            return;
+        }
+        for (size_t j = 0; j < numof; j++) {
+            if ((ELF32_ST_TYPE(syms[j].st_info) != STT_FUNC) ||
+                (syms[j].st_shndx == SHN_UNDEF) || (syms[j].st_value == 0)) {
+                continue;
+            }
+            _syms[_syms_numof].addr = syms[j].st_value;
+            _syms[_syms_numof].size = syms[j].st_size;
+            _syms[_syms_numof].name = strtab + syms[j].st_name;
+            _syms_numof++;
+        }
+        qsort(_syms, _syms_numof, sizeof(_sym_t), _sym_cmp);
+        break;
+    }
+    dl_iterate_phdr(_first_object, NULL);
+}
+
+static const char *_lookup_sym(uintptr_t addr)
+{
+    size_t lo = 0, hi = _syms_numof;
+
+    addr -= _load_bias;
+    /* find the last function starting at or before addr */
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (_syms[mid].addr <= addr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if ((lo == 0) ||
+        ((_syms[lo - 1].size != 0) &&
+         (addr >= _syms[lo - 1].addr + _syms[lo - 1].size))) {
+        return NULL;
+    }
+    return _syms[lo - 1].name;
+}
+#endif
+
+/**
+ * appends the name of the function at addr to line
+ */
+static size_t _print_frame(char *line, size_t pos, uintptr_t addr)
+{
+    const char *name = NULL;
+    Dl_info info = { .dli_fname = NULL };
+
+    if (dladdr((void *)addr, &info)) {
+        name = info.dli_sname;
+#ifndef __MACH__
+        if (info.dli_fbase == _exe_base) {
+            name = _lookup_sym(addr);
+        }
+#endif
+    }
+    if (name != NULL) {
+        return pos + snprintf(line + pos, LINE_SIZE - pos, ";%s", name);
+    }
+    if ((info.dli_fname != NULL) && (info.dli_fname[0] != '\0')) {
+        /* at least name the library, its addresses differ on each run */
+        const char *file = strrchr(info.dli_fname, '/');
+
+        return pos + snprintf(line + pos, LINE_SIZE - pos, ";[%s]",
+                              (file != NULL) ? (file + 1) : info.dli_fname);
+    }
+    return pos + snprintf(line + pos, LINE_SIZE - pos, ";0x%lx",
+                          (unsigned long)addr);
+}
+
+static size_t _print_ctx(char *line, kernel_pid_t ctx)
+{
+    const char *name = NULL;
+
+    if (ctx == CTX_ISR) {
+        name = "isr";
+    }
+    else if (ctx == KERNEL_PID_UNDEF) {
+        name = "startup";
+    }
+#ifdef DEVELHELP
+    else {
+        name = thread_getname(ctx);
+    }
+#endif
+    if (name != NULL) {
+        return snprintf(line, LINE_SIZE, "%s", name);
+    }
+    return snprintf(line, LINE_SIZE, "thread_%d", (int)ctx);
+}
+
+static int _line_cmp(const void *a, const void *b)
+{
+    return strcmp(((const _line_t *)a)->stack, ((const _line_t *)b)->stack);
+}
+
+/**
+ * resolves the stacks to lines, sorted so lines of stacks that only differ
+ * within functions are next to each other
+ */
+static _line_t *_resolve(unsigned *numof)
+{
+    static char line[LINE_SIZE];
+    _line_t *lines = real_calloc(NATIVE_PROFILE_STACKS, sizeof(_line_t));
+
+    *numof = 0;
+    if (lines == NULL) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < NATIVE_PROFILE_STACKS; i++) {
+        _stack_t *stack = &_stacks[i];
+        size_t pos;
+
+        if (stack->count == 0) {
+            continue;
+        }
+        pos = _print_ctx(line, stack->ctx);
+        for (int j = stack->depth - 1; (j >= 0) && (pos < LINE_SIZE); j--) {
+            uintptr_t addr = (uintptr_t)stack->frames[j];
+
+            /* return addresses point behind the call, which may already be
+             * the next function */
+            pos = _print_frame(line, pos, (j > 0) ? (addr - 1) : addr);
+        }
+        if (pos >= LINE_SIZE) {
+            pos = LINE_SIZE - 1;
+        }
+        lines[*numof].stack = real_malloc(pos + 1);
+        if (lines[*numof].stack == NULL) {
+            break;
+        }
+        memcpy(lines[*numof].stack, line, pos + 1);
+        lines[*numof].count = stack->count;
+        (*numof)++;
+    }
+    qsort(lines, *numof, sizeof(_line_t), _line_cmp);
+    return lines;
+}
+
+static int _write_line(int fd, const char *stack, uint32_t count)
+{
+    char buf[16];
+    size_t len = strlen(stack);
+    int res = snprintf(buf, sizeof(buf), " %" PRIu32 "\n", count);
+
+    while (len > 0) {
+        ssize_t written = real_write(fd, stack, len);
+
+        if (written < 0) {
+            return -errno;
+        }
+        stack += written;
+        len -= written;
+    }
+    return (real_write(fd, buf, res) == res) ? 0 : -EIO;
+}
+
+int native_profile_dump(const char *path)
+{
+    _line_t *lines;
+    unsigned numof;
+    int res = 0, written = 0;
+    bool running = _running;
+
+    if (_stacks == NULL) {
+        return 0;
+    }
+    if (running) {
+        native_profile_stop();
+    }
+
+    _native_syscall_enter();
+#ifndef __MACH__
+    if (_image == NULL) {
+        _load_syms();
+    }
+#endif
+    lines = _resolve(&numof);
+    int fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (lines == NULL) {
+        res = -ENOMEM;
+    }
+    else if (fd < 0) {
+        res = -errno;
+    }
+    for (unsigned i = 0; (res == 0) && (i < numof); i++) {
+        uint32_t count = lines[i].count;
+
+        /* merge the stacks that resolved to the same functions */
+        while ((i + 1 < numof) &&
+               (strcmp(lines[i].stack, lines[i + 1].stack) == 0)) {
+            count += lines[++i].count;
+        }
+        res = _write_line(fd, lines[i].stack, count);
+        written++;
+    }
+    if ((res == 0) && _dropped) {
+        res = _write_line(fd, "[dropped]", _dropped);
+    }
+    if ((fd >= 0) && (real_close(fd) < 0) && (res == 0)) {
+        res = -errno;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        real_free(lines[i].stack);
+    }
+    real_free(lines);
+    DEBUG("native_profile: %" PRIu32 " samples, %" PRIu32 " dropped\n",
+          _samples, _dropped);
+    _native_syscall_leave();
+
+    if (running) {
+        native_profile_start();
+    }
+    return (res < 0) ? res : written;
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Shared memory radio medium implementation
+ */
+
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "random.h"
+#include "shm_radio.h"
+#include "shm_radio_params.h"
+#include "thread.h"
+#include "native_internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Signal to wake up receivers
+ */
+#define SHM_RADIO_SIGNAL        (SIGUSR2)
+
+static shm_radio_t *_devs[SHM_RADIO_MAX];
+static unsigned _devs_numof;
+
+static inline uint8_t _link(const shm_radio_t *dev, unsigned sender)
+{
+    return dev->links[(sender * dev->medium->nodes_numof) + dev->node];
+}
+
+static bool _dst_not_me(shm_radio_t *dev, const void *buf)
+{
+    uint8_t dst_addr[IEEE802154_LONG_ADDRESS_LEN];
+    int dst_len;
+    le_uint16_t dst_pan = { .u16 = 0 };
+
+    dst_len = ieee802154_get_dst(buf, dst_addr, &dst_pan);
+    switch (dst_len) {
+        case IEEE802154_LONG_ADDRESS_LEN:
+            return memcmp(dst_addr, dev->netdev.long_addr, dst_len) != 0;
+        case IEEE802154_SHORT_ADDRESS_LEN:
+            return (memcmp(dst_addr, ieee802154_addr_bcast, dst_len) != 0) &&
+                   (memcmp(dst_addr, dev->netdev.short_addr, dst_len) != 0);
+        default:
+            return false;    /* better safe than sorry ;-) */
+    }
+}
+
+/* returns the next frame for this node, skipping frames that are filtered or
+ * lost, or NULL if there is none (yet) */
+static shm_radio_slot_t *_next_frame(shm_radio_t *dev)
+{
+    uint32_t mask = dev->medium->slots_numof - 1;
+
+    while ((int32_t)(__atomic_load_n(&dev->medium->head, __ATOMIC_ACQUIRE) -
+                     dev->rx_idx) > 0) {
+        shm_radio_slot_t *slot = &dev->slots[dev->rx_idx & mask];
+        uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq != dev->rx_idx + 1) {
+            if ((int32_t)(seq - (dev->rx_idx + 1)) > 0) {
+                /* overtaken by the senders, skip to the oldest frame */
+                DEBUG("shm_radio: lost %u frames\n",
+                      (unsigned)(seq - 1 - mask - dev->rx_idx));
+                dev->rx_idx = seq - 1 - mask;
+                dev->rx_accepted = false;
+                continue;
+            }
+            /* still written */
+            return NULL;
+        }
+        if (dev->rx_accepted) {
+            return slot;
+        }
+        if ((slot->sender != dev->node) &&
+            (slot->chan == dev->netdev.chan) && (_link(dev, slot->sender) > 0) &&
+            (random_uint32_range(0, 255) < _link(dev, slot->sender)) &&
+            !_dst_not_me(dev, slot->psdu)) {
+            dev->rx_lqi = _link(dev, slot->sender);
+            dev->rx_accepted = true;
+            return slot;
+        }
+        dev->rx_idx++;
+    }
+    return NULL;
+}
+
+/* checks if the process of a node still exists, releasing its slot if not */
+static bool _node_alive(shm_radio_node_t *node)
+{
+    int32_t pid = __atomic_load_n(&node->pid, __ATOMIC_SEQ_CST);
+
+    if (pid <= 0) {
+        return false;
+    }
+    if ((kill(pid, 0) == -1) && (errno == ESRCH)) {
+        __atomic_compare_exchange_n(&node->pid, &pid, 0, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        return false;
+    }
+    return true;
+}
+
+/* releases the node slots of this process, so no signal is sent to a later
+ * process reusing its PID */
+static void _release_nodes(void)
+{
+    for (unsigned i = 0; i < _devs_numof; i++) {
+        shm_radio_node_t *node = &_devs[i]->nodes[_devs[i]->node];
+        int32_t pid = _native_pid;
+
+        __atomic_store_n(&node->armed, 0, __ATOMIC_SEQ_CST);
+        __atomic_compare_exchange_n(&node->pid, &pid, 0, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+}
+
+static void _raise(void)
+{
+    int sig = SHM_RADIO_SIGNAL;
+
+    real_write(_sig_pipefd[1], &sig, sizeof(int));
+    _native_sigpend++;
+}
+
+/* notifies the thread if frames are left, else waits for the signal of the
+ * next sender */
+static void _continue_reading(shm_radio_t *dev)
+{
+    shm_radio_node_t *node = &dev->nodes[dev->node];
+
+    _native_in_syscall++; /* no switching here */
+    if (_next_frame(dev) == NULL) {
+        __atomic_store_n(&node->armed, 1, __ATOMIC_SEQ_CST);
+        /* a sender may have missed the armed flag */
+        if ((_next_frame(dev) == NULL) ||
+            !__atomic_exchange_n(&node->armed, 0, __ATOMIC_SEQ_CST)) {
+            _native_in_syscall--;
+            return;
+        }
+    }
+    _raise();
+    _native_in_syscall--;
+}
+
+static void _isr_signal(void)
+{
+    for (unsigned i = 0; i < _devs_numof; i++) {
+        shm_radio_t *dev = _devs[i];
+        netdev_t *netdev = (netdev_t *)dev;
+
+        if (_next_frame(dev) == NULL) {
+            /* woken up for a frame that is still written */
+            _continue_reading(dev);
+        }
+        else if (netdev->event_callback) {
+            dev->last_event = NETDEV_EVENT_RX_COMPLETE;
+            netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+        }
+    }
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+    shm_radio_medium_t *medium = dev->medium;
+    size_t len = iolist_size(iolist);
+    shm_radio_slot_t *slot;
+    uint8_t *pos;
+    uint32_t idx;
+
+    /* the FCS is not transmitted */
+    if (len > IEEE802154_FRAME_LEN_MAX - IEEE802154_FCS_LEN) {
+        return -EOVERFLOW;
+    }
+    /* simulate TX_STARTED interrupt */
+    if (netdev->event_callback) {
+        dev->last_event = NETDEV_EVENT_TX_STARTED;
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+        thread_yield();
+    }
+
+    idx = __atomic_fetch_add(&medium->head, 1, __ATOMIC_SEQ_CST);
+    slot = &dev->slots[idx & (medium->slots_numof - 1)];
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_SEQ_CST);
+    slot->sender = dev->node;
+    slot->chan = dev->netdev.chan;
+    slot->len = len;
+    pos = slot->psdu;
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        memcpy(pos, iol->iol_base, iol->iol_len);
+        pos += iol->iol_len;
+    }
+    __atomic_store_n(&slot->seq, idx + 1, __ATOMIC_SEQ_CST);
+
+    /* wake up the receivers waiting for a frame */
+    _native_in_syscall++;
+    for (unsigned i = 0; i < medium->nodes_numof; i++) {
+        shm_radio_node_t *node = &dev->nodes[i];
+
+        if ((dev->links[(dev->node * medium->nodes_numof) + i] > 0) &&
+            __atomic_exchange_n(&node->armed, 0, __ATOMIC_SEQ_CST) &&
+            _node_alive(node)) {
+            kill(node->pid, SHM_RADIO_SIGNAL);
+        }
+    }
+    _native_in_syscall--;
+
+    /* simulate TX_COMPLETE interrupt */
+    if (netdev->event_callback) {
+        dev->last_event = NETDEV_EVENT_TX_COMPLETE;
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+        thread_yield();
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+    return len;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+    shm_radio_slot_t *slot = _next_frame(dev);
+    int size;
+
+    if (slot == NULL) {
+        return 0;
+    }
+    size = slot->len;
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop the frame */
+            dev->rx_idx++;
+            dev->rx_accepted = false;
+            _continue_reading(dev);
+        }
+        return size;
+    }
+    if ((size_t)size > len) {
+        size = -ENOBUFS;
+    }
+    else {
+        memcpy(buf, slot->psdu, size);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != dev->rx_idx + 1) {
+            /* overwritten while copying */
+            size = -EIO;
+        }
+        else if (info != NULL) {
+            struct netdev_radio_rx_info *rx_info = info;
+
+            rx_info->lqi = dev->rx_lqi;
+            rx_info->rssi = UINT8_MAX;
+        }
+    }
+    dev->rx_idx++;
+    dev->rx_accepted = false;
+    _continue_reading(dev);
+#ifdef MODULE_NETSTATS_L2
+    if (size > 0) {
+        netdev->stats.rx_count++;
+        netdev->stats.rx_bytes += size;
+    }
+#endif
+    return size;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, dev->last_event);
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    shm_radio_t *dev = (shm_radio_t *)netdev;
+
+    netdev_ieee802154_reset(&dev->netdev);
+    dev->netdev.chan = IEEE802154_DEFAULT_CHANNEL;
+    _continue_reading(dev);
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    assert(netdev != NULL);
+    return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt, value,
+                                 max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value,
+                size_t value_len)
+{
+    assert(netdev != NULL);
+    return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt, value,
+                                 value_len);
+}
+
+static const netdev_driver_t shm_radio_driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+void shm_radio_setup(shm_radio_t *dev, const shm_radio_params_t *params)
+{
+    shm_radio_medium_t *medium;
+    shm_radio_node_t *node;
+    struct stat st;
+    int32_t none = 0;
+    size_t offset;
+    int fd;
+
+    assert(_devs_numof < SHM_RADIO_MAX);
+    memset(dev, 0, sizeof(shm_radio_t));
+    dev->netdev.netdev.driver = &shm_radio_driver;
+
+    _native_syscall_enter();
+    fd = real_open(params->medium, O_RDWR);
+    if ((fd == -1) || (real_fstat(fd, &st) == -1)) {
+        err(EXIT_FAILURE, "shm_radio: unable to open %s", params->medium);
+    }
+    medium = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (medium == MAP_FAILED) {
+        err(EXIT_FAILURE, "shm_radio: mmap");
+    }
+    real_close(fd);
+    _native_syscall_leave();
+    if (((size_t)st.st_size < sizeof(shm_radio_medium_t)) ||
+        (medium->magic != SHM_RADIO_MAGIC) ||
+        (medium->version != SHM_RADIO_VERSION)) {
+        errx(EXIT_FAILURE, "shm_radio: %s is no medium", params->medium);
+    }
+    if (params->node >= medium->nodes_numof) {
+        errx(EXIT_FAILURE, "shm_radio: node %u not in medium of %u nodes",
+             params->node, (unsigned)medium->nodes_numof);
+    }
+
+    dev->medium = medium;
+    dev->node = params->node;
+    offset = sizeof(shm_radio_medium_t);
+    dev->nodes = (shm_radio_node_t *)((uint8_t *)medium + offset);
+    offset += medium->nodes_numof * sizeof(shm_radio_node_t);
+    dev->links = (uint8_t *)medium + offset;
+    offset += (medium->nodes_numof * medium->nodes_numof + 3) & ~3U;
+    dev->slots = (shm_radio_slot_t *)((uint8_t *)medium + offset);
+    if ((size_t)st.st_size <
+        offset + medium->slots_numof * sizeof(shm_radio_slot_t)) {
+        errx(EXIT_FAILURE, "shm_radio: %s is truncated", params->medium);
+    }
+    /* claim the node slot unless a running process holds it */
+    node = &dev->nodes[dev->node];
+    _native_syscall_enter();
+    _node_alive(node);
+    if (!__atomic_compare_exchange_n(&node->pid, &none, _native_pid, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        errx(EXIT_FAILURE, "shm_radio: node %u of %s is taken by process %d",
+             params->node, params->medium, (int)none);
+    }
+    _native_syscall_leave();
+    __atomic_store_n(&node->armed, 0, __ATOMIC_SEQ_CST);
+    /* only receive frames sent from now on */
+    dev->rx_idx = __atomic_load_n(&medium->head, __ATOMIC_SEQ_CST);
+    if (_devs_numof == 0) {
+        atexit(_release_nodes);
+    }
+
+    /* generate hardware address from the node index */
+    dev->netdev.long_addr[1] = 'S';     /* The "OUI" */
+    dev->netdev.long_addr[2] = 'H';
+    dev->netdev.long_addr[3] = 'M';
+    dev->netdev.long_addr[6] = dev->node >> 8;
+    dev->netdev.long_addr[7] = dev->node & 0xff;
+    dev->netdev.short_addr[0] = dev->netdev.long_addr[6];
+    dev->netdev.short_addr[1] = dev->netdev.long_addr[7];
+
+    _devs[_devs_numof++] = dev;
+    register_interrupt(SHM_RADIO_SIGNAL, _isr_signal);
+#ifdef MODULE_NETSTATS_L2
+    memset(&dev->netdev.netdev.stats, 0, sizeof(netstats_t));
+#endif
+}
+
+/** @} */
@@ -129,31 +129,6 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
     return res - v[0].iov_len - v[n + 1].iov_len;
 }
 
-static void _continue_reading(socket_zep_t *dev)
-{
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->sock_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->sock_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-        real_write(_sig_pipefd[1], &sig, sizeof(int));
-        _native_sigpend++;
-    }
-    else {
-        native_async_read_continue(dev->sock_fd);
-    }
-
-    _native_in_syscall--;
-}
-
 static inline bool _dst_not_me(socket_zep_t *dev, const void *buf)
 {
     uint8_t dst_addr[IEEE802154_LONG_ADDRESS_LEN] = { 0 };
@@ -194,6 +169,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     }
     else if (len > 0) {
         size = real_read(dev->sock_fd, dev->rcv_buf, sizeof(dev->rcv_buf));
+        native_async_read_continue(dev->sock_fd);
 
         if (size > 0) {
             zep_hdr_t *tmp = (zep_hdr_t *)&dev->rcv_buf;
@@ -251,7 +227,6 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             errx(EXIT_FAILURE, "internal error _rx_event");
         }
     }
-    _continue_reading(dev);
 #ifdef MODULE_NETSTATS_L2
     netdev->stats.rx_count++;
     netdev->stats.rx_bytes += size;
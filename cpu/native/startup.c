@@ -77,11 +77,30 @@ netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 #include "candev_linux.h"
 #endif
 
+#ifdef MODULE_NETDEV_PACKET
+#include "netdev_packet_params.h"
+
+netdev_packet_params_t netdev_packet_params[NETDEV_PACKET_MAX];
+#endif
 #ifdef MODULE_SOCKET_ZEP
 #include "socket_zep_params.h"
 
 socket_zep_params_t socket_zep_params[SOCKET_ZEP_MAX];
 #endif
+#ifdef MODULE_SHM_RADIO
+#include "shm_radio_params.h"
+
+shm_radio_params_t shm_radio_params[SHM_RADIO_MAX];
+#endif
+#ifdef MODULE_NATIVE_VTIME
+#include "native_vtime.h"
+#endif
+#ifdef MODULE_NATIVE_PROFILE
+#include "native_profile.h"
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+#include "native_pktcap.h"
+#endif
 
 static const char short_opts[] = ":hi:s:deEoc:"
 #ifdef MODULE_MTD_NATIVE
@@ -90,8 +109,23 @@ static const char short_opts[] = ":hi:s:deEoc:"
 #ifdef MODULE_CAN_LINUX
     "n:"
 #endif
+#ifdef MODULE_NETDEV_PACKET
+    "p:"
+#endif
 #ifdef MODULE_SOCKET_ZEP
     "z:"
+#endif
+#ifdef MODULE_SHM_RADIO
+    "r:"
+#endif
+#ifdef MODULE_NATIVE_VTIME
+    "v:"
+#endif
+#ifdef MODULE_NATIVE_PROFILE
+    "P:"
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+    "w:"
 #endif
     "";
 
@@ -110,8 +144,23 @@ static const struct option long_opts[] = {
 #ifdef MODULE_CAN_LINUX
     { "can", required_argument, NULL, 'n' },
 #endif
+#ifdef MODULE_NETDEV_PACKET
+    { "packet", required_argument, NULL, 'p' },
+#endif
 #ifdef MODULE_SOCKET_ZEP
     { "zep", required_argument, NULL, 'z' },
+#endif
+#ifdef MODULE_SHM_RADIO
+    { "shm-radio", required_argument, NULL, 'r' },
+#endif
+#ifdef MODULE_NATIVE_VTIME
+    { "vtime", required_argument, NULL, 'v' },
+#endif
+#ifdef MODULE_NATIVE_PROFILE
+    { "profile", required_argument, NULL, 'P' },
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+    { "pcap", required_argument, NULL, 'w' },
 #endif
     { NULL, 0, NULL, '\0' },
 };
@@ -241,6 +290,11 @@ void usage_exit(int status)
     for (int i = 0; i < NETDEV_TAP_MAX; i++) {
         real_printf(" <tap interface %d>", i + 1);
     }
+#endif
+#if defined(MODULE_NETDEV_PACKET)
+    for (int i = 0; i < NETDEV_PACKET_MAX; i++) {
+        real_printf(" -p <interface>");
+    }
 #endif
     real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty>]\n");
 #if defined(MODULE_SOCKET_ZEP) && (SOCKET_ZEP_MAX > 0)
@@ -251,6 +305,11 @@ void usage_exit(int status)
         real_printf(" -z <laddr>:<lport>,<raddr>:<rport>\n");
     }
 #endif
+#if defined(MODULE_SHM_RADIO) && (SHM_RADIO_MAX > 0)
+    for (int i = 0; i < SHM_RADIO_MAX; i++) {
+        real_printf(" -r <medium>:<node>\n");
+    }
+#endif
 
     real_printf(" help: %s -h\n\n", _progname);
 
@@ -275,11 +334,23 @@ void usage_exit(int status)
 "    -c <tty>, --uart-tty=<tty>\n"
 "        specify TTY device for UART. This argument can be used multiple\n"
 "        times (up to UART_NUMOF)\n"
+#if defined(MODULE_NETDEV_PACKET)
+"    -p <interface>, --packet=<interface>\n"
+"        attach an Ethernet device to the host interface <interface> using\n"
+"        memory mapped packet rings. Required to be provided\n"
+"        NETDEV_PACKET_MAX times\n"
+#endif
 #if defined(MODULE_SOCKET_ZEP) && (SOCKET_ZEP_MAX > 0)
 "    -z [<laddr>:<lport>,]<raddr>:<rport> --zep=[<laddr>:<lport>,]<raddr>:<rport>\n"
 "        provide a ZEP interface with local address and port (<laddr>, <lport>)\n"
 "        and remote address and port (default local: [::]:17754).\n"
 "        Required to be provided SOCKET_ZEP_MAX times\n"
+#endif
+#if defined(MODULE_SHM_RADIO) && (SHM_RADIO_MAX > 0)
+"    -r <medium>:<node>, --shm-radio=<medium>:<node>\n"
+"        provide a radio as node <node> of the shared memory medium file\n"
+"        <medium> (see dist/tools/shm_radio).\n"
+"        Required to be provided SHM_RADIO_MAX times\n"
 #endif
     );
 #ifdef MODULE_MTD_NATIVE
@@ -292,6 +363,24 @@ void usage_exit(int status)
 "    -n <ifnum>:<ifname>, --can <ifnum>:<ifname>\n"
 "        specify CAN interface <ifname> to use for CAN device #<ifnum>\n"
 "        max number of CAN device: %d\n", CAN_DLL_NUMOF);
+#endif
+#ifdef MODULE_NATIVE_VTIME
+    real_printf(
+"    -v <socket>, --vtime=<socket>\n"
+"        use the virtual time of the controller listening on <socket>\n"
+"        (see dist/tools/vtime)\n");
+#endif
+#ifdef MODULE_NATIVE_PROFILE
+    real_printf(
+"    -P <file>, --profile=<file>\n"
+"        sample the call stacks while running and write them to <file> in\n"
+"        folded stack format on exit\n");
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+    real_printf(
+"    -w <file>, --pcap=<file>\n"
+"        capture the frames of all network interfaces to <file> in pcapng\n"
+"        format\n");
 #endif
     real_exit(status);
 }
@@ -355,6 +444,21 @@ static void _zep_params_setup(char *zep_str, int zep)
 }
 #endif
 
+#ifdef MODULE_SHM_RADIO
+static void _shm_radio_params_setup(char *radio_str, unsigned radio)
+{
+    char *node = strrchr(radio_str, ':');
+
+    if ((radio >= SHM_RADIO_MAX) || (node == NULL) || (node == radio_str) ||
+        (node[1] < '0') || (node[1] > '9')) {
+        usage_exit(EXIT_FAILURE);
+    }
+    *node++ = '\0';
+    shm_radio_params[radio].medium = radio_str;
+    shm_radio_params[radio].node = atoi(node);
+}
+#endif
+
 /** @brief Initialization function pointer type */
 typedef void (*init_func_t)(int argc, char **argv, char **envp);
 #ifdef __APPLE__
@@ -382,8 +486,14 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
     _native_id = _native_pid;
 
     int c, opt_idx = 0, uart = 0;
+#ifdef MODULE_NETDEV_PACKET
+    unsigned packets = 0;
+#endif
 #ifdef MODULE_SOCKET_ZEP
     unsigned zeps = 0;
+#endif
+#ifdef MODULE_SHM_RADIO
+    unsigned radios = 0;
 #endif
     bool dmn = false, force_stderr = false;
     _stdiotype_t stderrtype = _STDIOTYPE_STDIO;
@@ -451,10 +561,38 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
                 }
                 break;
 #endif
+#ifdef MODULE_NETDEV_PACKET
+            case 'p':
+                if (packets >= NETDEV_PACKET_MAX) {
+                    usage_exit(EXIT_FAILURE);
+                }
+                netdev_packet_params[packets++].if_name = optarg;
+                break;
+#endif
 #ifdef MODULE_SOCKET_ZEP
             case 'z':
                 _zep_params_setup(optarg, zeps++);
                 break;
+#endif
+#ifdef MODULE_SHM_RADIO
+            case 'r':
+                _shm_radio_params_setup(optarg, radios++);
+                break;
+#endif
+#ifdef MODULE_NATIVE_VTIME
+            case 'v':
+                _native_vtime_path = optarg;
+                break;
+#endif
+#ifdef MODULE_NATIVE_PROFILE
+            case 'P':
+                _native_profile_path = optarg;
+                break;
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+            case 'w':
+                _native_pktcap_path = optarg;
+                break;
 #endif
             default:
                 usage_exit(EXIT_FAILURE);
@@ -469,12 +607,24 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
         }
     }
 #endif
+#ifdef MODULE_NETDEV_PACKET
+    if (packets != NETDEV_PACKET_MAX) {
+        /* not enough interfaces given */
+        usage_exit(EXIT_FAILURE);
+    }
+#endif
 #ifdef MODULE_SOCKET_ZEP
     if (zeps != SOCKET_ZEP_MAX) {
         /* not enough ZEPs given */
         usage_exit(EXIT_FAILURE);
     }
 #endif
+#ifdef MODULE_SHM_RADIO
+    if (radios != SHM_RADIO_MAX) {
+        /* not enough radios given */
+        usage_exit(EXIT_FAILURE);
+    }
+#endif
 
     if (dmn) {
         filter_daemonize_argv(_native_argv);
@@ -532,6 +682,11 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
 
     native_cpu_init();
     native_interrupt_init();
+#ifdef MODULE_NATIVE_PROFILE
+    if (_native_profile_path != NULL) {
+        native_profile_start();
+    }
+#endif
 #ifdef MODULE_NETDEV_TAP
     for (int i = 0; i < NETDEV_TAP_MAX; i++) {
         netdev_tap_params[i].tap_name = &argv[optind + i];
@@ -75,6 +75,7 @@ int (*real_creat)(const char *path, ...);
 int (*real_dup2)(int, int);
 int (*real_execve)(const char *, char *const[], char *const[]);
 int (*real_fork)(void);
+int (*real_fstat)(int fd, struct stat *buf);
 int (*real_feof)(FILE *stream);
 int (*real_ferror)(FILE *stream);
 int (*real_listen)(int socket, int backlog);
@@ -82,6 +83,9 @@ int (*real_ioctl)(int fildes, int request, ...);
 int (*real_open)(const char *path, int oflag, ...);
 int (*real_pause)(void);
 int (*real_pipe)(int[2]);
+int (*real_poll)(struct pollfd *fds, nfds_t nfds, int timeout);
+ssize_t (*real_sendto)(int socket, const void *buf, size_t len, int flags,
+                       const struct sockaddr *dest_addr, socklen_t addrlen);
 int (*real_select)(int nfds, ...);
 int (*real_setitimer)(int which, const struct itimerval
         *restrict value, struct itimerval *restrict ovalue);
@@ -459,11 +463,14 @@ void _native_init_syscalls(void)
     *(void **)(&real_getpid) = dlsym(RTLD_NEXT, "getpid");
     *(void **)(&real_gettimeofday) = dlsym(RTLD_NEXT, "gettimeofday");
     *(void **)(&real_pipe) = dlsym(RTLD_NEXT, "pipe");
+    *(void **)(&real_poll) = dlsym(RTLD_NEXT, "poll");
+    *(void **)(&real_sendto) = dlsym(RTLD_NEXT, "sendto");
     *(void **)(&real_chdir) = dlsym(RTLD_NEXT, "chdir");
     *(void **)(&real_close) = dlsym(RTLD_NEXT, "close");
     *(void **)(&real_fcntl) = dlsym(RTLD_NEXT, "fcntl");
     *(void **)(&real_creat) = dlsym(RTLD_NEXT, "creat");
     *(void **)(&real_fork) = dlsym(RTLD_NEXT, "fork");
+    *(void **)(&real_fstat) = dlsym(RTLD_NEXT, "fstat");
     *(void **)(&real_dup2) = dlsym(RTLD_NEXT, "dup2");
     *(void **)(&real_select) = dlsym(RTLD_NEXT, "select");
     *(void **)(&real_setitimer) = dlsym(RTLD_NEXT, "setitimer");
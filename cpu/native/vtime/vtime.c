@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       Virtual time for native
+ *
+ * @}
+ */
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "async_read.h"
+#include "native_internal.h"
+#include "native_vtime.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+const char *_native_vtime_path;
+
+static int _sock = -1;
+static volatile const uint32_t *_clock;
+static uint64_t _now;
+static uint64_t _deadline = NATIVE_VTIME_NONE;
+static void (*_timer_isr)(void);
+
+static void _send(uint32_t type, uint64_t time)
+{
+    native_vtime_msg_t msg = { .type = type, .time = time };
+
+    if (real_write(_sock, &msg, sizeof(msg)) != sizeof(msg)) {
+        err(EXIT_FAILURE, "native_vtime: write");
+    }
+}
+
+/* the controller writes the clock only while all instances are idle, but an
+ * instance woken up by I/O may read it concurrently */
+static uint64_t _read_clock(void)
+{
+    uint32_t low, high;
+
+    do {
+        high = _clock[1];
+        low = _clock[0];
+    } while (high != _clock[1]);
+    return ((uint64_t)high << 32) | low;
+}
+
+static void _sync(void)
+{
+    uint64_t now = _read_clock();
+
+    if (now > _now) {
+        _now = now;
+    }
+}
+
+static void _vtime_isr(int fd, void *arg)
+{
+    native_vtime_msg_t msg;
+    ssize_t res;
+
+    (void)arg;
+    while ((res = real_read(fd, &msg, sizeof(msg))) == sizeof(msg)) {
+        if ((msg.type == NATIVE_VTIME_MSG_ADVANCE) && (msg.time > _now)) {
+            _now = msg.time;
+        }
+    }
+    if (res == 0) {
+        errx(EXIT_FAILURE, "native_vtime: controller closed the connection");
+    }
+    native_async_read_continue(fd);
+
+    _sync();
+    if ((_deadline != NATIVE_VTIME_NONE) && (_deadline <= _now)) {
+        DEBUG("native_vtime: timer at %llu\n", (unsigned long long)_now);
+        _deadline = NATIVE_VTIME_NONE;
+        _timer_isr();
+    }
+}
+
+void native_vtime_init(void (*timer_isr)(void))
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    char clock_path[PATH_MAX];
+    void *clock;
+    int fd;
+
+    if ((_native_vtime_path == NULL) || (_sock >= 0)) {
+        return;
+    }
+    if (strlen(_native_vtime_path) >= sizeof(addr.sun_path)) {
+        errx(EXIT_FAILURE, "native_vtime: socket path too long");
+    }
+    strcpy(addr.sun_path, _native_vtime_path);
+    snprintf(clock_path, sizeof(clock_path), "%s.clock", _native_vtime_path);
+
+    _native_syscall_enter();
+    fd = real_open(clock_path, O_RDONLY);
+    if (fd == -1) {
+        err(EXIT_FAILURE, "native_vtime: open(%s)", clock_path);
+    }
+    clock = mmap(NULL, sizeof(uint64_t), PROT_READ, MAP_SHARED, fd, 0);
+    if (clock == MAP_FAILED) {
+        err(EXIT_FAILURE, "native_vtime: mmap");
+    }
+    real_close(fd);
+    _sock = real_socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if ((_sock == -1) ||
+        (real_connect(_sock, (struct sockaddr *)&addr, sizeof(addr)) == -1)) {
+        err(EXIT_FAILURE, "native_vtime: connect(%s)", _native_vtime_path);
+    }
+    _native_syscall_leave();
+
+    _clock = clock;
+    _timer_isr = timer_isr;
+    _sync();
+    native_async_read_setup();
+    native_async_read_add_handler(_sock, NULL, _vtime_isr);
+}
+
+bool native_vtime_enabled(void)
+{
+    return (_sock >= 0);
+}
+
+uint64_t native_vtime_now(void)
+{
+    _sync();
+    _now += NATIVE_VTIME_READ_COST;
+    return _now;
+}
+
+void native_vtime_set(uint32_t offset)
+{
+    if (offset == 0) {
+        _deadline = NATIVE_VTIME_NONE;
+    }
+    else {
+        _sync();
+        _deadline = _now + offset;
+    }
+}
+
+void native_vtime_idle(void)
+{
+    sigset_t all, old;
+
+    /* the controller may answer before we wait, so signals are blocked until
+     * sigsuspend() */
+    sigfillset(&all);
+    sigprocmask(SIG_BLOCK, &all, &old);
+    _send(NATIVE_VTIME_MSG_IDLE, _deadline);
+    if (_native_sigpend == 0) {
+        sigsuspend(&old);
+    }
+    sigprocmask(SIG_SETMASK, &old, NULL);
+    _send(NATIVE_VTIME_MSG_BUSY, 0);
+}
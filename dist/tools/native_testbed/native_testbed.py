@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Runs a network of native instances and measures it.
+
+Starts NODES instances of a GNRC application with a shell, wired through tap
+interfaces, a shared memory radio medium or custom arguments, and waits for
+their link-local addresses. Then all nodes ping a peer at the same time with
+ping6 and the round-trip times, losses and the payload delivered per second
+of every pair are written as JSON. The output of every node is kept in
+<outdir>/node<i>.log.
+
+The Testbed class can be imported by scripts that drive the nodes through
+their shells differently.
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+import pexpect
+
+SHM_RADIO = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
+                         "shm_radio", "shm_radio.py")
+
+IFACE = re.compile(r"Iface\s+(\d+)")
+# up to the end of the line, which tells whether the address is tentative
+LINK_LOCAL = re.compile(r"inet6 addr: (fe80:[0-9a-f:]+)\s+scope: local"
+                        r"([^\r\n]*)\r?\n")
+PING_STATS = re.compile(r"(\d+) packets transmitted, (\d+) received")
+PING_RTT = re.compile(r"rtt min/avg/max = ([\d.]+)/([\d.]+)/([\d.]+) ms")
+
+
+class Node(object):
+    """A native instance, driven through its shell."""
+
+    def __init__(self, index, elf, args, outdir, timeout):
+        self.index = index
+        self.log = open(os.path.join(outdir, "node%d.log" % index), "w")
+        self.child = pexpect.spawn(elf, args, timeout=timeout,
+                                   encoding="utf-8", codec_errors="replace")
+        self.child.logfile_read = self.log
+        self.iface = None
+        self.addr = None
+
+    def cmd(self, line, patterns, timeout=-1):
+        """Sends a shell command and waits for one of patterns.
+
+        Returns the index of the pattern that matched, the match is in
+        self.child.match.
+        """
+        self.child.sendline(line)
+        return self.child.expect(patterns, timeout=timeout)
+
+    def wait_link_local(self, timeout):
+        """Waits until the node has a link-local address that passed DAD."""
+        deadline = time.monotonic() + timeout
+        while True:
+            self.cmd("ifconfig", [IFACE])
+            self.iface = int(self.child.match.group(1))
+            self.child.expect([LINK_LOCAL])
+            if "TNT" not in self.child.match.group(2):
+                self.addr = self.child.match.group(1)
+                return
+            if time.monotonic() > deadline:
+                raise pexpect.TIMEOUT("address of node %d stays tentative" %
+                                      self.index)
+            time.sleep(0.5)
+
+    def ping(self, peer, count, size, interval, timeout):
+        """Pings peer and returns the statistics as dict."""
+        start = time.monotonic()
+        self.cmd("ping6 %d %s%%%d %d %d" % (count, peer.addr, self.iface,
+                                             size, interval),
+                 [PING_STATS], timeout=timeout)
+        sent, received = (int(g) for g in self.child.match.groups())
+        result = {
+            "src": self.index,
+            "dst": peer.index,
+            "sent": sent,
+            "received": received,
+            "loss": round(1 - received / sent, 4) if sent else 1.0,
+        }
+        if received:
+            self.child.expect([PING_RTT])
+            rtt = [float(g) for g in self.child.match.groups()]
+            result.update(rtt_min_ms=rtt[0], rtt_avg_ms=rtt[1],
+                          rtt_max_ms=rtt[2])
+        result["duration_s"] = time.monotonic() - start
+        # echo requests and replies both carry the payload
+        result["goodput_bps"] = (received * size * 2 * 8 /
+                                 result["duration_s"])
+        return result
+
+    def close(self):
+        self.child.terminate(force=True)
+        self.log.close()
+
+
+class Testbed(object):
+    """Starts the given number of nodes and stops them on exit."""
+
+    def __init__(self, elf, nodes, args, outdir, timeout=10):
+        self.outdir = outdir
+        self.pool = concurrent.futures.ThreadPoolExecutor(max_workers=nodes)
+        self.nodes = []
+        try:
+            for i in range(nodes):
+                self.nodes.append(Node(i, elf, args(i), outdir, timeout))
+        except Exception:
+            self.close()
+            raise
+
+    def parallel(self, func, *iterables):
+        """Calls func for all nodes concurrently, returns the results."""
+        if not iterables:
+            iterables = (self.nodes,)
+        return list(self.pool.map(func, *iterables))
+
+    def close(self):
+        for node in self.nodes:
+            node.close()
+        self.pool.shutdown()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+
+def peers(nodes, pattern):
+    """Returns the (source, destination) pairs of a traffic pattern."""
+    if pattern == "ring":
+        return [(n, nodes[(i + 1) % len(nodes)]) for i, n in enumerate(nodes)]
+    if pattern == "star":
+        return [(n, nodes[0]) for n in nodes[1:]]
+    return [(a, b) for a in nodes for b in nodes if a is not b]
+
+
+def summarize(pairs):
+    received = [p for p in pairs if p["received"]]
+    summary = {
+        "pairs": len(pairs),
+        "sent": sum(p["sent"] for p in pairs),
+        "received": sum(p["received"] for p in pairs),
+        "goodput_bps": sum(p["goodput_bps"] for p in pairs),
+    }
+    summary["loss"] = (round(1 - summary["received"] / summary["sent"], 4)
+                       if summary["sent"] else 1.0)
+    if received:
+        summary["rtt_min_ms"] = min(p["rtt_min_ms"] for p in received)
+        summary["rtt_avg_ms"] = (sum(p["rtt_avg_ms"] * p["received"]
+                                     for p in received) /
+                                 summary["received"])
+        summary["rtt_max_ms"] = max(p["rtt_max_ms"] for p in received)
+    return summary
+
+
+def node_args(args, outdir):
+    medium = None
+    if args.shm_radio:
+        medium = os.path.join(outdir, "medium")
+        subprocess.check_call([SHM_RADIO, "-n", str(args.nodes), medium])
+
+    def _args(i):
+        res = []
+        if args.tap is not None:
+            res.append("%s%d" % (args.tap, i))
+        if medium:
+            res.append("--shm-radio=%s:%d" % (medium, i))
+        if args.args:
+            res += args.args.format(node=i, outdir=outdir).split()
+        return res
+    return _args
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--nodes", type=int, default=2,
+                        help="number of instances (default: %(default)s)")
+    parser.add_argument("-o", "--outdir",
+                        help="directory for the logs and the medium "
+                        "(default: a new temporary directory)")
+    wiring = parser.add_argument_group("wiring")
+    wiring.add_argument("--tap", nargs="?", const="tap",
+                        help="give node i the tap interface <TAP>i, e.g. "
+                        "created with tapsetup (default prefix: tap)")
+    wiring.add_argument("--shm-radio", action="store_true",
+                        help="put all nodes on a new shared memory radio "
+                        "medium")
+    wiring.add_argument("--args", help="further arguments of each node, "
+                        "{node} is replaced by its index and {outdir} by "
+                        "the output directory")
+    ping = parser.add_argument_group("measurement")
+    ping.add_argument("-p", "--pattern", choices=("ring", "star", "all"),
+                      default="ring",
+                      help="ring: node i pings node i+1, star: all nodes "
+                      "ping node 0, all: all nodes ping all others in turn "
+                      "(default: %(default)s)")
+    ping.add_argument("-c", "--count", type=int, default=100,
+                      help="echo requests per pair (default: %(default)s)")
+    ping.add_argument("-s", "--size", type=int, default=64,
+                      help="payload in bytes (default: %(default)s)")
+    ping.add_argument("-i", "--interval", type=int, default=10,
+                      help="ms between echo requests (default: %(default)s)")
+    ping.add_argument("-t", "--timeout", type=float, default=30,
+                      help="seconds to wait for the nodes to come up "
+                      "(default: %(default)s)")
+    parser.add_argument("-j", "--json",
+                        help="write the results to this file instead of "
+                        "stdout")
+    parser.add_argument("elf", help="application to run")
+    args = parser.parse_args()
+
+    if args.nodes < 2:
+        sys.exit("at least two nodes are needed")
+    outdir = args.outdir or tempfile.mkdtemp(prefix="native_testbed.")
+    os.makedirs(outdir, exist_ok=True)
+
+    results = {"elf": args.elf, "nodes": args.nodes, "outdir": outdir,
+               "pattern": args.pattern, "count": args.count,
+               "size": args.size, "interval_ms": args.interval}
+    start = time.monotonic()
+    try:
+        with Testbed(args.elf, args.nodes, node_args(args, outdir), outdir,
+                     args.timeout) as testbed:
+            testbed.parallel(lambda n: n.wait_link_local(args.timeout))
+            results["startup_s"] = time.monotonic() - start
+
+            # the ping of a pair may not time out before all requests
+            # were sent
+            timeout = args.timeout + args.count * args.interval / 1000
+            pairs = peers(testbed.nodes, args.pattern)
+            if args.pattern == "all":
+                # a node runs one ping at a time
+                def _ping_all(node):
+                    return [node.ping(dst, args.count, args.size,
+                                      args.interval, timeout)
+                            for src, dst in pairs if src is node]
+                results["pairs"] = sum(testbed.parallel(_ping_all), [])
+            else:
+                results["pairs"] = testbed.parallel(
+                    lambda p: p[0].ping(p[1], args.count, args.size,
+                                        args.interval, timeout), pairs)
+    except (pexpect.TIMEOUT, pexpect.EOF) as exc:
+        sys.exit("%s, see the logs in %s" %
+                 (str(exc).splitlines()[0], outdir))
+    results["summary"] = summarize(results["pairs"])
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+            f.write("\n")
+    else:
+        json.dump(results, sys.stdout, indent=2)
+        print()
+    return 0 if results["summary"]["received"] else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Extracts the inputs of a fuzz target of tests/fuzz_parsers from captures.
+
+Every packet of the pcap files that carries a message of the parser is
+written to its own file in the output directory, named after its SHA-1, so
+that the same message is only stored once. Ethernet, raw IPv6 and IEEE
+802.15.4 captures are supported, 6LoWPAN frames only yield inputs of iphc.
+"""
+
+import argparse
+import hashlib
+import os
+import struct
+import sys
+
+LINKTYPE_ETHERNET = 1
+LINKTYPE_RAW = 101
+LINKTYPE_IEEE802_15_4_WITHFCS = 195
+LINKTYPE_IPV6 = 229
+LINKTYPE_IEEE802_15_4_NOFCS = 230
+
+ETHERTYPE_IPV6 = 0x86dd
+PROTNUM_UDP = 17
+PROTNUM_ICMPV6 = 58
+ICMPV6_RPL_CTRL = 155
+# in the order of the selector byte of the ipv6_ext target
+IPV6_EXT = (0, 60, 43, 44, 51, 50, 135)
+PORTS = {"coap": 5683, "nhdp": 269}
+
+
+def pcap_packets(path):
+    """Yields the link type and data of all packets of a pcap file."""
+    with open(path, "rb") as f:
+        hdr = f.read(24)
+        if len(hdr) < 24:
+            raise ValueError("%s: not a pcap file" % path)
+        for endian in "<>":
+            magic, = struct.unpack(endian + "I", hdr[:4])
+            if magic in (0xa1b2c3d4, 0xa1b23c4d):
+                break
+        else:
+            raise ValueError("%s: not a pcap file (pcapng is not supported)"
+                             % path)
+        linktype, = struct.unpack(endian + "I", hdr[20:24])
+        while True:
+            rec = f.read(16)
+            if len(rec) < 16:
+                return
+            caplen, = struct.unpack(endian + "I", rec[8:12])
+            yield linktype, f.read(caplen)
+
+
+def ieee802154_payload(frame):
+    """Returns the MAC payload of an unsecured IEEE 802.15.4 data frame."""
+    if len(frame) < 3:
+        return None
+    fcf, = struct.unpack("<H", frame[:2])
+    if (fcf & 0x7) != 1 or (fcf & 0x8):
+        # no data frame or secured
+        return None
+    addr_len = {0: 0, 2: 2, 3: 8}
+    dst_mode, src_mode = (fcf >> 10) & 0x3, (fcf >> 14) & 0x3
+    if dst_mode not in addr_len or src_mode not in addr_len:
+        return None
+    offset = 3
+    if dst_mode:
+        offset += 2 + addr_len[dst_mode]
+    if src_mode:
+        if not (fcf & 0x40):
+            # no PAN ID compression
+            offset += 2
+        offset += addr_len[src_mode]
+    return frame[offset:]
+
+
+def ipv6_packet(linktype, data):
+    if linktype == LINKTYPE_ETHERNET:
+        if (len(data) < 14 or
+                struct.unpack(">H", data[12:14])[0] != ETHERTYPE_IPV6):
+            return None
+        data = data[14:]
+    elif linktype not in (LINKTYPE_RAW, LINKTYPE_IPV6):
+        return None
+    if len(data) < 40 or (data[0] >> 4) != 6:
+        return None
+    return data
+
+
+def inputs(parser, linktype, data):
+    """Returns the inputs of parser in a packet."""
+    if linktype in (LINKTYPE_IEEE802_15_4_WITHFCS,
+                    LINKTYPE_IEEE802_15_4_NOFCS):
+        if linktype == LINKTYPE_IEEE802_15_4_WITHFCS:
+            data = data[:-2]
+        payload = ieee802154_payload(data)
+        if parser == "iphc" and payload and (payload[0] & 0xe0) == 0x60:
+            return [payload]
+        return []
+
+    pkt = ipv6_packet(linktype, data)
+    if pkt is None:
+        return []
+    nh, payload = pkt[6], pkt[40:]
+    if parser == "ipv6_ext":
+        if nh in IPV6_EXT:
+            return [bytes([IPV6_EXT.index(nh)]) + payload]
+        return []
+    if parser == "rpl":
+        if (nh == PROTNUM_ICMPV6 and len(payload) >= 4 and
+                payload[0] == ICMPV6_RPL_CTRL):
+            return [payload]
+        return []
+    if parser in PORTS:
+        if nh == PROTNUM_UDP and len(payload) >= 8:
+            sport, dport = struct.unpack(">HH", payload[:4])
+            if PORTS[parser] in (sport, dport):
+                return [payload[8:]]
+    return []
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("parser", choices=("coap", "iphc", "ipv6_ext",
+                                           "nhdp", "rpl"),
+                        help="fuzz target the inputs are for")
+    parser.add_argument("outdir", help="directory to write the inputs to")
+    parser.add_argument("pcap", nargs="+", help="capture to read")
+    args = parser.parse_args()
+
+    os.makedirs(args.outdir, exist_ok=True)
+    written = 0
+    for path in args.pcap:
+        try:
+            for linktype, data in pcap_packets(path):
+                for data in inputs(args.parser, linktype, data):
+                    name = hashlib.sha1(data).hexdigest()
+                    out = os.path.join(args.outdir, name)
+                    if not os.path.exists(out):
+                        with open(out, "wb") as f:
+                            f.write(data)
+                        written += 1
+        except (OSError, ValueError) as exc:
+            sys.exit(str(exc))
+    print("%d new inputs in %s" % (written, args.outdir))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
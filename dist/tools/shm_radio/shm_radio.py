@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Creates a shared memory radio medium for native instances.
+
+Instances built with the shm_radio module and started with
+--shm-radio=<medium>:<node> map the medium file and exchange their frames
+through it. The link qualities between the nodes are read from a topology
+file with lines of the form `<from> <to> <quality>`, where the quality is the
+probability of a frame to be received from 0 to 1. Links not in the file get
+the default quality.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x4d485352
+VERSION = 1
+HEADER = struct.Struct("=IHHII")
+NODE_SIZE = 8
+SLOT_SIZE = 136
+
+
+def read_topology(path, nodes, links):
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            try:
+                src, dst, quality = line.split()
+                src, dst, quality = int(src), int(dst), float(quality)
+            except ValueError:
+                sys.exit("%s:%d: expected <from> <to> <quality>" %
+                         (path, lineno))
+            if not (0 <= src < nodes and 0 <= dst < nodes and
+                    0 <= quality <= 1):
+                sys.exit("%s:%d: link out of range" % (path, lineno))
+            links[src * nodes + dst] = int(round(quality * 255))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--nodes", type=int, required=True,
+                        help="number of nodes in the medium")
+    parser.add_argument("-s", "--slots", type=int, default=4096,
+                        help="frames in the ring, a power of 2 (default: "
+                        "%(default)s)")
+    parser.add_argument("-t", "--topology",
+                        help="file with the link qualities")
+    parser.add_argument("-d", "--default", type=float, default=1.0,
+                        help="quality of links not in the topology "
+                        "(default: %(default)s)")
+    parser.add_argument("medium", help="path of the medium file to create")
+    args = parser.parse_args()
+
+    if not (0 < args.nodes < 2 ** 16):
+        sys.exit("invalid number of nodes")
+    if (args.slots < 1) or (args.slots & (args.slots - 1)):
+        sys.exit("the number of slots must be a power of 2")
+    if not (0 <= args.default <= 1):
+        sys.exit("the default quality must be between 0 and 1")
+
+    default = int(round(args.default * 255))
+    links = bytearray([default] * (args.nodes * args.nodes))
+    for node in range(args.nodes):
+        links[node * args.nodes + node] = 0
+    if args.topology:
+        read_topology(args.topology, args.nodes, links)
+    links += bytes(-len(links) % 4)
+
+    # write a new file, instances still mapping an old one keep it
+    if os.path.exists(args.medium):
+        os.unlink(args.medium)
+    with open(args.medium, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, args.nodes, args.slots, 0))
+        f.write(bytes(NODE_SIZE * args.nodes))
+        f.write(links)
+        f.write(bytes(SLOT_SIZE * args.slots))
+
+
+if __name__ == "__main__":
+    main()
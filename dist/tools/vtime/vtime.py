@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Virtual time controller for native instances.
+
+Instances built with the native_vtime module and started with
+--vtime=<socket> connect to this controller and share its clock. Whenever all
+instances are idle and no instance woke up within the settle time, the clock
+jumps to the next timer of any instance and only the instances with a timer
+due are woken up.
+"""
+
+import argparse
+import mmap
+import os
+import select
+import socket
+import struct
+import sys
+import time
+
+MSG = struct.Struct("=IIQ")
+MSG_IDLE = 0
+MSG_BUSY = 1
+MSG_ADVANCE = 2
+NONE = 2 ** 64 - 1
+
+
+class Node(object):
+    def __init__(self):
+        self.idle = False
+        self.deadline = NONE
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--nodes", type=int, default=1,
+                        help="instances to wait for before the clock starts")
+    parser.add_argument("-s", "--settle", type=float, default=1.0,
+                        help="real time in ms all instances must be idle "
+                        "before the clock advances, must cover the latency "
+                        "of messages between instances")
+    parser.add_argument("-u", "--until", type=float, default=0,
+                        help="stop after this many seconds of virtual time")
+    parser.add_argument("socket", help="path of the controller socket")
+    args = parser.parse_args()
+
+    clock_path = args.socket + ".clock"
+    for path in (args.socket, clock_path):
+        if os.path.exists(path):
+            os.unlink(path)
+    with open(clock_path, "wb") as f:
+        f.write(bytes(8))
+    clock_file = open(clock_path, "r+b")
+    clock = mmap.mmap(clock_file.fileno(), 8)
+
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_SEQPACKET)
+    server.bind(args.socket)
+    server.listen(128)
+
+    nodes = {}
+    now = 0
+    advances = 0
+    until = int(args.until * 1000000)
+    start = time.monotonic()
+
+    try:
+        while True:
+            timeout = None
+            if (len(nodes) >= args.nodes and
+                    all(n.idle for n in nodes.values()) and
+                    any(n.deadline != NONE for n in nodes.values())):
+                timeout = args.settle / 1000
+            ready = select.select([server] + list(nodes), [], [], timeout)[0]
+            if not ready:
+                now = max(now, min(n.deadline for n in nodes.values()))
+                if until and now >= until:
+                    break
+                struct.pack_into("=Q", clock, 0, now)
+                for sock, node in nodes.items():
+                    if node.deadline <= now:
+                        node.idle = False
+                        node.deadline = NONE
+                        sock.send(MSG.pack(MSG_ADVANCE, 0, now))
+                advances += 1
+                continue
+            for sock in ready:
+                if sock is server:
+                    conn, _ = server.accept()
+                    nodes[conn] = Node()
+                    continue
+                data = sock.recv(MSG.size)
+                if not data:
+                    del nodes[sock]
+                    sock.close()
+                    continue
+                msg_type, _, msg_time = MSG.unpack(data)
+                nodes[sock].idle = (msg_type == MSG_IDLE)
+                if msg_type == MSG_IDLE:
+                    nodes[sock].deadline = msg_time
+    except KeyboardInterrupt:
+        pass
+    finally:
+        duration = time.monotonic() - start
+        print("virtual time: {:.3f} s, real time: {:.3f} s, {} advances"
+              .format(now / 1000000, duration, advances), file=sys.stderr)
+        server.close()
+        clock.close()
+        clock_file.close()
+        os.unlink(args.socket)
+        os.unlink(clock_path)
+
+
+if __name__ == "__main__":
+    main()
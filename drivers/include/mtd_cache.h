@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache MTD page cache
+ * @ingroup     drivers_storage
+ * @brief       Page cache and write-back layer stacked on top of another MTD
+ *
+ * This driver wraps an existing MTD device (e.g. @ref drivers_mtd_spi_nor,
+ * @ref drivers_mtd_sdcard or @ref drivers_mtd_native) and keeps a
+ * configurable number of page sized cache lines in RAM:
+ *
+ * - reads are served from the cache, a miss loads the complete page so that
+ *   subsequent small reads into the same page don't touch the bus again
+ * - sequential reads trigger a read-ahead of the following page(s)
+ * - writes are collected in the cache and written back to the underlying
+ *   device as a single operation once a page is complete, the line gets
+ *   evicted, or @ref mtd_cache_flush() is called
+ * - hits, misses, read-ahead and write-back operations are counted
+ *
+ * The cache device is used like any other MTD: statically initialize a
+ * @ref mtd_cache_t with @ref mtd_cache_driver, the parent device and the
+ * memory for the cache lines and call mtd_init() on it. The geometry is
+ * taken over from the parent device.
+ *
+ * @warning The contents of a dirty line are considered authoritative. This
+ *          matches the device contents as long as writes only target erased
+ *          memory (as all file systems on top of MTD do) or the device has
+ *          overwrite semantics (like SD cards).
+ *
+ * @warning Written data is only guaranteed to be on the device after
+ *          @ref mtd_cache_flush() or mtd_power() with @ref MTD_POWER_DOWN
+ *          returned.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the mtd_cache driver
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   Number of pages to read ahead when sequential access is detected
+ *
+ * Set to 0 to disable read-ahead.
+ */
+#ifndef MTD_CACHE_READAHEAD
+#define MTD_CACHE_READAHEAD     (1U)
+#endif
+
+/**
+ * @brief   Page number of an unused cache line
+ */
+#define MTD_CACHE_PAGE_INVALID  (UINT32_MAX)
+
+/**
+ * @name    Cache line flags
+ * @{
+ */
+#define MTD_CACHE_LINE_VALID    (0x01)  /**< line holds the complete page */
+#define MTD_CACHE_LINE_DIRTY    (0x02)  /**< line has data not yet written back */
+#define MTD_CACHE_LINE_PREFETCH (0x04)  /**< line was loaded by read-ahead */
+/** @} */
+
+/**
+ * @brief   Bookkeeping of a single cache line
+ */
+typedef struct {
+    uint32_t page;          /**< cached page, @ref MTD_CACHE_PAGE_INVALID if unused */
+    uint32_t last_use;      /**< access tick used for LRU replacement */
+    uint32_t dirty_start;   /**< offset of the first dirty byte in the page */
+    uint32_t dirty_end;     /**< offset behind the last dirty byte in the page */
+    uint8_t flags;          /**< cache line flags */
+} mtd_cache_line_t;
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;              /**< page accesses served from the cache */
+    uint32_t misses;            /**< page accesses that needed the parent */
+    uint32_t readahead;         /**< pages loaded by read-ahead */
+    uint32_t readahead_hits;    /**< read-ahead pages that were used */
+    uint32_t writebacks;        /**< write operations issued to the parent */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   Device descriptor for mtd_cache device
+ *
+ * This is an extension of the @c mtd_dev_t struct
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *parent;          /**< cached MTD device */
+    mtd_cache_line_t *lines;    /**< cache line bookkeeping */
+    uint8_t *buf;               /**< cache line memory, lines_numof pages */
+    size_t buf_size;            /**< size of @p buf in bytes */
+    unsigned lines_numof;       /**< number of cache lines */
+    uint32_t tick;              /**< access counter for LRU replacement */
+    uint32_t next_addr;         /**< address expected on sequential reading */
+    mtd_cache_stats_t stats;    /**< cache statistics */
+} mtd_cache_t;
+
+/**
+ * @brief   mtd_cache device operations table for mtd
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Write all dirty cache lines back to the parent device
+ *
+ * @param[in] cache     cache device
+ *
+ * @return 0 on success
+ * @return < 0 on error of the parent device
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+/**
+ * @brief   Drop all cache lines without writing them back
+ *
+ * Use this if the parent device was modified without going through the
+ * cache.
+ *
+ * @param[in] cache     cache device
+ */
+void mtd_cache_invalidate(mtd_cache_t *cache);
+
+/**
+ * @brief   Reset the statistics of a cache device
+ *
+ * @param[in] cache     cache device
+ */
+void mtd_cache_reset_stats(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
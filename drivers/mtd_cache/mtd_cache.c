@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Page cache and write-back layer for MTD devices
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static int _init(mtd_dev_t *dev);
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size);
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size);
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size);
+static int _power(mtd_dev_t *dev, enum mtd_power_state power);
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+static inline uint32_t _mtd_size(const mtd_dev_t *dev)
+{
+    return dev->sector_count * dev->pages_per_sector * dev->page_size;
+}
+
+static inline uint8_t *_line_buf(const mtd_cache_t *cache,
+                                 const mtd_cache_line_t *line)
+{
+    return cache->buf + (line - cache->lines) * cache->base.page_size;
+}
+
+static inline void _touch(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    line->last_use = ++cache->tick;
+}
+
+static inline void _release(mtd_cache_line_t *line)
+{
+    line->page = MTD_CACHE_PAGE_INVALID;
+    line->flags = 0;
+}
+
+static mtd_cache_line_t *_find(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        if (cache->lines[i].page == page) {
+            return &cache->lines[i];
+        }
+    }
+    return NULL;
+}
+
+static int _writeback(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    if (!(line->flags & MTD_CACHE_LINE_DIRTY)) {
+        return 0;
+    }
+
+    uint32_t addr = line->page * cache->base.page_size + line->dirty_start;
+    uint32_t len = line->dirty_end - line->dirty_start;
+
+    DEBUG("mtd_cache: write back page %" PRIu32 " [%" PRIu32 ", %" PRIu32 ")\n",
+          line->page, line->dirty_start, line->dirty_end);
+
+    cache->stats.writebacks++;
+    int res = mtd_write(cache->parent, _line_buf(cache, line) + line->dirty_start,
+                        addr, len);
+    if (res < 0) {
+        return res;
+    }
+    line->flags &= ~MTD_CACHE_LINE_DIRTY;
+    return 0;
+}
+
+static int _fill(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    /* partially written page: get the pending data onto the device first */
+    int res = _writeback(cache, line);
+    if (res < 0) {
+        return res;
+    }
+
+    res = mtd_read(cache->parent, _line_buf(cache, line),
+                   line->page * cache->base.page_size, cache->base.page_size);
+    if (res < 0) {
+        _release(line);
+        return res;
+    }
+    line->flags |= MTD_CACHE_LINE_VALID;
+    return 0;
+}
+
+static mtd_cache_line_t *_alloc(mtd_cache_t *cache, uint32_t page, int *res)
+{
+    mtd_cache_line_t *victim = &cache->lines[0];
+
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        mtd_cache_line_t *line = &cache->lines[i];
+        if (line->page == MTD_CACHE_PAGE_INVALID) {
+            victim = line;
+            break;
+        }
+        if (line->last_use < victim->last_use) {
+            victim = line;
+        }
+    }
+
+    *res = _writeback(cache, victim);
+    if (*res < 0) {
+        return NULL;
+    }
+    victim->page = page;
+    victim->flags = 0;
+    return victim;
+}
+
+static void _readahead(mtd_cache_t *cache, uint32_t page)
+{
+    const uint32_t pages = _mtd_size(&cache->base) / cache->base.page_size;
+
+    /* never evict the line that was just used */
+    if (cache->lines_numof <= MTD_CACHE_READAHEAD) {
+        return;
+    }
+
+    for (unsigned i = 0; (i < MTD_CACHE_READAHEAD) && (page < pages);
+         i++, page++) {
+        if (_find(cache, page)) {
+            continue;
+        }
+
+        int res;
+        mtd_cache_line_t *line = _alloc(cache, page, &res);
+        if (!line || (_fill(cache, line) < 0)) {
+            return;
+        }
+        DEBUG("mtd_cache: read ahead page %" PRIu32 "\n", page);
+        line->flags |= MTD_CACHE_LINE_PREFETCH;
+        _touch(cache, line);
+        cache->stats.readahead++;
+    }
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (!cache->parent || !cache->lines || !cache->buf ||
+        !cache->lines_numof) {
+        return -EINVAL;
+    }
+
+    int res = mtd_init(cache->parent);
+    if (res < 0) {
+        return res;
+    }
+
+    dev->sector_count = cache->parent->sector_count;
+    dev->pages_per_sector = cache->parent->pages_per_sector;
+    dev->page_size = cache->parent->page_size;
+
+    if (cache->buf_size < (size_t)cache->lines_numof * dev->page_size) {
+        return -ENOMEM;
+    }
+
+    mtd_cache_invalidate(cache);
+    mtd_cache_reset_stats(cache);
+    cache->tick = 0;
+    cache->next_addr = 0;
+
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    const uint32_t page_size = dev->page_size;
+    const bool sequential = (addr == cache->next_addr);
+    uint8_t *dst = buff;
+    int res;
+
+    if (addr + size > _mtd_size(dev)) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    for (uint32_t left = size; left > 0;) {
+        uint32_t page = addr / page_size;
+        uint32_t offset = addr % page_size;
+        uint32_t len = (left < page_size - offset) ? left : page_size - offset;
+        mtd_cache_line_t *line = _find(cache, page);
+
+        if (line) {
+            cache->stats.hits++;
+            if (line->flags & MTD_CACHE_LINE_PREFETCH) {
+                cache->stats.readahead_hits++;
+                line->flags &= ~MTD_CACHE_LINE_PREFETCH;
+            }
+            /* a partially written line can only serve its dirty range */
+            if (!(line->flags & MTD_CACHE_LINE_VALID) &&
+                (!(line->flags & MTD_CACHE_LINE_DIRTY) ||
+                 (offset < line->dirty_start) ||
+                 (offset + len > line->dirty_end))) {
+                res = _fill(cache, line);
+                if (res < 0) {
+                    return res;
+                }
+            }
+        }
+        else {
+            cache->stats.misses++;
+            if (len == page_size) {
+                /* whole pages go straight into the user buffer, there is no
+                 * point in evicting another line for them */
+                res = mtd_read(cache->parent, dst, addr, len);
+                if (res < 0) {
+                    return res;
+                }
+                goto next;
+            }
+            line = _alloc(cache, page, &res);
+            if (!line) {
+                return res;
+            }
+            res = _fill(cache, line);
+            if (res < 0) {
+                return res;
+            }
+        }
+
+        _touch(cache, line);
+        memcpy(dst, _line_buf(cache, line) + offset, len);
+next:
+        addr += len;
+        dst += len;
+        left -= len;
+    }
+
+    if (sequential && MTD_CACHE_READAHEAD) {
+        /* addr points behind the last byte read now */
+        _readahead(cache, (addr + page_size - 1) / page_size);
+    }
+    cache->next_addr = addr;
+
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    const uint32_t page_size = dev->page_size;
+    uint32_t page = addr / page_size;
+    uint32_t offset = addr % page_size;
+    int res;
+
+    if (addr + size > _mtd_size(dev)) {
+        return -EOVERFLOW;
+    }
+    if (offset + size > page_size) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    mtd_cache_line_t *line = _find(cache, page);
+    if (line) {
+        cache->stats.hits++;
+    }
+    else {
+        cache->stats.misses++;
+        line = _alloc(cache, page, &res);
+        if (!line) {
+            return res;
+        }
+    }
+
+    /* merging non-adjacent data into a partial line would write back the
+     * unknown gap in between, so get the pending data out first */
+    if ((line->flags & MTD_CACHE_LINE_DIRTY) &&
+        !(line->flags & MTD_CACHE_LINE_VALID) &&
+        ((offset > line->dirty_end) || (offset + size < line->dirty_start))) {
+        res = _writeback(cache, line);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    memcpy(_line_buf(cache, line) + offset, buff, size);
+    if (line->flags & MTD_CACHE_LINE_DIRTY) {
+        if (offset < line->dirty_start) {
+            line->dirty_start = offset;
+        }
+        if (offset + size > line->dirty_end) {
+            line->dirty_end = offset + size;
+        }
+    }
+    else {
+        line->dirty_start = offset;
+        line->dirty_end = offset + size;
+        line->flags |= MTD_CACHE_LINE_DIRTY;
+    }
+    line->flags &= ~MTD_CACHE_LINE_PREFETCH;
+    _touch(cache, line);
+
+    /* a complete page goes out in one go */
+    if ((line->dirty_start == 0) && (line->dirty_end == page_size)) {
+        line->flags |= MTD_CACHE_LINE_VALID;
+        res = _writeback(cache, line);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    int res = mtd_erase(cache->parent, addr, size);
+    if (res < 0) {
+        return res;
+    }
+
+    /* pending writes to erased pages are obsolete now */
+    uint32_t first = addr / dev->page_size;
+    uint32_t last = (addr + size) / dev->page_size;
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        mtd_cache_line_t *line = &cache->lines[i];
+        if ((line->page != MTD_CACHE_PAGE_INVALID) &&
+            (line->page >= first) && (line->page < last)) {
+            _release(line);
+        }
+    }
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    return mtd_power(cache->parent, power);
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        mtd_cache_line_t *line = &cache->lines[i];
+        int res = _writeback(cache, line);
+        if (res < 0) {
+            return res;
+        }
+        if (!(line->flags & MTD_CACHE_LINE_VALID)) {
+            _release(line);
+        }
+    }
+    return 0;
+}
+
+void mtd_cache_invalidate(mtd_cache_t *cache)
+{
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        _release(&cache->lines[i]);
+    }
+}
+
+void mtd_cache_reset_stats(mtd_cache_t *cache)
+{
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
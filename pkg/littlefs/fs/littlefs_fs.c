@@ -367,6 +367,71 @@ static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
     return littlefs_err_to_errno(ret);
 }
 
+static ssize_t _writev(vfs_file_t *filp, const iolist_t *iolist)
+{
+    littlefs_desc_t *fs = filp->mp->private_data;
+    lfs_file_t *fp = (lfs_file_t *)&filp->private_data.buffer;
+    ssize_t total = 0;
+
+    /* take the lock once for the whole list */
+    mutex_lock(&fs->lock);
+
+    DEBUG("littlefs: writev: filp=%p, fp=%p, iolist=%p\n",
+          (void *)filp, (void *)fp, (void *)iolist);
+
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if (iol->iol_len == 0) {
+            continue;
+        }
+        ssize_t ret = lfs_file_write(&fs->fs, fp, iol->iol_base, iol->iol_len);
+        if (ret < 0) {
+            if (total == 0) {
+                total = littlefs_err_to_errno(ret);
+            }
+            break;
+        }
+        total += ret;
+        if ((size_t)ret < iol->iol_len) {
+            break;
+        }
+    }
+    mutex_unlock(&fs->lock);
+
+    return total;
+}
+
+static ssize_t _readv(vfs_file_t *filp, const iolist_t *iolist)
+{
+    littlefs_desc_t *fs = filp->mp->private_data;
+    lfs_file_t *fp = (lfs_file_t *)&filp->private_data.buffer;
+    ssize_t total = 0;
+
+    mutex_lock(&fs->lock);
+
+    DEBUG("littlefs: readv: filp=%p, fp=%p, iolist=%p\n",
+          (void *)filp, (void *)fp, (void *)iolist);
+
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if (iol->iol_len == 0) {
+            continue;
+        }
+        ssize_t ret = lfs_file_read(&fs->fs, fp, iol->iol_base, iol->iol_len);
+        if (ret < 0) {
+            if (total == 0) {
+                total = littlefs_err_to_errno(ret);
+            }
+            break;
+        }
+        total += ret;
+        if ((size_t)ret < iol->iol_len) {
+            break;
+        }
+    }
+    mutex_unlock(&fs->lock);
+
+    return total;
+}
+
 static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
 {
     littlefs_desc_t *fs = filp->mp->private_data;
@@ -515,6 +580,8 @@ static const vfs_file_ops_t littlefs_file_ops = {
     .close = _close,
     .read = _read,
     .write = _write,
+    .readv = _readv,
+    .writev = _writev,
     .lseek = _lseek,
 };
 
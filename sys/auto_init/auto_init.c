@@ -28,6 +28,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_THREADSTAT
+#include "threadstat.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
@@ -48,6 +52,10 @@
 #include "net/gnrc/pktdump.h"
 #endif
 
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
+
 #ifdef MODULE_GNRC_UDP
 #include "net/gnrc/udp.h"
 #endif
@@ -80,6 +88,10 @@
 #include "net/skald.h"
 #endif
 
+#ifdef MODULE_VFS_AIO
+#include "vfs_aio.h"
+#endif
+
 #ifdef MODULE_NDN_RIOT
 #include "ndn-riot/ndn.h"
 #endif
@@ -101,6 +113,10 @@ void auto_init(void)
     DEBUG("Auto init xtimer module.\n");
     xtimer_init();
 #endif
+#ifdef MODULE_THREADSTAT
+    DEBUG("Auto init threadstat module.\n");
+    threadstat_init();
+#endif
 #ifdef MODULE_MCI
     DEBUG("Auto init mci module.\n");
     mci_initialize();
@@ -117,6 +133,14 @@ void auto_init(void)
     DEBUG("Auto init gnrc_pktdump module.\n");
     gnrc_pktdump_init();
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+    DEBUG("Auto init gnrc_pktcap module.\n");
+    gnrc_pktcap_init();
+#endif
+#ifdef MODULE_NATIVE_PKTCAP
+    extern void auto_init_native_pktcap(void);
+    auto_init_native_pktcap();
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN
     DEBUG("Auto init gnrc_sixlowpan module.\n");
     gnrc_sixlowpan_init();
@@ -150,6 +174,10 @@ void auto_init(void)
     extern void auto_init_devfs(void);
     auto_init_devfs();
 #endif
+#ifdef MODULE_VFS_AIO
+    DEBUG("Auto init vfs_aio module.\n");
+    vfs_aio_init();
+#endif
 #ifdef MODULE_GNRC_IPV6_NIB
     DEBUG("Auto init gnrc_ipv6_nib module.\n");
     gnrc_ipv6_nib_init();
@@ -261,11 +289,21 @@ void auto_init(void)
     auto_init_netdev_tap();
 #endif
 
+#ifdef MODULE_NETDEV_PACKET
+    extern void auto_init_netdev_packet(void);
+    auto_init_netdev_packet();
+#endif
+
 #ifdef MODULE_SOCKET_ZEP
     extern void auto_init_socket_zep(void);
     auto_init_socket_zep();
 #endif
 
+#ifdef MODULE_SHM_RADIO
+    extern void auto_init_shm_radio(void);
+    auto_init_shm_radio();
+#endif
+
 #ifdef MODULE_NORDIC_SOFTDEVICE_BLE
     extern void gnrc_nordic_ble_6lowpan_init(void);
     gnrc_nordic_ble_6lowpan_init();
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup sys_auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for netdev_packet devices
+ */
+
+#ifdef MODULE_NETDEV_PACKET
+
+#include "log.h"
+#include "debug.h"
+#include "netdev_packet_params.h"
+#include "net/gnrc/netif/ethernet.h"
+
+#define PACKET_MAC_STACKSIZE        (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#define PACKET_MAC_PRIO             (GNRC_NETIF_PRIO)
+
+static netdev_packet_t netdev_packet[NETDEV_PACKET_MAX];
+static char _netdev_packet_stack[NETDEV_PACKET_MAX][PACKET_MAC_STACKSIZE];
+
+void auto_init_netdev_packet(void)
+{
+    for (unsigned i = 0; i < NETDEV_PACKET_MAX; i++) {
+        const netdev_packet_params_t *p = &netdev_packet_params[i];
+
+        LOG_DEBUG("[auto_init_netif] initializing netdev_packet #%u on %s\n",
+                  i, p->if_name);
+
+        netdev_packet_setup(&netdev_packet[i], p);
+        gnrc_netif_ethernet_create(_netdev_packet_stack[i],
+                                   PACKET_MAC_STACKSIZE, PACKET_MAC_PRIO,
+                                   "gnrc_netdev_packet",
+                                   &netdev_packet[i].netdev);
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NETDEV_PACKET */
+/** @} */
@@ -23,6 +23,9 @@
 #include "socket_zep.h"
 #include "socket_zep_params.h"
 #include "net/gnrc/netif/ieee802154.h"
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/tsch.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -47,10 +50,17 @@ void auto_init_socket_zep(void)
         LOG_DEBUG("[auto_init_netif: initializing socket ZEP device #%u\n", i);
         /* setup netdev device */
         socket_zep_setup(&_socket_zeps[i], &socket_zep_params[i]);
+#ifdef MODULE_GNRC_TSCH
+        gnrc_netif_tsch_create(_socket_zep_stacks[i],
+                               SOCKET_ZEP_MAC_STACKSIZE,
+                               SOCKET_ZEP_MAC_PRIO, "socket_zep-tsch",
+                               (netdev_t *)&_socket_zeps[i]);
+#else
         gnrc_netif_ieee802154_create(_socket_zep_stacks[i],
                                      SOCKET_ZEP_MAC_STACKSIZE,
                                      SOCKET_ZEP_MAC_PRIO, "socket_zep",
                                      (netdev_t *)&_socket_zeps[i]);
+#endif
     }
 }
 
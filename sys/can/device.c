@@ -30,6 +30,10 @@
 #include "can/can_trx.h"
 #endif
 
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+#include "can/router.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -49,6 +53,98 @@ static void pm_cb(void *arg);
 static void pm_reset(candev_dev_t *candev_dev, uint32_t value);
 #endif
 
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+static int _hw_filter_idx(candev_dev_t *candev_dev, const struct can_filter *filter)
+{
+    for (unsigned i = 0; i < candev_dev->hw_filters_numof; i++) {
+        if ((candev_dev->hw_filters[i].can_id == filter->can_id) &&
+            (candev_dev->hw_filters[i].can_mask == filter->can_mask)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* reprogram the device with the filters chosen by the router */
+static void _offload_filters(candev_dev_t *candev_dev)
+{
+    candev_t *dev = candev_dev->dev;
+    struct can_filter filters[CAN_DEVICE_HW_FILTERS_MAX];
+    size_t n = can_router_hw_filters(candev_dev->ifnum, filters, candev_dev->hw_banks);
+
+    candev_dev->rx_count = 0;
+
+    if (n == candev_dev->hw_filters_numof) {
+        unsigned i;
+        for (i = 0; i < n; i++) {
+            if (_hw_filter_idx(candev_dev, &filters[i]) < 0) {
+                break;
+            }
+        }
+        if (i == n) {
+            return;
+        }
+    }
+
+    DEBUG("can device: updating %u hw filters\n", (unsigned)n);
+    for (unsigned i = 0; i < candev_dev->hw_filters_numof; i++) {
+        dev->driver->remove_filter(dev, &candev_dev->hw_filters[i]);
+    }
+    candev_dev->hw_filters_numof = 0;
+    for (unsigned i = 0; i < n; i++) {
+        if (dev->driver->set_filter(dev, &filters[i]) >= 0) {
+            candev_dev->hw_filters[candev_dev->hw_filters_numof++] = filters[i];
+        }
+    }
+
+    if (n < candev_dev->hw_banks) {
+        /* everything fits again */
+        candev_dev->hw_banks = 0;
+    }
+}
+
+static int _set_filter(candev_dev_t *candev_dev, const struct can_filter *filter)
+{
+    candev_t *dev = candev_dev->dev;
+
+    if (candev_dev->hw_banks == 0) {
+        int res = -EOVERFLOW;
+        if (candev_dev->hw_filters_numof < CAN_DEVICE_HW_FILTERS_MAX) {
+            res = dev->driver->set_filter(dev, filter);
+        }
+        if (res >= 0) {
+            candev_dev->hw_filters[candev_dev->hw_filters_numof++] = *filter;
+            return res;
+        }
+        if (candev_dev->hw_filters_numof == 0) {
+            return res;
+        }
+        /* out of filter banks, the router filters the rest from now on */
+        candev_dev->hw_banks = candev_dev->hw_filters_numof;
+    }
+    _offload_filters(candev_dev);
+
+    return 0;
+}
+
+static int _remove_filter(candev_dev_t *candev_dev, const struct can_filter *filter)
+{
+    candev_t *dev = candev_dev->dev;
+
+    if (candev_dev->hw_banks) {
+        _offload_filters(candev_dev);
+        return 0;
+    }
+
+    int idx = _hw_filter_idx(candev_dev, filter);
+    if (idx >= 0) {
+        candev_dev->hw_filters[idx] =
+            candev_dev->hw_filters[--candev_dev->hw_filters_numof];
+    }
+    return dev->driver->remove_filter(dev, filter);
+}
+#endif
+
 static void _can_event(candev_t *dev, candev_event_t event, void *arg)
 {
     msg_t msg;
@@ -95,6 +191,12 @@ static void _can_event(candev_t *dev, candev_event_t event, void *arg)
         /* received frame in arg */
         frame = (struct can_frame *) arg;
         can_dll_dispatch_rx_frame(frame, candev_dev->pid);
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+        if (candev_dev->hw_banks &&
+            (++candev_dev->rx_count >= CAN_DEVICE_OFFLOAD_INTERVAL)) {
+            _offload_filters(candev_dev);
+        }
+#endif
         break;
     case CANDEV_EVENT_RX_ERROR:
         DEBUG("_can_event: CANDEV_EVENT_RX_ERROR\n");
@@ -287,7 +389,11 @@ static void *_can_device_thread(void *args)
             DEBUG("can device: CAN_MSG_SET_FILTER received\n");
             wake_up(candev_dev);
             /* set filter for device driver */
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+            res = _set_filter(candev_dev, msg.content.ptr);
+#else
             res = dev->driver->set_filter(dev, msg.content.ptr);
+#endif
             /* send reply to calling thread */
             reply.type = CAN_MSG_ACK;
             reply.content.value = (uint32_t)res;
@@ -297,7 +403,11 @@ static void *_can_device_thread(void *args)
             DEBUG("can device: CAN_MSG_REMOVE_FILTER received\n");
             wake_up(candev_dev);
             /* set filter for device driver */
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+            res = _remove_filter(candev_dev, msg.content.ptr);
+#else
             res = dev->driver->remove_filter(dev, msg.content.ptr);
+#endif
             /* send reply to calling thread */
             reply.type = CAN_MSG_ACK;
             reply.content.value = (uint32_t)res;
@@ -65,6 +65,9 @@
 #define CAN_ISOTP_TIMEOUT_N_Cr (1 * US_PER_SEC)
 #endif
 
+/* largest separation time which can be encoded in a FC frame */
+#define STMIN_MAX_US (0x7F * US_PER_MS)
+
 enum {
     ISOTP_IDLE = 0,
     ISOTP_WAIT_FC,
@@ -104,6 +107,144 @@ static void _rx_timeout(void *arg);
 static int _isotp_send_fc(struct isotp *isotp, int ae, uint8_t status);
 static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame);
 
+static void _con_init(struct tpcon *con, const iolist_t *iol, unsigned len)
+{
+    con->idx = 0;
+    con->len = len;
+    con->iol = iol;
+    con->iol_off = 0;
+}
+
+static void _con_init_snip(struct tpcon *con, gnrc_pktsnip_t *snip)
+{
+    con->snip = snip;
+    con->buf.iol_next = NULL;
+    con->buf.iol_base = snip->data;
+    con->buf.iol_len = snip->size;
+    _con_init(con, &con->buf, snip->size);
+}
+
+/* copies @p n bytes between @p buf and the message at the current index */
+static void _con_copy(struct tpcon *con, uint8_t *buf, unsigned n, bool to_msg)
+{
+    assert(con->idx + n <= con->len);
+
+    con->idx += n;
+    while (n) {
+        while (con->iol_off >= con->iol->iol_len) {
+            con->iol = con->iol->iol_next;
+            con->iol_off = 0;
+        }
+        uint8_t *pos = (uint8_t *)con->iol->iol_base + con->iol_off;
+        unsigned chunk = MIN(n, con->iol->iol_len - con->iol_off);
+        if (to_msg) {
+            memcpy(pos, buf, chunk);
+        }
+        else {
+            memcpy(buf, pos, chunk);
+        }
+        con->iol_off += chunk;
+        buf += chunk;
+        n -= chunk;
+    }
+}
+
+static uint32_t _stmin_to_us(uint8_t stmin)
+{
+    /* ISO15765-2 8.5.5.5 */
+    /* Range 0x0 - 0x7F -> 0 ms - 127 ms */
+    if (stmin < 0x80) {
+        return stmin * US_PER_MS;
+    }
+    /* Range 0xF1 - 0xF9 -> 100 us - 900 us */
+    return (stmin - 0xF0) * 100;
+}
+
+static uint8_t _us_to_stmin(uint32_t us)
+{
+    if (us < 100) {
+        return 0;
+    }
+    if (us < US_PER_MS) {
+        return 0xF0 + us / 100;
+    }
+    return MIN(us, STMIN_MAX_US) / US_PER_MS;
+}
+
+/* adapt the flow control parameters sent to the peer to the last reception:
+ * after a complete message the sender may go faster, after a lost frame it
+ * has to slow down */
+static void _isotp_rx_adapt_fc(struct isotp *isotp, bool success)
+{
+    if (!(isotp->opt.flags & CAN_ISOTP_RX_DYN_FC)) {
+        return;
+    }
+
+    uint32_t gap = _stmin_to_us(isotp->rxfc.stmin);
+
+    if (success) {
+        /* a block size of 0 means no further FC frames */
+        if (isotp->rxfc.bs) {
+            isotp->rxfc.bs = (isotp->rxfc.bs < 0x80) ? isotp->rxfc.bs * 2 : 0;
+        }
+        gap /= 2;
+    }
+    else {
+        isotp->rxfc.bs = isotp->rxfc.bs ? (isotp->rxfc.bs + 1) / 2 : CAN_ISOTP_BS;
+        gap = gap ? gap * 2 : 100;
+    }
+    isotp->rxfc.stmin = _us_to_stmin(gap);
+
+    DEBUG("_isotp_rx_adapt_fc: bs=%" PRIu8 ", stmin=0x%" PRIx8 "\n",
+          isotp->rxfc.bs, isotp->rxfc.stmin);
+}
+
+/* prepares the reception of a message of @p len bytes, either into the user
+ * buffers or into a newly allocated snip */
+static int _isotp_rx_start(struct isotp *isotp, unsigned len)
+{
+    if (isotp->rx.snip) {
+        DEBUG("_isotp_rx_start: freeing previous rx buf\n");
+        gnrc_pktbuf_release(isotp->rx.snip);
+        isotp->rx.snip = NULL;
+    }
+
+    if (isotp->rx_iol) {
+        if (iolist_size(isotp->rx_iol) < len) {
+            return -EOVERFLOW;
+        }
+        _con_init(&isotp->rx, isotp->rx_iol, len);
+        return 0;
+    }
+
+    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (!snip) {
+        return -ENOMEM;
+    }
+    _con_init_snip(&isotp->rx, snip);
+
+    return 0;
+}
+
+/* removes @p handle from the frames in flight, returns true if it was there */
+static bool _isotp_tx_handle_del(struct isotp *isotp, int handle)
+{
+    for (unsigned i = 0; i < isotp->tx_inflight; i++) {
+        if (isotp->tx_handles[i] == handle) {
+            isotp->tx_handles[i] = isotp->tx_handles[--isotp->tx_inflight];
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _isotp_tx_abort(struct isotp *isotp)
+{
+    while (isotp->tx_inflight) {
+        raw_can_abort(isotp->entry.ifnum, isotp->tx_handles[--isotp->tx_inflight]);
+    }
+}
+
 static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 {
 #ifdef MODULE_CAN_MBOX
@@ -128,21 +269,37 @@ static int _isotp_dispatch_rx(struct isotp *isotp)
     can_rx_data_t *data;
 
     msg.type = CAN_MSG_RX_INDICATION;
-    data = can_pkt_alloc_rx_data(isotp->rx.snip,
-                                 isotp->rx.snip->size + sizeof(*isotp->rx.snip),
-                                 isotp->arg);
+    if (isotp->rx.snip) {
+        data = can_pkt_alloc_rx_data(isotp->rx.snip,
+                                     isotp->rx.snip->size + sizeof(*isotp->rx.snip),
+                                     isotp->arg);
+    }
+    else {
+        /* the message is in the user buffers */
+        data = can_pkt_alloc_rx_data(NULL, isotp->rx.len, isotp->arg);
+    }
 
     if (!data) {
+        if (isotp->rx.snip) {
+            gnrc_pktbuf_release(isotp->rx.snip);
+            isotp->rx.snip = NULL;
+        }
         return -ENOMEM;
     }
 
     msg.content.ptr = data;
     if (_send_msg(&msg, &isotp->entry) < 1) {
         DEBUG("_isotp_dispatch_rx: msg lost, freeing rx buf\n");
-        gnrc_pktbuf_release(((gnrc_pktsnip_t *)data->data.iov_base));
+        if (isotp->rx.snip) {
+            gnrc_pktbuf_release(isotp->rx.snip);
+        }
         can_pkt_free_rx_data(data);
         ret = -EOVERFLOW;
     }
+    else if (!isotp->rx.snip) {
+        /* the user buffers are handed back with the indication */
+        isotp->rx_iol = NULL;
+    }
 
     isotp->rx.snip = NULL;
 
@@ -153,8 +310,11 @@ static int _isotp_dispatch_tx(struct isotp *isotp, int err)
 {
     msg_t msg;
 
-    gnrc_pktbuf_release(isotp->tx.snip);
-    isotp->tx.snip = NULL;
+    if (isotp->tx.snip) {
+        gnrc_pktbuf_release(isotp->tx.snip);
+        isotp->tx.snip = NULL;
+    }
+    isotp->tx.iol = NULL;
 
     if (isotp->opt.flags & CAN_ISOTP_TX_DONT_WAIT) {
         return 0;
@@ -226,15 +386,7 @@ static int _isotp_rcv_fc(struct isotp *isotp, struct can_frame *frame, int ae)
         /* according to ISO15765-2 8.5.5.6 */
         isotp->txfc.stmin = 0x7F;
     }
-    /* ISO15765-2 8.5.5.5 */
-    /* Range 0x0 - 0x7F -> 0 ms - 127 ms */
-    if (isotp->txfc.stmin < 0x80) {
-        isotp->tx_gap = isotp->txfc.stmin * US_PER_MS;
-    }
-    /* Range 0xF1 - 0xF9 -> 100 us - 900 us */
-    else {
-        isotp->tx_gap = (isotp->txfc.stmin - 0xF0) * 100;
-    }
+    isotp->tx_gap = _stmin_to_us(isotp->txfc.stmin);
 
     switch (frame->data[ae] & 0xF) {
     case ISOTP_FC_CTS:
@@ -276,16 +428,11 @@ static int _isotp_rcv_sf(struct isotp *isotp, struct can_frame *frame, int ae)
         return 1;
     }
 
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
-    if (!snip) {
+    if (_isotp_rx_start(isotp, len) < 0) {
         return 1;
     }
-    isotp->rx.snip = snip;
 
-    isotp->rx.idx = 0;
-    for (size_t i = SF_PCI_SZ + ae; i < isotp->rx.snip->size + ae + SF_PCI_SZ; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-    }
+    _con_copy(&isotp->rx, &frame->data[SF_PCI_SZ + ae], len, true);
 
     return _isotp_dispatch_rx(isotp);
 }
@@ -297,39 +444,19 @@ static int _isotp_rcv_ff(struct isotp *isotp, struct can_frame *frame, int ae)
     int len = (frame->data[ae] & 0x0F) << 8;
     len += frame->data[ae + 1];
 
-    if (isotp->rx.snip) {
-        DEBUG("_isotp_rcv_ff: freeing previous rx buf\n");
-        gnrc_pktbuf_release(isotp->rx.snip);
-    }
-
-    if (len > MAX_MSG_LENGTH) {
-        if (!(isotp->opt.flags & CAN_ISOTP_LISTEN_MODE)) {
-            _isotp_send_fc(isotp, ae, ISOTP_FC_OVFLW);
-        }
-        return 1;
-    }
-
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
-    if (!snip) {
+    /* the FF payload must not exceed the message */
+    if ((len > MAX_MSG_LENGTH) || (len < frame->can_dlc - (ae + FF_PCI_SZ)) ||
+        (_isotp_rx_start(isotp, len) < 0)) {
         if (!(isotp->opt.flags & CAN_ISOTP_LISTEN_MODE)) {
             _isotp_send_fc(isotp, ae, ISOTP_FC_OVFLW);
         }
         return 1;
     }
-    isotp->rx.snip = snip;
 
-    isotp->rx.idx = 0;
-    for (int i = ae + FF_PCI_SZ; i < frame->can_dlc; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-    }
+    _con_copy(&isotp->rx, &frame->data[ae + FF_PCI_SZ],
+              frame->can_dlc - (ae + FF_PCI_SZ), true);
 
-#if ENABLE_DEBUG
-    DEBUG("_isotp_rcv_ff: rx.buf=");
-    for (unsigned i = 0; i < isotp->rx.idx; i++) {
-        DEBUG("%02hhx", ((uint8_t *)isotp->rx.snip->data)[i]);
-    }
-    DEBUG("\n");
-#endif
+    DEBUG("_isotp_rcv_ff: len=%d, rx.idx=%u\n", len, isotp->rx.idx);
 
     isotp->rx.sn = 1;
 
@@ -357,30 +484,27 @@ static int _isotp_rcv_cf(struct isotp *isotp, struct can_frame *frame, int ae)
     if ((frame->data[ae] & 0x0F) != isotp->rx.sn) {
         DEBUG("_isotp_rcv_cf: wrong seq number %d, expected %d\n", frame->data[ae] & 0x0F, isotp->rx.sn);
         isotp->rx.state = ISOTP_IDLE;
-        gnrc_pktbuf_release(isotp->rx.snip);
-        isotp->rx.snip = NULL;
+        if (isotp->rx.snip) {
+            gnrc_pktbuf_release(isotp->rx.snip);
+            isotp->rx.snip = NULL;
+        }
+        _isotp_rx_adapt_fc(isotp, false);
         return 1;
     }
     isotp->rx.sn++;
     isotp->rx.sn %= 16;
 
-    for (int i = ae + N_PCI_SZ; i < frame->can_dlc; i++) {
-        ((uint8_t *)isotp->rx.snip->data)[isotp->rx.idx++] = frame->data[i];
-        if (isotp->rx.idx >= isotp->rx.snip->size) {
-            break;
-        }
+    if (frame->can_dlc > ae + N_PCI_SZ) {
+        unsigned num_bytes = MIN((unsigned)frame->can_dlc - (ae + N_PCI_SZ),
+                                 isotp->rx.len - isotp->rx.idx);
+        _con_copy(&isotp->rx, &frame->data[ae + N_PCI_SZ], num_bytes, true);
     }
 
-#if ENABLE_DEBUG
-    DEBUG("_isotp_rcv_cf: rx.buf=");
-    for (unsigned i = 0; i < isotp->rx.idx; i++) {
-        DEBUG("%02hhx", ((uint8_t *)isotp->rx.snip->data)[i]);
-    }
-    DEBUG("\n");
-#endif
+    DEBUG("_isotp_rcv_cf: rx.idx=%u\n", isotp->rx.idx);
 
-    if (isotp->rx.idx >= isotp->rx.snip->size) {
+    if (isotp->rx.idx >= isotp->rx.len) {
         isotp->rx.state = ISOTP_IDLE;
+        _isotp_rx_adapt_fc(isotp, true);
         return _isotp_dispatch_rx(isotp);
     }
 
@@ -490,12 +614,11 @@ static void _isotp_create_ff(struct isotp *isotp, struct can_frame *frame, int a
         frame->data[0] = isotp->opt.ext_address;
     }
 
-    frame->data[ae] = (uint8_t)(isotp->tx.snip->size >> 8) | N_PCI_FF;
-    frame->data[ae + 1] = (uint8_t) isotp->tx.snip->size & 0xFFU;
+    frame->data[ae] = (uint8_t)(isotp->tx.len >> 8) | N_PCI_FF;
+    frame->data[ae + 1] = (uint8_t) isotp->tx.len & 0xFFU;
 
-    for (int i = ae + FF_PCI_SZ; i < CAN_MAX_DLEN; i++) {
-        frame->data[i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _con_copy(&isotp->tx, &frame->data[ae + FF_PCI_SZ],
+              CAN_MAX_DLEN - (ae + FF_PCI_SZ), false);
 
     isotp->tx.sn = 1;
 }
@@ -504,7 +627,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 {
     size_t pci_len = N_PCI_SZ + ae;
     size_t space = CAN_MAX_DLEN - pci_len;
-    size_t num_bytes = MIN(space, isotp->tx.snip->size - isotp->tx.idx);
+    size_t num_bytes = MIN(space, isotp->tx.len - isotp->tx.idx);
 
     frame->can_id = isotp->opt.tx_id;
     frame->can_dlc = num_bytes + pci_len;
@@ -518,9 +641,7 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
         }
     }
 
-    for (size_t i = 0; i < num_bytes; i++) {
-        frame->data[pci_len + i] = ((uint8_t *)isotp->tx.snip->data)[isotp->tx.idx++];
-    }
+    _con_copy(&isotp->tx, &frame->data[pci_len], num_bytes, false);
 
     if (ae) {
         frame->data[0] = isotp->opt.ext_address;
@@ -528,11 +649,35 @@ static void _isotp_fill_dataframe(struct isotp *isotp, struct can_frame *frame,
 
 }
 
-static void _isotp_tx_timeout_task(struct isotp *isotp)
+/* true if the next CF may be sent without waiting for a FC */
+static bool _isotp_cf_allowed(struct isotp *isotp)
+{
+    return (isotp->tx.idx < isotp->tx.len) &&
+           !(isotp->txfc.bs && (isotp->tx.bs >= isotp->txfc.bs));
+}
+
+/* sends the next CF, and without a separation time as many following ones as
+ * the transmit window and the block size allow */
+static void _isotp_send_cfs(struct isotp *isotp)
 {
     int ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
     struct can_frame frame;
 
+    do {
+        _isotp_fill_dataframe(isotp, &frame, ae);
+        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
+        isotp->tx.sn %= 16;
+        isotp->tx.bs++;
+
+        isotp->tx.state = ISOTP_SENDING_CF;
+        _isotp_tx_send(isotp, &frame);
+    } while (!isotp->tx_gap && (isotp->tx.state == ISOTP_SENDING_CF) &&
+             (isotp->tx_inflight < CAN_ISOTP_TX_WINDOW) &&
+             _isotp_cf_allowed(isotp));
+}
+
+static void _isotp_tx_timeout_task(struct isotp *isotp)
+{
     DEBUG("_isotp_tx_timeout_task: state=%d\n", isotp->tx.state);
 
     switch (isotp->tx.state) {
@@ -544,13 +689,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
 
     case ISOTP_SENDING_NEXT_CF:
         DEBUG("_isotp_tx_timeout_task: sending next CF\n");
-        _isotp_fill_dataframe(isotp, &frame, ae);
-        frame.data[ae] = N_PCI_CF | isotp->tx.sn++;
-        isotp->tx.sn %= 16;
-        isotp->tx.bs++;
-
-        isotp->tx.state = ISOTP_SENDING_CF;
-        _isotp_tx_send(isotp, &frame);
+        _isotp_send_cfs(isotp);
         break;
 
     case ISOTP_SENDING_CF:
@@ -558,7 +697,7 @@ static void _isotp_tx_timeout_task(struct isotp *isotp)
     case ISOTP_SENDING_SF:
         DEBUG("_isotp_tx_timeout_task: timeout on DLL\n");
         isotp->tx.state = ISOTP_IDLE;
-        raw_can_abort(isotp->entry.ifnum, isotp->tx.tx_handle);
+        _isotp_tx_abort(isotp);
         _isotp_dispatch_tx(isotp, ETIMEDOUT);
         break;
     }
@@ -583,7 +722,18 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
         break;
 
     case ISOTP_SENDING_CF:
-        if (isotp->tx.idx >= isotp->tx.snip->size) {
+        if (isotp->tx_inflight) {
+            /* pipelined CFs, keep the window filled */
+            if (!isotp->tx_gap && _isotp_cf_allowed(isotp)) {
+                _isotp_send_cfs(isotp);
+            }
+            if (isotp->tx.state == ISOTP_SENDING_CF) {
+                xtimer_set(&isotp->tx_timer, CAN_ISOTP_TIMEOUT_N_As);
+            }
+            break;
+        }
+
+        if (isotp->tx.idx >= isotp->tx.len) {
             /* Finished */
             isotp->tx.state = ISOTP_IDLE;
             _isotp_dispatch_tx(isotp, 0);
@@ -597,6 +747,11 @@ static void _isotp_tx_tx_conf(struct isotp *isotp)
             break;
         }
 
+        if (!isotp->tx_gap) {
+            _isotp_send_cfs(isotp);
+            break;
+        }
+
         isotp->tx.state = ISOTP_SENDING_NEXT_CF;
         xtimer_set(&isotp->tx_timer, isotp->tx_gap);
         break;
@@ -612,9 +767,12 @@ static void _isotp_rx_timeout_task(struct isotp *isotp)
         /* Fall through */
     case ISOTP_WAIT_CF:
         DEBUG("_isotp_rx_timeout_task: free rx buf\n");
-        gnrc_pktbuf_release(isotp->rx.snip);
-        isotp->rx.snip = NULL;
+        if (isotp->rx.snip) {
+            gnrc_pktbuf_release(isotp->rx.snip);
+            isotp->rx.snip = NULL;
+        }
         isotp->rx.state = ISOTP_IDLE;
+        _isotp_rx_adapt_fc(isotp, false);
         /* TODO dispatch rx error ? */
         break;
     }
@@ -643,8 +801,10 @@ static int _isotp_tx_send(struct isotp *isotp, struct can_frame *frame)
     if (isotp->tx.tx_handle < 0) {
         xtimer_remove(&isotp->tx_timer);
         isotp->tx.state = ISOTP_IDLE;
+        _isotp_tx_abort(isotp);
         return _isotp_dispatch_tx(isotp, isotp->tx.tx_handle);
     }
+    isotp->tx_handles[isotp->tx_inflight++] = isotp->tx.tx_handle;
 
     return 0;
 }
@@ -654,12 +814,12 @@ static int _isotp_send_sf_ff(struct isotp *isotp)
     struct can_frame frame;
     unsigned ae = (isotp->opt.flags & CAN_ISOTP_EXTEND_ADDR) ? 1 : 0;
 
-    if (isotp->tx.snip->size <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
+    if (isotp->tx.len <= CAN_MAX_DLEN - SF_PCI_SZ - ae) {
         /* Fits into a single frame */
         _isotp_fill_dataframe(isotp, &frame, ae);
 
         frame.data[ae] = N_PCI_SF;
-        frame.data[ae] |= isotp->tx.snip->size;
+        frame.data[ae] |= isotp->tx.len;
 
         isotp->tx.state = ISOTP_SENDING_SF;
     }
@@ -698,32 +858,33 @@ static void *_isotp_thread(void *args)
             }
             DEBUG("_isotp_thread: CAN_MSG_RX_INDICATION, frame=%p, data=%p\n",
                   (void *)rx_frame->data.iov_base, rx_frame->arg);
+            /* the lock protects the rx state against isotp_set_rx_iolist() */
+            mutex_lock(&lock);
             _isotp_rcv((struct isotp *)rx_frame->arg, rx_frame->data.iov_base);
+            mutex_unlock(&lock);
             raw_can_free_frame(rx_frame);
             break;
         case CAN_MSG_TX_CONFIRMATION:
             DEBUG("_isotp_thread: CAN_MSG_TX_CONFIRMATION, handle=%d\n", (int)msg.content.value);
             mutex_lock(&lock);
             LL_FOREACH(isotp_list, isotp) {
-                if (isotp->tx.tx_handle == (int)msg.content.value) {
-                    mutex_unlock(&lock);
+                if (_isotp_tx_handle_del(isotp, (int)msg.content.value)) {
                     _isotp_tx_tx_conf(isotp);
                     break;
                 }
                 else if (isotp->rx.tx_handle == (int)msg.content.value) {
-                    mutex_unlock(&lock);
                     _isotp_rx_tx_conf(isotp);
                     break;
                 }
             }
-            if (isotp == NULL) {
-                mutex_unlock(&lock);
-            }
+            mutex_unlock(&lock);
             break;
         case CAN_MSG_ISOTP_RX_TIMEOUT:
             isotp = msg.content.ptr;
             DEBUG("_isotp_thread: RX TIMEOUT arg=%p\n", (void *)isotp);
+            mutex_lock(&lock);
             _isotp_rx_timeout_task(isotp);
+            mutex_unlock(&lock);
             break;
         case CAN_MSG_ISOTP_TX_TIMEOUT:
             isotp = msg.content.ptr;
@@ -752,6 +913,17 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
     return res;
 }
 
+static void _isotp_send_start(struct isotp *isotp)
+{
+    isotp->tx_wft = 0;
+    isotp->tx_inflight = 0;
+
+    msg_t msg;
+    msg.type = CAN_MSG_SEND_FRAME;
+    msg.content.ptr = isotp;
+    msg_send(&msg, isotp_pid);
+}
+
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
 {
     assert(isotp != NULL);
@@ -776,22 +948,81 @@ int isotp_send(struct isotp *isotp, const void *buf, int len, int flags)
     if (!snip) {
         return -ENOMEM;
     }
-    isotp->tx.snip = snip;
 
-    memcpy(isotp->tx.snip->data, buf, len);
+    memcpy(snip->data, buf, len);
+    _con_init_snip(&isotp->tx, snip);
 
-    isotp->tx.idx = 0;
+    _isotp_send_start(isotp);
 
-    isotp->tx_wft = 0;
+    return len;
+}
 
-    msg_t msg;
-    msg.type = CAN_MSG_SEND_FRAME;
-    msg.content.ptr = isotp;
-    msg_send(&msg, isotp_pid);
+int isotp_send_iolist(struct isotp *isotp, const iolist_t *iolist, int flags)
+{
+    assert(isotp != NULL);
+#ifdef MODULE_CAN_MBOX
+    assert((isotp->entry.type == CAN_TYPE_DEFAULT && pid_is_valid(isotp->entry.target.pid)) ||
+           (isotp->entry.type == CAN_TYPE_MBOX && isotp->entry.target.mbox != NULL));
+#else
+    assert(isotp->entry.target.pid != KERNEL_PID_UNDEF);
+#endif
+
+    size_t len = iolist_size(iolist);
+    if (!len || (len > MAX_MSG_LENGTH) || (flags & CAN_ISOTP_TX_DONT_WAIT)) {
+        return -EINVAL;
+    }
+
+    if (isotp->tx.state != ISOTP_IDLE) {
+        return -EBUSY;
+    }
+
+    if (flags) {
+        isotp->opt.flags &= CAN_ISOTP_RX_FLAGS_MASK;
+        isotp->opt.flags |= (flags & CAN_ISOTP_TX_FLAGS_MASK);
+    }
+    /* a previous isotp_send() may have left the flag set */
+    isotp->opt.flags &= ~CAN_ISOTP_TX_DONT_WAIT;
+
+    isotp->tx.snip = NULL;
+    _con_init(&isotp->tx, iolist, len);
+
+    _isotp_send_start(isotp);
 
     return len;
 }
 
+int isotp_set_rx_iolist(struct isotp *isotp, const iolist_t *iolist)
+{
+    int res = 0;
+
+    assert(isotp != NULL);
+
+    mutex_lock(&lock);
+    if (!isotp->rx.snip && (isotp->rx.state != ISOTP_IDLE)) {
+        DEBUG("isotp_set_rx_iolist: aborting reception\n");
+        xtimer_remove(&isotp->rx_timer);
+        if (isotp->rx.state == ISOTP_SENDING_FC) {
+            raw_can_abort(isotp->entry.ifnum, isotp->rx.tx_handle);
+        }
+        isotp->rx.state = ISOTP_IDLE;
+    }
+    if (!iolist && !isotp->rx_iol) {
+        res = -ENOENT;
+    }
+    isotp->rx_iol = iolist;
+    mutex_unlock(&lock);
+
+    return res;
+}
+
+void isotp_set_rx_fc(struct isotp *isotp, uint8_t bs, uint8_t stmin)
+{
+    assert(isotp != NULL);
+
+    isotp->rxfc.bs = bs;
+    isotp->rxfc.stmin = stmin;
+}
+
 int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 {
     int ret;
@@ -815,6 +1046,8 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 
     memset(&isotp->rx, 0, sizeof(struct tpcon));
     memset(&isotp->tx, 0, sizeof(struct tpcon));
+    isotp->rx_iol = NULL;
+    isotp->tx_inflight = 0;
 
     isotp->rxfc.bs = CAN_ISOTP_BS;
     isotp->rxfc.stmin = CAN_ISOTP_STMIN;
@@ -857,7 +1090,9 @@ int isotp_bind(struct isotp *isotp, can_reg_entry_t *entry, void *arg)
 void isotp_free_rx(can_rx_data_t *rx)
 {
     DEBUG("isotp_free_rx: rx=%p\n", (void *)rx);
-    gnrc_pktbuf_release(rx->data.iov_base);
+    if (rx->data.iov_base) {
+        gnrc_pktbuf_release(rx->data.iov_base);
+    }
     can_pkt_free_rx_data(rx);
 }
 
@@ -885,6 +1120,7 @@ int isotp_release(struct isotp *isotp)
         isotp->rx.snip = NULL;
     }
     isotp->rx.state = ISOTP_IDLE;
+    isotp->rx_iol = NULL;
     isotp->entry.target.pid = KERNEL_PID_UNDEF;
 
     mutex_lock(&lock);
@@ -51,12 +51,23 @@ typedef struct filter_el {
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
     gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip */
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+    uint32_t hits;           /**< Number of frames matched since last offload */
+#endif
 } filter_el_t;
 
 /**
- * This table contains @p CAN_ROUTER_APP_MAX lists of CAN IDs per interface
+ * Index of the list holding the filters which don't match on all the
+ * standard ID bits
+ */
+#define WILDCARD_LIST   (CAN_ROUTER_BUCKETS)
+
+/**
+ * This table contains, per interface, @p CAN_ROUTER_BUCKETS lists of filters
+ * indexed by the lower 11 bits of their CAN ID, and one list of wildcard
+ * filters which need to be checked against every frame
  */
-static can_reg_entry_t *table[CAN_DLL_NUMOF];
+static can_reg_entry_t *table[CAN_DLL_NUMOF][CAN_ROUTER_BUCKETS + 1];
 
 
 static mutex_t lock = MUTEX_INIT;
@@ -67,16 +78,36 @@ static void _insert_to_list(can_reg_entry_t **list, filter_el_t *el);
 static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entry, canid_t can_id, canid_t mask, void *data);
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask);
 
+static inline unsigned _hash(canid_t can_id)
+{
+    can_id &= CAN_SFF_MASK;
+    return (can_id ^ (can_id >> 4) ^ (can_id >> 8)) & (CAN_ROUTER_BUCKETS - 1);
+}
+
+/* A filter can only match frames whose lower ID bits equal its own ones if
+ * the mask covers all of them, so these are stored in the bucket of their
+ * CAN ID. All other filters end up in the wildcard list. */
+static inline can_reg_entry_t **_list(unsigned int ifnum, canid_t can_id, canid_t mask)
+{
+    if ((mask & CAN_SFF_MASK) == CAN_SFF_MASK) {
+        return &table[ifnum][_hash(can_id)];
+    }
+    return &table[ifnum][WILDCARD_LIST];
+}
+
 #if ENABLE_DEBUG
 static void _print_filters(void)
 {
     for (int i = 0; i < (int)CAN_DLL_NUMOF; i++) {
         DEBUG("--- Ifnum: %d ---\n", i);
-        can_reg_entry_t *entry;
-        LL_FOREACH(table[i], entry) {
-            filter_el_t *el = container_of(entry, filter_el_t, entry);
-            DEBUG("App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32 ", mask=0x%" PRIx32 ", data=%p\n",
-                  el->entry.target.pid, (void*)el, el->can_id, el->mask, el->data);
+        for (unsigned b = 0; b <= CAN_ROUTER_BUCKETS; b++) {
+            can_reg_entry_t *entry;
+            LL_FOREACH(table[i][b], entry) {
+                filter_el_t *el = container_of(entry, filter_el_t, entry);
+                DEBUG("[%u] App pid=%" PRIkernel_pid ", el=%p, can_id=0x%" PRIx32
+                      ", mask=0x%" PRIx32 ", data=%p\n", b, el->entry.target.pid,
+                      (void*)el, el->can_id, el->mask, el->data);
+            }
         }
     }
 }
@@ -101,6 +132,9 @@ static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
     el->data = data;
     el->entry.next = NULL;
     el->snip = snip;
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+    el->hits = 0;
+#endif
     DEBUG("_alloc_canid_el: el allocated with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", can_id, mask, data);
     return el;
@@ -179,7 +213,7 @@ static filter_el_t *_find_filter_el(can_reg_entry_t *list, can_reg_entry_t *entr
 
 static int _filter_is_used(unsigned int ifnum, canid_t can_id, canid_t mask)
 {
-    filter_el_t *el = container_of(table[ifnum], filter_el_t, entry);
+    filter_el_t *el = container_of(*_list(ifnum, can_id, mask), filter_el_t, entry);
     if (!el) {
         DEBUG("_filter_is_used: empty list\n");
         return 0;
@@ -238,7 +272,7 @@ int can_router_register(can_reg_entry_t *entry, canid_t can_id, canid_t mask, vo
     filter->entry.target.pid = entry->target.pid;
 #endif
     filter->entry.ifnum = entry->ifnum;
-    _insert_to_list(&table[entry->ifnum], filter);
+    _insert_to_list(_list(entry->ifnum, can_id, mask), filter);
     mutex_unlock(&lock);
 
     PRINT_FILTERS();
@@ -264,12 +298,13 @@ int can_router_unregister(can_reg_entry_t *entry, canid_t can_id,
 #endif
 
     mutex_lock(&lock);
-    el = _find_filter_el(table[entry->ifnum], entry, can_id, mask, param);
+    can_reg_entry_t **list = _list(entry->ifnum, can_id, mask);
+    el = _find_filter_el(*list, entry, can_id, mask, param);
     if (!el) {
         mutex_unlock(&lock);
         return -EINVAL;
     }
-    LL_DELETE(table[entry->ifnum], &el->entry);
+    LL_DELETE(*list, &el->entry);
     _free_filter_el(el);
     ret = _filter_is_used(entry->ifnum, can_id, mask);
     mutex_unlock(&lock);
@@ -296,52 +331,58 @@ static int _send_msg(msg_t *msg, can_reg_entry_t *entry)
 #endif
 }
 
-/* send received pkt to all interested users */
-int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+/* send received pkt to all users of a list that match the frame */
+static int _dispatch_list(can_reg_entry_t *list, can_pkt_t *pkt)
 {
-    if (!pkt) {
-        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
-        return -EINVAL;
-    }
-
-    int res = 0;
     msg_t msg;
     msg.type = CAN_MSG_RX_INDICATION;
-#if ENABLE_DEBUG
-    int msg_cnt = 0;
-#endif
-    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
-          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
 
-    mutex_lock(&lock);
     can_reg_entry_t *entry;
     filter_el_t *el;
-    LL_FOREACH(table[pkt->entry.ifnum], entry) {
+    LL_FOREACH(list, entry) {
         el = container_of(entry, filter_el_t, entry);
         if ((pkt->frame.can_id & el->mask) == el->can_id) {
             DEBUG("can_router_dispatch_rx_indic: found el=%p, data=%p\n",
                   (void *)el, (void *)el->data);
             DEBUG("can_router_dispatch_rx_indic: rx_ind to pid: %"
                   PRIkernel_pid "\n", entry->target.pid);
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+            el->hits++;
+#endif
             atomic_fetch_add(&pkt->ref_count, 1);
             msg.content.ptr = can_pkt_alloc_rx_data(&pkt->frame, sizeof(pkt->frame), el->data);
-#if ENABLE_DEBUG
-            msg_cnt++;
-#endif
             if (!msg.content.ptr || (_send_msg(&msg, entry) <= 0)) {
                 can_pkt_free_rx_data(msg.content.ptr);
                 atomic_fetch_sub(&pkt->ref_count, 1);
                 DEBUG("can_router_dispatch_rx_indic: failed to send msg to "
                       "pid=%" PRIkernel_pid "\n", entry->target.pid);
-                res = -EBUSY;
-                break;
+                return -EBUSY;
             }
         }
     }
+
+    return 0;
+}
+
+/* send received pkt to all interested users */
+int can_router_dispatch_rx_indic(can_pkt_t *pkt)
+{
+    if (!pkt) {
+        DEBUG("can_router_dispatch_rx_indic: invalid pkt\n");
+        return -EINVAL;
+    }
+
+    int res;
+    DEBUG("can_router_dispatch_rx_indic: pkt=%p, ifnum=%d, can_id=%" PRIx32 "\n",
+          (void *)pkt, pkt->entry.ifnum, pkt->frame.can_id);
+
+    mutex_lock(&lock);
+    res = _dispatch_list(table[pkt->entry.ifnum][_hash(pkt->frame.can_id)], pkt);
+    if (res == 0) {
+        res = _dispatch_list(table[pkt->entry.ifnum][WILDCARD_LIST], pkt);
+    }
     mutex_unlock(&lock);
-#if ENABLE_DEBUG
-    DEBUG("can_router_dispatch_rx: msg send to %d threads\n", msg_cnt);
-#endif
+
     if (atomic_load(&pkt->ref_count) == 0) {
         can_pkt_free(pkt);
     }
@@ -349,6 +390,125 @@ int can_router_dispatch_rx_indic(can_pkt_t *pkt)
     return res;
 }
 
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+/* iterate over the filters of all lists of an interface */
+static filter_el_t *_next_el(int ifnum, filter_el_t *el)
+{
+    unsigned b = 0;
+
+    if (el) {
+        if (el->entry.next) {
+            return container_of(el->entry.next, filter_el_t, entry);
+        }
+        b = _list(ifnum, el->can_id, el->mask) - table[ifnum] + 1;
+    }
+    for (; b <= CAN_ROUTER_BUCKETS; b++) {
+        if (table[ifnum][b]) {
+            return container_of(table[ifnum][b], filter_el_t, entry);
+        }
+    }
+    return NULL;
+}
+
+#define FOREACH_FILTER_EL(ifnum, el) \
+    for (el = _next_el(ifnum, NULL); el; el = _next_el(ifnum, el))
+
+static int _is_selected(const filter_el_t *el, const struct can_filter *filters, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if ((filters[i].can_id == el->can_id) && (filters[i].can_mask == el->mask)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* copy all distinct filters, returns max + 1 if they don't fit */
+static size_t _collect(int ifnum, struct can_filter *filters, size_t max)
+{
+    filter_el_t *el;
+    size_t n = 0;
+
+    FOREACH_FILTER_EL(ifnum, el) {
+        if (_is_selected(el, filters, n)) {
+            continue;
+        }
+        if (n == max) {
+            return max + 1;
+        }
+        filters[n].can_id = el->can_id;
+        filters[n].can_mask = el->mask;
+        n++;
+    }
+    return n;
+}
+
+static size_t _select_most_used(int ifnum, struct can_filter *filters, size_t max)
+{
+    filter_el_t *el;
+    size_t n;
+
+    for (n = 0; n < max; n++) {
+        filter_el_t *best = NULL;
+        FOREACH_FILTER_EL(ifnum, el) {
+            if (!_is_selected(el, filters, n) && (!best || (el->hits > best->hits))) {
+                best = el;
+            }
+        }
+        filters[n].can_id = best->can_id;
+        filters[n].can_mask = best->mask;
+    }
+    return n;
+}
+
+/* build one filter covering all not selected ones, it only keeps the ID bits
+ * they all agree on */
+static void _merge_rest(int ifnum, struct can_filter *merged,
+                        const struct can_filter *filters, size_t n)
+{
+    filter_el_t *el;
+    int first = 1;
+
+    FOREACH_FILTER_EL(ifnum, el) {
+        if (_is_selected(el, filters, n)) {
+            continue;
+        }
+        if (first) {
+            merged->can_id = el->can_id;
+            merged->can_mask = el->mask;
+            first = 0;
+        }
+        else {
+            merged->can_mask &= el->mask & ~(merged->can_id ^ el->can_id);
+            merged->can_id &= merged->can_mask;
+        }
+    }
+}
+
+size_t can_router_hw_filters(int ifnum, struct can_filter *filters, size_t max)
+{
+    filter_el_t *el;
+
+    assert(max > 0);
+
+    mutex_lock(&lock);
+    size_t n = _collect(ifnum, filters, max);
+    if (n > max) {
+        n = _select_most_used(ifnum, filters, max - 1);
+        _merge_rest(ifnum, &filters[n], filters, n);
+        n++;
+    }
+    FOREACH_FILTER_EL(ifnum, el) {
+        el->hits /= 2;
+    }
+    mutex_unlock(&lock);
+
+    DEBUG("can_router_hw_filters: ifnum=%d, %u filters\n", ifnum, (unsigned)n);
+
+    return n;
+}
+#endif
+
 int can_router_dispatch_tx_conf(can_pkt_t *pkt)
 {
     msg_t msg;
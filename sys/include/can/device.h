@@ -49,6 +49,22 @@ extern "C" {
 #define CAN_DLL_NUMOF       (1)
 #endif
 
+#ifndef CAN_DEVICE_HW_FILTERS_MAX
+/**
+ * Maximum number of hardware filters tracked per device when filters are
+ * offloaded by the router
+ */
+#define CAN_DEVICE_HW_FILTERS_MAX       (16)
+#endif
+
+#ifndef CAN_DEVICE_OFFLOAD_INTERVAL
+/**
+ * Number of received frames after which the hardware filters are updated
+ * when there are more filters than filter banks
+ */
+#define CAN_DEVICE_OFFLOAD_INTERVAL     (1024)
+#endif
+
 /**
  * @brief Parameters to initialize a candev
  */
@@ -81,6 +97,12 @@ typedef struct candev_dev {
     uint32_t last_pm_value;    /**< last pm timer value set */
     xtimer_t pm_timer;         /**< timer for power management */
 #endif
+#if defined(MODULE_CAN_ROUTER_OFFLOAD) || defined(DOXYGEN)
+    struct can_filter hw_filters[CAN_DEVICE_HW_FILTERS_MAX]; /**< filters set in the device */
+    uint8_t hw_filters_numof;  /**< number of filters set in the device */
+    uint8_t hw_banks;          /**< number of filter banks, 0 while all filters fit */
+    uint16_t rx_count;         /**< frames received since the last filter update */
+#endif
 } candev_dev_t;
 
 /**
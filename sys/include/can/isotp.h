@@ -27,10 +27,19 @@ extern "C" {
 
 #include "can/can.h"
 #include "can/common.h"
+#include "iolist.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "net/gnrc/pktbuf.h"
 
+#ifndef CAN_ISOTP_TX_WINDOW
+/**
+ * @brief Number of consecutive frames queued to the DLL at once when the
+ *        receiver allows a separation time of 0
+ */
+#define CAN_ISOTP_TX_WINDOW 4
+#endif
+
 
 /**
  * @brief The isotp_fc_options struct
@@ -70,12 +79,17 @@ struct isotp_options {
  * It describes the current connection status
  */
 struct tpcon {
-    unsigned idx;         /**< current index in @p buf */
+    unsigned idx;         /**< current index in the message */
+    unsigned len;         /**< length of the message */
     uint8_t state;        /**< the protocol state */
     uint8_t bs;           /**< block size */
     uint8_t sn;           /**< current sequence number */
     int tx_handle;        /**< handle of the last sent frame */
-    gnrc_pktsnip_t *snip; /**< allocated snip containing data buffer */
+    gnrc_pktsnip_t *snip; /**< allocated snip containing data buffer, NULL
+                               if the data is in user supplied buffers */
+    const iolist_t *iol;  /**< buffer at the current index */
+    unsigned iol_off;     /**< offset of the current index in @p iol */
+    iolist_t buf;         /**< list entry describing @p snip */
 };
 
 /**
@@ -95,6 +109,9 @@ struct isotp {
     can_reg_entry_t entry;         /**< entry containing ifnum and upper layer msg system */
     uint32_t tx_gap;               /**< transmit gap from fc (in us) */
     uint8_t tx_wft;                /**< transmit wait counter */
+    uint8_t tx_inflight;           /**< frames passed to the DLL, not confirmed yet */
+    int tx_handles[CAN_ISOTP_TX_WINDOW]; /**< handles of the frames in flight */
+    const iolist_t *rx_iol;        /**< user buffers for the next received message */
     void *arg;                     /**< upper layer private arg */
 };
 
@@ -108,6 +125,7 @@ struct isotp {
 #define CAN_ISOTP_TX_PADDING    0x0004     /**< enable CAN frame padding tx path */
 #define CAN_ISOTP_HALF_DUPLEX   0x0040     /**< half duplex error state handling */
 #define CAN_ISOTP_RX_EXT_ADDR   0x0200     /**< different rx extended addressing */
+#define CAN_ISOTP_RX_DYN_FC     0x0400     /**< adapt BS and STmin to the reception results */
 
 #define CAN_ISOTP_TX_FLAGS_MASK 0xFFFF0000 /**< tx flags mask */
 #define CAN_ISOTP_TX_DONT_WAIT  0x00010000 /**< do not send a tx confirmation msg */
@@ -151,6 +169,61 @@ kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *n
  */
 int isotp_send(struct isotp *isotp, const void *buf, int len, int flags);
 
+/**
+ * @brief Send data from a list of buffers through an isotp channel
+ *
+ * Contrary to isotp_send() the data is not copied, it is read from the
+ * buffers while the frames are built. The buffers must not be modified until
+ * the upper layer got the CAN_MSG_TX_CONFIRMATION or CAN_MSG_TX_ERROR message,
+ * therefore CAN_ISOTP_TX_DONT_WAIT can't be used.
+ *
+ * @param isotp           the channel to use
+ * @param iolist          the data to send
+ * @param flags           flags for sending
+ *
+ * @return the number of bytes sent
+ * @return < 0 if an error occured  (-EBUSY, -EINVAL)
+ */
+int isotp_send_iolist(struct isotp *isotp, const iolist_t *iolist, int flags);
+
+/**
+ * @brief Set the buffers to receive the next message into
+ *
+ * The next message is reassembled directly in the buffers of @p iolist. A
+ * message which does not fit is rejected, with an overflow flow control frame
+ * if it is a multi frame message. Once
+ * the message is complete, the buffers are released by the channel and the
+ * upper layer gets a CAN_MSG_RX_INDICATION whose can_rx_data_t::data has a
+ * NULL iov_base and the message length as iov_len. Messages received while no
+ * buffers are set are stored in the packet buffer as before.
+ *
+ * Calling this function with @p iolist set to NULL takes back buffers which
+ * were not used yet. A reception into these buffers which is in progress is
+ * aborted.
+ *
+ * @param isotp           the channel
+ * @param iolist          the buffers, NULL to take them back
+ *
+ * @return 0 on success
+ * @return -ENOENT if there were no buffers to take back, i.e. they were filled
+ *         and the CAN_MSG_RX_INDICATION for them is or will be delivered
+ */
+int isotp_set_rx_iolist(struct isotp *isotp, const iolist_t *iolist);
+
+/**
+ * @brief Set the flow control parameters announced to a sender
+ *
+ * They take effect with the next flow control frame. With the
+ * CAN_ISOTP_RX_DYN_FC flag set they are the starting point for the
+ * adaptation: every successfully received message increases the block size
+ * and decreases the separation time, a failed reception does the opposite.
+ *
+ * @param isotp           the channel
+ * @param bs              block size, 0 for no further flow control frames
+ * @param stmin           separation time, encoded as in the FC frame
+ */
+void isotp_set_rx_fc(struct isotp *isotp, uint8_t bs, uint8_t stmin);
+
 /**
  * @brief Bind an isotp channel
  *
@@ -181,7 +254,8 @@ int isotp_release(struct isotp *isotp);
 /**
  * @brief Free a received buffer
  *
- * This MUST be called by the upper layer when the received data are read
+ * This MUST be called by the upper layer when the received data are read,
+ * also for messages received into buffers set with isotp_set_rx_iolist()
  *
  * @param rx              the received data
  */
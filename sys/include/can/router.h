@@ -29,6 +29,14 @@ extern "C" {
 #include "can/can.h"
 #include "can/pkt.h"
 
+#ifndef CAN_ROUTER_BUCKETS
+/**
+ * Number of hash buckets per interface for filters matching on the whole
+ * standard ID, must be a power of two
+ */
+#define CAN_ROUTER_BUCKETS  (16)
+#endif
+
 /**
  * @brief Register a user @p entry to receive a frame @p can_id
  *
@@ -106,6 +114,28 @@ int can_router_dispatch_tx_conf(can_pkt_t *pkt);
  */
 int can_router_dispatch_tx_error(can_pkt_t *pkt);
 
+#if defined(MODULE_CAN_ROUTER_OFFLOAD) || defined(DOXYGEN)
+/**
+ * @brief Compute the filters to program into the hardware of an interface
+ *
+ * If all registered filters fit into @p max filter banks, they are all
+ * returned. Otherwise the @p max - 1 filters which matched most frames since
+ * the last call are returned, followed by one filter which covers all the
+ * remaining ones. Frames passing this wider filter are sorted out by the
+ * router.
+ *
+ * The match counters are halved on every call, so the selection follows
+ * changes of the bus traffic.
+ *
+ * @param[in]  ifnum    the interface number
+ * @param[out] filters  the filters to set
+ * @param[in]  max      the number of filter banks of the interface
+ *
+ * @return the number of filters written to @p filters
+ */
+size_t can_router_hw_filters(int ifnum, struct can_filter *filters, size_t max);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
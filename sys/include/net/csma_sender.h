@@ -13,6 +13,13 @@
  * @brief       This interface allows code from layer 2 (MAC) or higher
  *              to send packets with CSMA/CA, whatever the abilities and/or
  *              configuration of a given radio transceiver device are.
+ *
+ * With the `csma_sender_async` module frames can also be sent
+ * asynchronously: they are put into a per-device send queue and the backoffs
+ * are timed with @ref sys_xtimer messages to the thread owning the device,
+ * so the thread can keep handling other events. After a successful CCA all
+ * queued frames up to @ref CSMA_SENDER_BURST_MAX are sent back-to-back, which
+ * e.g. sends the fragments of a 6LoWPAN datagram in a burst.
  * @{
  *
  * @file
@@ -28,6 +35,11 @@
 #include <stdint.h>
 
 #include "net/netdev.h"
+#ifdef MODULE_CSMA_SENDER_ASYNC
+#include "kernel_types.h"
+#include "msg.h"
+#include "xtimer.h"
+#endif
 
 
 #ifdef __cplusplus
@@ -63,6 +75,33 @@ extern "C" {
 #define CSMA_SENDER_BACKOFF_PERIOD_UNIT     (320U)
 #endif
 
+/**
+ * @brief   Number of frames that can be queued with
+ *          @ref csma_sender_queue()
+ */
+#ifndef CSMA_SENDER_QUEUE_SIZE
+#define CSMA_SENDER_QUEUE_SIZE              (4U)
+#endif
+
+/**
+ * @brief   Maximum number of queued frames sent after one successful CCA
+ */
+#ifndef CSMA_SENDER_BURST_MAX
+#define CSMA_SENDER_BURST_MAX               (4U)
+#endif
+
+/**
+ * @brief   Message type of the backoff timer of @ref csma_sender_t
+ *
+ * A message of this type must be handed to @ref csma_sender_handle_msg().
+ */
+#define CSMA_SENDER_MSG_TYPE_BACKOFF        (0x0350)
+
+/**
+ * @brief   Number of entries in csma_sender_stats_t::busy
+ */
+#define CSMA_SENDER_STATS_BUSY_NUMOF        (CSMA_SENDER_MAX_BACKOFFS_DEFAULT + 2)
+
 /**
  * @brief   Configuration type for backoff
  */
@@ -133,6 +172,116 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
  */
 int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist);
 
+#if defined(MODULE_CSMA_SENDER_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Channel access statistics of @ref csma_sender_t
+ */
+typedef struct {
+    uint32_t cca;               /**< CCAs done */
+    uint32_t cca_busy;          /**< CCAs that found the medium busy */
+    uint32_t tx;                /**< frames sent */
+    uint32_t tx_burst;          /**< frames sent right after another one
+                                 *   without a CCA of their own */
+    uint32_t tx_failed;         /**< frames dropped, because the medium
+                                 *   never was available */
+    uint32_t queue_full;        /**< frames not queued, because the queue
+                                 *   was full */
+    /**
+     * @brief   Channel accesses by the number of busy CCAs before it
+     *
+     * The last entry counts all channel accesses with more busy CCAs,
+     * including the failed ones.
+     */
+    uint32_t busy[CSMA_SENDER_STATS_BUSY_NUMOF];
+} csma_sender_stats_t;
+
+/**
+ * @brief   Forward declaration for @ref csma_sender_cb_t
+ */
+typedef struct csma_sender csma_sender_t;
+
+/**
+ * @brief   Called for each queued frame after it was sent or dropped
+ *
+ * @param[in] csma      The CSMA/CA sender.
+ * @param[in] iolist    The frame as given to @ref csma_sender_queue().
+ * @param[in] res       Return value of the device driver's
+ *                      netdev_driver_t::send() function, -EBUSY if the
+ *                      medium never was available, or -ECANCELED on an
+ *                      internal driver error.
+ */
+typedef void (*csma_sender_cb_t)(csma_sender_t *csma, iolist_t *iolist,
+                                 int res);
+
+/**
+ * @brief   Asynchronous CSMA/CA sender of a device
+ */
+struct csma_sender {
+    netdev_t *dev;                      /**< the device */
+    const csma_sender_conf_t *conf;     /**< configuration for the backoff */
+    csma_sender_cb_t cb;                /**< called for sent frames */
+    xtimer_t timer;                     /**< backoff timer */
+    msg_t msg;                          /**< message of the backoff timer */
+    kernel_pid_t pid;                   /**< thread owning the device */
+    /**
+     * @brief   Queued frames, csma_sender_t::queue[csma_sender_t::head] is
+     *          sent next
+     */
+    iolist_t *queue[CSMA_SENDER_QUEUE_SIZE];
+    uint8_t head;                       /**< first queued frame */
+    uint8_t len;                        /**< number of queued frames */
+    uint8_t nb;                         /**< busy CCAs for the first frame */
+    uint8_t be;                         /**< current backoff exponent */
+    /**
+     * @brief   Frames sent back to back before the current one within the
+     *          same channel access, valid in csma_sender_t::cb
+     */
+    uint8_t burst;
+    csma_sender_stats_t stats;          /**< channel access statistics */
+};
+
+/**
+ * @brief   Initializes an asynchronous CSMA/CA sender
+ *
+ * Must be called by the thread owning @p dev, which then receives the
+ * messages of type @ref CSMA_SENDER_MSG_TYPE_BACKOFF.
+ *
+ * @param[out] csma     The CSMA/CA sender.
+ * @param[in] dev       netdev device, needs to be already initialized
+ * @param[in] conf      configuration for the backoff;
+ *                      will be set to @ref CSMA_SENDER_CONF_DEFAULT if NULL.
+ * @param[in] cb        Called for each frame after it was sent or dropped.
+ */
+void csma_sender_init(csma_sender_t *csma, netdev_t *dev,
+                      const csma_sender_conf_t *conf, csma_sender_cb_t cb);
+
+/**
+ * @brief   Queues a frame to send it with the CSMA/CA method
+ *
+ * If the transceiver does CSMA/CA in hardware, the frame is sent right away.
+ * The frame must stay valid until csma_sender_t::cb was called for it.
+ *
+ * @pre `csma != NULL && iolist != NULL`
+ *
+ * @param[in] csma      The CSMA/CA sender.
+ * @param[in] iolist    The frame.
+ *
+ * @return  0, if the frame was queued.
+ * @return  -ENOBUFS, if the queue is full.
+ */
+int csma_sender_queue(csma_sender_t *csma, iolist_t *iolist);
+
+/**
+ * @brief   Handles a message of type @ref CSMA_SENDER_MSG_TYPE_BACKOFF
+ *
+ * Does the CCA after a backoff and sends the queued frames if the medium is
+ * available.
+ *
+ * @param[in] msg   The message.
+ */
+void csma_sender_handle_msg(msg_t *msg);
+#endif /* defined(MODULE_CSMA_SENDER_ASYNC) || defined(DOXYGEN) */
+
 
 #ifdef __cplusplus
 }
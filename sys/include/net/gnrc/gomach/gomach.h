@@ -123,6 +123,20 @@ extern "C" {
 #define GNRC_GOMACH_CP_DURATION_MAX_US        (5LU * GNRC_GOMACH_CP_DURATION_US)
 #endif
 
+/**
+ * @brief Maximum exponent of the adaptive wake-up period.
+ *
+ * With the `gnrc_mac_dutycycle` module (see @ref net_gnrc_mac_dutycycle),
+ * GoMacH keeps its cycle of @ref GNRC_GOMACH_SUPERFRAME_DURATION_US, which
+ * its vTDMA slots and the senders' phase-locking rely on, and extends its WP
+ * to @ref GNRC_GOMACH_CP_DURATION_US << exp under load instead, up to
+ * @ref GNRC_GOMACH_CP_DURATION_MAX_US. The wake-up period and latency
+ * estimates of the controller do not apply to GoMacH.
+ */
+#ifndef GNRC_GOMACH_CP_EXP_MAX
+#define GNRC_GOMACH_CP_EXP_MAX        (2U)
+#endif
+
 /**
  * @brief The maximum time for waiting the receiver's beacon in GoMacH.
  *
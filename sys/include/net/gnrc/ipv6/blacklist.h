@@ -11,6 +11,11 @@
  * @defgroup    net_gnrc_ipv6_blacklist IPv6 address blacklist
  * @ingroup     net_gnrc_ipv6
  * @brief       This refuses IPv6 addresses that are defined in this list.
+ *
+ * Entries can be single addresses or prefixes. The list is kept in a
+ * @ref net_ipv6_lpm "prefix set", so checking an address takes about the
+ * same time for thousands of entries as for a few, as long as they use only
+ * a few different prefix lengths. Every entry counts the packets it matched.
  * @{
  *
  * @file
@@ -23,6 +28,7 @@
 #define NET_GNRC_IPV6_BLACKLIST_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "net/ipv6/addr.h"
 
@@ -32,6 +38,8 @@ extern "C" {
 
 /**
  * Maximum size of the blacklist.
+ *
+ * @note    Must be a power of 2. The blacklist should be at most 3/4 full.
  */
 #ifndef GNRC_IPV6_BLACKLIST_SIZE
 #define GNRC_IPV6_BLACKLIST_SIZE    (8)
@@ -59,6 +67,9 @@ void gnrc_ipv6_blacklist_del(const ipv6_addr_t *addr);
 /**
  * @brief   Checks if an IPv6 address is blacklisted.
  *
+ * An address is blacklisted, if it matches one of the prefixes in the
+ * blacklist. The hit counter of the longest matching prefix is incremented.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  true, if @p addr is blacklisted.
@@ -67,7 +78,30 @@ void gnrc_ipv6_blacklist_del(const ipv6_addr_t *addr);
 bool gnrc_ipv6_blacklisted(const ipv6_addr_t *addr);
 
 /**
- * @brief   Prints the blacklist.
+ * @brief   Adds an IPv6 prefix to the blacklist.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ *
+ * @return  0, on success.
+ * @return  -1, if blacklist is full or @p prefix_len is greater than 128.
+ */
+int gnrc_ipv6_blacklist_add_prefix(const ipv6_addr_t *prefix,
+                                   uint8_t prefix_len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the blacklist.
+ *
+ * Prefixes not in the blacklist will be ignored.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ */
+void gnrc_ipv6_blacklist_del_prefix(const ipv6_addr_t *prefix,
+                                    uint8_t prefix_len);
+
+/**
+ * @brief   Prints the blacklist with the number of matched packets per entry.
  */
 void gnrc_ipv6_blacklist_print(void);
 
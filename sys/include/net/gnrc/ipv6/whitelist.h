@@ -10,6 +10,11 @@
  * @defgroup    net_gnrc_ipv6_whitelist IPv6 address whitelist
  * @ingroup     net_gnrc_ipv6
  * @brief       This allows you to only accept IPv6 addresses that are defined in this list.
+ *
+ * Entries can be single addresses or prefixes. The list is kept in a
+ * @ref net_ipv6_lpm "prefix set", so checking an address takes about the
+ * same time for thousands of entries as for a few, as long as they use only
+ * a few different prefix lengths. Every entry counts the packets it matched.
  * @{
  *
  * @file
@@ -21,6 +26,7 @@
 #define NET_GNRC_IPV6_WHITELIST_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "net/ipv6/addr.h"
 
@@ -30,6 +36,8 @@ extern "C" {
 
 /**
  * Maximum size of the whitelist.
+ *
+ * @note    Must be a power of 2. The whitelist should be at most 3/4 full.
  */
 #ifndef GNRC_IPV6_WHITELIST_SIZE
 #define GNRC_IPV6_WHITELIST_SIZE    (8)
@@ -57,6 +65,9 @@ void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr);
 /**
  * @brief   Checks if an IPv6 address is whitelisted.
  *
+ * An address is whitelisted, if it matches one of the prefixes in the
+ * whitelist. The hit counter of the longest matching prefix is incremented.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  true, if @p addr is whitelisted.
@@ -65,7 +76,30 @@ void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr);
 bool gnrc_ipv6_whitelisted(const ipv6_addr_t *addr);
 
 /**
- * @brief   Prints the whitelist.
+ * @brief   Adds an IPv6 prefix to the whitelist.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ *
+ * @return  0, on success.
+ * @return  -1, if whitelist is full or @p prefix_len is greater than 128.
+ */
+int gnrc_ipv6_whitelist_add_prefix(const ipv6_addr_t *prefix,
+                                   uint8_t prefix_len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the whitelist.
+ *
+ * Prefixes not in the whitelist will be ignored.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ */
+void gnrc_ipv6_whitelist_del_prefix(const ipv6_addr_t *prefix,
+                                    uint8_t prefix_len);
+
+/**
+ * @brief   Prints the whitelist with the number of matched packets per entry.
  */
 void gnrc_ipv6_whitelist_print(void);
 
@@ -148,6 +148,20 @@ extern "C" {
 #define GNRC_LWMAC_WAKEUP_DURATION_US        (GNRC_LWMAC_TIME_BETWEEN_WR_US * 2)
 #endif
 
+/**
+ * @brief Maximum exponent of the adaptive wake-up interval.
+ *
+ * With the `gnrc_mac_dutycycle` module, a receiver shortens its wake-up
+ * interval down to @ref GNRC_LWMAC_WAKEUP_INTERVAL_US >> this value under
+ * load (see @ref net_gnrc_mac_dutycycle). The shortest interval must stay
+ * well above @ref GNRC_LWMAC_WAKEUP_DURATION_US, at least 4 times by default.
+ * As the receiver announces its interval in its WA frames, all nodes of a
+ * network must either use the module or not.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_EXP_MAX
+#define GNRC_LWMAC_WAKEUP_EXP_MAX            (2U)
+#endif
+
 /**
  * @brief How long broadcast packets @ref gnrc_lwmac_frame_broadcast_t will be sent to make sure
  *        every participant has received at least one copy.
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_mac_dutycycle Adaptive duty cycle
+ * @ingroup     net_gnrc_mac
+ * @brief       Traffic-adaptive wake-up period for duty-cycled MAC protocols
+ *
+ * The controller is shared by @ref net_gnrc_lwmac and @ref net_gnrc_gomach
+ * and is enabled with the `gnrc_mac_dutycycle` module. It shortens the
+ * wake-up period of a receiver from a base period `base_us` to
+ * `base_us >> exp` for `0 <= exp <= exp_max`:
+ *
+ * - the number of received frames per base period is averaged. `exp` is
+ *   raised until at most about one frame arrives per wake-up,
+ * - while there is traffic, `exp` is raised until half the period, the
+ *   expected wait of a sender for the receiver to wake up, meets the
+ *   latency target,
+ * - a sender reporting more pending frames (backlog) raises `exp` by one.
+ *
+ * `exp` changes by at most one per base period, so the period follows
+ * bursts quickly but falls back to the base period one step at a time.
+ * An @ref net_gnrc_lwmac receiver tells its senders `exp` in its WA frames,
+ * so senders know the period of each neighbor. @ref net_gnrc_gomach, whose
+ * cycle is fixed by its slot schedule, lengthens its wake-up period by
+ * `1 << exp` instead (see @ref GNRC_GOMACH_CP_EXP_MAX).
+ *
+ * Radio on-time and transmission latency are accounted as well, the
+ * resulting duty cycle, latency and energy estimates are available with
+ * @ref NETSTATS_DUTYCYCLE and are shown by `ifconfig <if> stats`.
+ *
+ * All times are in microseconds and may wrap around.
+ * @{
+ *
+ * @file
+ * @brief   Adaptive duty cycle definitions
+ */
+#ifndef NET_GNRC_MAC_DUTYCYCLE_H
+#define NET_GNRC_MAC_DUTYCYCLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default latency target in microseconds
+ *
+ * Set to 0 to adapt to the load only.
+ */
+#ifndef GNRC_MAC_DUTYCYCLE_LATENCY_US
+#define GNRC_MAC_DUTYCYCLE_LATENCY_US   (50000U)
+#endif
+
+/**
+ * @brief   Power draw of the radio when on in milliwatts, for the energy
+ *          estimate
+ */
+#ifndef GNRC_MAC_DUTYCYCLE_RADIO_MW
+#define GNRC_MAC_DUTYCYCLE_RADIO_MW     (60U)
+#endif
+
+/**
+ * @brief   Fixed point shift of @ref gnrc_mac_dutycycle_t::load
+ */
+#define GNRC_MAC_DUTYCYCLE_LOAD_SHIFT   (4U)
+
+/**
+ * @brief   State of the controller
+ */
+typedef struct {
+    uint64_t on_us;             /**< accumulated radio on-time */
+    uint64_t total_us;          /**< accumulated time since init */
+    uint32_t last;              /**< time up to which the times are accounted */
+    uint32_t base_us;           /**< base (longest) wake-up period */
+    uint32_t latency_target_us; /**< latency target, 0 for none */
+    uint32_t tx_start;          /**< start of the current transmission */
+    uint32_t tx_latency_us;     /**< average transmission latency */
+    uint32_t updated;           /**< time of the last adaptation */
+    uint16_t load;              /**< average frames per base period, fixed
+                                 *   point with @ref
+                                 *   GNRC_MAC_DUTYCYCLE_LOAD_SHIFT */
+    uint16_t rx;                /**< frames received in this base period */
+    uint8_t exp;                /**< wake-up period is base_us >> exp */
+    uint8_t exp_max;            /**< maximum of exp */
+    bool backlog;               /**< a sender reported pending frames */
+    bool radio_on;              /**< radio is on */
+} gnrc_mac_dutycycle_t;
+
+/**
+ * @brief   Estimates derived from @ref gnrc_mac_dutycycle_t
+ */
+typedef struct {
+    uint64_t energy_uj;         /**< radio energy since init */
+    uint32_t period_us;         /**< current wake-up period */
+    uint32_t latency_us;        /**< expected wait for a wake-up (period/2) */
+    uint32_t tx_latency_us;     /**< measured average transmission latency */
+    uint16_t duty_cycle;        /**< radio duty cycle in per mille */
+    uint16_t load;              /**< average frames per base period * 100 */
+} gnrc_mac_dutycycle_stats_t;
+
+/**
+ * @brief   Initializes the controller
+ *
+ * @param[out] dc               The controller
+ * @param[in] now               The current time
+ * @param[in] base_us           The base (longest) wake-up period
+ * @param[in] exp_max           Maximum exponent, the shortest period is
+ *                              `base_us >> exp_max`
+ * @param[in] latency_target_us The latency target, 0 for none
+ */
+void gnrc_mac_dutycycle_init(gnrc_mac_dutycycle_t *dc, uint32_t now,
+                             uint32_t base_us, uint8_t exp_max,
+                             uint32_t latency_target_us);
+
+/**
+ * @brief   Reports a received data frame
+ *
+ * @param[in,out] dc    The controller
+ * @param[in] pending   The sender has more frames pending
+ */
+static inline void gnrc_mac_dutycycle_rx(gnrc_mac_dutycycle_t *dc,
+                                         bool pending)
+{
+    dc->rx++;
+    dc->backlog |= pending;
+}
+
+/**
+ * @brief   Reports the start of a transmission, i.e. when a frame is taken
+ *          from the queue
+ *
+ * @param[in,out] dc    The controller
+ * @param[in] now       The current time
+ */
+static inline void gnrc_mac_dutycycle_tx_start(gnrc_mac_dutycycle_t *dc,
+                                               uint32_t now)
+{
+    dc->tx_start = now;
+}
+
+/**
+ * @brief   Reports the end of a transmission
+ *
+ * @param[in,out] dc    The controller
+ * @param[in] now       The current time
+ * @param[in] success   The frame was delivered, only then the latency is
+ *                      accounted
+ */
+void gnrc_mac_dutycycle_tx_done(gnrc_mac_dutycycle_t *dc, uint32_t now,
+                                bool success);
+
+/**
+ * @brief   Reports the radio being turned on or off
+ *
+ * @param[in,out] dc    The controller
+ * @param[in] now       The current time
+ * @param[in] on        The radio is on
+ */
+void gnrc_mac_dutycycle_radio(gnrc_mac_dutycycle_t *dc, uint32_t now, bool on);
+
+/**
+ * @brief   Adapts the wake-up period, to be called once per base period
+ *
+ * @param[in,out] dc    The controller
+ *
+ * @return  The new exponent, the wake-up period is `base_us >> exp`
+ */
+uint8_t gnrc_mac_dutycycle_update(gnrc_mac_dutycycle_t *dc);
+
+/**
+ * @brief   Reports a wake-up of the receiver, adapts the wake-up period once
+ *          per base period
+ *
+ * For protocols that wake up every period, instead of calling
+ * @ref gnrc_mac_dutycycle_update() from a timer of their own.
+ *
+ * @param[in,out] dc    The controller
+ * @param[in] now       The current time
+ *
+ * @return  The exponent for the next wake-up period
+ */
+uint8_t gnrc_mac_dutycycle_wakeup(gnrc_mac_dutycycle_t *dc, uint32_t now);
+
+/**
+ * @brief   Gets the current wake-up period
+ *
+ * @param[in] dc    The controller
+ *
+ * @return  The wake-up period in microseconds
+ */
+static inline uint32_t gnrc_mac_dutycycle_period(const gnrc_mac_dutycycle_t *dc)
+{
+    return dc->base_us >> dc->exp;
+}
+
+/**
+ * @brief   Gets the duty cycle, latency and energy estimates
+ *
+ * @param[in] dc        The controller
+ * @param[in] now       The current time
+ * @param[out] stats    The estimates
+ */
+void gnrc_mac_dutycycle_get_stats(const gnrc_mac_dutycycle_t *dc,
+                                  uint32_t now,
+                                  gnrc_mac_dutycycle_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_MAC_DUTYCYCLE_H */
+/** @} */
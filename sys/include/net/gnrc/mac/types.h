@@ -35,6 +35,9 @@
 #ifdef MODULE_GNRC_GOMACH
 #include "net/gnrc/gomach/types.h"
 #endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -123,6 +126,11 @@ typedef struct {
     uint8_t l2_addr[IEEE802154_LONG_ADDRESS_LEN];       /**< Address of neighbor node */
     uint8_t l2_addr_len;                                /**< Neighbor address length */
     uint32_t phase;                                     /**< Neighbor's wake-up Phase */
+#if defined(MODULE_GNRC_MAC_DUTYCYCLE) || defined(DOXYGEN)
+    uint8_t wakeup_exp;                                 /**< Exponent of neighbor's
+                                                         *   adaptive wake-up
+                                                         *   interval */
+#endif
 
 #if (GNRC_MAC_TX_QUEUE_SIZE != 0) || defined(DOXYGEN)
     gnrc_priority_pktqueue_t queue;                  /**< TX queue for this particular Neighbor */
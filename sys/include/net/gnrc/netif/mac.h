@@ -20,6 +20,9 @@
 
 #include "net/gnrc/mac/types.h"
 #include "net/csma_sender.h"
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+#include "net/gnrc/mac/dutycycle.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,7 +48,8 @@ extern "C" {
  */
 #define GNRC_NETIF_MAC_INFO_CSMA_ENABLED       (0x0100U)
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
 /**
  * @brief Data type to hold MAC protocols
  */
@@ -63,6 +67,14 @@ typedef union {
      */
     gnrc_gomach_t gomach;
 #endif
+
+#ifdef MODULE_GNRC_TSCH
+    /**
+     * @brief Slotframe MAC specific structure object for storing its schedule
+     *        and synchronization state.
+     */
+    gnrc_tsch_t tsch;
+#endif
 } gnrc_mac_prot_t;
 #endif
 
@@ -80,6 +92,16 @@ typedef struct {
      */
     csma_sender_conf_t csma_conf;
 
+#if defined(MODULE_CSMA_SENDER_ASYNC) || DOXYGEN
+    /**
+     * @brief   Asynchronous software CSMA/CA sender with its send queue
+     *
+     * @note    Only available with the `csma_sender_async` module and only
+     *          used by IEEE 802.15.4 interfaces.
+     */
+    csma_sender_t csma;
+#endif
+
 #if ((GNRC_MAC_RX_QUEUE_SIZE != 0) || (GNRC_MAC_DISPATCH_BUFFER_SIZE != 0)) || DOXYGEN
     /**
      * @brief MAC internal object which stores reception parameters, queues, and
@@ -101,7 +123,18 @@ typedef struct {
     gnrc_mac_tx_t tx;
 #endif  /* ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0)) || DOXYGEN */
 
-#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
+#if defined(MODULE_GNRC_MAC_DUTYCYCLE) || DOXYGEN
+    /**
+     * @brief   Adaptive duty cycle controller
+     *
+     * @note    Only available with the `gnrc_mac_dutycycle` module and only
+     *          used by duty-cycled MAC protocols.
+     */
+    gnrc_mac_dutycycle_t dutycycle;
+#endif
+
+#if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH) || \
+    defined(MODULE_GNRC_TSCH)
     gnrc_mac_prot_t prot;
 #endif
 } gnrc_netif_mac_t;
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktcap Packet capture
+ * @ingroup     net_gnrc
+ * @brief       Capture the frames of all GNRC interfaces to a pcapng file
+ *
+ * The link layers of @ref net_gnrc_netif copy every frame they receive or
+ * pass to the device into a ring buffer, together with the interface, the
+ * direction and a timestamp. Reserving space in the ring takes no lock, so
+ * interfaces of any priority capture without waiting for each other or for
+ * the output. A thread of lower priority than the interfaces writes the
+ * frames as pcapng Enhanced Packet Blocks to a sink, e.g. a file of @ref
+ * sys_vfs. Each interface gets its own Interface Description Block, so
+ * IEEE 802.15.4 (`LINKTYPE_IEEE802_15_4_NOFCS`) and Ethernet interfaces end
+ * up in the same file. Frames that do not fit into the ring are dropped and
+ * counted.
+ *
+ * The timestamps are the time since boot as given by @ref sys_xtimer.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet capture definitions
+ */
+
+#ifndef NET_GNRC_PKTCAP_H
+#define NET_GNRC_PKTCAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "iolist.h"
+#include "kernel_types.h"
+#include "net/gnrc/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer between the interfaces and the writer
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef GNRC_PKTCAP_BUF_SIZE
+#define GNRC_PKTCAP_BUF_SIZE        (4096U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes captured of a frame
+ *
+ * Longer frames are truncated. A frame must not take more than half of the
+ * ring buffer.
+ */
+#ifndef GNRC_PKTCAP_SNAPLEN
+#define GNRC_PKTCAP_SNAPLEN         (1536U)
+#endif
+
+/**
+ * @brief   Size of the buffer the writer collects blocks in before
+ *          passing them to the sink
+ */
+#ifndef GNRC_PKTCAP_WRITE_BUF_SIZE
+#define GNRC_PKTCAP_WRITE_BUF_SIZE  (512U)
+#endif
+
+/**
+ * @brief   Priority of the writer thread
+ *
+ * Lower than all interfaces, so writing never delays the datapath.
+ */
+#ifndef GNRC_PKTCAP_PRIO
+#define GNRC_PKTCAP_PRIO            (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the writer thread
+ */
+#ifndef GNRC_PKTCAP_STACKSIZE
+#define GNRC_PKTCAP_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Output of a capture
+ */
+typedef struct {
+    /**
+     * @brief   Writes @p len bytes of @p data
+     *
+     * @return  @p len on success
+     * @return  negative errno on error, the capture stops
+     */
+    ssize_t (*write)(void *arg, const void *data, size_t len);
+    /**
+     * @brief   Called when the capture stopped, may be NULL
+     */
+    void (*close)(void *arg);
+    void *arg;      /**< argument of the callbacks */
+} gnrc_pktcap_sink_t;
+
+/**
+ * @brief   Statistics of the current or last capture
+ */
+typedef struct {
+    uint32_t frames;    /**< frames written */
+    uint32_t bytes;     /**< bytes written, including the pcapng blocks */
+    uint32_t dropped;   /**< frames dropped as the ring buffer was full */
+} gnrc_pktcap_stats_t;
+
+/**
+ * @brief   Start the writer thread
+ *
+ * Called by auto_init.
+ *
+ * @return  PID of the writer thread
+ * @return  negative value on error
+ */
+kernel_pid_t gnrc_pktcap_init(void);
+
+/**
+ * @brief   Start capturing to a sink
+ *
+ * @param[in] sink  output of the capture, is copied
+ *
+ * @return  0 on success
+ * @return  -EALREADY if a capture is running
+ * @return  -ENOTCONN if the writer thread was not started
+ */
+int gnrc_pktcap_start(const gnrc_pktcap_sink_t *sink);
+
+/**
+ * @brief   Start capturing to a file of @ref sys_vfs
+ *
+ * The file is created or truncated.
+ *
+ * @param[in] path  path of the file
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int gnrc_pktcap_start_vfs(const char *path);
+
+/**
+ * @brief   Stop capturing, write the remaining frames and close the sink
+ *
+ * Blocks until the writer thread closed the sink. Must not be called by an
+ * interface.
+ */
+void gnrc_pktcap_stop(void);
+
+/**
+ * @brief   Check if frames are captured
+ *
+ * @return  0 if no capture was started, it was stopped or writing failed
+ */
+int gnrc_pktcap_running(void);
+
+/**
+ * @brief   Get the statistics of the current or last capture
+ *
+ * @param[out] stats    the statistics
+ */
+void gnrc_pktcap_get_stats(gnrc_pktcap_stats_t *stats);
+
+/**
+ * @brief   Capture a received frame
+ *
+ * Called by the link layers of @ref net_gnrc_netif.
+ *
+ * @param[in] netif     interface the frame was received on
+ * @param[in] frame     the frame, including the link-layer header
+ * @param[in] len       length of @p frame
+ */
+void gnrc_pktcap_rx(const gnrc_netif_t *netif, const void *frame, size_t len);
+
+/**
+ * @brief   Capture a frame passed to the device
+ *
+ * Called by the link layers of @ref net_gnrc_netif.
+ *
+ * @param[in] netif     interface the frame is sent on
+ * @param[in] iolist    the frame, including the link-layer header
+ */
+void gnrc_pktcap_tx(const gnrc_netif_t *netif, const iolist_t *iolist);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTCAP_H */
+/** @} */
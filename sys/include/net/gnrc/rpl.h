@@ -175,13 +175,21 @@ extern "C" {
 
 /**
  * @brief   Default minimum hop rank increase
+ *
+ * With @ref net_gnrc_rpl_mrhof it equals an ETX of 1, so links up to that
+ * quality are distinguished by the rank.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc6550#section-17">
  *          RFC 6550, section 17
  *      </a>
  */
 #ifndef GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE (128)
+#else
 #define GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE (256)
 #endif
+#endif
 
 /**
  * @brief   Maximum rank increase
@@ -193,12 +201,20 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @brief   Default Objective Code Point (OF0, MRHOF with @ref net_gnrc_rpl_mrhof)
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_DEFAULT_OCP (1)
+#else
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -216,10 +232,14 @@ extern "C" {
 #define GNRC_RPL_MOP_STORING_MODE_NO_MC  (0x02)
 #define GNRC_RPL_MOP_STORING_MODE_MC     (0x03)
 
-/** default MOP set on compile time */
+/** default MOP set on compile time, non-storing mode with @ref net_gnrc_rpl_sr */
 #ifndef GNRC_RPL_DEFAULT_MOP
+#ifdef MODULE_GNRC_RPL_SR
+#define GNRC_RPL_DEFAULT_MOP GNRC_RPL_MOP_NON_STORING_MODE
+#else
 #define GNRC_RPL_DEFAULT_MOP GNRC_RPL_MOP_STORING_MODE_NO_MC
 #endif
+#endif
 /** @} */
 
 /**
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof Minimum Rank with Hysteresis OF
+ * @ingroup     net_gnrc_rpl
+ * @brief       MRHOF with the ETX metric
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ *
+ * The path cost through a parent is the rank of the parent plus the ETX of
+ * the link to it. The ETX is taken from the @ref net_netstats_neighbor
+ * statistics of the interface, so it reflects the acknowledgments and
+ * retransmissions of the frames sent to the parent. A new preferred parent is
+ * only selected if its path cost is lower by more than
+ * @ref GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ *
+ * If the module is used, MRHOF is the default objective function of new
+ * DODAGs. Nodes use the objective function advertised by the root.
+ *
+ * @{
+ *
+ * @file
+ * @brief       MRHOF definitions
+ */
+#ifndef NET_GNRC_RPL_MRHOF_H
+#define NET_GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective code point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (0x1)
+
+/**
+ * @brief   Links with a higher ETX are not used, default ETX 4
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512U)
+#endif
+
+/**
+ * @brief   Parents with a higher path cost are not used
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_PATH_COST
+#define GNRC_RPL_MRHOF_MAX_PATH_COST            (32768U)
+#endif
+
+/**
+ * @brief   Difference in path cost needed to switch the parent, default ETX 1.5
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192U)
+#endif
+
+/**
+ * @brief   ETX of a link without statistics, default ETX 2
+ *
+ * Used until the first frame to the parent was acknowledged or lost.
+ */
+#ifndef GNRC_RPL_MRHOF_DEFAULT_ETX
+#define GNRC_RPL_MRHOF_DEFAULT_ETX              (256U)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_MRHOF_H */
+/** @} */
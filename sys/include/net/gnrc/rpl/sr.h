@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_sr RPL non-storing mode source routes
+ * @ingroup     net_gnrc_rpl
+ * @brief       Downward routes of a non-storing mode DODAG root
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7, Non-Storing Mode
+ *      </a>
+ *
+ * In non-storing mode every node reports its parent to the DODAG root in the
+ * transit option of its DAO. The root keeps these parent relations and adds
+ * an RPL source routing header (@ref net_gnrc_rpl_srh) to the packets it
+ * sends down the DODAG.
+ *
+ * Nodes are stored by the interface identifier of their address, all
+ * addresses are expected to share the /64 prefix of the DODAG ID. The parent
+ * is an index into the same table, so an entry takes 14 bytes independent of
+ * the depth of the DODAG. Entries are found by a hash of the interface
+ * identifier, a route is collected by following the parent indexes, i.e. in
+ * O(depth).
+ *
+ * Until @ref gnrc_rpl_sr_init() was called the table stays empty, i.e. on
+ * nodes which are not the root of a non-storing DODAG.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Source route table definitions
+ */
+#ifndef NET_GNRC_RPL_SR_H
+#define NET_GNRC_RPL_SR_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/eui64.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of nodes in the table
+ */
+#ifndef GNRC_RPL_SR_NUMOF
+#define GNRC_RPL_SR_NUMOF           (64U)
+#endif
+
+/**
+ * @brief   Number of hash buckets, must be a power of 2
+ */
+#ifndef GNRC_RPL_SR_BUCKETS
+#define GNRC_RPL_SR_BUCKETS         (16U)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route
+ *
+ * Longer routes, e.g. due to a loop in the reported parents, are not used.
+ */
+#ifndef GNRC_RPL_SR_MAX_DEPTH
+#define GNRC_RPL_SR_MAX_DEPTH       (16U)
+#endif
+
+/**
+ * @brief   Lifetime of an entry which does not expire
+ */
+#define GNRC_RPL_SR_LIFETIME_INF    (UINT16_MAX)
+
+/**
+ * @brief   A node of the DODAG
+ */
+typedef struct {
+    eui64_t iid;            /**< interface identifier of the node */
+    uint16_t parent;        /**< index of the parent */
+    uint16_t next;          /**< next entry in the hash bucket */
+    uint16_t lifetime;      /**< remaining lifetime in seconds */
+} gnrc_rpl_sr_entry_t;
+
+/**
+ * @brief   Reset the table for a DODAG
+ *
+ * Called by @ref gnrc_rpl_root_init() if the DODAG is in non-storing mode.
+ *
+ * @param[in] dodag_id  the DODAG ID, i.e. the address of the root
+ * @param[in] iface     interface of the DODAG
+ */
+void gnrc_rpl_sr_init(const ipv6_addr_t *dodag_id, kernel_pid_t iface);
+
+/**
+ * @brief   Add or update the parent of a node
+ *
+ * A parent which is not in the table yet is added as well, with an unknown
+ * route, until its own DAO is received.
+ *
+ * @param[in] target    address of the node
+ * @param[in] parent    address of its parent
+ * @param[in] lifetime  lifetime in seconds, 0 removes @p target
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if an address is not in the prefix of the DODAG ID
+ * @return  -ENOMEM, if the table is full
+ */
+int gnrc_rpl_sr_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                    uint16_t lifetime);
+
+/**
+ * @brief   Remove a node
+ *
+ * Routes through the node become unknown.
+ *
+ * @param[in] target    address of the node
+ */
+void gnrc_rpl_sr_del(const ipv6_addr_t *target);
+
+/**
+ * @brief   Get the source route to a node
+ *
+ * @param[in]  dst      destination address
+ * @param[out] route    the hops from the root to @p dst, starting with the
+ *                      neighbor of the root and ending with @p dst
+ * @param[in]  max      number of addresses fitting into @p route
+ * @param[out] iface    interface of the DODAG, may be NULL
+ *
+ * @return  the number of addresses written to @p route
+ * @return  -ENOENT, if @p dst is not in the table
+ * @return  -EHOSTUNREACH, if the parent of a node on the route is unknown
+ * @return  -ELOOP, if the route is longer than @p max
+ */
+int gnrc_rpl_sr_get_route(const ipv6_addr_t *dst, ipv6_addr_t *route,
+                          unsigned max, kernel_pid_t *iface);
+
+/**
+ * @brief   Age the entries, removing the expired ones
+ *
+ * @param[in] elapsed   seconds since the last call
+ */
+void gnrc_rpl_sr_update(uint16_t elapsed);
+
+/**
+ * @brief   Get the number of nodes in the table
+ *
+ * @return  number of used entries
+ */
+unsigned gnrc_rpl_sr_numof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_SR_H */
+/** @} */
@@ -23,6 +23,7 @@
 #ifndef NET_GNRC_RPL_SRH_H
 #define NET_GNRC_RPL_SRH_H
 
+#include "net/gnrc/pkt.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -65,6 +66,28 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh);
 
+/**
+ * @brief   Add a RPL source routing header to an outgoing packet
+ *
+ * The header is inserted directly after the IPv6 header. The destination of
+ * the IPv6 header is replaced by the first hop and the remaining hops are
+ * put into the routing header, with the prefixes they share with the first
+ * hop elided.
+ *
+ * @pre The IPv6 header of @p ipv6 is complete, i.e. the payload length, the
+ *      next header and an upper layer checksum were already calculated for
+ *      the final destination.
+ *
+ * @param[in,out] ipv6  The IPv6 header snip of the packet, write protected.
+ * @param[in] route     The hops of the route, ending with the destination.
+ * @param[in] num       Number of hops in @p route, at least 2.
+ *
+ * @return  0, on success
+ * @return  -ENOMEM, if the packet buffer is full
+ */
+int gnrc_rpl_srh_insert(gnrc_pktsnip_t *ipv6, const ipv6_addr_t *route,
+                        unsigned num);
+
 #ifdef __cplusplus
 }
 #endif
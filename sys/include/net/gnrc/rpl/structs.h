@@ -260,7 +260,18 @@ struct gnrc_rpl_parent {
 typedef struct {
     uint16_t ocp;   /**< objective code point */
     uint16_t (*calc_rank)(gnrc_rpl_parent_t *parent, uint16_t base_rank); /**< calculate the rank */
-    gnrc_rpl_parent_t *(*which_parent)(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *); /**< retrieve the better parent */
+    /**
+     * @brief   Retrieve the better parent
+     *
+     * Used to decide whether to switch the preferred parent after the parent
+     * list was sorted.
+     *
+     * @param[in] parent1   The current preferred parent.
+     * @param[in] parent2   The parent preferred by @ref gnrc_rpl_of_t::parent_cmp.
+     *
+     * @return  The parent to use as preferred parent.
+     */
+    gnrc_rpl_parent_t *(*which_parent)(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2);
 
     /**
      * @brief   Compare two @ref gnrc_rpl_parent_t.
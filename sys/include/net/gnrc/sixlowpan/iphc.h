@@ -10,6 +10,11 @@
  * @defgroup    net_gnrc_sixlowpan_iphc   IPv6 header compression (IPHC)
  * @ingroup     net_gnrc_sixlowpan
  * @brief       IPv6 header compression for 6LoWPAN.
+ *
+ * With the `gnrc_sixlowpan_iphc_nhc` module the headers following the IPv6
+ * header are compressed as well with next header compression (NHC): UDP,
+ * IPv6 extension headers and encapsulated IPv6 headers (see
+ * [RFC 6282, section 4](https://tools.ietf.org/html/rfc6282#section-4)).
  * @{
  *
  * @file
@@ -29,6 +34,37 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of entries in the compression cache
+ *
+ * With the `gnrc_sixlowpan_iphc_cache` module the compressed source and
+ * destination addresses of recently sent packets are cached per link-layer
+ * and IPv6 destination, so the context lookups and the derivation of the
+ * interface identifiers are only done for the first packet of a flow. The
+ * cache is invalidated whenever a 6LoWPAN context changes.
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (8U)
+#endif
+
+/**
+ * @brief   Maximum length of UDP and ICMPv6 messages compressed with GHC
+ *
+ * With the `gnrc_sixlowpan_iphc_ghc` module UDP datagrams and ICMPv6
+ * messages, e.g. Neighbor Discovery and RPL control messages, are compressed
+ * with [RFC 7400](https://tools.ietf.org/html/rfc7400) generic header
+ * compression, if they are not longer than this and the compressed datagram
+ * fits into a single frame. Otherwise they are sent as usual.
+ *
+ * @note    The GHC compressor needs a buffer of this size plus
+ *          @ref SIXLOWPAN_GHC_DICT_LEN bytes.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_GHC_MAX_LEN
+#define GNRC_SIXLOWPAN_IPHC_GHC_MAX_LEN (256U)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -57,6 +93,15 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Removes all entries from the compression cache
+ *
+ * @note    Only available with the `gnrc_sixlowpan_iphc_cache` module.
+ */
+void gnrc_sixlowpan_iphc_cache_flush(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
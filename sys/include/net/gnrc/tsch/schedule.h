@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Schedule of the slotframe MAC
+ *
+ * These functions are not thread-safe, use the functions of
+ * @ref net/gnrc/tsch/tsch.h to change the schedule of an interface.
+ */
+
+#ifndef NET_GNRC_TSCH_SCHEDULE_H
+#define NET_GNRC_TSCH_SCHEDULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Initializes a schedule with the default hopping sequence and the
+ *          minimal schedule: one shared cell in timeslot 0, channel offset 0
+ *
+ * @param[out] sched    The schedule
+ */
+void gnrc_tsch_schedule_init(gnrc_tsch_schedule_t *sched);
+
+/**
+ * @brief   Adds a cell, its statistics are reset
+ *
+ * @param[in,out] sched The schedule
+ * @param[in] cell      The cell
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if the timeslot is not in the slotframe, the cell has
+ *          neither @ref GNRC_TSCH_CELL_TX nor @ref GNRC_TSCH_CELL_RX set or
+ *          the address is too long
+ * @return  -EEXIST, if there is a cell with the same timeslot and channel
+ *          offset
+ * @return  -ENOMEM, if there are already @ref GNRC_TSCH_CELLS_NUMOF cells
+ */
+int gnrc_tsch_schedule_add(gnrc_tsch_schedule_t *sched,
+                           const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Removes a cell
+ *
+ * @param[in,out] sched         The schedule
+ * @param[in] slot              Timeslot of the cell
+ * @param[in] channel_offset    Channel offset of the cell
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if there is no such cell
+ */
+int gnrc_tsch_schedule_del(gnrc_tsch_schedule_t *sched, uint16_t slot,
+                           uint8_t channel_offset);
+
+/**
+ * @brief   Iterates over the cells of a timeslot
+ *
+ * @param[in] sched     The schedule
+ * @param[in] slot      The timeslot
+ * @param[in] prev      The previous cell, NULL to start
+ *
+ * @return  The next cell in @p slot, NULL if there is none
+ */
+gnrc_tsch_cell_t *gnrc_tsch_schedule_iter(const gnrc_tsch_schedule_t *sched,
+                                          uint16_t slot,
+                                          const gnrc_tsch_cell_t *prev);
+
+/**
+ * @brief   Finds the dedicated transmit cell of a neighbor
+ *
+ * @param[in] sched     The schedule
+ * @param[in] addr      Address of the neighbor
+ * @param[in] addr_len  Length of @p addr
+ *
+ * @return  A transmit cell dedicated to the neighbor, NULL if there is none
+ */
+gnrc_tsch_cell_t *gnrc_tsch_schedule_find_tx(const gnrc_tsch_schedule_t *sched,
+                                             const uint8_t *addr,
+                                             size_t addr_len);
+
+/**
+ * @brief   Sets the hopping sequence
+ *
+ * @param[in,out] sched The schedule
+ * @param[in] seq       Channels of the sequence
+ * @param[in] len       Length of @p seq
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p len is 0 or greater than
+ *          @ref GNRC_TSCH_HOPPING_LEN_MAX
+ */
+int gnrc_tsch_schedule_set_hopping(gnrc_tsch_schedule_t *sched,
+                                   const uint8_t *seq, size_t len);
+
+/**
+ * @brief   Resets the statistics of all cells
+ *
+ * @param[in,out] sched The schedule
+ */
+void gnrc_tsch_schedule_reset_stats(gnrc_tsch_schedule_t *sched);
+
+/**
+ * @brief   Gets the channel of a cell in a slot
+ *
+ * @param[in] sched             The schedule
+ * @param[in] asn               Absolute slot number
+ * @param[in] channel_offset    Channel offset of the cell
+ *
+ * @return  The channel
+ */
+static inline uint8_t gnrc_tsch_schedule_channel(const gnrc_tsch_schedule_t *sched,
+                                                 uint32_t asn,
+                                                 uint8_t channel_offset)
+{
+    return sched->hopping[(asn + channel_offset) % sched->hopping_len];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_SCHEDULE_H */
+/** @} */
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch Slotframe MAC
+ * @ingroup     net_gnrc
+ * @brief       A time-slotted, channel-hopping IEEE 802.15.4 MAC protocol
+ *              after the TSCH mode of IEEE 802.15.4e
+ *
+ * ## Slotframe
+ * Time is divided into timeslots of @ref GNRC_TSCH_SLOT_US, numbered by the
+ * absolute slot number (ASN) since the network was started. The timeslots
+ * repeat in a slotframe of @ref GNRC_TSCH_SLOTFRAME_LEN timeslots. The
+ * schedule of a node assigns cells, i.e. a timeslot and a channel offset, to
+ * transmit or to listen. Outside its cells the radio of a node sleeps.
+ *
+ * ## Channel hopping
+ * A cell uses the channel `hopping[(ASN + channel_offset) % hopping_len]`
+ * of the hopping sequence, so its channel changes with every slotframe.
+ * Cells in the same timeslot with different channel offsets use different
+ * channels and do not interfere, the throughput of the network grows with
+ * the number of channels used. The hopping sequence defaults to
+ * @ref GNRC_TSCH_HOPPING_SEQUENCE and must be the same on all nodes.
+ *
+ * ## Dedicated and shared cells
+ * A transmit cell with a neighbor address is dedicated to frames to this
+ * neighbor. Frames to other neighbors, broadcast frames and beacons are sent
+ * in shared cells, transmit cells without address. After a failed
+ * transmission in a shared cell a node skips a random number of shared
+ * cells with an exponential backoff. The schedule is initialized with the
+ * minimal schedule of one shared transmit and receive cell in timeslot 0,
+ * channel offset 0. Further cells are added with @ref gnrc_tsch_cell_add(),
+ * the statistics of each cell are shown by the `tsch` shell command.
+ *
+ * ## Synchronization
+ * A coordinator, started with @ref gnrc_tsch_start_coordinator(), and every
+ * synchronized node send beacons with the ASN in their shared cells. A new
+ * node listens on the first channel of the hopping sequence until it
+ * receives a beacon. The sender becomes its time source, every later frame
+ * of the time source corrects the start of the timeslots. A node that did
+ * not hear its time source for @ref GNRC_TSCH_DESYNC_SLOTS timeslots scans
+ * again.
+ *
+ * Unlike IEEE 802.15.4e, beacons are plain beacon frames without
+ * information elements and timeslots are timed with @ref sys_xtimer, so the
+ * protocol also runs on native with @ref netdev_socket_zep.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the slotframe MAC
+ */
+
+#ifndef NET_GNRC_TSCH_TSCH_H
+#define NET_GNRC_TSCH_TSCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch/types.h"
+#include "net/gnrc/tsch/schedule.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a timeslot in microseconds
+ */
+#ifndef GNRC_TSCH_SLOT_US
+#define GNRC_TSCH_SLOT_US               (10000U)
+#endif
+
+/**
+ * @brief   Start of a transmission into a timeslot in microseconds
+ *
+ * Gives the receivers time to switch the channel, must cover the clock
+ * offsets between nodes.
+ */
+#ifndef GNRC_TSCH_TX_OFFSET_US
+#define GNRC_TSCH_TX_OFFSET_US          (2000U)
+#endif
+
+/**
+ * @brief   Maximum number of retransmissions of a unicast frame
+ */
+#ifndef GNRC_TSCH_MAX_RETRIES
+#define GNRC_TSCH_MAX_RETRIES           (3U)
+#endif
+
+/**
+ * @brief   Minimum backoff exponent in shared cells
+ */
+#ifndef GNRC_TSCH_BACKOFF_EXP_MIN
+#define GNRC_TSCH_BACKOFF_EXP_MIN       (1U)
+#endif
+
+/**
+ * @brief   Maximum backoff exponent in shared cells
+ */
+#ifndef GNRC_TSCH_BACKOFF_EXP_MAX
+#define GNRC_TSCH_BACKOFF_EXP_MAX       (5U)
+#endif
+
+/**
+ * @brief   Average number of slotframes between two beacons of a node
+ */
+#ifndef GNRC_TSCH_BEACON_PERIOD
+#define GNRC_TSCH_BEACON_PERIOD         (4U)
+#endif
+
+/**
+ * @brief   Timeslots without a frame from the time source after which a
+ *          node loses synchronization
+ */
+#ifndef GNRC_TSCH_DESYNC_SLOTS
+#define GNRC_TSCH_DESYNC_SLOTS          (GNRC_TSCH_SLOTFRAME_LEN * 64U)
+#endif
+
+/**
+ * @brief   State of an interface as returned by @ref gnrc_tsch_get_info()
+ */
+typedef struct {
+    gnrc_tsch_schedule_t schedule;      /**< schedule with cell statistics */
+    uint32_t asn;                       /**< absolute slot number */
+    uint8_t state;                      /**< @ref gnrc_tsch_state_t */
+    uint8_t join_prio;                  /**< hops to the coordinator */
+} gnrc_tsch_info_t;
+
+/**
+ * @brief   Creates an IEEE 802.15.4 slotframe MAC network interface
+ *
+ * @param[in] stack     The stack for the network interface's thread.
+ * @param[in] stacksize Size of @p stack.
+ * @param[in] priority  Priority for the network interface's thread.
+ * @param[in] name      Name for the network interface. May be NULL.
+ * @param[in] dev       Device for the interface
+ *
+ * @see @ref gnrc_netif_create()
+ *
+ * @return  The network interface on success.
+ * @return  NULL, on error.
+ */
+gnrc_netif_t *gnrc_netif_tsch_create(char *stack, int stacksize,
+                                     char priority, char *name,
+                                     netdev_t *dev);
+
+/**
+ * @brief   Starts a network with the interface as coordinator
+ *
+ * @param[in] netif The network interface
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ */
+int gnrc_tsch_start_coordinator(gnrc_netif_t *netif);
+
+/**
+ * @brief   Adds a cell to the schedule of an interface
+ *
+ * @param[in] netif The network interface
+ * @param[in] cell  The cell
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ * @return  see @ref gnrc_tsch_schedule_add() for other errors
+ */
+int gnrc_tsch_cell_add(gnrc_netif_t *netif, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Removes a cell from the schedule of an interface
+ *
+ * @param[in] netif             The network interface
+ * @param[in] slot              Timeslot of the cell
+ * @param[in] channel_offset    Channel offset of the cell
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ * @return  -ENOENT, if there is no such cell
+ */
+int gnrc_tsch_cell_del(gnrc_netif_t *netif, uint16_t slot,
+                       uint8_t channel_offset);
+
+/**
+ * @brief   Sets the hopping sequence of an interface
+ *
+ * @param[in] netif The network interface
+ * @param[in] seq   Channels of the sequence
+ * @param[in] len   Length of @p seq
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ * @return  -EINVAL, if @p len is invalid
+ */
+int gnrc_tsch_set_hopping(gnrc_netif_t *netif, const uint8_t *seq,
+                          size_t len);
+
+/**
+ * @brief   Resets the cell statistics of an interface
+ *
+ * @param[in] netif The network interface
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ */
+int gnrc_tsch_reset_stats(gnrc_netif_t *netif);
+
+/**
+ * @brief   Gets the state and schedule of an interface
+ *
+ * @param[in] netif The network interface
+ * @param[out] info The state
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP, if @p netif is not a slotframe MAC interface
+ */
+int gnrc_tsch_get_info(gnrc_netif_t *netif, gnrc_tsch_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TSCH_H */
+/** @} */
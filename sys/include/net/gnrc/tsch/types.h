@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Definition of the types used by the slotframe MAC
+ */
+
+#ifndef NET_GNRC_TSCH_TYPES_H
+#define NET_GNRC_TSCH_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "xtimer.h"
+#include "net/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of timeslots in the slotframe
+ *
+ * Should be coprime with the length of the hopping sequence, so every cell
+ * cycles through all channels.
+ */
+#ifndef GNRC_TSCH_SLOTFRAME_LEN
+#define GNRC_TSCH_SLOTFRAME_LEN         (11U)
+#endif
+
+/**
+ * @brief   Maximum number of cells in the schedule
+ */
+#ifndef GNRC_TSCH_CELLS_NUMOF
+#define GNRC_TSCH_CELLS_NUMOF           (16U)
+#endif
+
+/**
+ * @brief   Maximum length of the hopping sequence
+ */
+#ifndef GNRC_TSCH_HOPPING_LEN_MAX
+#define GNRC_TSCH_HOPPING_LEN_MAX       (16U)
+#endif
+
+/**
+ * @brief   Default hopping sequence
+ *
+ * The default sequence of IEEE 802.15.4-2015 for the 2.4 GHz band.
+ */
+#ifndef GNRC_TSCH_HOPPING_SEQUENCE
+#define GNRC_TSCH_HOPPING_SEQUENCE      { 16, 17, 23, 18, 26, 15, 25, 22, \
+                                          19, 11, 12, 13, 24, 14, 20, 21 }
+#endif
+
+/**
+ * @brief   Slot start event type
+ */
+#define GNRC_TSCH_EVENT_SLOT_TYPE       (0x4300)
+
+/**
+ * @brief   Transmission event type, at @ref GNRC_TSCH_TX_OFFSET_US into a
+ *          slot
+ */
+#define GNRC_TSCH_EVENT_TX_TYPE         (0x4301)
+
+/**
+ * @brief   Event type for calls into the interface's thread
+ */
+#define GNRC_TSCH_EVENT_CALL_TYPE       (0x4302)
+
+/**
+ * @name    Cell options
+ * @{
+ */
+#define GNRC_TSCH_CELL_TX               (0x01)  /**< transmit in the cell */
+#define GNRC_TSCH_CELL_RX               (0x02)  /**< listen in the cell */
+#define GNRC_TSCH_CELL_SHARED           (0x04)  /**< contention with backoff */
+/** @} */
+
+/**
+ * @brief   Synchronization states
+ */
+typedef enum {
+    GNRC_TSCH_STATE_SCAN = 0,           /**< listening for a beacon */
+    GNRC_TSCH_STATE_SYNCED,             /**< synchronized to a time source */
+    GNRC_TSCH_STATE_COORDINATOR,        /**< time source of the network */
+} gnrc_tsch_state_t;
+
+/**
+ * @brief   Per-cell statistics
+ */
+typedef struct {
+    uint32_t tx;                        /**< frames sent */
+    uint32_t tx_fail;                   /**< frames not acknowledged or not
+                                         *   sent due to a busy medium */
+    uint32_t rx;                        /**< frames received */
+    uint32_t idle;                      /**< active slots without a frame */
+} gnrc_tsch_cell_stats_t;
+
+/**
+ * @brief   A cell, i.e. a timeslot and channel offset in the slotframe
+ *
+ * A transmit cell with a neighbor address is dedicated to frames to this
+ * neighbor, a transmit cell without address is used for frames to all
+ * neighbors without a dedicated cell, broadcast frames and beacons.
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< neighbor address */
+    uint8_t addr_len;                   /**< length of addr, 0 for any */
+    uint8_t channel_offset;             /**< channel offset */
+    uint16_t slot;                      /**< timeslot in the slotframe */
+    uint8_t flags;                      /**< cell options, 0 if unused */
+    gnrc_tsch_cell_stats_t stats;       /**< statistics of the cell */
+} gnrc_tsch_cell_t;
+
+/**
+ * @brief   Schedule of a node: its cells and the hopping sequence
+ */
+typedef struct {
+    gnrc_tsch_cell_t cells[GNRC_TSCH_CELLS_NUMOF];  /**< cells */
+    uint8_t hopping[GNRC_TSCH_HOPPING_LEN_MAX];     /**< hopping sequence */
+    uint8_t hopping_len;                /**< length of the hopping sequence */
+} gnrc_tsch_schedule_t;
+
+/**
+ * @brief   Payload of a beacon frame
+ */
+typedef struct __attribute__((packed)) {
+    network_uint32_t asn;               /**< absolute slot number */
+    uint8_t slotframe_len;              /**< number of timeslots */
+    uint8_t join_prio;                  /**< hops to the coordinator */
+} gnrc_tsch_beacon_t;
+
+/**
+ * @brief   State of the slotframe MAC
+ */
+typedef struct {
+    gnrc_tsch_schedule_t schedule;      /**< schedule */
+    xtimer_t timer;                     /**< slot timer */
+    msg_t timer_msg;                    /**< message of the slot timer */
+    gnrc_tsch_cell_t *cell;             /**< active cell of this slot */
+    gnrc_tsch_cell_t *tx_cell;          /**< cell of the last transmission */
+    uint32_t asn;                       /**< absolute slot number */
+    uint32_t slot_start;                /**< start of the slot (xtimer) */
+    uint32_t sync_asn;                  /**< slot of the last synchronization */
+    uint32_t beacon_asn;                /**< slot of the next beacon */
+    uint32_t rx_start;                  /**< start of the last reception */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];   /**< time source */
+    uint8_t time_source_len;            /**< length of time_source */
+    uint8_t state;                      /**< @ref gnrc_tsch_state_t */
+    uint8_t join_prio;                  /**< hops to the coordinator */
+    uint8_t retries;                    /**< retransmissions of the frame */
+    uint8_t backoff_exp;                /**< shared cell backoff exponent */
+    uint8_t backoff;                    /**< shared cells to skip */
+    uint8_t next_neighbor;              /**< round robin of shared cells */
+    bool tx;                            /**< transmitting in this slot */
+    bool tx_beacon;                     /**< the transmission is a beacon */
+    bool rx;                            /**< received in this slot */
+} gnrc_tsch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TSCH_TYPES_H */
+/** @} */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ipv6_lpm    IPv6 prefix set
+ * @ingroup     net_ipv6
+ * @brief       Longest prefix match on a set of IPv6 prefixes
+ *
+ * The prefixes are kept in a hash table keyed by prefix and prefix length,
+ * with a bitmap of the prefix lengths in use. A lookup hashes the address
+ * once per prefix length in use, starting with the longest, so its cost
+ * depends on the number of distinct prefix lengths (typically /128 and /64)
+ * and not on the number of prefixes.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 prefix set definitions
+ */
+#ifndef NET_IPV6_LPM_H
+#define NET_IPV6_LPM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitfield.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   An entry of a prefix set
+ */
+typedef struct {
+    ipv6_addr_t prefix;     /**< the prefix, bits after prefix_len are 0 */
+    uint32_t hits;          /**< hit counter, maintained by the user */
+    uint8_t prefix_len;     /**< length of the prefix in bits */
+    bool used;              /**< entry is in use */
+} ipv6_lpm_entry_t;
+
+/**
+ * @brief   A prefix set
+ *
+ * Can be initialized statically with
+ * `{ .entries = entries, .size = ARRAY_LEN }`.
+ */
+typedef struct {
+    ipv6_lpm_entry_t *entries;  /**< hash table, @ref size entries */
+    unsigned size;              /**< size of the hash table, a power of 2 */
+    unsigned numof;             /**< number of prefixes in the set */
+    BITFIELD(lens, 129);        /**< prefix lengths in use */
+} ipv6_lpm_t;
+
+/**
+ * @brief   Initializes an empty prefix set
+ *
+ * @param[out] lpm      A prefix set
+ * @param[in] entries   Memory for the hash table
+ * @param[in] size      Number of entries in @p entries, must be a power of 2.
+ *                      The set should be at most 3/4 full for short lookups.
+ */
+void ipv6_lpm_init(ipv6_lpm_t *lpm, ipv6_lpm_entry_t *entries, unsigned size);
+
+/**
+ * @brief   Adds a prefix to a set
+ *
+ * Adding a prefix that is already in the set succeeds and keeps its hit
+ * counter.
+ *
+ * @param[in,out] lpm       A prefix set
+ * @param[in] prefix        The prefix, bits after @p prefix_len are ignored
+ * @param[in] prefix_len    Length of @p prefix in bits
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p prefix_len > 128
+ * @return  -ENOMEM if the set is full
+ */
+int ipv6_lpm_add(ipv6_lpm_t *lpm, const ipv6_addr_t *prefix,
+                 uint8_t prefix_len);
+
+/**
+ * @brief   Removes a prefix from a set
+ *
+ * @param[in,out] lpm       A prefix set
+ * @param[in] prefix        The prefix, bits after @p prefix_len are ignored
+ * @param[in] prefix_len    Length of @p prefix in bits
+ *
+ * @return  0 on success
+ * @return  -ENOENT if the prefix is not in the set
+ */
+int ipv6_lpm_del(ipv6_lpm_t *lpm, const ipv6_addr_t *prefix,
+                 uint8_t prefix_len);
+
+/**
+ * @brief   Finds the longest prefix in a set that matches an address
+ *
+ * @param[in] lpm   A prefix set
+ * @param[in] addr  An IPv6 address
+ *
+ * @return  The entry of the longest matching prefix
+ * @return  NULL if no prefix in @p lpm matches @p addr
+ */
+ipv6_lpm_entry_t *ipv6_lpm_match(const ipv6_lpm_t *lpm,
+                                 const ipv6_addr_t *addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_IPV6_LPM_H */
+/** @} */
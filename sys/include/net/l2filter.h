@@ -21,6 +21,14 @@
  * The actual memory for the filter lists should be allocated for every network
  * device. This is done centrally in netdev_t type.
  *
+ * By default the filter list is searched linearly for every received frame,
+ * which is fine for a handful of entries. For large lists, e.g. a whitelist
+ * of all commissioned devices on a gateway, include the `l2filter_hash`
+ * module: the list is then used as an open addressing hash table, so adding,
+ * removing and checking an address takes constant time on average. In that
+ * mode @ref L2FILTER_LISTSIZE must be a power of 2 and should be chosen so
+ * that the list is at most 3/4 full, otherwise the probe sequences get long.
+ *
  * @{
  * @file
  * @brief       Link layer address filter interface definition
@@ -49,10 +57,16 @@ extern "C" {
 
 /**
  * @brief   Number of slots in each filter list (filter entries per device)
+ *
+ * @note    Must be a power of 2 with the `l2filter_hash` module.
  */
 #ifndef L2FILTER_LISTSIZE
+#ifdef MODULE_L2FILTER_HASH
+#define L2FILTER_LISTSIZE               (64U)
+#else
 #define L2FILTER_LISTSIZE               (8U)
 #endif
+#endif
 
 /**
  * @brief   Filter list entries
@@ -79,6 +93,9 @@ typedef struct {
  *
  * @return  0 on success
  * @return  -ENOMEM if no empty slot left in list
+ *
+ * @note    With the `l2filter_hash` module adding an address that is already
+ *          in the list succeeds without adding it a second time.
  */
 int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len);
 
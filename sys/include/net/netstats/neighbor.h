@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Per neighbor link statistics
+ * @ingroup     net_netstats
+ * @brief       Transmission statistics and ETX per link-layer neighbor
+ *
+ * A network interface records the destination of every unicast frame it sends
+ * and reports the outcome of the transmission when the device signals it,
+ * including the number of retransmissions if the device provides
+ * @ref NETOPT_TX_RETRIES_NEEDED. From this an expected transmission count
+ * (ETX) is estimated per neighbor with an exponentially weighted moving
+ * average.
+ *
+ * The ETX is stored in the fixed point format of the RPL ETX metric, i.e.
+ * multiplied with @ref NETSTATS_NB_ETX_DIVISOR.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ *
+ * @{
+ *
+ * @file
+ * @brief       Per neighbor link statistics definitions
+ */
+#ifndef NET_NETSTATS_NEIGHBOR_H
+#define NET_NETSTATS_NEIGHBOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors per interface
+ *
+ * If the table is full the least recently used entry is replaced.
+ */
+#ifndef NETSTATS_NB_NUMOF
+#define NETSTATS_NB_NUMOF               (8U)
+#endif
+
+/**
+ * @brief   Maximum length of a link-layer address
+ */
+#ifndef NETSTATS_NB_L2ADDR_MAXLEN
+#define NETSTATS_NB_L2ADDR_MAXLEN       (8U)
+#endif
+
+/**
+ * @brief   Fixed point divisor of the ETX, i.e. the value of an ETX of 1
+ */
+#define NETSTATS_NB_ETX_DIVISOR         (128U)
+
+/**
+ * @brief   ETX sample of a transmission that was not acknowledged
+ */
+#ifndef NETSTATS_NB_ETX_NOACK_PENALTY
+#define NETSTATS_NB_ETX_NOACK_PENALTY   (8U)
+#endif
+
+/**
+ * @brief   Weight of a new sample in the ETX average in percent
+ */
+#ifndef NETSTATS_NB_EWMA_ALPHA
+#define NETSTATS_NB_EWMA_ALPHA          (15U)
+#endif
+
+/**
+ * @brief   Outcome of a transmission
+ */
+typedef enum {
+    NETSTATS_NB_SUCCESS,        /**< the frame was acknowledged */
+    NETSTATS_NB_NOACK,          /**< the frame was not acknowledged */
+    NETSTATS_NB_BUSY,           /**< the medium was busy, nothing was sent */
+} netstats_nb_result_t;
+
+/**
+ * @brief   Statistics of a neighbor
+ */
+typedef struct {
+    uint8_t l2addr[NETSTATS_NB_L2ADDR_MAXLEN];  /**< link-layer address */
+    uint8_t l2addr_len;         /**< length of netstats_nb_t::l2addr, 0 if
+                                 *   unused */
+    uint16_t etx;               /**< ETX * @ref NETSTATS_NB_ETX_DIVISOR, 0
+                                 *   until the first transmission completed */
+    uint16_t tx_count;          /**< completed transmissions */
+    uint16_t tx_failed;         /**< transmissions without ACK */
+    uint16_t tx_busy;           /**< transmissions not done, medium busy */
+    uint32_t last_used;         /**< table time of the last transmission */
+} netstats_nb_t;
+
+/**
+ * @brief   Neighbor statistics of an interface
+ */
+typedef struct {
+    netstats_nb_t entries[NETSTATS_NB_NUMOF];   /**< the neighbors */
+    netstats_nb_t *last;        /**< destination of the pending frame */
+    uint32_t time;              /**< incremented with every frame */
+} netstats_nb_table_t;
+
+/**
+ * @brief   Clear a table
+ *
+ * @param[out] table    the table
+ */
+void netstats_nb_init(netstats_nb_table_t *table);
+
+/**
+ * @brief   Record the destination of a frame that is about to be sent
+ *
+ * @param[in,out] table     the table
+ * @param[in] l2addr        link-layer destination address
+ * @param[in] l2addr_len    length of @p l2addr, 0 for a multicast frame,
+ *                          which is not recorded
+ */
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2addr,
+                        uint8_t l2addr_len);
+
+/**
+ * @brief   Update the statistics of the last recorded destination
+ *
+ * @param[in,out] table     the table
+ * @param[in] result        outcome of the transmission
+ * @param[in] retries       number of retransmissions
+ */
+void netstats_nb_update_tx(netstats_nb_table_t *table,
+                           netstats_nb_result_t result, unsigned retries);
+
+/**
+ * @brief   Get the statistics of a neighbor
+ *
+ * @param[in] table         the table
+ * @param[in] l2addr        link-layer address of the neighbor
+ * @param[in] l2addr_len    length of @p l2addr
+ * @param[out] stats        the statistics of the neighbor
+ *
+ * @return  true, if the neighbor was found
+ * @return  false, otherwise
+ */
+bool netstats_nb_get(const netstats_nb_table_t *table, const uint8_t *l2addr,
+                     uint8_t l2addr_len, netstats_nb_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_NETSTATS_NEIGHBOR_H */
+/** @} */
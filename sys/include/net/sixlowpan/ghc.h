@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sixlowpan_ghc   Generic Header Compression (GHC)
+ * @ingroup     net_sixlowpan
+ * @brief       Generic header compression for 6LoWPAN
+ * @see         [RFC 7400](https://tools.ietf.org/html/rfc7400)
+ *
+ * GHC compresses a header together with its payload with a simple
+ * LZ77-style bytecode: runs of literal bytes, runs of zeroes, and
+ * back-references into the data decompressed so far. Back-references can
+ * also point into a dictionary that consists of the IPv6 source and
+ * destination address of the packet and a static string, which makes GHC
+ * work well on the addresses, prefixes and options in Neighbor Discovery and
+ * RPL control messages.
+ * @{
+ *
+ * @file
+ * @brief   GHC definitions
+ */
+#ifndef NET_SIXLOWPAN_GHC_H
+#define NET_SIXLOWPAN_GHC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of the pre-filled dictionary
+ */
+#define SIXLOWPAN_GHC_DICT_LEN      (48U)
+
+/**
+ * @brief   Writes the pre-filled dictionary
+ *
+ * @param[out] dict At least @ref SIXLOWPAN_GHC_DICT_LEN bytes
+ * @param[in] src   IPv6 source address of the packet
+ * @param[in] dst   IPv6 destination address of the packet
+ */
+void sixlowpan_ghc_dict_init(uint8_t *dict, const ipv6_addr_t *src,
+                             const ipv6_addr_t *dst);
+
+/**
+ * @brief   Compresses data
+ *
+ * @param[in] buf       The dictionary (see @ref sixlowpan_ghc_dict_init())
+ *                      directly followed by the data to compress.
+ * @param[in] len       Length of the data to compress (without dictionary).
+ * @param[out] out      Buffer for the compressed data.
+ * @param[in] out_len   Length of @p out.
+ *
+ * @return  Length of the compressed data.
+ * @return  -ENOBUFS, if the compressed data does not fit into @p out.
+ */
+int sixlowpan_ghc_compress(const uint8_t *buf, size_t len,
+                           uint8_t *out, size_t out_len);
+
+/**
+ * @brief   Decompresses data
+ *
+ * The data ends with the input or with a stop code.
+ *
+ * @param[in] dict      The dictionary (see @ref sixlowpan_ghc_dict_init()).
+ * @param[in] in        The compressed data.
+ * @param[in] in_len    Length of @p in.
+ * @param[out] out      Buffer for the decompressed data. May be NULL to only
+ *                      determine the length of the decompressed data.
+ * @param[in] out_len   Length of @p out.
+ *
+ * @return  Length of the decompressed data.
+ * @return  -EINVAL, if @p in is malformed.
+ * @return  -ENOBUFS, if the decompressed data does not fit into @p out.
+ */
+int sixlowpan_ghc_decompress(const uint8_t *dict, const uint8_t *in,
+                             size_t in_len, uint8_t *out, size_t out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SIXLOWPAN_GHC_H */
+/** @} */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_threadstat Thread statistics
+ * @ingroup     sys
+ * @brief       Per-thread CPU time, wake-up latency and stack usage
+ *
+ * With this module the scheduler accounts for every thread
+ *
+ * - the time it was running,
+ * - how often it was switched to,
+ * - the time from being woken up until it ran (wake-up latency) and
+ * - the maximum stack usage (for threads created with
+ *   @ref THREAD_CREATE_STACKTEST).
+ *
+ * The time spent in interrupt handlers is accounted separately on CPUs that
+ * report their interrupt handlers with threadstat_isr_enter() and
+ * threadstat_isr_exit() (currently native). Elsewhere it is accounted to
+ * the interrupted thread.
+ *
+ * Unlike `ps`, this module does not need `DEVELHELP` and gives the numbers
+ * to the application, e.g. to report them periodically.
+ *
+ * Times are given in cycles of the fastest clock available:
+ *
+ * | CPU                          | Clock                         |
+ * |------------------------------|-------------------------------|
+ * | Cortex-M3, -M4(F) and -M7    | DWT cycle counter             |
+ * | native                       | host's monotonic clock, in ns |
+ * | others                       | @ref sys_xtimer ticks         |
+ *
+ * threadstat_hz() gives the rate of the clock. The 32-bit DWT cycle counter
+ * is extended to 64 bit on every context switch and by a timer at least
+ * twice per wrap-around (every 12 s at 168 MHz), so that no wrap-around is
+ * missed while no thread is switched to, e.g. in a tickless idle. Note that
+ * the counter stops on most MCUs while the CPU sleeps, i.e. the time of the
+ * idle thread does not include sleeping there.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Thread statistics definitions
+ */
+
+#ifndef THREADSTAT_H
+#define THREADSTAT_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Statistics of a thread
+ */
+typedef struct {
+    uint64_t runtime;       /**< cycles the thread was running */
+    uint64_t latency_sum;   /**< sum of the wake-up latencies in cycles */
+    uint32_t latency_max;   /**< longest wake-up latency in cycles */
+    uint32_t wakeups;       /**< number of wake-ups, i.e. latencies summed */
+    uint32_t switches;      /**< how often the thread was switched to */
+    uint32_t stack_size;    /**< size of the stack in bytes */
+    uint32_t stack_used;    /**< maximum stack usage in bytes */
+} threadstat_t;
+
+/**
+ * @brief   Statistics of the interrupt handlers
+ */
+typedef struct {
+    uint64_t runtime;       /**< cycles spent in interrupt handlers */
+    uint32_t max;           /**< longest interrupt handler in cycles */
+    uint32_t count;         /**< number of interrupts handled */
+} threadstat_isr_t;
+
+/**
+ * @brief   Start the timer extending the DWT cycle counter
+ *
+ * Called by auto_init after @ref sys_xtimer was initialized. Does nothing
+ * on CPUs without the DWT cycle counter.
+ */
+void threadstat_init(void);
+
+/**
+ * @brief   Get the statistics of a thread
+ *
+ * The time of the calling thread includes its current run.
+ *
+ * @param[in] pid       the thread
+ * @param[out] stat     the statistics
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no thread @p pid
+ */
+int threadstat_get(kernel_pid_t pid, threadstat_t *stat);
+
+/**
+ * @brief   Get the statistics of the interrupt handlers
+ *
+ * @param[out] stat     the statistics
+ */
+void threadstat_get_isr(threadstat_isr_t *stat);
+
+/**
+ * @brief   Reset the statistics of all threads and interrupt handlers
+ */
+void threadstat_reset(void);
+
+/**
+ * @brief   Get the current time in cycles
+ *
+ * The difference of two calls is the total time the statistics of threads
+ * and interrupt handlers add up to.
+ */
+uint64_t threadstat_now(void);
+
+/**
+ * @brief   Get the rate of the cycles in Hz
+ */
+uint32_t threadstat_hz(void);
+
+/**
+ * @brief   Convert cycles to microseconds
+ *
+ * @param[in] cycles    cycles as given in the statistics
+ *
+ * @return  @p cycles in microseconds
+ */
+uint64_t threadstat_usec(uint64_t cycles);
+
+/**
+ * @brief   Accounts a context switch
+ *
+ * Called by the scheduler with interrupts disabled.
+ *
+ * @param[in] active    thread that was running, NULL if it exited
+ * @param[in] next      thread that runs next
+ */
+void threadstat_switch(thread_t *active, thread_t *next);
+
+/**
+ * @brief   Accounts a change of the status of a thread
+ *
+ * Called by the scheduler with interrupts disabled, before @p thread gets
+ * @p status.
+ *
+ * @param[in] thread    the thread
+ * @param[in] status    new status of @p thread
+ */
+void threadstat_set_status(thread_t *thread, unsigned status);
+
+/**
+ * @brief   Accounts the start of an interrupt handler
+ *
+ * Called by the CPU with interrupts disabled.
+ */
+void threadstat_isr_enter(void);
+
+/**
+ * @brief   Accounts the end of an interrupt handler
+ *
+ * Called by the CPU with interrupts disabled, before switching to another
+ * thread.
+ */
+void threadstat_isr_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREADSTAT_H */
+/** @} */
@@ -70,6 +70,7 @@ using std::atomic_int;
 
 #include "kernel_types.h"
 #include "clist.h"
+#include "iolist.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -153,6 +154,27 @@ extern "C" {
 #define VFS_NAME_MAX (31)
 #endif
 
+#ifndef VFS_STAT_CACHE_SIZE
+/**
+ * @brief Number of entries in the stat cache
+ *
+ * Only used with the vfs_stat_cache module. The cache keeps the results of
+ * successful vfs_stat() calls. All entries of a mount are dropped whenever a
+ * file on it is written, created, truncated, closed after writing, renamed or
+ * removed, or a directory is created or removed.
+ */
+#define VFS_STAT_CACHE_SIZE (4)
+#endif
+
+#ifndef VFS_STAT_CACHE_PATH_MAX
+/**
+ * @brief Size of the path buffer of a stat cache entry (including terminating null)
+ *
+ * Mount point relative paths that don't fit are never cached.
+ */
+#define VFS_STAT_CACHE_PATH_MAX (VFS_NAME_MAX + 1)
+#endif
+
 /**
  * @brief Used with vfs_bind to bind to any available fd number
  */
@@ -370,6 +392,38 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Read bytes from an open file into a list of buffers
+     *
+     * Optional, if NULL the VFS layer calls @c read for every buffer. File
+     * systems implement this if they can handle the whole list cheaper than
+     * separate calls, e.g. by taking their lock only once.
+     *
+     * Reading stops at the first buffer that could not be filled completely.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   list of destination buffers
+     *
+     * @return number of bytes read on success
+     * @return <0 on error
+     */
+    ssize_t (*readv) (vfs_file_t *filp, const iolist_t *iolist);
+
+    /**
+     * @brief Write bytes from a list of buffers to an open file
+     *
+     * Optional, if NULL the VFS layer calls @c write for every buffer.
+     *
+     * Writing stops at the first buffer that could not be written completely.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   list of source buffers
+     *
+     * @return number of bytes written on success
+     * @return <0 on error
+     */
+    ssize_t (*writev) (vfs_file_t *filp, const iolist_t *iolist);
 };
 
 /**
@@ -669,6 +723,34 @@ ssize_t vfs_read(int fd, void *dest, size_t count);
  */
 ssize_t vfs_write(int fd, const void *src, size_t count);
 
+/**
+ * @brief Read bytes from an open file into a list of buffers
+ *
+ * The buffers are filled in list order. Reading stops at the first buffer
+ * that could not be filled completely, e.g. at the end of the file.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   list of destination buffers
+ *
+ * @return number of bytes read on success
+ * @return <0 on error
+ */
+ssize_t vfs_readv(int fd, const iolist_t *iolist);
+
+/**
+ * @brief Write bytes from a list of buffers to an open file
+ *
+ * The buffers are written in list order. Writing stops at the first buffer
+ * that could not be written completely.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   list of source buffers
+ *
+ * @return number of bytes written on success
+ * @return <0 on error
+ */
+ssize_t vfs_writev(int fd, const iolist_t *iolist);
+
 /**
  * @brief Open a directory for reading with readdir
  *
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_vfs_aio Asynchronous VFS I/O
+ * @ingroup     sys_vfs
+ * @brief       Submit vectored VFS reads and writes to a worker thread
+ *
+ * Writing to flash based file systems can block the caller for a long time.
+ * This module runs vfs_readv() and vfs_writev() in a dedicated worker thread
+ * so that e.g. a sampling loop can hand a list of buffers over and continue.
+ *
+ * A request is described by a @ref vfs_aio_t that stays owned by the module
+ * until the operation completed. Completion is signaled by posting an event to
+ * an @ref event_queue_t, by setting @ref VFS_AIO_THREAD_FLAG on a thread, or
+ * both. The file descriptor and all buffers in the list must stay valid until
+ * then.
+ *
+ * Requests are processed in submission order, so a request may be reused
+ * after completion or several requests can be queued for the same file.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS I/O interface
+ */
+
+#ifndef VFS_AIO_H
+#define VFS_AIO_H
+
+#include <errno.h>
+#include <sys/types.h>
+
+#include "event.h"
+#include "iolist.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the worker thread
+ */
+#ifndef VFS_AIO_STACKSIZE
+#define VFS_AIO_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the worker thread
+ *
+ * Defaults to a priority below main, so file system work does not delay the
+ * submitting thread.
+ */
+#ifndef VFS_AIO_PRIO
+#define VFS_AIO_PRIO            (THREAD_PRIORITY_MAIN + 1)
+#endif
+
+/**
+ * @brief   Thread flag set on @ref vfs_aio_t::thread on completion
+ */
+#ifndef VFS_AIO_THREAD_FLAG
+#define VFS_AIO_THREAD_FLAG     (0x2000)
+#endif
+
+/**
+ * @brief   Operation of an asynchronous request
+ */
+typedef enum {
+    VFS_AIO_READ,               /**< vfs_readv() */
+    VFS_AIO_WRITE,              /**< vfs_writev() */
+} vfs_aio_op_t;
+
+/**
+ * @brief   Asynchronous request
+ */
+typedef struct {
+    event_t super;              /**< event used by the worker, internal */
+    int fd;                     /**< file descriptor */
+    vfs_aio_op_t op;            /**< operation */
+    const iolist_t *iolist;     /**< buffers to read into or write from */
+    volatile ssize_t res;       /**< result, -EINPROGRESS while pending */
+    event_queue_t *queue;       /**< queue to post @p done to, may be NULL */
+    event_t *done;              /**< event posted on completion */
+    thread_t *thread;           /**< thread to signal, may be NULL */
+} vfs_aio_t;
+
+/**
+ * @brief   Start the worker thread
+ *
+ * Called by auto_init.
+ */
+void vfs_aio_init(void);
+
+/**
+ * @brief   Hand a request to the worker thread
+ *
+ * @p req->fd, @p req->op, @p req->iolist and the completion fields must be
+ * set by the caller. Zero-initialize a request before its first use.
+ *
+ * @param[in,out] req   request
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p req is not valid
+ * @return -EBUSY if @p req is still pending
+ */
+int vfs_aio_submit(vfs_aio_t *req);
+
+/**
+ * @brief   Submit an asynchronous vfs_readv()
+ *
+ * @param[in,out] req   request with the completion fields set
+ * @param[in]     fd    fd number obtained from vfs_open
+ * @param[in]     iolist list of destination buffers
+ *
+ * @return see @ref vfs_aio_submit()
+ */
+static inline int vfs_aio_readv(vfs_aio_t *req, int fd, const iolist_t *iolist)
+{
+    req->fd = fd;
+    req->op = VFS_AIO_READ;
+    req->iolist = iolist;
+    return vfs_aio_submit(req);
+}
+
+/**
+ * @brief   Submit an asynchronous vfs_writev()
+ *
+ * @param[in,out] req   request with the completion fields set
+ * @param[in]     fd    fd number obtained from vfs_open
+ * @param[in]     iolist list of source buffers
+ *
+ * @return see @ref vfs_aio_submit()
+ */
+static inline int vfs_aio_writev(vfs_aio_t *req, int fd, const iolist_t *iolist)
+{
+    req->fd = fd;
+    req->op = VFS_AIO_WRITE;
+    req->iolist = iolist;
+    return vfs_aio_submit(req);
+}
+
+/**
+ * @brief   Check whether a request is still pending
+ *
+ * @param[in] req   request
+ *
+ * @return  1 while the request is queued or being processed
+ * @return  0 once @p req->res holds the result
+ */
+static inline int vfs_aio_pending(const vfs_aio_t *req)
+{
+    return (req->res == -EINPROGRESS);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VFS_AIO_H */
+/** @} */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static netstats_nb_t *_find(const netstats_nb_table_t *table,
+                            const uint8_t *l2addr, uint8_t l2addr_len)
+{
+    for (unsigned i = 0; i < NETSTATS_NB_NUMOF; i++) {
+        const netstats_nb_t *nb = &table->entries[i];
+
+        if ((nb->l2addr_len == l2addr_len) &&
+            (memcmp(nb->l2addr, l2addr, l2addr_len) == 0)) {
+            return (netstats_nb_t *)nb;
+        }
+    }
+    return NULL;
+}
+
+static netstats_nb_t *_lru(netstats_nb_table_t *table)
+{
+    netstats_nb_t *res = &table->entries[0];
+
+    for (unsigned i = 0; i < NETSTATS_NB_NUMOF; i++) {
+        netstats_nb_t *nb = &table->entries[i];
+
+        if (nb->l2addr_len == 0) {
+            return nb;
+        }
+        /* the difference is robust against the wrap around of the time */
+        if ((table->time - nb->last_used) > (table->time - res->last_used)) {
+            res = nb;
+        }
+    }
+    return res;
+}
+
+void netstats_nb_init(netstats_nb_table_t *table)
+{
+    memset(table, 0, sizeof(*table));
+}
+
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2addr,
+                        uint8_t l2addr_len)
+{
+    netstats_nb_t *nb;
+
+    if ((l2addr_len == 0) || (l2addr_len > NETSTATS_NB_L2ADDR_MAXLEN)) {
+        table->last = NULL;
+        return;
+    }
+
+    unsigned state = irq_disable();
+    if ((nb = _find(table, l2addr, l2addr_len)) == NULL) {
+        nb = _lru(table);
+        DEBUG("netstats_nb: new neighbor in entry %u\n",
+              (unsigned)(nb - table->entries));
+        memset(nb, 0, sizeof(*nb));
+        memcpy(nb->l2addr, l2addr, l2addr_len);
+        nb->l2addr_len = l2addr_len;
+    }
+    nb->last_used = ++table->time;
+    table->last = nb;
+    irq_restore(state);
+}
+
+void netstats_nb_update_tx(netstats_nb_table_t *table,
+                           netstats_nb_result_t result, unsigned retries)
+{
+    netstats_nb_t *nb = table->last;
+    uint32_t sample;
+
+    if (nb == NULL) {
+        return;
+    }
+    table->last = NULL;
+
+    switch (result) {
+        case NETSTATS_NB_SUCCESS:
+            sample = (retries + 1) * NETSTATS_NB_ETX_DIVISOR;
+            break;
+        case NETSTATS_NB_NOACK:
+            sample = NETSTATS_NB_ETX_NOACK_PENALTY * NETSTATS_NB_ETX_DIVISOR;
+            break;
+        default:
+            /* says nothing about the link */
+            nb->tx_busy++;
+            return;
+    }
+    if (sample > UINT16_MAX) {
+        sample = UINT16_MAX;
+    }
+
+    unsigned state = irq_disable();
+    if (nb->etx == 0) {
+        nb->etx = sample;
+    }
+    else {
+        nb->etx = (nb->etx * (100 - NETSTATS_NB_EWMA_ALPHA) +
+                   sample * NETSTATS_NB_EWMA_ALPHA) / 100;
+    }
+    nb->tx_count++;
+    if (result == NETSTATS_NB_NOACK) {
+        nb->tx_failed++;
+    }
+    irq_restore(state);
+
+    DEBUG("netstats_nb: entry %u, result %u, retries %u, ETX %u/%u\n",
+          (unsigned)(nb - table->entries), result, retries, nb->etx,
+          NETSTATS_NB_ETX_DIVISOR);
+}
+
+bool netstats_nb_get(const netstats_nb_table_t *table, const uint8_t *l2addr,
+                     uint8_t l2addr_len, netstats_nb_t *stats)
+{
+    netstats_nb_t *nb;
+    bool res = false;
+
+    unsigned state = irq_disable();
+    if ((l2addr_len > 0) && (nb = _find(table, l2addr, l2addr_len)) != NULL) {
+        *stats = *nb;
+        res = true;
+    }
+    irq_restore(state);
+    return res;
+}
+
+/** @} */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_mac_dutycycle
+ * @{
+ *
+ * @file
+ * @brief       Implementation of the adaptive duty cycle controller
+ * @}
+ */
+
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+
+#include <string.h>
+
+#include "assert.h"
+#include "net/gnrc/mac/dutycycle.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* weight of a new sample in the averages is 1 / (1 << EWMA_SHIFT) */
+#define EWMA_SHIFT      (2U)
+#define LOAD_ONE        (1U << GNRC_MAC_DUTYCYCLE_LOAD_SHIFT)
+
+static void _account(gnrc_mac_dutycycle_t *dc, uint32_t now)
+{
+    uint32_t elapsed = now - dc->last;
+
+    dc->total_us += elapsed;
+    if (dc->radio_on) {
+        dc->on_us += elapsed;
+    }
+    dc->last = now;
+}
+
+void gnrc_mac_dutycycle_init(gnrc_mac_dutycycle_t *dc, uint32_t now,
+                             uint32_t base_us, uint8_t exp_max,
+                             uint32_t latency_target_us)
+{
+    assert((base_us >> exp_max) > 0);
+    memset(dc, 0, sizeof(*dc));
+    dc->last = now;
+    dc->updated = now;
+    dc->base_us = base_us;
+    dc->exp_max = exp_max;
+    dc->latency_target_us = latency_target_us;
+}
+
+void gnrc_mac_dutycycle_tx_done(gnrc_mac_dutycycle_t *dc, uint32_t now,
+                                bool success)
+{
+    uint32_t latency = now - dc->tx_start;
+
+    /* a following frame of a burst is accounted from here */
+    dc->tx_start = now;
+    if (!success) {
+        return;
+    }
+    if (dc->tx_latency_us == 0) {
+        dc->tx_latency_us = latency;
+    }
+    else {
+        dc->tx_latency_us = dc->tx_latency_us -
+                            (dc->tx_latency_us >> EWMA_SHIFT) +
+                            (latency >> EWMA_SHIFT);
+    }
+}
+
+void gnrc_mac_dutycycle_radio(gnrc_mac_dutycycle_t *dc, uint32_t now, bool on)
+{
+    _account(dc, now);
+    dc->radio_on = on;
+}
+
+uint8_t gnrc_mac_dutycycle_update(gnrc_mac_dutycycle_t *dc)
+{
+    uint32_t sample = (uint32_t)dc->rx << GNRC_MAC_DUTYCYCLE_LOAD_SHIFT;
+    uint8_t exp = 0;
+
+    /* round the decay up, so the load drops to 0 without traffic */
+    dc->load -= (dc->load + (1U << EWMA_SHIFT) - 1) >> EWMA_SHIFT;
+    dc->load += (sample > UINT16_MAX) ? (UINT16_MAX >> EWMA_SHIFT)
+                                      : (sample >> EWMA_SHIFT);
+    /* at most about one frame per wake-up */
+    while ((exp < dc->exp_max) && ((unsigned)(dc->load >> exp) > LOAD_ONE)) {
+        exp++;
+    }
+    /* wake up often enough to meet the latency target while there is
+     * traffic */
+    if ((dc->latency_target_us > 0) && ((dc->load > 0) || (dc->rx > 0))) {
+        while ((exp < dc->exp_max) &&
+               (((dc->base_us >> exp) / 2) > dc->latency_target_us)) {
+            exp++;
+        }
+    }
+    if (dc->backlog && (exp <= dc->exp)) {
+        exp = dc->exp + 1;
+    }
+    if ((exp > dc->exp) && (dc->exp < dc->exp_max)) {
+        dc->exp++;
+    }
+    else if (exp < dc->exp) {
+        dc->exp--;
+    }
+    DEBUG("gnrc_mac_dutycycle: rx %u load %u/%u backlog %u => exp %u\n",
+          (unsigned)dc->rx, (unsigned)dc->load, LOAD_ONE,
+          (unsigned)dc->backlog, (unsigned)dc->exp);
+    dc->rx = 0;
+    dc->backlog = false;
+    return dc->exp;
+}
+
+uint8_t gnrc_mac_dutycycle_wakeup(gnrc_mac_dutycycle_t *dc, uint32_t now)
+{
+    /* wake-ups drift a bit against the base period, so allow for half a
+     * period of slack */
+    if ((now - dc->updated) >=
+        (dc->base_us - (gnrc_mac_dutycycle_period(dc) / 2))) {
+        dc->updated = now;
+        return gnrc_mac_dutycycle_update(dc);
+    }
+    return dc->exp;
+}
+
+void gnrc_mac_dutycycle_get_stats(const gnrc_mac_dutycycle_t *dc,
+                                  uint32_t now,
+                                  gnrc_mac_dutycycle_stats_t *stats)
+{
+    uint32_t elapsed = now - dc->last;
+    uint64_t total_us = dc->total_us + elapsed;
+    uint64_t on_us = dc->on_us + ((dc->radio_on) ? elapsed : 0);
+
+    stats->energy_uj = (on_us * GNRC_MAC_DUTYCYCLE_RADIO_MW) / 1000;
+    stats->period_us = gnrc_mac_dutycycle_period(dc);
+    stats->latency_us = stats->period_us / 2;
+    stats->tx_latency_us = dc->tx_latency_us;
+    stats->duty_cycle = (total_us > 0) ? (uint16_t)((on_us * 1000) / total_us)
+                                       : 0;
+    stats->load = (dc->load * 100U) >> GNRC_MAC_DUTYCYCLE_LOAD_SHIFT;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_MAC_DUTYCYCLE */
@@ -37,6 +37,9 @@
 #include "net/gnrc/gomach/gomach.h"
 #include "net/gnrc/gomach/timeout.h"
 #include "include/gomach_internal.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -99,6 +102,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+#endif
         if (!(state->flags & NETDEV_IEEE802154_RAW)) {
             gnrc_pktsnip_t *ieee802154_hdr;
             size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
@@ -564,6 +570,10 @@ static void gomach_t2k_trans_in_cp(gnrc_netif_t *netif)
 
 static void _cp_tx_success(gnrc_netif_t *netif)
 {
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_tx_done(&netif->mac.dutycycle, xtimer_now_usec(), true);
+#endif
+
     /* Since the packet will not be released by the sending function,
      * so, here, if TX success, we first release the packet. */
     gnrc_pktbuf_release(netif->mac.tx.packet);
@@ -827,6 +837,10 @@ static void gomach_t2k_trans_in_slots(gnrc_netif_t *netif)
 
 static void _t2k_wait_vtdma_tx_success(gnrc_netif_t *netif)
 {
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_tx_done(&netif->mac.dutycycle, xtimer_now_usec(), true);
+#endif
+
     /* First release the packet. */
     gnrc_pktbuf_release(netif->mac.tx.packet);
     netif->mac.tx.packet = NULL;
@@ -1279,6 +1293,10 @@ static void gomach_t2u_send_data(gnrc_netif_t *netif)
 
 static void _t2u_data_tx_success(gnrc_netif_t *netif)
 {
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_tx_done(&netif->mac.dutycycle, xtimer_now_usec(), true);
+#endif
+
     /* If transmission succeeded, release the data. */
     gnrc_pktbuf_release(netif->mac.tx.packet);
     netif->mac.tx.packet = NULL;
@@ -1487,6 +1505,13 @@ static void gomach_listen_init(gnrc_netif_t *netif)
     /* Set listen period timeout. */
     uint32_t listen_period = random_uint32_range(0, GNRC_GOMACH_CP_RANDOM_END_US) +
                              GNRC_GOMACH_CP_DURATION_US;
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    /* Listen longer under load, the cycle itself is fixed. */
+    listen_period <<= gnrc_mac_dutycycle_update(&netif->mac.dutycycle);
+    if (listen_period > GNRC_GOMACH_CP_DURATION_MAX_US) {
+        listen_period = GNRC_GOMACH_CP_DURATION_MAX_US;
+    }
+#endif
     gnrc_gomach_set_timeout(netif, GNRC_GOMACH_TIMEOUT_CP_END, listen_period);
     gnrc_gomach_set_timeout(netif, GNRC_GOMACH_TIMEOUT_CP_MAX, GNRC_GOMACH_CP_DURATION_MAX_US);
 
@@ -2127,6 +2152,13 @@ static void _gomach_init(gnrc_netif_t *netif)
                                          netif->l2addr,
                                          sizeof(netif->l2addr));
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_init(&netif->mac.dutycycle, xtimer_now_usec(),
+                            GNRC_GOMACH_SUPERFRAME_DURATION_US,
+                            GNRC_GOMACH_CP_EXP_MAX,
+                            GNRC_MAC_DUTYCYCLE_LATENCY_US);
+#endif
+
     /* Initialize GoMacH's state machines. */
     netif->mac.prot.gomach.basic_state = GNRC_GOMACH_INIT;
     netif->mac.prot.gomach.init_state = GNRC_GOMACH_INIT_PREPARE;
@@ -32,6 +32,9 @@
 #include "include/gomach_internal.h"
 #include "net/gnrc/netif/ieee802154.h"
 #include "net/netdev/ieee802154.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -100,6 +103,9 @@ int _gnrc_gomach_transmit(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         .iol_len = (size_t)res
     };
 
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, &iolist);
+#endif
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
             (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
@@ -303,6 +309,12 @@ void gnrc_gomach_set_netdev_state(gnrc_netif_t *netif, netopt_state_t devstate)
                             &devstate,
                             sizeof(devstate));
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_radio(&netif->mac.dutycycle, xtimer_now_usec(),
+                             (devstate != NETOPT_STATE_SLEEP) &&
+                             (devstate != NETOPT_STATE_OFF));
+#endif
+
 #if (GNRC_GOMACH_ENABLE_DUTYCYLE_RECORD == 1)
     if (devstate == NETOPT_STATE_IDLE) {
         if (!(netif->mac.prot.gomach.gomach_info & GNRC_GOMACH_INTERNAL_INFO_RADIO_IS_ON)) {
@@ -599,6 +611,11 @@ void gnrc_gomach_indicator_update(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
         return;
     }
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_rx(&netif->mac.dutycycle,
+                          gomach_data_hdr->queue_indicator > 0);
+#endif
+
     uint8_t i;
     /* Check whether the device has been registered or not. */
     for (i = 0; i < GNRC_GOMACH_SLOSCH_UNIT_COUNT; i++) {
@@ -1188,6 +1205,9 @@ bool gnrc_gomach_find_next_tx_neighbor(gnrc_netif_t *netif)
     if (next >= 0) {
         gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&netif->mac.tx.neighbors[next].queue);
         if (pkt != NULL) {
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+            gnrc_mac_dutycycle_tx_start(&netif->mac.dutycycle, xtimer_now_usec());
+#endif
             netif->mac.tx.packet = pkt;
             netif->mac.tx.current_neighbor = &netif->mac.tx.neighbors[next];
             netif->mac.tx.tx_seq = 0;
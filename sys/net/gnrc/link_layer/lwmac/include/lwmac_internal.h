@@ -374,6 +374,61 @@ static inline uint32_t _gnrc_lwmac_ticks_until_phase(uint32_t phase)
     return (uint32_t)tmp;
 }
 
+/**
+ * @brief Get the device's current wake-up interval
+ *
+ * @param[in] netif    ptr to the network interface
+ *
+ * @return             RTT ticks
+ */
+static inline uint32_t _gnrc_lwmac_wakeup_interval(gnrc_netif_t *netif)
+{
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    return RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) >>
+           netif->mac.dutycycle.exp;
+#else
+    (void)netif;
+    return RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+#endif
+}
+
+/**
+ * @brief Get a neighbor's wake-up interval
+ *
+ * @param[in] neighbor    ptr to the neighbor
+ *
+ * @return                RTT ticks
+ */
+static inline uint32_t _gnrc_lwmac_neighbor_interval(gnrc_mac_tx_neighbor_t *neighbor)
+{
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    return RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) >> neighbor->wakeup_exp;
+#else
+    (void)neighbor;
+    return RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US);
+#endif
+}
+
+/**
+ * @brief Calculate how many ticks remaining to a neighbor's next wake-up
+ *
+ * @param[in]   neighbor    ptr to the neighbor
+ *
+ * @return                  RTT ticks, as @ref _gnrc_lwmac_ticks_until_phase
+ *                          for an unknown phase
+ */
+static inline uint32_t _gnrc_lwmac_ticks_until_wakeup(gnrc_mac_tx_neighbor_t *neighbor)
+{
+    uint32_t ticks = _gnrc_lwmac_ticks_until_phase(neighbor->phase);
+
+    /* the phase is relative to the base interval, the neighbor also wakes
+     * up every shortened interval after it */
+    if (neighbor->phase < RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US)) {
+        ticks %= _gnrc_lwmac_neighbor_interval(neighbor);
+    }
+    return ticks;
+}
+
 /**
  * @brief Store the received packet to the dispatch buffer and remove possible
  *        duplicate packets.
@@ -28,6 +28,9 @@
 #include "timex.h"
 #include "random.h"
 #include "periph/rtt.h"
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+#include "xtimer.h"
+#endif
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/netif/internal.h"
@@ -40,6 +43,9 @@
 #include "include/tx_state_machine.h"
 #include "include/rx_state_machine.h"
 #include "include/lwmac_internal.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -132,6 +138,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+#endif
         if (!(state->flags & NETDEV_IEEE802154_RAW)) {
             gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
             gnrc_netif_hdr_t *hdr;
@@ -207,7 +216,7 @@ static gnrc_mac_tx_neighbor_t *_next_tx_neighbor(gnrc_netif_t *netif)
             /* Unknown destinations are initialized with their phase at the end
              * of the local interval, so known destinations that still wakeup
              * in this interval will be preferred. */
-            uint32_t phase_check = _gnrc_lwmac_ticks_until_phase(netif->mac.tx.neighbors[i].phase);
+            uint32_t phase_check = _gnrc_lwmac_ticks_until_wakeup(&netif->mac.tx.neighbors[i]);
 
             if (phase_check <= phase_nearest) {
                 next = &(netif->mac.tx.neighbors[i]);
@@ -303,13 +312,13 @@ void lwmac_set_state(gnrc_netif_t *netif, gnrc_lwmac_state_t newstate)
 
                 rtt_clear_alarm();
                 alarm = random_uint32_range(RTT_US_TO_TICKS((3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)),
-                                            RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US -
-                                                            (3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)));
+                                            _gnrc_lwmac_wakeup_interval(netif) -
+                                            RTT_US_TO_TICKS((3 * GNRC_LWMAC_WAKEUP_DURATION_US / 2)));
                 LOG_WARNING("WARNING: [LWMAC] phase backoffed: %lu us\n",
                             (unsigned long)RTT_TICKS_TO_US(alarm));
                 netif->mac.prot.lwmac.last_wakeup = netif->mac.prot.lwmac.last_wakeup + alarm;
                 alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                            RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                            _gnrc_lwmac_wakeup_interval(netif));
                 rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             }
 
@@ -372,6 +381,9 @@ static void _sleep_management(gnrc_netif_t *netif)
             neighbour = netif->mac.tx.current_neighbor;
         }
         else {
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+            gnrc_mac_dutycycle_tx_start(&netif->mac.dutycycle, xtimer_now_usec());
+#endif
             /* Check if there are broadcasts to send and transmit immediately */
             if (gnrc_priority_pktqueue_length(&(netif->mac.tx.neighbors[0].queue)) > 0) {
                 netif->mac.tx.current_neighbor = &(netif->mac.tx.neighbors[0]);
@@ -393,12 +405,12 @@ static void _sleep_management(gnrc_netif_t *netif)
 
             /* Offset in microseconds when the earliest (phase) destination
              * node wakes up that we have packets for. */
-            uint32_t time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_phase(neighbour->phase));
+            uint32_t time_until_tx = RTT_TICKS_TO_US(_gnrc_lwmac_ticks_until_wakeup(neighbour));
 
             /* If there's not enough time to prepare a WR to catch the phase
              * postpone to next interval */
             if (time_until_tx < GNRC_LWMAC_WR_PREPARATION_US) {
-                time_until_tx += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+                time_until_tx += RTT_TICKS_TO_US(_gnrc_lwmac_neighbor_interval(neighbour));
             }
             time_until_tx -= GNRC_LWMAC_WR_PREPARATION_US;
 
@@ -451,7 +463,7 @@ static void _rx_management_failed(gnrc_netif_t *netif)
         phase = phase - netif->mac.prot.lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4 * RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) / 5)) {
+    if (phase > (4 * _gnrc_lwmac_wakeup_interval(netif) / 5)) {
         gnrc_lwmac_set_quit_rx(netif, true);
     }
 
@@ -482,7 +494,7 @@ static void _rx_management_success(gnrc_netif_t *netif)
         phase = phase - netif->mac.prot.lwmac.last_wakeup;
     }
     /* If the relative phase is beyond 4/5 cycle time, go to sleep. */
-    if (phase > (4 * RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US) / 5)) {
+    if (phase > (4 * _gnrc_lwmac_wakeup_interval(netif) / 5)) {
         gnrc_lwmac_set_quit_rx(netif, true);
     }
 
@@ -587,6 +599,10 @@ static void _tx_management(gnrc_netif_t *netif)
             /* Intentionally falls through */
 
         case GNRC_LWMAC_TX_STATE_SUCCESSFUL:
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+            gnrc_mac_dutycycle_tx_done(&netif->mac.dutycycle, xtimer_now_usec(),
+                                       state_tx == GNRC_LWMAC_TX_STATE_SUCCESSFUL);
+#endif
             _tx_management_success(netif);
             break;
 
@@ -701,6 +717,10 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         case GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING: {
             /* A new cycle starts, set sleep timing and initialize related MAC-info flags. */
             netif->mac.prot.lwmac.last_wakeup = rtt_get_alarm();
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+            /* adapt the interval to the traffic once per base interval */
+            gnrc_mac_dutycycle_wakeup(&netif->mac.dutycycle, xtimer_now_usec());
+#endif
             alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
                                         RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_DURATION_US));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING);
@@ -714,7 +734,7 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
         case GNRC_LWMAC_EVENT_RTT_SLEEP_PENDING: {
             /* Set next wake-up timing. */
             alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                        _gnrc_lwmac_wakeup_interval(netif));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             lwmac_set_state(netif, GNRC_LWMAC_SLEEPING);
             break;
@@ -739,7 +759,7 @@ void rtt_handler(uint32_t event, gnrc_netif_t *netif)
             LOG_DEBUG("[LWMAC] RTT: Resume duty cycling\n");
             rtt_clear_alarm();
             alarm = _next_inphase_event(netif->mac.prot.lwmac.last_wakeup,
-                                        RTT_US_TO_TICKS(GNRC_LWMAC_WAKEUP_INTERVAL_US));
+                                        _gnrc_lwmac_wakeup_interval(netif));
             rtt_set_alarm(alarm, rtt_cb, (void *) GNRC_LWMAC_EVENT_RTT_WAKEUP_PENDING);
             gnrc_lwmac_set_dutycycle_active(netif, true);
             break;
@@ -930,6 +950,13 @@ static void _lwmac_init(gnrc_netif_t *netif)
     /* Reset all timeouts just to be sure */
     gnrc_lwmac_reset_timeouts(netif);
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_init(&netif->mac.dutycycle, xtimer_now_usec(),
+                            GNRC_LWMAC_WAKEUP_INTERVAL_US,
+                            GNRC_LWMAC_WAKEUP_EXP_MAX,
+                            GNRC_MAC_DUTYCYCLE_LATENCY_US);
+#endif
+
     /* Start duty cycling */
     lwmac_set_state(netif, GNRC_LWMAC_START);
 
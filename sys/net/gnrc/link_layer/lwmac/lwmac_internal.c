@@ -28,6 +28,12 @@
 #include "include/lwmac_internal.h"
 #include "net/gnrc/netif/ieee802154.h"
 #include "net/netdev/ieee802154.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -87,6 +93,9 @@ int _gnrc_lwmac_transmit(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         .iol_len = (size_t)res
     };
 
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, &iolist);
+#endif
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
             (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
@@ -191,6 +200,12 @@ void _gnrc_lwmac_set_netdev_state(gnrc_netif_t *netif, netopt_state_t devstate)
                             &devstate,
                             sizeof(devstate));
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    gnrc_mac_dutycycle_radio(&netif->mac.dutycycle, xtimer_now_usec(),
+                             (devstate != NETOPT_STATE_SLEEP) &&
+                             (devstate != NETOPT_STATE_OFF));
+#endif
+
 #if (GNRC_LWMAC_ENABLE_DUTYCYLE_RECORD == 1)
     if (devstate == NETOPT_STATE_IDLE) {
         if (!(netif->mac.prot.lwmac.lwmac_info & GNRC_LWMAC_RADIO_IS_ON)) {
@@ -147,6 +147,11 @@ static bool _send_wa(gnrc_netif_t *netif)
                                   _gnrc_lwmac_ticks_to_phase(netif->mac.prot.lwmac.last_wakeup);
     }
 
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    /* Tell the sender the current wake-up interval */
+    lwmac_hdr.wakeup_exp = netif->mac.dutycycle.exp;
+#endif
+
     pkt = gnrc_pktbuf_add(NULL, &lwmac_hdr, sizeof(lwmac_hdr), GNRC_NETTYPE_LWMAC);
     if (pkt == NULL) {
         LOG_ERROR("ERROR: [LWMAC-rx] Cannot allocate pktbuf of type GNRC_NETTYPE_LWMAC\n");
@@ -261,6 +266,11 @@ static uint8_t _packet_process_in_wait_for_data(gnrc_netif_t *netif)
             case GNRC_LWMAC_FRAMETYPE_DATA:
             case GNRC_LWMAC_FRAMETYPE_DATA_PENDING: {
                 /* Receiver gets the data packet */
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+                gnrc_mac_dutycycle_rx(&netif->mac.dutycycle,
+                                      info.header->type ==
+                                      GNRC_LWMAC_FRAMETYPE_DATA_PENDING);
+#endif
                 _gnrc_lwmac_dispatch_defer(netif->mac.rx.dispatch_buffer, pkt);
                 gnrc_mac_dispatch(&netif->mac.rx);
                 LOG_DEBUG("[LWMAC-rx] Found DATA!\n");
@@ -305,6 +305,12 @@ static uint8_t _packet_process_in_wait_for_wa(gnrc_netif_t *netif)
             netif->mac.tx.timestamp = _gnrc_lwmac_phase_now();
             gnrc_lwmac_frame_wa_t *wa_hdr;
             wa_hdr = (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_LWMAC))->data;
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+            /* Receiver's wake-up interval, within the range we know */
+            netif->mac.tx.current_neighbor->wakeup_exp =
+                (wa_hdr->wakeup_exp > GNRC_LWMAC_WAKEUP_EXP_MAX) ?
+                GNRC_LWMAC_WAKEUP_EXP_MAX : wa_hdr->wakeup_exp;
+#endif
 
             if (netif->mac.tx.timestamp >= wa_hdr->current_phase) {
                 netif->mac.tx.timestamp = netif->mac.tx.timestamp -
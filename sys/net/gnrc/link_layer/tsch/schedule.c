@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Implementation of the schedule of the slotframe MAC
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "net/gnrc/tsch/schedule.h"
+
+static const uint8_t _hopping[] = GNRC_TSCH_HOPPING_SEQUENCE;
+
+void gnrc_tsch_schedule_init(gnrc_tsch_schedule_t *sched)
+{
+    const gnrc_tsch_cell_t minimal = {
+        .flags = GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX | GNRC_TSCH_CELL_SHARED,
+    };
+    int res;
+
+    memset(sched, 0, sizeof(*sched));
+    res = gnrc_tsch_schedule_set_hopping(sched, _hopping, sizeof(_hopping));
+    assert(res == 0);
+    res = gnrc_tsch_schedule_add(sched, &minimal);
+    assert(res == 0);
+    (void)res;
+}
+
+static gnrc_tsch_cell_t *_find(const gnrc_tsch_schedule_t *sched,
+                               uint16_t slot, uint8_t channel_offset)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        const gnrc_tsch_cell_t *cell = &sched->cells[i];
+
+        if ((cell->flags != 0) && (cell->slot == slot) &&
+            (cell->channel_offset == channel_offset)) {
+            return (gnrc_tsch_cell_t *)cell;
+        }
+    }
+    return NULL;
+}
+
+int gnrc_tsch_schedule_add(gnrc_tsch_schedule_t *sched,
+                           const gnrc_tsch_cell_t *cell)
+{
+    if ((cell->slot >= GNRC_TSCH_SLOTFRAME_LEN) ||
+        !(cell->flags & (GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX)) ||
+        (cell->addr_len > sizeof(cell->addr))) {
+        return -EINVAL;
+    }
+    if (_find(sched, cell->slot, cell->channel_offset) != NULL) {
+        return -EEXIST;
+    }
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_t *entry = &sched->cells[i];
+
+        if (entry->flags == 0) {
+            *entry = *cell;
+            memset(&entry->stats, 0, sizeof(entry->stats));
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+int gnrc_tsch_schedule_del(gnrc_tsch_schedule_t *sched, uint16_t slot,
+                           uint8_t channel_offset)
+{
+    gnrc_tsch_cell_t *cell = _find(sched, slot, channel_offset);
+
+    if (cell == NULL) {
+        return -ENOENT;
+    }
+    cell->flags = 0;
+    return 0;
+}
+
+gnrc_tsch_cell_t *gnrc_tsch_schedule_iter(const gnrc_tsch_schedule_t *sched,
+                                          uint16_t slot,
+                                          const gnrc_tsch_cell_t *prev)
+{
+    const gnrc_tsch_cell_t *cell = (prev == NULL) ? sched->cells : (prev + 1);
+
+    assert((prev == NULL) || (prev >= sched->cells));
+    for (; cell < (sched->cells + GNRC_TSCH_CELLS_NUMOF); cell++) {
+        if ((cell->flags != 0) && (cell->slot == slot)) {
+            return (gnrc_tsch_cell_t *)cell;
+        }
+    }
+    return NULL;
+}
+
+gnrc_tsch_cell_t *gnrc_tsch_schedule_find_tx(const gnrc_tsch_schedule_t *sched,
+                                             const uint8_t *addr,
+                                             size_t addr_len)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        const gnrc_tsch_cell_t *cell = &sched->cells[i];
+
+        if ((cell->flags & GNRC_TSCH_CELL_TX) && (cell->addr_len > 0) &&
+            (cell->addr_len == addr_len) &&
+            (memcmp(cell->addr, addr, addr_len) == 0)) {
+            return (gnrc_tsch_cell_t *)cell;
+        }
+    }
+    return NULL;
+}
+
+int gnrc_tsch_schedule_set_hopping(gnrc_tsch_schedule_t *sched,
+                                   const uint8_t *seq, size_t len)
+{
+    if ((len == 0) || (len > sizeof(sched->hopping))) {
+        return -EINVAL;
+    }
+    memcpy(sched->hopping, seq, len);
+    sched->hopping_len = len;
+    return 0;
+}
+
+void gnrc_tsch_schedule_reset_stats(gnrc_tsch_schedule_t *sched)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        memset(&sched->cells[i].stats, 0, sizeof(sched->cells[i].stats));
+    }
+}
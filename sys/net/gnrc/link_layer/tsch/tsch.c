@@ -0,0 +1,865 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Implementation of the slotframe MAC
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "random.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/netdev/ieee802154.h"
+#include "net/gnrc/tsch/tsch.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
+#ifdef MODULE_L2FILTER
+#include "net/l2filter.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifndef LOG_LEVEL
+/**
+ * @brief Default log level define
+ */
+#define LOG_LEVEL LOG_WARNING
+#endif
+
+#include "log.h"
+
+/**
+ * @brief   A call into the interface's thread
+ */
+typedef struct {
+    int (*fn)(gnrc_netif_t *netif, void *arg);  /**< function to call */
+    void *arg;                                  /**< argument of fn */
+} _call_t;
+
+/**
+ * @brief   Arguments of @ref gnrc_tsch_set_hopping()
+ */
+typedef struct {
+    const uint8_t *seq;
+    size_t len;
+} _hopping_t;
+
+static void _tsch_init(gnrc_netif_t *netif);
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg);
+
+static const gnrc_netif_ops_t tsch_ops = {
+    .init = _tsch_init,
+    .send = _send,
+    .recv = _recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+    .msg_handler = _tsch_msg_handler,
+};
+
+gnrc_netif_t *gnrc_netif_tsch_create(char *stack, int stacksize,
+                                     char priority, char *name,
+                                     netdev_t *dev)
+{
+    return gnrc_netif_create(stack, stacksize, priority, name, dev,
+                             &tsch_ops);
+}
+
+static inline bool _synced(const gnrc_tsch_t *tsch)
+{
+    return (tsch->state != GNRC_TSCH_STATE_SCAN);
+}
+
+static inline bool _listening(const gnrc_tsch_t *tsch)
+{
+    return !_synced(tsch) ||
+           ((tsch->cell != NULL) && !tsch->tx &&
+            (tsch->cell->flags & GNRC_TSCH_CELL_RX));
+}
+
+static bool _is_time_source(const gnrc_tsch_t *tsch, const uint8_t *addr,
+                            size_t addr_len)
+{
+    return (tsch->state == GNRC_TSCH_STATE_SYNCED) &&
+           (tsch->time_source_len == addr_len) &&
+           (memcmp(tsch->time_source, addr, addr_len) == 0);
+}
+
+static void _set_timer(gnrc_netif_t *netif, uint32_t at, uint16_t type)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int32_t offset = (int32_t)(at - xtimer_now_usec());
+
+    tsch->timer_msg.type = type;
+    xtimer_set_msg(&tsch->timer, (offset > 0) ? (uint32_t)offset : 0,
+                   &tsch->timer_msg, netif->pid);
+}
+
+static void _radio(gnrc_netif_t *netif, netopt_state_t state, uint8_t channel)
+{
+    netdev_t *dev = netif->dev;
+
+    if (state != NETOPT_STATE_SLEEP) {
+        uint16_t chan = channel;
+
+        dev->driver->set(dev, NETOPT_CHANNEL, &chan, sizeof(chan));
+    }
+    dev->driver->set(dev, NETOPT_STATE, &state, sizeof(state));
+}
+
+static void _schedule_beacon(gnrc_tsch_t *tsch)
+{
+    /* randomized, so the beacons of neighbors rarely collide */
+    tsch->beacon_asn = tsch->asn + (GNRC_TSCH_SLOTFRAME_LEN *
+                       random_uint32_range(1, 2 * GNRC_TSCH_BEACON_PERIOD));
+}
+
+static void _scan(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    xtimer_remove(&tsch->timer);
+    tsch->state = GNRC_TSCH_STATE_SCAN;
+    tsch->time_source_len = 0;
+    tsch->cell = NULL;
+    tsch->tx = false;
+    tsch->rx = false;
+    _radio(netif, NETOPT_STATE_IDLE, tsch->schedule.hopping[0]);
+}
+
+static void _resync(gnrc_tsch_t *tsch, uint32_t rx_time)
+{
+    /* frames are sent GNRC_TSCH_TX_OFFSET_US into the slot of the sender */
+    int32_t drift = (int32_t)(rx_time - (tsch->slot_start +
+                                         GNRC_TSCH_TX_OFFSET_US));
+
+    if ((drift > -(int32_t)(GNRC_TSCH_SLOT_US / 2)) &&
+        (drift < (int32_t)(GNRC_TSCH_SLOT_US / 2))) {
+        tsch->slot_start += drift;
+    }
+    tsch->sync_asn = tsch->asn;
+}
+
+static void _beacon_rx(gnrc_netif_t *netif, const uint8_t *src, int src_len,
+                       const void *data, size_t len, uint32_t rx_time)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    const gnrc_tsch_beacon_t *beacon = data;
+
+    if ((len < sizeof(*beacon)) || (src_len <= 0) ||
+        (beacon->slotframe_len != GNRC_TSCH_SLOTFRAME_LEN)) {
+        DEBUG("gnrc_tsch: invalid beacon\n");
+        return;
+    }
+    if (tsch->state == GNRC_TSCH_STATE_SCAN) {
+        memcpy(tsch->time_source, src, src_len);
+        tsch->time_source_len = src_len;
+        tsch->join_prio = beacon->join_prio + 1;
+        tsch->asn = byteorder_ntohl(beacon->asn);
+        tsch->slot_start = rx_time - GNRC_TSCH_TX_OFFSET_US;
+        tsch->sync_asn = tsch->asn;
+        tsch->state = GNRC_TSCH_STATE_SYNCED;
+        _schedule_beacon(tsch);
+        LOG_INFO("[TSCH] synchronized at ASN %" PRIu32 "\n", tsch->asn);
+        _set_timer(netif, tsch->slot_start + GNRC_TSCH_SLOT_US,
+                   GNRC_TSCH_EVENT_SLOT_TYPE);
+    }
+    else if (_is_time_source(tsch, src, src_len)) {
+        /* slots may have been missed */
+        tsch->asn = byteorder_ntohl(beacon->asn);
+        tsch->sync_asn = tsch->asn;
+    }
+}
+
+static gnrc_mac_tx_neighbor_t *_find_neighbor(gnrc_netif_t *netif,
+                                              const uint8_t *addr,
+                                              size_t addr_len)
+{
+    /* the broadcast queue (0) is only served by shared cells */
+    for (unsigned i = 1; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        gnrc_mac_tx_neighbor_t *nb = &netif->mac.tx.neighbors[i];
+
+        if ((nb->l2_addr_len == addr_len) &&
+            (memcmp(nb->l2_addr, addr, addr_len) == 0)) {
+            return nb;
+        }
+    }
+    return NULL;
+}
+
+static inline bool _has_dedicated(gnrc_netif_t *netif,
+                                  const gnrc_mac_tx_neighbor_t *nb)
+{
+    return (nb != &netif->mac.tx.neighbors[0]) &&
+           (gnrc_tsch_schedule_find_tx(&netif->mac.prot.tsch.schedule,
+                                       nb->l2_addr, nb->l2_addr_len) != NULL);
+}
+
+static void _pop(gnrc_netif_t *netif, gnrc_mac_tx_neighbor_t *nb)
+{
+    netif->mac.tx.packet = gnrc_priority_pktqueue_pop(&nb->queue);
+    netif->mac.tx.current_neighbor = nb;
+    netif->mac.prot.tsch.retries = 0;
+}
+
+static bool _tx_dedicated(gnrc_netif_t *netif, gnrc_tsch_cell_t *cell)
+{
+    gnrc_mac_tx_t *tx = &netif->mac.tx;
+    gnrc_mac_tx_neighbor_t *nb;
+
+    if (tx->packet != NULL) {
+        /* retransmission */
+        nb = tx->current_neighbor;
+        return (nb->l2_addr_len == cell->addr_len) &&
+               (memcmp(nb->l2_addr, cell->addr, cell->addr_len) == 0);
+    }
+    nb = _find_neighbor(netif, cell->addr, cell->addr_len);
+    if ((nb == NULL) || (gnrc_priority_pktqueue_length(&nb->queue) == 0)) {
+        return false;
+    }
+    _pop(netif, nb);
+    return true;
+}
+
+static gnrc_mac_tx_neighbor_t *_next_shared(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_neighbor_t *nbs = netif->mac.tx.neighbors;
+
+    if (gnrc_priority_pktqueue_length(&nbs[0].queue) > 0) {
+        return &nbs[0];
+    }
+    /* round robin over the neighbors without a dedicated cell */
+    for (unsigned i = 0; i < GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        unsigned id = 1 + ((tsch->next_neighbor + i) % GNRC_MAC_NEIGHBOR_COUNT);
+        gnrc_mac_tx_neighbor_t *nb = &nbs[id];
+
+        if ((nb->l2_addr_len > 0) &&
+            (gnrc_priority_pktqueue_length(&nb->queue) > 0) &&
+            !_has_dedicated(netif, nb)) {
+            tsch->next_neighbor = id % GNRC_MAC_NEIGHBOR_COUNT;
+            return nb;
+        }
+    }
+    return NULL;
+}
+
+static bool _tx_shared(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_t *tx = &netif->mac.tx;
+    gnrc_mac_tx_neighbor_t *nb = NULL;
+
+    if (tx->packet != NULL) {
+        if (_has_dedicated(netif, tx->current_neighbor)) {
+            return false;
+        }
+    }
+    else {
+        nb = _next_shared(netif);
+    }
+    if ((tx->packet != NULL) || (nb != NULL)) {
+        if (tsch->backoff > 0) {
+            tsch->backoff--;
+            return false;
+        }
+        if (nb != NULL) {
+            _pop(netif, nb);
+        }
+        return true;
+    }
+    if ((int32_t)(tsch->asn - tsch->beacon_asn) >= 0) {
+        tsch->tx_beacon = true;
+        _schedule_beacon(tsch);
+        return true;
+    }
+    return false;
+}
+
+static gnrc_tsch_cell_t *_select(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    uint16_t slot = tsch->asn % GNRC_TSCH_SLOTFRAME_LEN;
+    gnrc_tsch_cell_t *cell = NULL, *rx = NULL, *shared = NULL;
+
+    /* dedicated cells first, then shared cells, else listen */
+    while ((cell = gnrc_tsch_schedule_iter(&tsch->schedule, slot, cell))) {
+        if (cell->flags & GNRC_TSCH_CELL_TX) {
+            if (cell->addr_len == 0) {
+                if (shared == NULL) {
+                    shared = cell;
+                }
+            }
+            else if (_tx_dedicated(netif, cell)) {
+                tsch->tx = true;
+                return cell;
+            }
+            else if (!(cell->flags & GNRC_TSCH_CELL_RX)) {
+                cell->stats.idle++;
+            }
+        }
+        if ((cell->flags & GNRC_TSCH_CELL_RX) && (rx == NULL)) {
+            rx = cell;
+        }
+    }
+    if ((shared != NULL) && _tx_shared(netif)) {
+        tsch->tx = true;
+        return shared;
+    }
+    return rx;
+}
+
+static void _slot_end(gnrc_tsch_t *tsch)
+{
+    if ((tsch->cell != NULL) && !tsch->tx && !tsch->rx) {
+        tsch->cell->stats.idle++;
+    }
+    tsch->cell = NULL;
+    tsch->tx = false;
+    tsch->rx = false;
+}
+
+static void _slot_start(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    uint32_t now = xtimer_now_usec();
+
+    if (!_synced(tsch)) {
+        return;
+    }
+    _slot_end(tsch);
+    tsch->slot_start += GNRC_TSCH_SLOT_US;
+    tsch->asn++;
+    /* skip the slots missed while the thread was busy */
+    while ((int32_t)(now - tsch->slot_start) >= (int32_t)GNRC_TSCH_SLOT_US) {
+        tsch->slot_start += GNRC_TSCH_SLOT_US;
+        tsch->asn++;
+    }
+    if ((tsch->state == GNRC_TSCH_STATE_SYNCED) &&
+        ((tsch->asn - tsch->sync_asn) > GNRC_TSCH_DESYNC_SLOTS)) {
+        LOG_INFO("[TSCH] lost synchronization\n");
+        _scan(netif);
+        return;
+    }
+    tsch->cell = _select(netif);
+    if (tsch->cell == NULL) {
+        _radio(netif, NETOPT_STATE_SLEEP, 0);
+        _set_timer(netif, tsch->slot_start + GNRC_TSCH_SLOT_US,
+                   GNRC_TSCH_EVENT_SLOT_TYPE);
+        return;
+    }
+    _radio(netif, NETOPT_STATE_IDLE,
+           gnrc_tsch_schedule_channel(&tsch->schedule, tsch->asn,
+                                      tsch->cell->channel_offset));
+    if (tsch->tx) {
+        _set_timer(netif, tsch->slot_start + GNRC_TSCH_TX_OFFSET_US,
+                   GNRC_TSCH_EVENT_TX_TYPE);
+    }
+    else {
+        _set_timer(netif, tsch->slot_start + GNRC_TSCH_SLOT_US,
+                   GNRC_TSCH_EVENT_SLOT_TYPE);
+    }
+}
+
+static int _transmit(gnrc_netif_t *netif, uint8_t type, const uint8_t *dst,
+                     size_t dst_len, iolist_t *payload)
+{
+    netdev_t *dev = netif->dev;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    uint8_t flags = (uint8_t)(state->flags & NETDEV_IEEE802154_SEND_MASK);
+    le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
+    int res;
+
+    flags |= type;
+    if ((dst_len == IEEE802154_ADDR_BCAST_LEN) &&
+        (memcmp(dst, ieee802154_addr_bcast, dst_len) == 0)) {
+        flags &= ~IEEE802154_FCF_ACK_REQ;
+    }
+    if ((res = ieee802154_set_frame_hdr(mhr, netif->l2addr, netif->l2addr_len,
+                                        dst, dst_len, dev_pan, dev_pan, flags,
+                                        state->seq++)) == 0) {
+        DEBUG("gnrc_tsch: error preparing frame\n");
+        return -EINVAL;
+    }
+    iolist_t iolist = {
+        .iol_next = payload,
+        .iol_base = mhr,
+        .iol_len = (size_t)res
+    };
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, &iolist);
+#endif
+    return dev->driver->send(dev, &iolist);
+}
+
+static int _send_beacon(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_tsch_beacon_t beacon = {
+        .asn = byteorder_htonl(tsch->asn),
+        .slotframe_len = GNRC_TSCH_SLOTFRAME_LEN,
+        .join_prio = tsch->join_prio,
+    };
+    iolist_t payload = {
+        .iol_next = NULL,
+        .iol_base = &beacon,
+        .iol_len = sizeof(beacon)
+    };
+
+    return _transmit(netif, IEEE802154_FCF_TYPE_BEACON, ieee802154_addr_bcast,
+                     IEEE802154_ADDR_BCAST_LEN, &payload);
+}
+
+static int _send_data(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t *pkt = netif->mac.tx.packet;
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    const uint8_t *dst;
+    size_t dst_len;
+
+    if (hdr->flags &
+        (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        dst = ieee802154_addr_bcast;
+        dst_len = IEEE802154_ADDR_BCAST_LEN;
+#ifdef MODULE_NETSTATS_L2
+        netif->dev->stats.tx_mcast_count++;
+#endif
+    }
+    else {
+        dst = gnrc_netif_hdr_get_dst_addr(hdr);
+        dst_len = hdr->dst_l2addr_len;
+#ifdef MODULE_NETSTATS_L2
+        netif->dev->stats.tx_unicast_count++;
+#endif
+    }
+    return _transmit(netif, IEEE802154_FCF_TYPE_DATA, dst, dst_len,
+                     (iolist_t *)pkt->next);
+}
+
+static void _tx_done(gnrc_netif_t *netif, bool success)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_mac_tx_t *tx = &netif->mac.tx;
+    gnrc_tsch_cell_t *cell = tsch->tx_cell;
+
+    /* devices may report the end of a transmission more than once */
+    if (cell == NULL) {
+        return;
+    }
+    tsch->tx_cell = NULL;
+    if (tsch->tx_beacon) {
+        tsch->tx_beacon = false;
+        return;
+    }
+    if (tx->packet == NULL) {
+        return;
+    }
+    if (!success) {
+        cell->stats.tx_fail++;
+        if (cell->flags & GNRC_TSCH_CELL_SHARED) {
+            tsch->backoff = random_uint32_range(0, 1U << tsch->backoff_exp);
+            if (tsch->backoff_exp < GNRC_TSCH_BACKOFF_EXP_MAX) {
+                tsch->backoff_exp++;
+            }
+        }
+        if (tsch->retries++ < GNRC_TSCH_MAX_RETRIES) {
+            return;
+        }
+        DEBUG("gnrc_tsch: dropping frame after %u retries\n",
+              (unsigned)GNRC_TSCH_MAX_RETRIES);
+    }
+    else if (cell->flags & GNRC_TSCH_CELL_SHARED) {
+        tsch->backoff_exp = GNRC_TSCH_BACKOFF_EXP_MIN;
+        tsch->backoff = 0;
+    }
+    gnrc_pktbuf_release(tx->packet);
+    tx->packet = NULL;
+    tx->current_neighbor = NULL;
+}
+
+static void _tx(gnrc_netif_t *netif)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    int res;
+
+    if (!tsch->tx || (tsch->cell == NULL)) {
+        return;
+    }
+    tsch->tx_cell = tsch->cell;
+    tsch->cell->stats.tx++;
+    res = (tsch->tx_beacon) ? _send_beacon(netif) : _send_data(netif);
+    if (res < 0) {
+        DEBUG("gnrc_tsch: error sending frame: %d\n", res);
+        _tx_done(netif, false);
+    }
+    _set_timer(netif, tsch->slot_start + GNRC_TSCH_SLOT_US,
+               GNRC_TSCH_EVENT_SLOT_TYPE);
+}
+
+static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
+{
+    gnrc_pktsnip_t *snip;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
+    int src_len, dst_len;
+    le_uint16_t _pan_tmp;   /* TODO: hand-up PAN IDs to GNRC? */
+
+    dst_len = ieee802154_get_dst(mhr, dst, &_pan_tmp);
+    src_len = ieee802154_get_src(mhr, src, &_pan_tmp);
+    if ((dst_len < 0) || (src_len < 0)) {
+        DEBUG("_make_netif_hdr: unable to get addresses\n");
+        return NULL;
+    }
+    /* allocate space for header */
+    snip = gnrc_netif_hdr_build(src, (size_t)src_len, dst, (size_t)dst_len);
+    if (snip == NULL) {
+        DEBUG("_make_netif_hdr: no space left in packet buffer\n");
+        return NULL;
+    }
+    /* set broadcast flag for broadcast destination */
+    if ((dst_len == 2) && (dst[0] == 0xff) && (dst[1] == 0xff)) {
+        gnrc_netif_hdr_t *hdr = snip->data;
+        hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    return snip;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    netdev_ieee802154_rx_info_t rx_info;
+    netdev_ieee802154_t *state = (netdev_ieee802154_t *)netif->dev;
+    gnrc_pktsnip_t *pkt, *ieee802154_hdr, *netif_hdr;
+    gnrc_netif_hdr_t *hdr;
+    uint32_t rx_time = (gnrc_netif_get_rx_started(netif)) ? tsch->rx_start
+                                                            : xtimer_now_usec();
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    size_t mhr_len;
+    int nread;
+
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("gnrc_tsch: cannot allocate pktsnip.\n");
+        return NULL;
+    }
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
+#ifdef MODULE_GNRC_PKTCAP
+    if (nread > 0) {
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+    }
+#endif
+    /* radios outside a receive cell would be asleep */
+    if ((nread <= 0) || !_listening(tsch) ||
+        (state->flags & NETDEV_IEEE802154_RAW)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+    if (mhr_len == 0) {
+        DEBUG("gnrc_tsch: illegally formatted frame received\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    nread -= mhr_len;
+    /* mark IEEE 802.15.4 header */
+    ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
+    if (ieee802154_hdr == NULL) {
+        DEBUG("gnrc_tsch: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if (tsch->cell != NULL) {
+        tsch->cell->stats.rx++;
+        tsch->rx = true;
+    }
+    if ((((uint8_t *)ieee802154_hdr->data)[0] & IEEE802154_FCF_TYPE_MASK) ==
+        IEEE802154_FCF_TYPE_BEACON) {
+        uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+        le_uint16_t pan;
+        int src_len = ieee802154_get_src(ieee802154_hdr->data, src, &pan);
+
+        if (_is_time_source(tsch, src, src_len)) {
+            _resync(tsch, rx_time);
+        }
+        _beacon_rx(netif, src, src_len, pkt->data, nread, rx_time);
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+    if (netif_hdr == NULL) {
+        DEBUG("gnrc_tsch: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    hdr = netif_hdr->data;
+#ifdef MODULE_L2FILTER
+    if (!l2filter_pass(dev->filter, gnrc_netif_hdr_get_src_addr(hdr),
+                       hdr->src_l2addr_len)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif_hdr);
+        DEBUG("gnrc_tsch: packet dropped by l2filter\n");
+        return NULL;
+    }
+#endif
+    if (_is_time_source(tsch, gnrc_netif_hdr_get_src_addr(hdr),
+                        hdr->src_l2addr_len)) {
+        _resync(tsch, rx_time);
+    }
+    hdr->lqi = rx_info.lqi;
+    hdr->rssi = rx_info.rssi;
+    hdr->if_pid = thread_getpid();
+    pkt->type = state->proto;
+    gnrc_pktbuf_remove_snip(pkt, ieee802154_hdr);
+    LL_APPEND(pkt, netif_hdr);
+    gnrc_pktbuf_realloc_data(pkt, nread);
+    return pkt;
+}
+
+static void _tsch_event_cb(netdev_t *dev, netdev_event_t event)
+{
+    gnrc_netif_t *netif = (gnrc_netif_t *)dev->context;
+
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
+                      .content = { .ptr = netif } };
+
+        if (msg_send(&msg, netif->pid) <= 0) {
+            LOG_WARNING("WARNING: [TSCH] possibly lost interrupt.\n");
+        }
+        return;
+    }
+    DEBUG("gnrc_tsch: event triggered -> %i\n", event);
+    switch (event) {
+        case NETDEV_EVENT_RX_STARTED:
+            netif->mac.prot.tsch.rx_start = xtimer_now_usec();
+            gnrc_netif_set_rx_started(netif, true);
+            break;
+        case NETDEV_EVENT_RX_COMPLETE: {
+            gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+            gnrc_netif_set_rx_started(netif, false);
+            if ((pkt != NULL) &&
+                !gnrc_netapi_dispatch_receive(pkt->type,
+                                              GNRC_NETREG_DEMUX_CTX_ALL,
+                                              pkt)) {
+                DEBUG("gnrc_tsch: unable to forward packet of type %i\n",
+                      pkt->type);
+                gnrc_pktbuf_release(pkt);
+            }
+            break;
+        }
+        case NETDEV_EVENT_TX_COMPLETE:
+            _tx_done(netif, true);
+            break;
+        case NETDEV_EVENT_TX_NOACK:
+        case NETDEV_EVENT_TX_MEDIUM_BUSY:
+            _tx_done(netif, false);
+            break;
+        default:
+            DEBUG("gnrc_tsch: unhandled event %u\n", event);
+    }
+}
+
+static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    if (pkt->type != GNRC_NETTYPE_NETIF) {
+        DEBUG("gnrc_tsch: first header is not generic netif header\n");
+        gnrc_pktbuf_release(pkt);
+        return -EBADMSG;
+    }
+    /* frames are sent in the cells of their destination */
+    if (!gnrc_mac_queue_tx_packet(&netif->mac.tx, 0, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        LOG_WARNING("WARNING: [TSCH] TX queue full, drop packet\n");
+        return -ENOBUFS;
+    }
+    return 0;
+}
+
+static void _tsch_msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_TSCH_EVENT_SLOT_TYPE:
+            _slot_start(netif);
+            break;
+        case GNRC_TSCH_EVENT_TX_TYPE:
+            _tx(netif);
+            break;
+        case GNRC_TSCH_EVENT_CALL_TYPE: {
+            _call_t *call = msg->content.ptr;
+            msg_t reply = { .type = GNRC_TSCH_EVENT_CALL_TYPE };
+
+            reply.content.value = (uint32_t)call->fn(netif, call->arg);
+            msg_reply(msg, &reply);
+            break;
+        }
+        default:
+            DEBUG("gnrc_tsch: unknown message type 0x%04x\n", msg->type);
+            break;
+    }
+}
+
+static void _tsch_init(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    netopt_enable_t enable = NETOPT_ENABLE;
+    uint16_t src_len = IEEE802154_LONG_ADDRESS_LEN;
+
+    dev->event_callback = _tsch_event_cb;
+    dev->driver->set(dev, NETOPT_RX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+    /* the schedule replaces CSMA */
+    enable = NETOPT_DISABLE;
+    dev->driver->set(dev, NETOPT_CSMA, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_SRC_LEN, &src_len, sizeof(src_len));
+    netif->l2addr_len = dev->driver->get(dev, NETOPT_ADDRESS_LONG,
+                                         &netif->l2addr,
+                                         IEEE802154_LONG_ADDRESS_LEN);
+    memset(tsch, 0, sizeof(*tsch));
+    gnrc_tsch_schedule_init(&tsch->schedule);
+    tsch->backoff_exp = GNRC_TSCH_BACKOFF_EXP_MIN;
+    _scan(netif);
+}
+
+static int _call(gnrc_netif_t *netif, int (*fn)(gnrc_netif_t *, void *),
+                 void *arg)
+{
+    _call_t call = { .fn = fn, .arg = arg };
+    msg_t msg = { .type = GNRC_TSCH_EVENT_CALL_TYPE,
+                  .content = { .ptr = &call } };
+    msg_t reply;
+
+    if ((netif == NULL) || (netif->ops != &tsch_ops)) {
+        return -ENOTSUP;
+    }
+    /* the schedule is only touched by the interface's thread */
+    if (netif->pid == thread_getpid()) {
+        return fn(netif, arg);
+    }
+    msg_send_receive(&msg, &reply, netif->pid);
+    return (int)reply.content.value;
+}
+
+static int _start_coordinator(gnrc_netif_t *netif, void *arg)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+
+    (void)arg;
+    tsch->state = GNRC_TSCH_STATE_COORDINATOR;
+    tsch->join_prio = 0;
+    tsch->time_source_len = 0;
+    tsch->asn = 0;
+    tsch->sync_asn = 0;
+    tsch->beacon_asn = 0;
+    tsch->slot_start = xtimer_now_usec();
+    _set_timer(netif, tsch->slot_start + GNRC_TSCH_SLOT_US,
+               GNRC_TSCH_EVENT_SLOT_TYPE);
+    return 0;
+}
+
+int gnrc_tsch_start_coordinator(gnrc_netif_t *netif)
+{
+    return _call(netif, _start_coordinator, NULL);
+}
+
+static int _cell_add(gnrc_netif_t *netif, void *arg)
+{
+    return gnrc_tsch_schedule_add(&netif->mac.prot.tsch.schedule, arg);
+}
+
+int gnrc_tsch_cell_add(gnrc_netif_t *netif, const gnrc_tsch_cell_t *cell)
+{
+    return _call(netif, _cell_add, (void *)cell);
+}
+
+static int _cell_del(gnrc_netif_t *netif, void *arg)
+{
+    const gnrc_tsch_cell_t *cell = arg;
+
+    return gnrc_tsch_schedule_del(&netif->mac.prot.tsch.schedule, cell->slot,
+                                  cell->channel_offset);
+}
+
+int gnrc_tsch_cell_del(gnrc_netif_t *netif, uint16_t slot,
+                       uint8_t channel_offset)
+{
+    gnrc_tsch_cell_t cell = { .slot = slot, .channel_offset = channel_offset };
+
+    return _call(netif, _cell_del, &cell);
+}
+
+static int _set_hopping(gnrc_netif_t *netif, void *arg)
+{
+    gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    const _hopping_t *hopping = arg;
+    int res;
+
+    res = gnrc_tsch_schedule_set_hopping(&tsch->schedule, hopping->seq,
+                                         hopping->len);
+    if ((res == 0) && !_synced(tsch)) {
+        _radio(netif, NETOPT_STATE_IDLE, tsch->schedule.hopping[0]);
+    }
+    return res;
+}
+
+int gnrc_tsch_set_hopping(gnrc_netif_t *netif, const uint8_t *seq,
+                          size_t len)
+{
+    _hopping_t hopping = { .seq = seq, .len = len };
+
+    return _call(netif, _set_hopping, &hopping);
+}
+
+static int _reset_stats(gnrc_netif_t *netif, void *arg)
+{
+    (void)arg;
+    gnrc_tsch_schedule_reset_stats(&netif->mac.prot.tsch.schedule);
+    return 0;
+}
+
+int gnrc_tsch_reset_stats(gnrc_netif_t *netif)
+{
+    return _call(netif, _reset_stats, NULL);
+}
+
+static int _get_info(gnrc_netif_t *netif, void *arg)
+{
+    const gnrc_tsch_t *tsch = &netif->mac.prot.tsch;
+    gnrc_tsch_info_t *info = arg;
+
+    info->schedule = tsch->schedule;
+    info->asn = tsch->asn;
+    info->state = tsch->state;
+    info->join_prio = tsch->join_prio;
+    return 0;
+}
+
+int gnrc_tsch_get_info(gnrc_netif_t *netif, gnrc_tsch_info_t *info)
+{
+    return _call(netif, _get_info, info);
+}
@@ -23,6 +23,9 @@
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -142,6 +145,9 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         .iol_len = sizeof(ethernet_hdr_t)
     };
 
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, &iolist);
+#endif
 #ifdef MODULE_NETSTATS_L2
     if ((netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) ||
         (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
@@ -183,6 +189,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             DEBUG("gnrc_netif_ethernet: read error.\n");
             goto safe_out;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+#endif
 
         if (nread < bytes_expected) {
             /* we've got less than the expected packet size,
@@ -25,7 +25,8 @@
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6.h"
 #endif /* MODULE_GNRC_IPV6_NIB */
-#ifdef MODULE_NETSTATS_IPV6
+#if defined(MODULE_NETSTATS_IPV6) || defined(MODULE_CSMA_SENDER_ASYNC) || \
+    defined(MODULE_GNRC_MAC_DUTYCYCLE)
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
@@ -46,6 +47,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _record_neighbor(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+static unsigned _tx_retries(netdev_t *dev);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -120,6 +125,27 @@ int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
                     *((netstats_t **)opt->data) = &netif->ipv6.stats;
                     res = sizeof(&netif->ipv6.stats);
                     break;
+#endif
+#ifdef MODULE_CSMA_SENDER_ASYNC
+                case NETSTATS_CSMA:
+                    if (netif->mac.csma.dev != NULL) {
+                        assert(opt->data_len == sizeof(csma_sender_stats_t *));
+                        *((csma_sender_stats_t **)opt->data) =
+                            &netif->mac.csma.stats;
+                        res = sizeof(&netif->mac.csma.stats);
+                    }
+                    break;
+#endif
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+                case NETSTATS_DUTYCYCLE:
+                    /* only initialized by duty-cycled MAC protocols */
+                    if (netif->mac.dutycycle.base_us > 0) {
+                        assert(opt->data_len == sizeof(gnrc_mac_dutycycle_t *));
+                        *((gnrc_mac_dutycycle_t **)opt->data) =
+                            &netif->mac.dutycycle;
+                        res = sizeof(&netif->mac.dutycycle);
+                    }
+                    break;
 #endif
                 default:
                     /* take from device */
@@ -1227,7 +1253,7 @@ static void _configure_netdev(netdev_t *dev)
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_RX_END_IRQ failed: %d\n", res);
     }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
     res = dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
     if (res < 0) {
         DEBUG("gnrc_netif: enable NETOPT_TX_END_IRQ failed: %d\n", res);
@@ -1269,6 +1295,12 @@ static void *_gnrc_netif_thread(void *args)
     _configure_netdev(dev);
     _init_from_device(netif);
     netif->cur_hl = GNRC_NETIF_DEFAULT_HL;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    netstats_nb_init(&netif->neighbors);
+#endif
+#ifdef MODULE_GNRC_MAC
+    netif->mac.csma_conf = CSMA_SENDER_CONF_DEFAULT;
+#endif
 #ifdef MODULE_GNRC_IPV6_NIB
     gnrc_ipv6_nib_init_iface(netif);
 #endif
@@ -1289,6 +1321,9 @@ static void *_gnrc_netif_thread(void *args)
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _record_neighbor(netif, msg.content.ptr);
+#endif
                 res = netif->ops->send(netif, msg.content.ptr);
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
@@ -1352,6 +1387,39 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _record_neighbor(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    if (netif->mac.csma.dev != NULL) {
+        /* queued frames are recorded when they are actually sent */
+        return;
+    }
+#endif
+    if ((pkt->type != GNRC_NETTYPE_NETIF) ||
+        (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                       GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        netstats_nb_record(&netif->neighbors, NULL, 0);
+        return;
+    }
+    netstats_nb_record(&netif->neighbors, gnrc_netif_hdr_get_dst_addr(hdr),
+                       hdr->dst_l2addr_len);
+}
+
+static unsigned _tx_retries(netdev_t *dev)
+{
+    uint8_t retries;
+
+    if (dev->driver->get(dev, NETOPT_TX_RETRIES_NEEDED, &retries,
+                         sizeof(retries)) < 0) {
+        return 0;
+    }
+    return retries;
+}
+#endif
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1375,16 +1443,33 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
                     }
                 }
                 break;
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_BUSY, 0);
+#endif
                 break;
             case NETDEV_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_SUCCESS,
+                                      _tx_retries(dev));
+#endif
+                break;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            case NETDEV_EVENT_TX_NOACK:
+                netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_NOACK,
+                                      _tx_retries(dev));
                 break;
 #endif
             default:
@@ -15,6 +15,9 @@
 
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netif/raw.h"
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -70,6 +73,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+#endif
         if (nread < bytes_expected) {
             /* we've got less then the expected packet size,
              * so free the unused space.*/
@@ -104,6 +110,9 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 #ifdef MODULE_NETSTATS_L2
     dev->stats.tx_unicast_count++;
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, (iolist_t *)pkt);
+#endif
 
     res = dev->driver->send(dev, (iolist_t *)pkt);
     /* release old data */
@@ -20,6 +20,12 @@
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
+#ifdef MODULE_CSMA_SENDER_ASYNC
+#include "net/csma_sender.h"
+#endif
+#ifdef MODULE_GNRC_PKTCAP
+#include "net/gnrc/pktcap.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -30,12 +36,22 @@
 
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+#ifdef MODULE_CSMA_SENDER_ASYNC
+static void _init(gnrc_netif_t *netif);
+static void _msg_handler(gnrc_netif_t *netif, msg_t *msg);
+#endif
 
 static const gnrc_netif_ops_t ieee802154_ops = {
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    .init = _init,
+#endif
     .send = _send,
     .recv = _recv,
     .get = gnrc_netif_get_from_netdev,
     .set = gnrc_netif_set_from_netdev,
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    .msg_handler = _msg_handler,
+#endif
 };
 
 gnrc_netif_t *gnrc_netif_ieee802154_create(char *stack, int stacksize,
@@ -46,6 +62,80 @@ gnrc_netif_t *gnrc_netif_ieee802154_create(char *stack, int stacksize,
                              &ieee802154_ops);
 }
 
+#ifdef MODULE_CSMA_SENDER_ASYNC
+static void _csma_sent(csma_sender_t *csma, iolist_t *iolist, int res)
+{
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    gnrc_netif_t *netif = csma->dev->context;
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t pan;
+    int dst_len = ieee802154_get_dst(iolist->iol_base, dst, &pan);
+
+    if (csma->burst > 0) {
+        /* the TX events of a burst are handled after all of its frames were
+         * sent, but only the last recorded destination is kept, so none of
+         * them can be attributed */
+        netstats_nb_record(&netif->neighbors, NULL, 0);
+    }
+    else if ((dst_len <= 0) ||
+             ((dst_len == IEEE802154_ADDR_BCAST_LEN) &&
+              (memcmp(dst, ieee802154_addr_bcast, dst_len) == 0))) {
+        netstats_nb_record(&netif->neighbors, NULL, 0);
+    }
+    else {
+        netstats_nb_record(&netif->neighbors, dst, dst_len);
+    }
+    if (res == -EBUSY) {
+        netstats_nb_update_tx(&netif->neighbors, NETSTATS_NB_BUSY, 0);
+    }
+#else
+    (void)csma;
+#endif
+    DEBUG("_csma_sent: sent frame %p (res: %d)\n", (void *)iolist, res);
+    (void)res;
+    gnrc_pktbuf_release((gnrc_pktsnip_t *)iolist);
+}
+
+static void _init(gnrc_netif_t *netif)
+{
+    csma_sender_init(&netif->mac.csma, netif->dev, &netif->mac.csma_conf,
+                     _csma_sent);
+    netif->mac.mac_info |= GNRC_NETIF_MAC_INFO_CSMA_ENABLED;
+}
+
+static void _msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    (void)netif;
+    if (msg->type == CSMA_SENDER_MSG_TYPE_BACKOFF) {
+        csma_sender_handle_msg(msg);
+    }
+}
+
+/* queues the frame with the MAC header in place of the netif header */
+static int _csma_queue(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
+                       const uint8_t *mhr, size_t mhr_len)
+{
+    gnrc_pktsnip_t *frame = gnrc_pktbuf_add(pkt->next, mhr, mhr_len,
+                                            GNRC_NETTYPE_UNDEF);
+    int res;
+
+    if (frame == NULL) {
+        DEBUG("_send_ieee802154: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    /* the payload is now referenced by frame instead of pkt */
+    if (pkt->next != NULL) {
+        gnrc_pktbuf_hold(pkt->next, 1);
+    }
+    gnrc_pktbuf_release(pkt);
+    if ((res = csma_sender_queue(&netif->mac.csma, (iolist_t *)frame)) < 0) {
+        gnrc_pktbuf_release(frame);
+    }
+    return res;
+}
+#endif
+
 static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
 {
     gnrc_pktsnip_t *snip;
@@ -95,6 +185,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_PKTCAP
+        gnrc_pktcap_rx(netif, pkt->data, nread);
+#endif
         if (netif->flags & GNRC_NETIF_FLAGS_RAWMODE) {
             /* Raw mode, skip packet processing, but provide rx_info via
              * GNRC_NETTYPE_NETIF */
@@ -238,6 +331,9 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         .iol_len = (size_t)res
     };
 
+#ifdef MODULE_GNRC_PKTCAP
+    gnrc_pktcap_tx(netif, &iolist);
+#endif
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
             (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
@@ -247,6 +343,11 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         netif->dev->stats.tx_unicast_count++;
     }
 #endif
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
+        return _csma_queue(netif, pkt, mhr, res);
+    }
+#endif
 #ifdef MODULE_GNRC_MAC
     if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
         res = csma_sender_csma_ca_send(dev, &iolist, &netif->mac.csma_conf);
@@ -14,22 +14,26 @@
  * @author Martin Landsmann <martin.landsmann@haw-hamburg.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
-#include "bitfield.h"
 #include "net/ipv6/addr.h"
+#include "net/ipv6/lpm.h"
 
 #include "net/gnrc/ipv6/blacklist.h"
 
-extern ipv6_addr_t gnrc_ipv6_blacklist[GNRC_IPV6_BLACKLIST_SIZE];
-extern BITFIELD(gnrc_ipv6_blacklist_set, GNRC_IPV6_BLACKLIST_SIZE);
+extern ipv6_lpm_t gnrc_ipv6_blacklist;
 
 void gnrc_ipv6_blacklist_print(void)
 {
     char addr_str[IPV6_ADDR_MAX_STR_LEN];
-    for (int i = 0; i < GNRC_IPV6_BLACKLIST_SIZE; i++) {
-        if (bf_isset(gnrc_ipv6_blacklist_set, i)) {
-            puts(ipv6_addr_to_str(addr_str, &gnrc_ipv6_blacklist[i], sizeof(addr_str)));
+    for (unsigned i = 0; i < gnrc_ipv6_blacklist.size; i++) {
+        const ipv6_lpm_entry_t *entry = &gnrc_ipv6_blacklist.entries[i];
+
+        if (entry->used) {
+            printf("%s/%u hits: %" PRIu32 "\n",
+                   ipv6_addr_to_str(addr_str, &entry->prefix, sizeof(addr_str)),
+                   entry->prefix_len, entry->hits);
         }
     }
 }
@@ -31,6 +31,10 @@
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#ifdef MODULE_GNRC_RPL_SR
+#include "net/gnrc/rpl/sr.h"
+#include "net/gnrc/rpl/srh.h"
+#endif
 
 #include "net/gnrc/ipv6.h"
 
@@ -457,6 +461,37 @@ static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     return true;
 }
 
+#ifdef MODULE_GNRC_RPL_SR
+/* adds a source routing header to packets a non-storing DODAG root sends
+ * down the DODAG. The header is filled before, so the upper layer checksum
+ * is calculated for the final destination.
+ * Returns 1 if the header was added, 0 if there is no source route and a
+ * negative errno on error */
+static int _add_srh(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    ipv6_hdr_t *hdr = pkt->data;
+    ipv6_addr_t route[GNRC_RPL_SR_MAX_DEPTH];
+    kernel_pid_t iface;
+    int res = gnrc_rpl_sr_get_route(&hdr->dst, route, GNRC_RPL_SR_MAX_DEPTH,
+                                    &iface);
+
+    /* neighbors of the root are reached without routing header */
+    if (res <= 1) {
+        return (res == -ENOENT) ? 0 : res;
+    }
+    if ((netif == NULL) && ((netif = gnrc_netif_get_by_pid(iface)) == NULL)) {
+        return -ENETUNREACH;
+    }
+    if ((res = _fill_ipv6_hdr(netif, pkt)) < 0) {
+        return res;
+    }
+    if ((res = gnrc_rpl_srh_insert(pkt, route, res)) < 0) {
+        return res;
+    }
+    return 1;
+}
+#endif
+
 /* functions for sending */
 static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
@@ -465,6 +500,19 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     gnrc_ipv6_nib_nc_t nce;
 
     DEBUG("ipv6: send unicast\n");
+#ifdef MODULE_GNRC_RPL_SR
+    if (prep_hdr) {
+        int res = _add_srh(netif, pkt);
+
+        if (res < 0) {
+            DEBUG("ipv6: unable to add source routing header\n");
+            gnrc_pktbuf_release_error(pkt, -res);
+            return;
+        }
+        /* the header is complete now */
+        prep_hdr = (res == 0);
+    }
+#endif
     if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
                                           &nce) < 0) {
         /* packet is released by NIB */
@@ -13,22 +13,26 @@
  * @author Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
-#include "bitfield.h"
 #include "net/ipv6/addr.h"
+#include "net/ipv6/lpm.h"
 
 #include "net/gnrc/ipv6/whitelist.h"
 
-extern ipv6_addr_t gnrc_ipv6_whitelist[GNRC_IPV6_WHITELIST_SIZE];
-extern BITFIELD(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE);
+extern ipv6_lpm_t gnrc_ipv6_whitelist;
 
 void gnrc_ipv6_whitelist_print(void)
 {
     char addr_str[IPV6_ADDR_MAX_STR_LEN];
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (bf_isset(gnrc_ipv6_whitelist_set, i)) {
-            puts(ipv6_addr_to_str(addr_str, &gnrc_ipv6_whitelist[i], sizeof(addr_str)));
+    for (unsigned i = 0; i < gnrc_ipv6_whitelist.size; i++) {
+        const ipv6_lpm_entry_t *entry = &gnrc_ipv6_whitelist.entries[i];
+
+        if (entry->used) {
+            printf("%s/%u hits: %" PRIu32 "\n",
+                   ipv6_addr_to_str(addr_str, &entry->prefix, sizeof(addr_str)),
+                   entry->prefix_len, entry->hits);
         }
     }
 }
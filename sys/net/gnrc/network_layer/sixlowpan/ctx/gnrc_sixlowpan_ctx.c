@@ -25,6 +25,10 @@
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+/* changes whenever a context changes for compression */
+static uint16_t _ctx_gen;
+/* earliest time a context used for compression expires */
+static uint32_t _ctx_next_inval = UINT32_MAX;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
@@ -124,11 +128,49 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    if (comp && (_ctx_inval_times[id] < _ctx_next_inval)) {
+        _ctx_next_inval = _ctx_inval_times[id];
+    }
+    _ctx_gen++;
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    mutex_lock(&_ctx_mutex);
+    DEBUG("6lo ctx: remove context %u\n", id);
+    _ctxs[id].prefix_len = 0;
+    _ctx_gen++;
+    mutex_unlock(&_ctx_mutex);
+}
+
+uint16_t gnrc_sixlowpan_ctx_generation(void)
+{
+    uint16_t res;
+
+    mutex_lock(&_ctx_mutex);
+    if (_current_minute() >= _ctx_next_inval) {
+        /* let expired contexts drop their compression flag */
+        _ctx_next_inval = UINT32_MAX;
+        for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+            if (_valid(id) &&
+                (_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
+                (_ctx_inval_times[id] < _ctx_next_inval)) {
+                _ctx_next_inval = _ctx_inval_times[id];
+            }
+        }
+    }
+    res = _ctx_gen;
+    mutex_unlock(&_ctx_mutex);
+    return res;
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (US_PER_SEC * 60);
@@ -139,6 +181,9 @@ static void _update_lifetime(uint8_t id)
     uint32_t now;
 
     if (_ctxs[id].ltime == 0) {
+        if (_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) {
+            _ctx_gen++;
+        }
         _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
         return;
     }
@@ -147,6 +192,9 @@ static void _update_lifetime(uint8_t id)
 
     if (now >= _ctx_inval_times[id]) {
         DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
+        if (_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) {
+            _ctx_gen++;
+        }
         _ctxs[id].ltime = 0;
         _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
     }
@@ -161,6 +209,8 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_next_inval = UINT32_MAX;
+    _ctx_gen++;
 }
 #endif
 
@@ -19,6 +19,7 @@
 #include <stdbool.h>
 
 #include "byteorder.h"
+#include "net/ipv6/ext.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/internal.h"
@@ -32,6 +33,9 @@
 #include "net/gnrc/udp.h"
 
 #include "net/gnrc/sixlowpan/iphc.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+#include "net/sixlowpan/ghc.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -92,6 +96,29 @@
 #define NHC_UDP_8BIT_PORT           (0xF000)
 #define NHC_UDP_8BIT_MASK           (0xFF00)
 
+#define NHC_EXT_ID_MASK             (0xF0)
+#define NHC_EXT_ID                  (0xE0)
+#define NHC_EXT_EID_MASK            (0x0E)
+#define NHC_EXT_NH                  (0x01)
+#define NHC_EXT_EID_HOPOPT          (0x00)
+#define NHC_EXT_EID_RH              (0x02)
+#define NHC_EXT_EID_FRAG            (0x04)
+#define NHC_EXT_EID_DST             (0x06)
+#define NHC_EXT_EID_MOB             (0x08)
+#define NHC_EXT_EID_IPV6            (0x0E)
+#define NHC_EXT_DATA_MAX            (UINT8_MAX)
+
+#define NHC_EXT_OPT_PAD1            (0x00)
+#define NHC_EXT_OPT_PADN            (0x01)
+
+#define NHC_GHC_UDP_ID              (0xD0)
+#define NHC_GHC_ICMPV6_ID           (0xDF)
+
+/* IPHC header with all fields inline */
+#define IPHC_MAX_LEN                (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                                     sizeof(ipv6_hdr_t))
+
 static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
                                          ipv6_addr_t *addr,
                                          eui64_t *iid)
@@ -135,13 +162,37 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
                                    gnrc_pktsnip_t *ipv6, size_t *uncomp_hdr_len)
 {
     uint8_t *payload = sixlo->data;
-    ipv6_hdr_t *ipv6_hdr;
     udp_hdr_t *udp_hdr;
     bool frag = true;   /* datagram is fragmented => infer payload length from
                          * ipv6 snip (== reassembly buffer space) */
     uint16_t payload_len;
-    uint8_t udp_nhc = payload[offset++];
+    uint8_t udp_nhc;
     uint8_t tmp;
+    size_t inline_len;
+
+    if (offset >= sixlo->size) {
+        return 0;
+    }
+    udp_nhc = payload[offset++];
+    switch (udp_nhc & NHC_UDP_PP_MASK) {
+        case NHC_UDP_SD_INLINE:
+            inline_len = 4;
+            break;
+        case NHC_UDP_S_INLINE:
+        case NHC_UDP_D_INLINE:
+            inline_len = 3;
+            break;
+        default:
+            inline_len = 1;
+            break;
+    }
+    if (!(udp_nhc & NHC_UDP_C_ELIDED)) {
+        inline_len += sizeof(udp_hdr->checksum);
+    }
+    if ((offset + inline_len) > sixlo->size) {
+        DEBUG("6lo iphc nhc: UDP header truncated\n");
+        return 0;
+    }
 
     /* realloc size for uncompressed snip, if too small */
     if (ipv6->size < (*uncomp_hdr_len + sizeof(udp_hdr_t))) {
@@ -153,7 +204,6 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
         frag = false;   /* datagram was not fragmented => infer payload length
                          * from original 6Lo packet*/
     }
-    ipv6_hdr = ipv6->data;
     udp_hdr = (udp_hdr_t *)((uint8_t *)ipv6->data + *uncomp_hdr_len);
     network_uint16_t *src_port = &(udp_hdr->src_port);
     network_uint16_t *dst_port = &(udp_hdr->dst_port);
@@ -210,60 +260,90 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
     }
     udp_hdr->length = byteorder_htons(payload_len);
     *uncomp_hdr_len += sizeof(udp_hdr_t);
-    ipv6_hdr->nh = PROTNUM_UDP;
 
     return offset;
 }
 #endif
 
-static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
-                                       gnrc_pktsnip_t *ipv6,
-                                       gnrc_sixlowpan_rbuf_t *rbuf) {
-    if (rbuf != NULL) {
-        gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+static int _iid_from_src(gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                         const ipv6_hdr_t *outer, eui64_t *iid)
+{
+    if (outer != NULL) {
+        /* derived from the encapsulating IPv6 header */
+        memcpy(iid, &outer->src.u64[1], sizeof(eui64_t));
+        return 0;
     }
-    gnrc_pktbuf_release(ipv6);
-    gnrc_pktbuf_release(sixlo);
+    return gnrc_netif_hdr_ipv6_iid_from_src(iface, netif_hdr, iid);
 }
 
-void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
-                              unsigned page)
+static int _iid_from_dst(gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                         const ipv6_hdr_t *outer, eui64_t *iid)
 {
-    assert(sixlo != NULL);
-    gnrc_pktsnip_t *ipv6, *netif;
-    gnrc_netif_hdr_t *netif_hdr;
-    gnrc_netif_t *iface;
-    ipv6_hdr_t *ipv6_hdr;
-    uint8_t *iphc_hdr = sixlo->data;
-    size_t payload_offset = SIXLOWPAN_IPHC_HDR_LEN;
-    size_t uncomp_hdr_len = sizeof(ipv6_hdr_t);
-    gnrc_sixlowpan_ctx_t *ctx = NULL;
-    gnrc_sixlowpan_rbuf_t *rbuf = rbuf_ptr;
-
-    if (rbuf != NULL) {
-        ipv6 = rbuf->pkt;
-        assert(ipv6 != NULL);
+    if (outer != NULL) {
+        /* derived from the encapsulating IPv6 header */
+        memcpy(iid, &outer->dst.u64[1], sizeof(eui64_t));
+        return 0;
     }
-    else {
-        ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
-                               GNRC_NETTYPE_IPV6);
-        if (ipv6 == NULL) {
-            gnrc_pktbuf_release(sixlo);
-            return;
-        }
+    return gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, iid);
+}
+
+/**
+ * @brief   Checks if @p len inline bytes starting at @p pos are missing from
+ *          @p sixlo
+ */
+static inline bool _iphc_truncated(const gnrc_pktsnip_t *sixlo, size_t pos,
+                                   size_t len)
+{
+    if ((pos + len) > sixlo->size) {
+        DEBUG("6lo iphc: IPHC header truncated\n");
+        return true;
     }
+    return false;
+}
 
-    assert(ipv6->size >= sizeof(ipv6_hdr_t));
-    ipv6_hdr = ipv6->data;
+/**
+ * @brief   Decodes an IPHC header
+ *
+ * @param[in] sixlo         The IPHC encoded packet
+ * @param[in] offset        The offset of the IPHC header in @p sixlo
+ * @param[in] iface         The interface the packet was received on
+ * @param[in] netif_hdr     The interface header of the packet
+ * @param[in] outer         The encapsulating IPv6 header for an IPv6 header
+ *                          encoded with NHC, NULL otherwise
+ * @param[out] ipv6_hdr     The decoded IPv6 header. The payload length is not
+ *                          set.
+ *
+ * @return  The offset after the IPHC header on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_decode(gnrc_pktsnip_t *sixlo, size_t offset,
+                           gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                           const ipv6_hdr_t *outer, ipv6_hdr_t *ipv6_hdr)
+{
+    uint8_t *iphc_hdr = (uint8_t *)sixlo->data + offset;
+    size_t payload_offset = SIXLOWPAN_IPHC_HDR_LEN;
+    gnrc_sixlowpan_ctx_t *ctx = NULL;
 
+    if ((offset + SIXLOWPAN_IPHC_HDR_LEN) > sixlo->size) {
+        DEBUG("6lo iphc: IPHC header truncated\n");
+        return 0;
+    }
     if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_CID_EXT) {
+        if (_iphc_truncated(sixlo, offset + payload_offset, 1)) {
+            return 0;
+        }
         payload_offset++;
     }
 
+    /* flow label is partly set by OR-ing */
+    ipv6_hdr->v_tc_fl.u32 = 0;
     ipv6_hdr_set_version(ipv6_hdr);
 
     switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF) {
         case IPHC_TF_ECN_DSCP_FL:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 4)) {
+                return 0;
+            }
             ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
             ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
@@ -271,6 +351,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_TF_ECN_FL:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 3)) {
+                return 0;
+            }
             ipv6_hdr_set_tc_ecn(ipv6_hdr, iphc_hdr[payload_offset] >> 6);
             ipv6_hdr_set_tc_dscp(ipv6_hdr, 0);
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
@@ -279,6 +362,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_TF_ECN_DSCP:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 1)) {
+                return 0;
+            }
             ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
             ipv6_hdr_set_fl(ipv6_hdr, 0);
             break;
@@ -290,11 +376,17 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
     }
 
     if (!(iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH)) {
+        if (_iphc_truncated(sixlo, offset + payload_offset, 1)) {
+            return 0;
+        }
         ipv6_hdr->nh = iphc_hdr[payload_offset++];
     }
 
     switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL) {
         case IPHC_HL_INLINE:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 1)) {
+                return 0;
+            }
             ipv6_hdr->hl = iphc_hdr[payload_offset++];
             break;
 
@@ -323,31 +415,35 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
 
             if (ctx == NULL) {
                 DEBUG("6lo iphc: could not find source context\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
         }
     }
 
-    netif = gnrc_pktsnip_search_type(sixlo, GNRC_NETTYPE_NETIF);
-    assert(netif != NULL);
-    netif_hdr = netif->data;
-    iface = gnrc_netif_hdr_get_netif(netif_hdr);
     switch (iphc_hdr[IPHC2_IDX] & (SIXLOWPAN_IPHC2_SAC | SIXLOWPAN_IPHC2_SAM)) {
 
         case IPHC_SAC_SAM_FULL:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 16)) {
+                return 0;
+            }
             /* take full 128 from inline */
             memcpy(&(ipv6_hdr->src), iphc_hdr + payload_offset, 16);
             payload_offset += 16;
             break;
 
         case IPHC_SAC_SAM_64:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 8)) {
+                return 0;
+            }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->src);
             memcpy(ipv6_hdr->src.u8 + 8, iphc_hdr + payload_offset, 8);
             payload_offset += 8;
             break;
 
         case IPHC_SAC_SAM_16:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 2)) {
+                return 0;
+            }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->src);
             ipv6_hdr->src.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->src.u16[6] = byteorder_htons(0xfe00);
@@ -356,12 +452,10 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_SAC_SAM_L2:
-            if (gnrc_netif_hdr_ipv6_iid_from_src(
-                        iface, netif_hdr, (eui64_t *)(&ipv6_hdr->src.u64[1])
-                    ) < 0) {
+            if (_iid_from_src(iface, netif_hdr, outer,
+                              (eui64_t *)(&ipv6_hdr->src.u64[1])) < 0) {
                 DEBUG("6lo iphc: could not get source's IID\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->src);
             break;
@@ -371,6 +465,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_SAC_SAM_CTX_64:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 8)) {
+                return 0;
+            }
             assert(ctx != NULL);
             memcpy(ipv6_hdr->src.u8 + 8, iphc_hdr + payload_offset, 8);
             ipv6_addr_init_prefix(&ipv6_hdr->src, &ctx->prefix,
@@ -379,6 +476,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_SAC_SAM_CTX_16:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 2)) {
+                return 0;
+            }
             assert(ctx != NULL);
             ipv6_hdr->src.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->src.u16[6] = byteorder_htons(0xfe00);
@@ -390,12 +490,10 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
 
         case IPHC_SAC_SAM_CTX_L2:
             assert(ctx != NULL);
-            if (gnrc_netif_hdr_ipv6_iid_from_src(
-                        iface, netif_hdr, (eui64_t *)(&ipv6_hdr->src.u64[1])
-                    ) < 0) {
+            if (_iid_from_src(iface, netif_hdr, outer,
+                              (eui64_t *)(&ipv6_hdr->src.u64[1])) < 0) {
                 DEBUG("6lo iphc: could not get source's IID\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
             ipv6_addr_init_prefix(&ipv6_hdr->src, &ctx->prefix,
                                   ctx->prefix_len);
@@ -414,8 +512,7 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
 
             if (ctx == NULL) {
                 DEBUG("6lo iphc: could not find destination context\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
         }
     }
@@ -424,17 +521,26 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                                    SIXLOWPAN_IPHC2_DAM)) {
         case IPHC_M_DAC_DAM_U_FULL:
         case IPHC_M_DAC_DAM_M_FULL:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 16)) {
+                return 0;
+            }
             memcpy(&(ipv6_hdr->dst.u8), iphc_hdr + payload_offset, 16);
             payload_offset += 16;
             break;
 
         case IPHC_M_DAC_DAM_U_64:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 8)) {
+                return 0;
+            }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->dst);
             memcpy(ipv6_hdr->dst.u8 + 8, iphc_hdr + payload_offset, 8);
             payload_offset += 8;
             break;
 
         case IPHC_M_DAC_DAM_U_16:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 2)) {
+                return 0;
+            }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->dst);
             ipv6_hdr->dst.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->dst.u16[6] = byteorder_htons(0xfe00);
@@ -443,17 +549,18 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_U_L2:
-            if (gnrc_netif_hdr_ipv6_iid_from_dst(
-                        iface, netif_hdr, (eui64_t *)(&ipv6_hdr->dst.u64[1])
-                    ) < 0) {
+            if (_iid_from_dst(iface, netif_hdr, outer,
+                              (eui64_t *)(&ipv6_hdr->dst.u64[1])) < 0) {
                 DEBUG("6lo iphc: could not get destination's IID\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->dst);
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_64:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 8)) {
+                return 0;
+            }
             memcpy(ipv6_hdr->dst.u8 + 8, iphc_hdr + payload_offset, 8);
             ipv6_addr_init_prefix(&ipv6_hdr->dst, &ctx->prefix,
                                   ctx->prefix_len);
@@ -461,6 +568,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_16:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 2)) {
+                return 0;
+            }
             ipv6_hdr->dst.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->dst.u16[6] = byteorder_htons(0xfe00);
             memcpy(ipv6_hdr->dst.u8 + 14, iphc_hdr + payload_offset, 2);
@@ -470,18 +580,19 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_L2:
-            if (gnrc_netif_hdr_ipv6_iid_from_dst(
-                        iface, netif_hdr, (eui64_t *)(&ipv6_hdr->dst.u64[1])
-                    ) < 0) {
+            if (_iid_from_dst(iface, netif_hdr, outer,
+                              (eui64_t *)(&ipv6_hdr->dst.u64[1])) < 0) {
                 DEBUG("6lo iphc: could not get destination's IID\n");
-                _recv_error_release(sixlo, ipv6, rbuf);
-                return;
+                return 0;
             }
             ipv6_addr_init_prefix(&ipv6_hdr->dst, &ctx->prefix,
                                   ctx->prefix_len);
             break;
 
         case IPHC_M_DAC_DAM_M_48:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 6)) {
+                return 0;
+            }
             /* ffXX::00XX:XXXX:XXXX */
             ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
@@ -491,6 +602,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_M_32:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 4)) {
+                return 0;
+            }
             /* ffXX::00XX:XXXX */
             ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
@@ -500,6 +614,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_M_8:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 1)) {
+                return 0;
+            }
             /* ff02::XX: */
             ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
@@ -508,6 +625,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
 
         case IPHC_M_DAC_DAM_M_UC_PREFIX:
+            if (_iphc_truncated(sixlo, offset + payload_offset, 6)) {
+                return 0;
+            }
             do {
                 uint8_t orig_ctx_len = ctx->prefix_len;
 
@@ -523,7 +643,7 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 ipv6_hdr->dst.u8[3] = ctx->prefix_len;
                 ipv6_addr_init_prefix((ipv6_addr_t *)ipv6_hdr->dst.u8 + 4,
                                       &ctx->prefix, ctx->prefix_len);
-                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset + 2, 4);
+                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset, 4);
 
                 payload_offset += 4;
                 ctx->prefix_len = orig_ctx_len;
@@ -535,24 +655,351 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
     }
 
+    return offset + payload_offset;
+}
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-    if (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
-        switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
-            case NHC_UDP_ID: {
-                payload_offset = _iphc_nhc_udp_decode(sixlo, payload_offset,
-                                                      ipv6, &uncomp_hdr_len);
-                if (payload_offset == 0) {
-                    _recv_error_release(sixlo, ipv6, rbuf);
-                    return;
-                }
+static bool _ipv6_reserve(gnrc_pktsnip_t *ipv6, size_t size)
+{
+    if ((ipv6->size < size) && (gnrc_pktbuf_realloc_data(ipv6, size) != 0)) {
+        DEBUG("6lo iphc nhc: not enough buffer space\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief   Decodes IPv6 extension header NHC
+ *
+ * @param[in] sixlo                 The IPHC encoded packet
+ * @param[in] offset                The offset of the NHC encoded header
+ * @param[out] ipv6                 The packet to write the decoded data to
+ * @param[in,out] nh_pos            Offset of the next header field in @p ipv6
+ *                                  that refers to the header. Set to the
+ *                                  offset of the header's next header field.
+ * @param[in,out] uncomp_hdr_len    Number of bytes already decoded into
+ *                                  @p ipv6. Adds size of the extension header.
+ *
+ * @return  The offset after the NHC encoded header on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_nhc_ext_decode(gnrc_pktsnip_t *sixlo, size_t offset,
+                                   gnrc_pktsnip_t *ipv6, size_t *nh_pos,
+                                   size_t *uncomp_hdr_len)
+{
+    uint8_t *payload = sixlo->data;
+    uint8_t ext_nhc = payload[offset++];
+    uint8_t nh = PROTNUM_RESERVED, protnum, *data;
+    size_t len, hdr_len, pad;
+    ipv6_ext_t *ext;
+
+    switch (ext_nhc & NHC_EXT_EID_MASK) {
+        case NHC_EXT_EID_HOPOPT:
+            protnum = PROTNUM_IPV6_EXT_HOPOPT;
+            break;
+        case NHC_EXT_EID_RH:
+            protnum = PROTNUM_IPV6_EXT_RH;
+            break;
+        case NHC_EXT_EID_FRAG:
+            protnum = PROTNUM_IPV6_EXT_FRAG;
+            break;
+        case NHC_EXT_EID_DST:
+            protnum = PROTNUM_IPV6_EXT_DST;
+            break;
+        case NHC_EXT_EID_MOB:
+            protnum = PROTNUM_IPV6_EXT_MOB;
+            break;
+        default:
+            DEBUG("6lo iphc nhc: reserved extension header ID\n");
+            return 0;
+    }
+    if (!(ext_nhc & NHC_EXT_NH)) {
+        if (offset >= sixlo->size) {
+            return 0;
+        }
+        nh = payload[offset++];
+    }
+    if (offset >= sixlo->size) {
+        return 0;
+    }
+    len = payload[offset++];
+    if ((offset + len) > sixlo->size) {
+        DEBUG("6lo iphc nhc: extension header truncated\n");
+        return 0;
+    }
+    hdr_len = sizeof(ipv6_ext_t) + len;
+    switch (protnum) {
+        case PROTNUM_IPV6_EXT_HOPOPT:
+        case PROTNUM_IPV6_EXT_DST:
+            /* trailing padding might have been elided */
+            hdr_len = (hdr_len + IPV6_EXT_LEN_UNIT - 1) &
+                      ~(IPV6_EXT_LEN_UNIT - 1);
+            break;
+        case PROTNUM_IPV6_EXT_FRAG:
+            if (hdr_len != IPV6_EXT_LEN_UNIT) {
+                return 0;
+            }
+            break;
+        default:
+            if ((hdr_len % IPV6_EXT_LEN_UNIT) != 0) {
+                return 0;
+            }
+            break;
+    }
+    if (!_ipv6_reserve(ipv6, *uncomp_hdr_len + hdr_len)) {
+        return 0;
+    }
+    data = ipv6->data;
+    data[*nh_pos] = protnum;
+    ext = (ipv6_ext_t *)&data[*uncomp_hdr_len];
+    ext->nh = nh;
+    /* the second byte of the fragment header is reserved */
+    ext->len = (protnum == PROTNUM_IPV6_EXT_FRAG) ?
+               0 : (hdr_len / IPV6_EXT_LEN_UNIT) - 1;
+    data = (uint8_t *)(ext + 1);
+    memcpy(data, &payload[offset], len);
+    /* restore padding */
+    pad = hdr_len - sizeof(ipv6_ext_t) - len;
+    if (pad == 1) {
+        data[len] = NHC_EXT_OPT_PAD1;
+    }
+    else if (pad > 1) {
+        data[len] = NHC_EXT_OPT_PADN;
+        data[len + 1] = pad - 2;
+        memset(&data[len + 2], 0, pad - 2);
+    }
+    *nh_pos = *uncomp_hdr_len;
+    *uncomp_hdr_len += hdr_len;
+    return offset + len;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+/**
+ * @brief   Decodes GHC for UDP or ICMPv6, the rest of the packet is the
+ *          compressed data.
+ *
+ * @return  The offset after the compressed data on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_ghc_decode(gnrc_pktsnip_t *sixlo, size_t offset,
+                               gnrc_pktsnip_t *ipv6, size_t ip_pos,
+                               size_t nh_pos, size_t *uncomp_hdr_len)
+{
+    uint8_t dict[SIXLOWPAN_GHC_DICT_LEN];
+    uint8_t *payload = sixlo->data;
+    const ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)((uint8_t *)ipv6->data + ip_pos);
+    uint8_t protnum = (payload[offset++] == NHC_GHC_UDP_ID) ? PROTNUM_UDP :
+                                                              PROTNUM_ICMPV6;
+    int res;
+
+    sixlowpan_ghc_dict_init(dict, &ipv6_hdr->src, &ipv6_hdr->dst);
+    /* determine length first */
+    res = sixlowpan_ghc_decompress(dict, &payload[offset], sixlo->size - offset,
+                                   NULL, 0);
+    if ((res < 0) || !_ipv6_reserve(ipv6, *uncomp_hdr_len + res)) {
+        DEBUG("6lo iphc ghc: unable to decompress\n");
+        return 0;
+    }
+    ((uint8_t *)ipv6->data)[nh_pos] = protnum;
+    sixlowpan_ghc_decompress(dict, &payload[offset], sixlo->size - offset,
+                             (uint8_t *)ipv6->data + *uncomp_hdr_len, res);
+    *uncomp_hdr_len += res;
+    return sixlo->size;
+}
+#endif
+
+/**
+ * @brief   Decodes the NHC encoded headers following an IPHC header
+ *
+ * @param[in] sixlo                 The IPHC encoded packet
+ * @param[in] offset                The offset of the first NHC encoded header
+ * @param[in] iface                 The interface the packet was received on
+ * @param[in] netif_hdr             The interface header of the packet
+ * @param[out] ipv6                 The packet to write the decoded data to
+ * @param[in] rbuf                  Reassembly buffer entry of the packet,
+ *                                  NULL if not fragmented
+ * @param[in,out] uncomp_hdr_len    Number of bytes already decoded into
+ *                                  @p ipv6. Adds size of the decoded headers.
+ *
+ * @return  The offset after the NHC encoded headers on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_nhc_decode(gnrc_pktsnip_t *sixlo, size_t offset,
+                               gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                               gnrc_pktsnip_t *ipv6,
+                               gnrc_sixlowpan_rbuf_t *rbuf,
+                               size_t *uncomp_hdr_len)
+{
+    uint8_t *payload = sixlo->data;
+    /* offsets in ipv6, since the data might get reallocated */
+    size_t nh_pos = offsetof(ipv6_hdr_t, nh);   /* field referring to next */
+    size_t ip_pos = 0;                          /* innermost IPv6 header */
+    bool nhc = true;
+
+#ifndef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+    (void)rbuf;
+#endif
+    while (nhc) {
+        uint8_t nhc_id;
+
+        if (offset >= sixlo->size) {
+            DEBUG("6lo iphc nhc: NHC header missing\n");
+            return 0;
+        }
+        nhc_id = payload[offset];
+        if ((nhc_id & NHC_ID_MASK) == NHC_UDP_ID) {
+            offset = _iphc_nhc_udp_decode(sixlo, offset, ipv6, uncomp_hdr_len);
+            if (offset > 0) {
+                ((uint8_t *)ipv6->data)[nh_pos] = PROTNUM_UDP;
+            }
+            nhc = false;
+        }
+        else if (nhc_id == (NHC_EXT_ID | NHC_EXT_EID_IPV6)) {
+            size_t inner_pos = *uncomp_hdr_len;
+            uint8_t *data;
+
+            if (!_ipv6_reserve(ipv6, inner_pos + sizeof(ipv6_hdr_t))) {
+                return 0;
+            }
+            data = ipv6->data;
+            data[nh_pos] = PROTNUM_IPV6;
+            /* the NH bit of the inner IPHC header */
+            nhc = ((offset + 1) < sixlo->size) &&
+                  (payload[offset + 1] & SIXLOWPAN_IPHC1_NH);
+            offset = _iphc_decode(sixlo, offset + 1, iface, netif_hdr,
+                                  (ipv6_hdr_t *)&data[ip_pos],
+                                  (ipv6_hdr_t *)&data[inner_pos]);
+            ip_pos = inner_pos;
+            nh_pos = inner_pos + offsetof(ipv6_hdr_t, nh);
+            *uncomp_hdr_len += sizeof(ipv6_hdr_t);
+        }
+        else if ((nhc_id & NHC_EXT_ID_MASK) == NHC_EXT_ID) {
+            nhc = (nhc_id & NHC_EXT_NH);
+            offset = _iphc_nhc_ext_decode(sixlo, offset, ipv6, &nh_pos,
+                                          uncomp_hdr_len);
+        }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+        else if (((nhc_id == NHC_GHC_UDP_ID) ||
+                  (nhc_id == NHC_GHC_ICMPV6_ID)) && (rbuf == NULL)) {
+            /* compressed data can't span multiple fragments */
+            offset = _iphc_ghc_decode(sixlo, offset, ipv6, ip_pos, nh_pos,
+                                      uncomp_hdr_len);
+            nhc = false;
+        }
+#endif
+        else {
+            DEBUG("6lo iphc nhc: unsupported NHC header 0x%02x\n",
+                  (unsigned)nhc_id);
+            return 0;
+        }
+        if (offset == 0) {
+            return 0;
+        }
+    }
+    return offset;
+}
+
+/* sets the payload length of the IPv6 headers encapsulated in ipv6 */
+static void _iphc_nhc_set_inner_len(gnrc_pktsnip_t *ipv6, size_t uncomp_hdr_len)
+{
+    uint8_t *data = ipv6->data;
+    uint8_t nh = ((ipv6_hdr_t *)data)->nh;
+    size_t pos = sizeof(ipv6_hdr_t);
+
+    while (pos < uncomp_hdr_len) {
+        switch (nh) {
+            case PROTNUM_IPV6: {
+                ipv6_hdr_t *inner = (ipv6_hdr_t *)&data[pos];
+
+                inner->len = byteorder_htons(ipv6->size - pos -
+                                             sizeof(ipv6_hdr_t));
+                nh = inner->nh;
+                pos += sizeof(ipv6_hdr_t);
                 break;
             }
-            default:
+            case PROTNUM_IPV6_EXT_FRAG:
+                nh = data[pos];
+                pos += IPV6_EXT_LEN_UNIT;
                 break;
+            case PROTNUM_IPV6_EXT_HOPOPT:
+            case PROTNUM_IPV6_EXT_RH:
+            case PROTNUM_IPV6_EXT_DST:
+            case PROTNUM_IPV6_EXT_MOB:
+                nh = data[pos];
+                pos += (data[pos + 1] + 1) * IPV6_EXT_LEN_UNIT;
+                break;
+            default:
+                return;
+        }
+    }
+}
+#endif
+
+static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
+                                       gnrc_pktsnip_t *ipv6,
+                                       gnrc_sixlowpan_rbuf_t *rbuf) {
+    if (rbuf != NULL) {
+        gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+    }
+    gnrc_pktbuf_release(ipv6);
+    gnrc_pktbuf_release(sixlo);
+}
+
+void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
+                              unsigned page)
+{
+    assert(sixlo != NULL);
+    gnrc_pktsnip_t *ipv6, *netif;
+    gnrc_netif_hdr_t *netif_hdr;
+    gnrc_netif_t *iface;
+    ipv6_hdr_t *ipv6_hdr;
+    size_t payload_offset;
+    size_t uncomp_hdr_len = sizeof(ipv6_hdr_t);
+    gnrc_sixlowpan_rbuf_t *rbuf = rbuf_ptr;
+
+    if (rbuf != NULL) {
+        ipv6 = rbuf->pkt;
+        assert(ipv6 != NULL);
+    }
+    else {
+        ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+                               GNRC_NETTYPE_IPV6);
+        if (ipv6 == NULL) {
+            gnrc_pktbuf_release(sixlo);
+            return;
+        }
+    }
+
+    assert(ipv6->size >= sizeof(ipv6_hdr_t));
+    ipv6_hdr = ipv6->data;
+
+    netif = gnrc_pktsnip_search_type(sixlo, GNRC_NETTYPE_NETIF);
+    assert(netif != NULL);
+    netif_hdr = netif->data;
+    iface = gnrc_netif_hdr_get_netif(netif_hdr);
+
+    payload_offset = _iphc_decode(sixlo, 0, iface, netif_hdr, NULL, ipv6_hdr);
+    if (payload_offset == 0) {
+        _recv_error_release(sixlo, ipv6, rbuf);
+        return;
+    }
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    if (((uint8_t *)sixlo->data)[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
+        payload_offset = _iphc_nhc_decode(sixlo, payload_offset, iface,
+                                          netif_hdr, ipv6, rbuf,
+                                          &uncomp_hdr_len);
+        if (payload_offset == 0) {
+            _recv_error_release(sixlo, ipv6, rbuf);
+            return;
         }
     }
 #endif
+    if (payload_offset > sixlo->size) {
+        DEBUG("6lo iphc: compressed headers exceed frame\n");
+        _recv_error_release(sixlo, ipv6, rbuf);
+        return;
+    }
     uint16_t payload_len;
     if (rbuf != NULL) {
         /* for a fragmented datagram we know the overall length already */
@@ -565,7 +1012,7 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                        payload_offset - sizeof(ipv6_hdr_t));
     }
     if ((rbuf == NULL) &&
-        (gnrc_pktbuf_realloc_data(ipv6, uncomp_hdr_len + payload_len) != 0)) {
+        (gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t) + payload_len) != 0)) {
         DEBUG("6lo iphc: no space left to copy payload\n");
         _recv_error_release(sixlo, ipv6, rbuf);
         return;
@@ -573,6 +1020,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
     /* re-assign IPv6 header in case realloc changed the address */
     ipv6_hdr = ipv6->data;
     ipv6_hdr->len = byteorder_htons(payload_len);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    _iphc_nhc_set_inner_len(ipv6, uncomp_hdr_len);
+#endif
     memcpy(((uint8_t *)ipv6->data) + uncomp_hdr_len,
            ((uint8_t *)sixlo->data) + payload_offset,
            sixlo->size - payload_offset);
@@ -591,9 +1041,8 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
 static inline size_t iphc_nhc_udp_encode(uint8_t *nhc_data,
-                                         const gnrc_pktsnip_t *udp)
+                                         const udp_hdr_t *udp_hdr)
 {
-    const udp_hdr_t *udp_hdr = udp->data;
     uint16_t src_port = byteorder_ntohs(udp_hdr->src_port);
     uint16_t dst_port = byteorder_ntohs(udp_hdr->dst_port);
     size_t nhc_len = 1; /* skip over NHC header */
@@ -640,86 +1089,26 @@ static inline size_t iphc_nhc_udp_encode(uint8_t *nhc_data,
 }
 #endif
 
-static inline bool _compressible(gnrc_pktsnip_t *hdr)
+/* address part of an IPHC header */
+typedef struct {
+    uint8_t iphc2;      /* CID, SAC, SAM, M, DAC, and DAM bits */
+    uint8_t cid_ext;    /* context identifier extension */
+    uint8_t inline_len; /* length of inline_addrs */
+    uint8_t inline_addrs[2 * sizeof(ipv6_addr_t)];  /* inline address bytes */
+} _iphc_addrs_t;
+
+/* outer is the encapsulating IPv6 header for an IPv6 header encoded with NHC,
+ * the fully elided addresses are then derived from it */
+static bool _compress_addrs(gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                            const ipv6_hdr_t *outer, ipv6_hdr_t *ipv6_hdr,
+                            _iphc_addrs_t *addrs)
 {
-    switch (hdr->type) {
-        case GNRC_NETTYPE_UNDEF:    /* when forwarded */
-        case GNRC_NETTYPE_IPV6:
-#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC) && defined(MODULE_GNRC_UDP)
-        case GNRC_NETTYPE_UDP:
-            return true;
-#endif
-        default:
-            return false;
-    }
-}
-
-void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
-{
-    assert(pkt != NULL);
-    gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr;
-    gnrc_netif_t *iface = gnrc_netif_hdr_get_netif(netif_hdr);
-    uint8_t *iphc_hdr;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
+    uint8_t *inline_addrs = addrs->inline_addrs;
     bool addr_comp = false;
-    size_t dispatch_size = 0;
-    /* datagram size before compression */
-    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-
-    (void)ctx;
-    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
-    /* determine maximum dispatch size and write protect all headers until
-     * then because they will be removed */
-    while (_compressible(ptr)) {
-        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
-
-        if (tmp == NULL) {
-            DEBUG("6lo iphc: unable to write protect compressible header\n");
-            if (addr_comp) {    /* addr_comp was used as release indicator */
-                gnrc_pktbuf_release(pkt);
-            }
-            return;
-        }
-        ptr = tmp;
-        if (dispatch == NULL) {
-            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
-             * we shouldn't do it again */
-            pkt->next = ptr;    /* reset original packet */
-        }
-        else {
-            dispatch->next = ptr;
-        }
-        if (ptr->type == GNRC_NETTYPE_UNDEF) {
-            /* most likely UDP for now so use that (XXX: extend if extension
-             * headers make problems) */
-            dispatch_size += sizeof(udp_hdr_t);
-            break;  /* nothing special after UDP so quit even if more UNDEF
-                     * come */
-        }
-        else {
-            dispatch_size += ptr->size;
-        }
-        dispatch = ptr; /* use dispatch as temporary point for prev */
-        ptr = ptr->next;
-    }
-    ipv6_hdr = pkt->next->data;
-    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
-                               GNRC_NETTYPE_SIXLOWPAN);
-
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
 
-    iphc_hdr = dispatch->data;
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    addrs->iphc2 = 0;
+    addrs->cid_ext = 0;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -740,94 +1129,16 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         }
     }
 
-    /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
-    if (((src_ctx != NULL) &&
-            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
-        ((dst_ctx != NULL) &&
-            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
-        /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
-    }
-
-    /* check for compressible next header */
-    switch (ipv6_hdr->nh) {
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            break;
-#endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
-    }
-
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        addrs->iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if (src_ctx != NULL) {
             /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
+            addrs->iphc2 |= SIXLOWPAN_IPHC2_SAC;
 
             if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
+                addrs->cid_ext |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
             }
         }
 
@@ -835,43 +1146,47 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             eui64_t iid;
             iid.uint64.u64 = 0;
 
-            gnrc_netif_acquire(iface);
-            if (gnrc_netif_ipv6_get_iid(iface, &iid) < 0) {
-                DEBUG("6lo iphc: could not get interface's IID\n");
+            if (outer != NULL) {
+                iid.uint64.u64 = outer->src.u64[1].u64;
+            }
+            else {
+                gnrc_netif_acquire(iface);
+                if (gnrc_netif_ipv6_get_iid(iface, &iid) < 0) {
+                    DEBUG("6lo iphc: could not get interface's IID\n");
+                    gnrc_netif_release(iface);
+                    return false;
+                }
                 gnrc_netif_release(iface);
-                gnrc_pktbuf_release(pkt);
-                return;
             }
-            gnrc_netif_release(iface);
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
+                addrs->iphc2 |= IPHC_SAC_SAM_L2;
                 addr_comp = true;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
-                inline_pos += 2;
+                addrs->iphc2 |= IPHC_SAC_SAM_16;
+                memcpy(inline_addrs, ipv6_hdr->src.u16 + 7, 2);
+                inline_addrs += 2;
                 addr_comp = true;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
-                inline_pos += 8;
+                addrs->iphc2 |= IPHC_SAC_SAM_64;
+                memcpy(inline_addrs, ipv6_hdr->src.u64 + 1, 8);
+                inline_addrs += 8;
                 addr_comp = true;
             }
         }
 
         if (!addr_comp) {
             /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
-            inline_pos += 16;
+            addrs->iphc2 |= IPHC_SAC_SAM_FULL;
+            memcpy(inline_addrs, &ipv6_hdr->src, 16);
+            inline_addrs += 16;
         }
     }
 
@@ -879,7 +1194,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        addrs->iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -891,27 +1206,27 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_8;
+                *(inline_addrs++) = ipv6_hdr->dst.u8[15];
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
-                inline_pos += 3;
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_32;
+                *(inline_addrs++) = ipv6_hdr->dst.u8[1];
+                memcpy(inline_addrs, ipv6_hdr->dst.u8 + 13, 3);
+                inline_addrs += 3;
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
-                inline_pos += 5;
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_48;
+                *(inline_addrs++) = ipv6_hdr->dst.u8[1];
+                memcpy(inline_addrs, ipv6_hdr->dst.u8 + 11, 5);
+                inline_addrs += 5;
                 addr_comp = true;
             }
         }
@@ -931,102 +1246,714 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+                addrs->iphc2 |= SIXLOWPAN_IPHC2_DAC;
                 if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                    addrs->cid_ext |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
                 }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
-                inline_pos += 4;
+                *(inline_addrs++) = ipv6_hdr->dst.u8[1];
+                *(inline_addrs++) = ipv6_hdr->dst.u8[2];
+                memcpy(inline_addrs, ipv6_hdr->dst.u16 + 6, 4);
+                inline_addrs += 4;
                 addr_comp = true;
             }
         }
     }
     else if (((dst_ctx != NULL) ||
-              ipv6_addr_is_link_local(&ipv6_hdr->dst)) && (netif_hdr->dst_l2addr_len > 0)) {
+              ipv6_addr_is_link_local(&ipv6_hdr->dst)) &&
+             ((outer != NULL) || (netif_hdr->dst_l2addr_len > 0))) {
         eui64_t iid;
 
         if (dst_ctx != NULL) {
             /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            addrs->iphc2 |= SIXLOWPAN_IPHC2_DAC;
 
             if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                addrs->cid_ext |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
             }
         }
 
-        if (gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, &iid) < 0) {
+        if (_iid_from_dst(iface, netif_hdr, outer, &iid) < 0) {
             DEBUG("6lo iphc: could not get destination's IID\n");
-            gnrc_pktbuf_release(pkt);
-            return;
+            return false;
         }
 
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_L2;
             addr_comp = true;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
-            inline_pos += 2;
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_16;
+            memcpy(inline_addrs, &(ipv6_hdr->dst.u16[7]), 2);
+            inline_addrs += 2;
             addr_comp = true;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
-            inline_pos += 8;
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_64;
+            memcpy(inline_addrs, &(ipv6_hdr->dst.u8[8]), 8);
+            inline_addrs += 8;
             addr_comp = true;
         }
     }
 
     if (!addr_comp) {
         /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
-        inline_pos += 16;
+        addrs->iphc2 |= IPHC_SAC_SAM_FULL;
+        memcpy(inline_addrs, &ipv6_hdr->dst, 16);
+        inline_addrs += 16;
+    }
+
+    if (addrs->cid_ext != 0) {
+        /* add context identifier extension */
+        addrs->iphc2 |= SIXLOWPAN_IPHC2_CID_EXT;
+    }
+    addrs->inline_len = inline_addrs - addrs->inline_addrs;
+    return true;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+/* compressed addresses of a recently sent packet */
+typedef struct {
+    ipv6_addr_t src;                            /* IPv6 source address */
+    ipv6_addr_t dst;                            /* IPv6 destination address */
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /* link-layer destination */
+    uint8_t own_l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /* interface's address */
+    kernel_pid_t if_pid;                        /* KERNEL_PID_UNDEF if unused */
+    uint16_t ctx_gen;                           /* generation of the contexts */
+    uint8_t l2addr_len;                         /* length of l2addr */
+    uint8_t own_l2addr_len;                     /* length of own_l2addr */
+    _iphc_addrs_t addrs;                        /* the compressed addresses */
+} _iphc_cache_entry_t;
+
+/* only used by the 6LoWPAN thread, so no locking required */
+static _iphc_cache_entry_t _iphc_cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+
+static _iphc_cache_entry_t *_cache_entry(ipv6_hdr_t *ipv6_hdr)
+{
+    /* the link-layer destination is left out, it is usually the source of the
+     * destination's IID anyway */
+    unsigned idx = ipv6_hdr->dst.u8[15] ^ ipv6_hdr->dst.u8[14] ^
+                   ipv6_hdr->src.u8[15];
+
+    return &_iphc_cache[idx & (GNRC_SIXLOWPAN_IPHC_CACHE_SIZE - 1)];
+}
+
+static bool _cache_match(const _iphc_cache_entry_t *entry,
+                         gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                         ipv6_hdr_t *ipv6_hdr, uint16_t ctx_gen)
+{
+    return (entry->if_pid == iface->pid) &&
+           (entry->ctx_gen == ctx_gen) &&
+           (entry->l2addr_len == netif_hdr->dst_l2addr_len) &&
+           (entry->own_l2addr_len == iface->l2addr_len) &&
+           ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) &&
+           ipv6_addr_equal(&entry->src, &ipv6_hdr->src) &&
+           (memcmp(entry->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   entry->l2addr_len) == 0) &&
+           (memcmp(entry->own_l2addr, iface->l2addr,
+                   entry->own_l2addr_len) == 0);
+}
+
+static const _iphc_addrs_t *_get_addrs(gnrc_netif_t *iface,
+                                       gnrc_netif_hdr_t *netif_hdr,
+                                       ipv6_hdr_t *ipv6_hdr,
+                                       _iphc_addrs_t *tmp)
+{
+    _iphc_cache_entry_t *entry = _cache_entry(ipv6_hdr);
+    uint16_t ctx_gen = gnrc_sixlowpan_ctx_generation();
+
+    if (netif_hdr->dst_l2addr_len > sizeof(entry->l2addr)) {
+        /* can't be cached */
+        return (_compress_addrs(iface, netif_hdr, NULL, ipv6_hdr, tmp)) ?
+               tmp : NULL;
+    }
+    if (_cache_match(entry, iface, netif_hdr, ipv6_hdr, ctx_gen)) {
+        return &entry->addrs;
+    }
+    if (!_compress_addrs(iface, netif_hdr, NULL, ipv6_hdr, &entry->addrs)) {
+        entry->if_pid = KERNEL_PID_UNDEF;
+        return NULL;
+    }
+    DEBUG("6lo iphc: cache compressed addresses in entry %u\n",
+          (unsigned)(entry - _iphc_cache));
+    entry->src = ipv6_hdr->src;
+    entry->dst = ipv6_hdr->dst;
+    entry->l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(entry->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           entry->l2addr_len);
+    entry->own_l2addr_len = iface->l2addr_len;
+    memcpy(entry->own_l2addr, iface->l2addr, entry->own_l2addr_len);
+    entry->ctx_gen = ctx_gen;
+    entry->if_pid = iface->pid;
+    return &entry->addrs;
+}
+
+void gnrc_sixlowpan_iphc_cache_flush(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _iphc_cache[i].if_pid = KERNEL_PID_UNDEF;
     }
+}
+#else   /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+static inline const _iphc_addrs_t *_get_addrs(gnrc_netif_t *iface,
+                                              gnrc_netif_hdr_t *netif_hdr,
+                                              ipv6_hdr_t *ipv6_hdr,
+                                              _iphc_addrs_t *tmp)
+{
+    return (_compress_addrs(iface, netif_hdr, NULL, ipv6_hdr, tmp)) ? tmp : NULL;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+
+static inline bool _compressible(gnrc_pktsnip_t *hdr)
+{
+    switch (hdr->type) {
+        case GNRC_NETTYPE_UNDEF:    /* when forwarded */
+        case GNRC_NETTYPE_IPV6:
+#ifdef MODULE_GNRC_IPV6_EXT
+        case GNRC_NETTYPE_IPV6_EXT:
+#endif
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC) && defined(MODULE_GNRC_UDP)
+        case GNRC_NETTYPE_UDP:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* position of the next header to compress in the packet */
+typedef struct {
+    gnrc_pktsnip_t *snip;   /* snip the header is in */
+    gnrc_pktsnip_t *end;    /* first snip that is not write protected */
+    size_t offset;          /* offset of the header in snip */
+} _iphc_pos_t;
+
+/* returns the header at pos, if it has at least len bytes in a write
+ * protected snip */
+static uint8_t *_hdr_get(const _iphc_pos_t *pos, size_t len)
+{
+    if ((pos->snip == pos->end) ||
+        ((pos->offset + len) > pos->snip->size)) {
+        return NULL;
+    }
+    return (uint8_t *)pos->snip->data + pos->offset;
+}
+
+static void _hdr_skip(_iphc_pos_t *pos, size_t len)
+{
+    pos->offset += len;
+    if (pos->offset >= pos->snip->size) {
+        pos->snip = pos->snip->next;
+        pos->offset = 0;
+    }
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+/* returns the length of the rest of the packet, if it can be compressed with
+ * GHC */
+static size_t _ghc_len(const _iphc_pos_t *pos)
+{
+    size_t len;
+
+    if (pos->snip == NULL) {
+        return 0;
+    }
+    len = gnrc_pkt_len(pos->snip) - pos->offset;
+    return (len <= GNRC_SIXLOWPAN_IPHC_GHC_MAX_LEN) ? len : 0;
+}
+
+static uint8_t _ghc_buf[SIXLOWPAN_GHC_DICT_LEN +
+                        GNRC_SIXLOWPAN_IPHC_GHC_MAX_LEN];
+
+/* compresses the rest of the packet with GHC, returns the encoded length or
+ * 0 if the compression does not save anything */
+static size_t _iphc_ghc_encode(const ipv6_hdr_t *ipv6_hdr, uint8_t nh,
+                               const _iphc_pos_t *pos, uint8_t *nhc_data,
+                               size_t max_len)
+{
+    size_t len = 0, offset = pos->offset;
+    int res;
+
+    sixlowpan_ghc_dict_init(_ghc_buf, &ipv6_hdr->src, &ipv6_hdr->dst);
+    for (gnrc_pktsnip_t *snip = pos->snip; snip != NULL; snip = snip->next) {
+        memcpy(&_ghc_buf[SIXLOWPAN_GHC_DICT_LEN + len],
+               (uint8_t *)snip->data + offset, snip->size - offset);
+        len += snip->size - offset;
+        offset = 0;
+    }
+    if (max_len > len) {
+        max_len = len;
+    }
+    res = sixlowpan_ghc_compress(_ghc_buf, len, &nhc_data[1], max_len - 1);
+    if (res < 0) {
+        DEBUG("6lo iphc ghc: compression of %u bytes does not save anything\n",
+              (unsigned)len);
+        return 0;
+    }
+    nhc_data[0] = (nh == PROTNUM_UDP) ? NHC_GHC_UDP_ID : NHC_GHC_ICMPV6_ID;
+    return res + 1;
+}
+#endif
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-    switch (ipv6_hdr->nh) {
-        case PROTNUM_UDP: {
-            gnrc_pktsnip_t *udp = pkt->next->next;
-
-            assert(udp->size >= sizeof(udp_hdr_t));
-            inline_pos += iphc_nhc_udp_encode(&iphc_hdr[inline_pos], udp);
-            /* remove UDP header */
-            if (udp->size > sizeof(udp_hdr_t)) {
-                udp = gnrc_pktbuf_mark(udp, sizeof(udp_hdr_t),
-                                       GNRC_NETTYPE_UNDEF);
-
-                if (udp == NULL) {
-                    DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
-                    gnrc_pktbuf_release(dispatch);
-                    return;
-                }
+/* returns the length of the header nh at pos, if it can be encoded with NHC,
+ * 0 otherwise */
+static size_t _nhc_hdr_len(uint8_t nh, const _iphc_pos_t *pos, bool ghc)
+{
+    const ipv6_ext_t *ext;
+    size_t len;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+    if (ghc && ((nh == PROTNUM_UDP) || (nh == PROTNUM_ICMPV6)) &&
+        (_ghc_len(pos) > 0)) {
+        return _ghc_len(pos);
+    }
+#else
+    (void)ghc;
+#endif
+    switch (nh) {
+#ifdef MODULE_GNRC_UDP
+        case PROTNUM_UDP:
+            return (_hdr_get(pos, sizeof(udp_hdr_t)) != NULL) ?
+                   sizeof(udp_hdr_t) : 0;
+#endif
+        case PROTNUM_IPV6:
+            return (_hdr_get(pos, sizeof(ipv6_hdr_t)) != NULL) ?
+                   sizeof(ipv6_hdr_t) : 0;
+        case PROTNUM_IPV6_EXT_FRAG:
+            return (_hdr_get(pos, IPV6_EXT_LEN_UNIT) != NULL) ?
+                   IPV6_EXT_LEN_UNIT : 0;
+        case PROTNUM_IPV6_EXT_HOPOPT:
+        case PROTNUM_IPV6_EXT_RH:
+        case PROTNUM_IPV6_EXT_DST:
+        case PROTNUM_IPV6_EXT_MOB:
+            if ((ext = (ipv6_ext_t *)_hdr_get(pos, sizeof(ipv6_ext_t))) == NULL) {
+                return 0;
+            }
+            len = (ext->len + 1) * IPV6_EXT_LEN_UNIT;
+            if (((len - sizeof(ipv6_ext_t)) > NHC_EXT_DATA_MAX) ||
+                (_hdr_get(pos, len) == NULL)) {
+                return 0;
             }
-            gnrc_pktbuf_remove_snip(pkt, udp);
+            return len;
+        default:
+            return 0;
+    }
+}
+
+/* length of the options without a trailing padding option, that the
+ * decoder restores */
+static size_t _nhc_opts_len(const uint8_t *opts, size_t len)
+{
+    size_t pos = 0, last = 0;
+
+    while (pos < len) {
+        last = pos;
+        if (opts[pos] == NHC_EXT_OPT_PAD1) {
+            pos++;
+        }
+        else if ((pos + 1) < len) {
+            pos += opts[pos + 1] + 2;
+        }
+        else {
             break;
         }
+    }
+    if ((pos == len) && ((len - last) < IPV6_EXT_LEN_UNIT) &&
+        ((opts[last] == NHC_EXT_OPT_PAD1) || (opts[last] == NHC_EXT_OPT_PADN))) {
+        return last;
+    }
+    return len;
+}
+
+static size_t _iphc_nhc_ext_encode(uint8_t *nhc_data, uint8_t protnum,
+                                   const ipv6_ext_t *ext, size_t len, bool nhc)
+{
+    const uint8_t *data = (const uint8_t *)(ext + 1);
+    size_t data_len = len - sizeof(ipv6_ext_t), nhc_len = 0;
+    uint8_t eid;
+
+    switch (protnum) {
+        case PROTNUM_IPV6_EXT_HOPOPT:
+            eid = NHC_EXT_EID_HOPOPT;
+            data_len = _nhc_opts_len(data, data_len);
+            break;
+        case PROTNUM_IPV6_EXT_DST:
+            eid = NHC_EXT_EID_DST;
+            data_len = _nhc_opts_len(data, data_len);
+            break;
+        case PROTNUM_IPV6_EXT_RH:
+            eid = NHC_EXT_EID_RH;
+            break;
+        case PROTNUM_IPV6_EXT_FRAG:
+            eid = NHC_EXT_EID_FRAG;
+            break;
         default:
+            eid = NHC_EXT_EID_MOB;
             break;
     }
+    nhc_data[nhc_len++] = NHC_EXT_ID | eid | ((nhc) ? NHC_EXT_NH : 0);
+    if (!nhc) {
+        nhc_data[nhc_len++] = ext->nh;
+    }
+    nhc_data[nhc_len++] = data_len;
+    memcpy(&nhc_data[nhc_len], data, data_len);
+    return nhc_len + data_len;
+}
+#else   /* MODULE_GNRC_SIXLOWPAN_IPHC_NHC */
+static inline size_t _nhc_hdr_len(uint8_t nh, const _iphc_pos_t *pos, bool ghc)
+{
+    (void)nh;
+    (void)pos;
+    (void)ghc;
+    return 0;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_NHC */
+
+/* maximum length of the encoded headers starting with the IPv6 header at
+ * pos */
+static size_t _iphc_max_len(_iphc_pos_t pos, bool ghc)
+{
+    uint8_t nh = ((ipv6_hdr_t *)_hdr_get(&pos, sizeof(ipv6_hdr_t)))->nh;
+    size_t len, res = IPHC_MAX_LEN;
+
+    _hdr_skip(&pos, sizeof(ipv6_hdr_t));
+    while ((len = _nhc_hdr_len(nh, &pos, ghc)) > 0) {
+        const uint8_t *hdr = _hdr_get(&pos, len);
+
+        /* NHC ID and the IPHC fields the IPv6 header does not have */
+        res += len + SIXLOWPAN_IPHC_HDR_LEN + SIXLOWPAN_IPHC_CID_EXT_LEN + 1;
+        if ((nh == PROTNUM_UDP) || (nh == PROTNUM_ICMPV6)) {
+            break;
+        }
+        nh = (nh == PROTNUM_IPV6) ? ((ipv6_hdr_t *)hdr)->nh :
+                                    ((ipv6_ext_t *)hdr)->nh;
+        _hdr_skip(&pos, len);
+    }
+    return res;
+}
+
+/**
+ * @brief   Encodes an IPv6 header with IPHC
+ *
+ * @param[in] iface     The interface the packet is sent over
+ * @param[in] netif_hdr The interface header of the packet
+ * @param[in] outer     The encapsulating IPv6 header for an IPv6 header
+ *                      encoded with NHC, NULL otherwise
+ * @param[in] ipv6_hdr  The IPv6 header to encode
+ * @param[in] nhc       The next header will be encoded with NHC
+ * @param[out] iphc_hdr The encoded header
+ *
+ * @return  The length of the encoded header on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_encode(gnrc_netif_t *iface, gnrc_netif_hdr_t *netif_hdr,
+                           const ipv6_hdr_t *outer, ipv6_hdr_t *ipv6_hdr,
+                           bool nhc, uint8_t *iphc_hdr)
+{
+    const _iphc_addrs_t *addrs;
+    _iphc_addrs_t tmp_addrs;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+
+    if (outer != NULL) {
+        /* only the outer-most header is cached */
+        addrs = (_compress_addrs(iface, netif_hdr, outer, ipv6_hdr,
+                                 &tmp_addrs)) ? &tmp_addrs : NULL;
+    }
+    else {
+        addrs = _get_addrs(iface, netif_hdr, ipv6_hdr, &tmp_addrs);
+    }
+    if (addrs == NULL) {
+        return 0;
+    }
+
+    iphc_hdr[IPHC2_IDX] = addrs->iphc2;
+    if (addrs->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = addrs->cid_ext;
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+        }
+    }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
+
+        /* copy remaining byteos of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
+    }
+
+    /* check for compressible next header */
+    if (nhc) {
+        iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+    }
+    else {
+        iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
+    }
+
+    /* compressed source and destination address */
+    memcpy(iphc_hdr + inline_pos, addrs->inline_addrs, addrs->inline_len);
+    inline_pos += addrs->inline_len;
+
+    return inline_pos;
+}
+
+/**
+ * @brief   Encodes the IPv6 header at @p pos and all headers following it
+ *          that can be encoded with NHC
+ *
+ * @param[in] iface     The interface the packet is sent over
+ * @param[in] netif_hdr The interface header of the packet
+ * @param[in,out] pos   Position of the IPv6 header. Set to the position after
+ *                      the encoded headers.
+ * @param[out] buf      The encoded headers
+ * @param[in] buf_len   Length of @p buf
+ * @param[in] ghc       Compress UDP and ICMPv6 together with the rest of the
+ *                      packet with GHC
+ *
+ * @return  The length of the encoded headers on success.
+ * @return  0 on error.
+ */
+static size_t _iphc_encode_hdrs(gnrc_netif_t *iface,
+                                gnrc_netif_hdr_t *netif_hdr,
+                                _iphc_pos_t *pos, uint8_t *buf,
+                                size_t buf_len, bool ghc)
+{
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)_hdr_get(pos, sizeof(ipv6_hdr_t));
+    uint8_t nh = ipv6_hdr->nh;
+    size_t res;
+    bool nhc;
+
+#if !defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC) || \
+    !defined(MODULE_GNRC_SIXLOWPAN_IPHC_GHC)
+    (void)buf_len;
 #endif
+    _hdr_skip(pos, sizeof(ipv6_hdr_t));
+    nhc = (_nhc_hdr_len(nh, pos, ghc) > 0);
+    if ((res = _iphc_encode(iface, netif_hdr, NULL, ipv6_hdr, nhc, buf)) == 0) {
+        return 0;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    while (nhc) {
+        size_t len = _nhc_hdr_len(nh, pos, ghc);
+        uint8_t *hdr;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+        if (ghc && ((nh == PROTNUM_UDP) || (nh == PROTNUM_ICMPV6)) &&
+            (_ghc_len(pos) > 0)) {
+            if ((len = _iphc_ghc_encode(ipv6_hdr, nh, pos, &buf[res],
+                                        buf_len - res)) == 0) {
+                return 0;
+            }
+            /* the rest of the packet is encoded */
+            pos->snip = NULL;
+            pos->offset = 0;
+            return res + len;
+        }
+#endif
+        hdr = _hdr_get(pos, len);
+        switch (nh) {
+            case PROTNUM_UDP:
+                res += iphc_nhc_udp_encode(&buf[res], (udp_hdr_t *)hdr);
+                nhc = false;
+                break;
+            case PROTNUM_IPV6: {
+                const ipv6_hdr_t *outer = ipv6_hdr;
+                size_t iphc_len;
+
+                buf[res++] = NHC_EXT_ID | NHC_EXT_EID_IPV6;
+                ipv6_hdr = (ipv6_hdr_t *)hdr;
+                nh = ipv6_hdr->nh;
+                _hdr_skip(pos, len);
+                nhc = (_nhc_hdr_len(nh, pos, ghc) > 0);
+                iphc_len = _iphc_encode(iface, netif_hdr, outer, ipv6_hdr, nhc,
+                                        &buf[res]);
+                if (iphc_len == 0) {
+                    return 0;
+                }
+                res += iphc_len;
+                continue;
+            }
+            default: {
+                const ipv6_ext_t *ext = (ipv6_ext_t *)hdr;
+                uint8_t protnum = nh;
+
+                nh = ext->nh;
+                _hdr_skip(pos, len);
+                nhc = (_nhc_hdr_len(nh, pos, ghc) > 0);
+                res += _iphc_nhc_ext_encode(&buf[res], protnum, ext, len, nhc);
+                continue;
+            }
+        }
+        _hdr_skip(pos, len);
+    }
+#endif
+    return res;
+}
+
+void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    assert(pkt != NULL);
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    gnrc_netif_t *iface = gnrc_netif_hdr_get_netif(netif_hdr);
+    gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
+    _iphc_pos_t pos;
+    bool addr_comp = false;
+    size_t dispatch_size, inline_pos = 0;
+    /* datagram size before compression */
+    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
+
+    (void)ctx;
+    dispatch = NULL;    /* use dispatch as temporary pointer for prev */
+    /* write protect all headers because they will be removed */
+    while ((ptr != NULL) && _compressible(ptr)) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(ptr);
+
+        if (tmp == NULL) {
+            DEBUG("6lo iphc: unable to write protect compressible header\n");
+            if (addr_comp) {    /* addr_comp was used as release indicator */
+                gnrc_pktbuf_release(pkt);
+            }
+            return;
+        }
+        ptr = tmp;
+        if (dispatch == NULL) {
+            /* pkt was already write protected in gnrc_sixlowpan.c:_send so
+             * we shouldn't do it again */
+            pkt->next = ptr;    /* reset original packet */
+        }
+        else {
+            dispatch->next = ptr;
+        }
+        dispatch = ptr; /* use dispatch as temporary point for prev */
+        ptr = ptr->next;
+        if (dispatch->type == GNRC_NETTYPE_UNDEF) {
+            /* payload or headers of a forwarded packet, nothing comes after
+             * that */
+            break;
+        }
+    }
+    pos.snip = pkt->next;
+    pos.end = ptr;
+    pos.offset = 0;
+
+    assert(_hdr_get(&pos, sizeof(ipv6_hdr_t)) != NULL);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+    dispatch_size = _iphc_max_len(pos, true);
+#else
+    dispatch_size = _iphc_max_len(pos, false);
+#endif
+    dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
+                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_GHC
+    do {
+        _iphc_pos_t ghc_pos = pos;
+
+        /* GHC compressed datagrams are not fragmented */
+        inline_pos = _iphc_encode_hdrs(iface, netif_hdr, &ghc_pos,
+                                       dispatch->data, dispatch_size, true);
+        if ((inline_pos > 0) && (ghc_pos.snip == NULL) &&
+            ((iface->sixlo.max_frag_size == 0) ||
+             (inline_pos <= iface->sixlo.max_frag_size))) {
+            pos = ghc_pos;
+        }
+        else {
+            inline_pos = 0;
+        }
+    } while (0);
+#endif
+    if ((inline_pos == 0) &&
+        ((inline_pos = _iphc_encode_hdrs(iface, netif_hdr, &pos,
+                                         dispatch->data, dispatch_size,
+                                         false)) == 0)) {
+        gnrc_pktbuf_release(dispatch);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
 
     /* shrink dispatch allocation to final size */
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
-    gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
+    gnrc_pktbuf_realloc_data(dispatch, inline_pos);
 
-    /* remove IPv6 header */
-    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    if (pos.offset > 0) {
+        /* the encoded headers share a snip with the rest of the packet, e.g.
+         * when forwarded */
+        gnrc_pktsnip_t *hdrs = gnrc_pktbuf_mark(pos.snip, pos.offset,
+                                                GNRC_NETTYPE_UNDEF);
+
+        if (hdrs == NULL) {
+            DEBUG("6lo iphc: unable to mark encoded headers\n");
+            gnrc_pktbuf_release(dispatch);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        gnrc_pktbuf_remove_snip(pkt, hdrs);
+    }
+    /* remove encoded headers */
+    if (pkt->next != pos.snip) {
+        for (ptr = pkt->next; ptr->next != pos.snip; ptr = ptr->next) {}
+        ptr->next = NULL;
+        gnrc_pktbuf_release(pkt->next);
+    }
 
     /* insert dispatch into packet */
-    dispatch->next = pkt->next;
+    dispatch->next = pos.snip;
     pkt->next = dispatch;
 
     gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
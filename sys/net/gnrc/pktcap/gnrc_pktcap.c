@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktcap
+ * @{
+ *
+ * @file
+ * @brief       Packet capture to pcapng
+ *
+ * The ring buffer holds records of a header and the captured bytes, both
+ * aligned to 4 bytes. An interface reserves a record by advancing `_head`
+ * with compare-and-swap, fills it and commits it by setting the size in its
+ * header. The writer takes committed records in order from `_tail`, so a
+ * record reserved earlier but committed later holds back the ones behind it
+ * until it is committed. A record that would wrap around the end of the
+ * buffer is preceded by a pad record filling the rest of the buffer. The
+ * writer zeroes everything it consumed, so the size in the header of a
+ * record is 0 until its interface commits it.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#include "net/netdev.h"
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pktcap.h"
+
+#ifdef MODULE_VFS
+#include <fcntl.h>
+#include "vfs.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_PKTCAP_BUF_SIZE & (GNRC_PKTCAP_BUF_SIZE - 1)) != 0
+#error "GNRC_PKTCAP_BUF_SIZE must be a power of two"
+#endif
+
+#define FLAG_DATA           (0x1)
+#define FLAG_STOP           (0x2)
+
+#define REC_PAD             (0x80000000U)   /**< marks a pad record */
+
+#define PCAPNG_SHB          (0x0A0D0D0AU)
+#define PCAPNG_IDB          (0x00000001U)
+#define PCAPNG_EPB          (0x00000006U)
+#define PCAPNG_BOM          (0x1A2B3C4DU)
+#define PCAPNG_OPT_END      (0U)
+#define PCAPNG_OPT_IF_NAME  (2U)
+#define PCAPNG_OPT_EPB_FLAGS (2U)
+#define PCAPNG_EPB_INBOUND  (0x1U)
+#define PCAPNG_EPB_OUTBOUND (0x2U)
+
+#define LINKTYPE_ETHERNET           (1U)
+#define LINKTYPE_RAW                (101U)
+#define LINKTYPE_USER0              (147U)
+#define LINKTYPE_IEEE802_15_4_NOFCS (230U)
+
+#define ALIGN4(x)           (((x) + 3U) & ~3U)
+
+typedef struct {
+    atomic_uint size;       /**< size of the record, 0 until committed */
+    uint32_t time_hi;       /**< upper 32 bit of the timestamp in usec */
+    uint32_t time_lo;       /**< lower 32 bit of the timestamp in usec */
+    uint16_t len;           /**< length of the frame */
+    uint16_t caplen;        /**< captured bytes of the frame */
+    kernel_pid_t iface;     /**< interface of the frame */
+    uint16_t linktype;      /**< pcap link type of the interface */
+    uint8_t flags;          /**< EPB flags, i.e. the direction */
+} _rec_t;
+
+/* a record must always fit, even behind a pad record */
+static_assert((GNRC_PKTCAP_SNAPLEN + 2 * sizeof(_rec_t)) <=
+              (GNRC_PKTCAP_BUF_SIZE / 2),
+              "GNRC_PKTCAP_SNAPLEN must not exceed half of GNRC_PKTCAP_BUF_SIZE");
+
+static uint8_t _ring[GNRC_PKTCAP_BUF_SIZE] __attribute__((aligned(4)));
+static atomic_uint _head = ATOMIC_VAR_INIT(0);
+static atomic_uint _tail = ATOMIC_VAR_INIT(0);
+static atomic_uint _dropped = ATOMIC_VAR_INIT(0);
+static atomic_bool _enabled = ATOMIC_VAR_INIT(false);
+
+/* owned by the writer while a capture is running */
+static gnrc_pktcap_sink_t _sink;
+static bool _sink_ok;
+static uint8_t _wbuf[GNRC_PKTCAP_WRITE_BUF_SIZE] __attribute__((aligned(4)));
+static size_t _wbuf_len;
+static kernel_pid_t _ifaces[GNRC_NETIF_NUMOF];
+static unsigned _ifaces_numof;
+static uint32_t _frames;
+static uint32_t _bytes;
+
+static mutex_t _lock = MUTEX_INIT;
+static mutex_t _stopped = MUTEX_INIT_LOCKED;
+static atomic_bool _running = ATOMIC_VAR_INIT(false);
+
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static char _stack[GNRC_PKTCAP_STACKSIZE];
+
+static inline _rec_t *_rec_at(unsigned pos)
+{
+    return (_rec_t *)&_ring[pos & (GNRC_PKTCAP_BUF_SIZE - 1)];
+}
+
+static uint16_t _linktype(const gnrc_netif_t *netif)
+{
+    switch (netif->device_type) {
+        case NETDEV_TYPE_ETHERNET:
+            return LINKTYPE_ETHERNET;
+        case NETDEV_TYPE_IEEE802154:
+            return LINKTYPE_IEEE802_15_4_NOFCS;
+        case NETDEV_TYPE_RAW:
+        case NETDEV_TYPE_SLIP:
+            return LINKTYPE_RAW;
+        default:
+            return LINKTYPE_USER0;
+    }
+}
+
+/**
+ * reserves a record for caplen bytes, returns NULL if the ring is full
+ */
+static _rec_t *_reserve(size_t caplen, unsigned *size)
+{
+    unsigned head = atomic_load_explicit(&_head, memory_order_relaxed);
+    unsigned need = sizeof(_rec_t) + ALIGN4(caplen);
+    unsigned pad;
+
+    do {
+        unsigned tail = atomic_load_explicit(&_tail, memory_order_acquire);
+        unsigned off = head & (GNRC_PKTCAP_BUF_SIZE - 1);
+
+        pad = ((GNRC_PKTCAP_BUF_SIZE - off) < need) ?
+              (GNRC_PKTCAP_BUF_SIZE - off) : 0;
+        if ((head + pad + need - tail) > GNRC_PKTCAP_BUF_SIZE) {
+            atomic_fetch_add_explicit(&_dropped, 1, memory_order_relaxed);
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&_head, &head,
+                                                    head + pad + need,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+    if (pad) {
+        /* pad records are at least 4 bytes long, i.e. hold the size */
+        atomic_store_explicit(&_rec_at(head)->size, pad | REC_PAD,
+                              memory_order_release);
+    }
+    *size = need;
+    return _rec_at(head + pad);
+}
+
+static void _commit(const gnrc_netif_t *netif, _rec_t *rec, unsigned size,
+                    size_t len, size_t caplen, uint8_t flags)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    rec->time_hi = (uint32_t)(now >> 32);
+    rec->time_lo = (uint32_t)now;
+    rec->len = len;
+    rec->caplen = caplen;
+    rec->iface = netif->pid;
+    rec->linktype = _linktype(netif);
+    rec->flags = flags;
+    atomic_store_explicit(&rec->size, size, memory_order_release);
+    thread_flags_set((thread_t *)thread_get(_pid), FLAG_DATA);
+}
+
+void gnrc_pktcap_rx(const gnrc_netif_t *netif, const void *frame, size_t len)
+{
+    size_t caplen = (len < GNRC_PKTCAP_SNAPLEN) ? len : GNRC_PKTCAP_SNAPLEN;
+    unsigned size;
+    _rec_t *rec;
+
+    if (!atomic_load_explicit(&_enabled, memory_order_relaxed)) {
+        return;
+    }
+    if ((rec = _reserve(caplen, &size)) == NULL) {
+        return;
+    }
+    memcpy(rec + 1, frame, caplen);
+    _commit(netif, rec, size, len, caplen, PCAPNG_EPB_INBOUND);
+}
+
+void gnrc_pktcap_tx(const gnrc_netif_t *netif, const iolist_t *iolist)
+{
+    size_t len = iolist_size(iolist);
+    size_t caplen = (len < GNRC_PKTCAP_SNAPLEN) ? len : GNRC_PKTCAP_SNAPLEN;
+    unsigned size;
+    uint8_t *data;
+    _rec_t *rec;
+
+    if (!atomic_load_explicit(&_enabled, memory_order_relaxed)) {
+        return;
+    }
+    if ((rec = _reserve(caplen, &size)) == NULL) {
+        return;
+    }
+    data = (uint8_t *)(rec + 1);
+    for (size_t left = caplen; (iolist != NULL) && (left > 0);
+         iolist = iolist->iol_next) {
+        size_t chunk = (iolist->iol_len < left) ? iolist->iol_len : left;
+
+        memcpy(data, iolist->iol_base, chunk);
+        data += chunk;
+        left -= chunk;
+    }
+    _commit(netif, rec, size, len, caplen, PCAPNG_EPB_OUTBOUND);
+}
+
+static void _write(const void *data, size_t len)
+{
+    if (!_sink_ok) {
+        return;
+    }
+    if ((_wbuf_len + len) > sizeof(_wbuf)) {
+        if (_wbuf_len > 0) {
+            ssize_t res = _sink.write(_sink.arg, _wbuf, _wbuf_len);
+
+            _wbuf_len = 0;
+            if (res < 0) {
+                DEBUG("pktcap: write failed (%d)\n", (int)res);
+                _sink_ok = false;
+                atomic_store(&_enabled, false);
+                return;
+            }
+        }
+        if (len > sizeof(_wbuf)) {
+            if (_sink.write(_sink.arg, data, len) < 0) {
+                _sink_ok = false;
+                atomic_store(&_enabled, false);
+                return;
+            }
+            _bytes += len;
+            return;
+        }
+    }
+    memcpy(&_wbuf[_wbuf_len], data, len);
+    _wbuf_len += len;
+    _bytes += len;
+}
+
+static void _flush(void)
+{
+    if (_sink_ok && (_wbuf_len > 0) &&
+        (_sink.write(_sink.arg, _wbuf, _wbuf_len) < 0)) {
+        _sink_ok = false;
+        atomic_store(&_enabled, false);
+    }
+    _wbuf_len = 0;
+}
+
+static void _write_u32(uint32_t val)
+{
+    _write(&val, sizeof(val));
+}
+
+static void _write_opt(uint16_t code, uint16_t len)
+{
+    uint16_t opt[] = { code, len };
+
+    _write(opt, sizeof(opt));
+}
+
+/**
+ * returns the interface ID of pid in the section, writes an IDB on its first
+ * frame
+ */
+static int _iface_id(kernel_pid_t pid, uint16_t linktype)
+{
+    char name[ALIGN4(sizeof("if") + 5)];
+    size_t name_len;
+    uint32_t len;
+
+    for (unsigned i = 0; i < _ifaces_numof; i++) {
+        if (_ifaces[i] == pid) {
+            return i;
+        }
+    }
+    if (_ifaces_numof >= GNRC_NETIF_NUMOF) {
+        return -1;
+    }
+    memset(name, 0, sizeof(name));
+    name_len = snprintf(name, sizeof(name), "if%u", (unsigned)pid);
+    len = 16 + 4 + ALIGN4(name_len) + 4 + 4;
+    _write_u32(PCAPNG_IDB);
+    _write_u32(len);
+    _write_opt(linktype, 0);            /* link type and reserved */
+    _write_u32(GNRC_PKTCAP_SNAPLEN);
+    _write_opt(PCAPNG_OPT_IF_NAME, name_len);
+    _write(name, ALIGN4(name_len));
+    _write_opt(PCAPNG_OPT_END, 0);
+    _write_u32(len);
+    _ifaces[_ifaces_numof] = pid;
+    return _ifaces_numof++;
+}
+
+static void _write_epb(const _rec_t *rec)
+{
+    static const uint8_t zero[3] = { 0 };
+    int id = _iface_id(rec->iface, rec->linktype);
+    uint32_t len = 28 + ALIGN4(rec->caplen) + 8 + 4 + 4;
+
+    if (id < 0) {
+        atomic_fetch_add_explicit(&_dropped, 1, memory_order_relaxed);
+        return;
+    }
+    _write_u32(PCAPNG_EPB);
+    _write_u32(len);
+    _write_u32(id);
+    _write_u32(rec->time_hi);
+    _write_u32(rec->time_lo);
+    _write_u32(rec->caplen);
+    _write_u32(rec->len);
+    _write(rec + 1, rec->caplen);
+    _write(zero, ALIGN4(rec->caplen) - rec->caplen);
+    _write_opt(PCAPNG_OPT_EPB_FLAGS, sizeof(uint32_t));
+    _write_u32(rec->flags);
+    _write_opt(PCAPNG_OPT_END, 0);
+    _write_u32(len);
+    _frames++;
+}
+
+/**
+ * writes all committed records, or throws them away without a capture
+ */
+static void _drain(void)
+{
+    unsigned tail = atomic_load_explicit(&_tail, memory_order_relaxed);
+
+    while (tail != atomic_load_explicit(&_head, memory_order_acquire)) {
+        _rec_t *rec = _rec_at(tail);
+        unsigned size = atomic_load_explicit(&rec->size, memory_order_acquire);
+
+        if (size == 0) {
+            /* reserved, but not committed yet */
+            break;
+        }
+        if (!(size & REC_PAD) && atomic_load(&_running)) {
+            _write_epb(rec);
+        }
+        size &= ~REC_PAD;
+        memset(rec, 0, size);
+        tail += size;
+        atomic_store_explicit(&_tail, tail, memory_order_release);
+    }
+}
+
+static void *_writer(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_flags_t flags = thread_flags_wait_any(FLAG_DATA | FLAG_STOP);
+
+        _drain();
+        if (atomic_load(&_running)) {
+            _flush();
+        }
+        if (flags & FLAG_STOP) {
+            if (_sink.close != NULL) {
+                _sink.close(_sink.arg);
+            }
+            atomic_store(&_running, false);
+            mutex_unlock(&_stopped);
+        }
+    }
+    return NULL;
+}
+
+kernel_pid_t gnrc_pktcap_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), GNRC_PKTCAP_PRIO,
+                             THREAD_CREATE_STACKTEST, _writer, NULL, "pktcap");
+    }
+    return _pid;
+}
+
+int gnrc_pktcap_start(const gnrc_pktcap_sink_t *sink)
+{
+    const struct {
+        uint32_t type;
+        uint32_t len;
+        uint32_t bom;
+        uint16_t major;
+        uint16_t minor;
+        uint32_t section_len[2];
+        uint32_t len2;
+    } shb = { PCAPNG_SHB, 28, PCAPNG_BOM, 1, 0,
+              { UINT32_MAX, UINT32_MAX }, 28 };
+    ssize_t res;
+
+    if (_pid <= KERNEL_PID_UNDEF) {
+        return -ENOTCONN;
+    }
+    mutex_lock(&_lock);
+    if (atomic_load(&_running)) {
+        mutex_unlock(&_lock);
+        return -EALREADY;
+    }
+    res = sink->write(sink->arg, &shb, sizeof(shb));
+    if (res < 0) {
+        mutex_unlock(&_lock);
+        return res;
+    }
+    /* the writer does not touch these without a capture */
+    _sink = *sink;
+    _sink_ok = true;
+    _wbuf_len = 0;
+    _ifaces_numof = 0;
+    _frames = 0;
+    _bytes = sizeof(shb);
+    atomic_store(&_dropped, 0);
+    atomic_store(&_running, true);
+    atomic_store(&_enabled, true);
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+void gnrc_pktcap_stop(void)
+{
+    mutex_lock(&_lock);
+    if (atomic_load(&_running)) {
+        atomic_store(&_enabled, false);
+        thread_flags_set((thread_t *)thread_get(_pid), FLAG_STOP);
+        mutex_lock(&_stopped);
+    }
+    mutex_unlock(&_lock);
+}
+
+int gnrc_pktcap_running(void)
+{
+    return atomic_load(&_enabled);
+}
+
+void gnrc_pktcap_get_stats(gnrc_pktcap_stats_t *stats)
+{
+    stats->frames = _frames;
+    stats->bytes = _bytes;
+    stats->dropped = atomic_load(&_dropped);
+}
+
+#ifdef MODULE_VFS
+static ssize_t _vfs_write(void *arg, const void *data, size_t len)
+{
+    const uint8_t *pos = data;
+    size_t left = len;
+
+    while (left > 0) {
+        ssize_t res = vfs_write((int)(intptr_t)arg, pos, left);
+
+        if (res < 0) {
+            return res;
+        }
+        if (res == 0) {
+            return -ENOSPC;
+        }
+        pos += res;
+        left -= res;
+    }
+    return len;
+}
+
+static void _vfs_close(void *arg)
+{
+    vfs_close((int)(intptr_t)arg);
+}
+
+int gnrc_pktcap_start_vfs(const char *path)
+{
+    gnrc_pktcap_sink_t sink = { .write = _vfs_write, .close = _vfs_close };
+    int fd = vfs_open(path, O_CREAT | O_TRUNC | O_WRONLY, 0);
+    int res;
+
+    if (fd < 0) {
+        return fd;
+    }
+    sink.arg = (void *)(intptr_t)fd;
+    if ((res = gnrc_pktcap_start(&sink)) < 0) {
+        vfs_close(fd);
+    }
+    return res;
+}
+#endif
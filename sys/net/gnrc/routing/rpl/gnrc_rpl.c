@@ -31,6 +31,9 @@
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
 #endif
+#ifdef MODULE_GNRC_RPL_SR
+#include "net/gnrc/rpl/sr.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -38,7 +41,7 @@
 static char _stack[GNRC_RPL_STACK_SIZE];
 kernel_pid_t gnrc_rpl_pid = KERNEL_PID_UNDEF;
 const ipv6_addr_t ipv6_addr_all_rpl_nodes = GNRC_RPL_ALL_NODES_ADDR;
-#ifdef MODULE_GNRC_RPL_P2P
+#if defined(MODULE_GNRC_RPL_P2P) || defined(MODULE_GNRC_RPL_SR)
 static uint32_t _lt_time = GNRC_RPL_LIFETIME_UPDATE_STEP * US_PER_SEC;
 static xtimer_t _lt_timer;
 static msg_t _lt_msg = { .type = GNRC_RPL_MSG_TYPE_LIFETIME_UPDATE };
@@ -55,7 +58,7 @@ gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
 netstats_rpl_t gnrc_rpl_netstats;
 #endif
 
-#ifdef MODULE_GNRC_RPL_P2P
+#if defined(MODULE_GNRC_RPL_P2P) || defined(MODULE_GNRC_RPL_SR)
 static void _update_lifetime(void);
 #endif
 static void _dao_handle_send(gnrc_rpl_dodag_t *dodag);
@@ -86,7 +89,7 @@ kernel_pid_t gnrc_rpl_init(kernel_pid_t if_pid)
 
         gnrc_rpl_of_manager_init();
         evtimer_init_msg(&gnrc_rpl_evtimer);
-#ifdef MODULE_GNRC_RPL_P2P
+#if defined(MODULE_GNRC_RPL_P2P) || defined(MODULE_GNRC_RPL_SR)
         xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 #endif
 
@@ -136,6 +139,12 @@ gnrc_rpl_instance_t *gnrc_rpl_root_init(uint8_t instance_id, ipv6_addr_t *dodag_
     dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
 
+#ifdef MODULE_GNRC_RPL_SR
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        gnrc_rpl_sr_init(&dodag->dodag_id, dodag->iface);
+    }
+#endif
+
     trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_MSG,
                   (1 << dodag->dio_min), dodag->dio_interval_doubl,
                   dodag->dio_redun);
@@ -260,7 +269,7 @@ static void *_event_loop(void *args)
         msg_receive(&msg);
 
         switch (msg.type) {
-#ifdef MODULE_GNRC_RPL_P2P
+#if defined(MODULE_GNRC_RPL_P2P) || defined(MODULE_GNRC_RPL_SR)
             case GNRC_RPL_MSG_TYPE_LIFETIME_UPDATE:
                 DEBUG("RPL: GNRC_RPL_MSG_TYPE_LIFETIME_UPDATE received\n");
                 _update_lifetime();
@@ -310,10 +319,15 @@ static void *_event_loop(void *args)
     return NULL;
 }
 
-#ifdef MODULE_GNRC_RPL_P2P
+#if defined(MODULE_GNRC_RPL_P2P) || defined(MODULE_GNRC_RPL_SR)
 void _update_lifetime(void)
 {
+#ifdef MODULE_GNRC_RPL_P2P
     gnrc_rpl_p2p_update();
+#endif
+#ifdef MODULE_GNRC_RPL_SR
+    gnrc_rpl_sr_update(GNRC_RPL_LIFETIME_UPDATE_STEP);
+#endif
 
     xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 }
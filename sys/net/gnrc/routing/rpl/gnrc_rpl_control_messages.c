@@ -42,6 +42,9 @@
 #include "net/gnrc/rpl/p2p_dodag.h"
 #include "net/gnrc/rpl/p2p.h"
 #endif
+#ifdef MODULE_GNRC_RPL_SR
+#include "net/gnrc/rpl/sr.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -393,6 +396,63 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
+#ifdef MODULE_GNRC_RPL_SR
+static inline bool _is_sr_root(gnrc_rpl_dodag_t *dodag)
+{
+    return (dodag->node_status == GNRC_RPL_ROOT_NODE) &&
+           (dodag->instance->mop == GNRC_RPL_MOP_NON_STORING_MODE);
+}
+
+/* nodes build the parent address from the DODAG prefix and the interface
+ * identifier of the link-local address the parent sends its DIOs from */
+static bool _is_root_iid(gnrc_rpl_dodag_t *dodag, const ipv6_addr_t *addr)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(dodag->iface);
+
+    if (netif == NULL) {
+        return false;
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_IPV6_ADDRS_NUMOF; i++) {
+        if (netif->ipv6.addrs_flags[i] &&
+            (memcmp(&netif->ipv6.addrs[i].u8[8], &addr->u8[8], 8) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* adds the targets preceding a transit option to the source route table */
+static void _sr_add_targets(gnrc_rpl_dodag_t *dodag,
+                            gnrc_rpl_opt_target_t *target,
+                            gnrc_rpl_opt_transit_t *transit)
+{
+    ipv6_addr_t parent, addr;
+    uint32_t lifetime = transit->path_lifetime * dodag->lifetime_unit;
+
+    /* the option length including the parent address is validated */
+    memcpy(&parent, transit + 1, sizeof(parent));
+    if (_is_root_iid(dodag, &parent)) {
+        parent = dodag->dodag_id;
+    }
+    if ((transit->path_lifetime == 0xFF) ||
+        (lifetime > GNRC_RPL_SR_LIFETIME_INF)) {
+        lifetime = GNRC_RPL_SR_LIFETIME_INF;
+    }
+
+    do {
+        memcpy(&addr, &target->target, sizeof(addr));
+        DEBUG("RPL: source route to %s/%d, lifetime %u\n",
+              ipv6_addr_to_str(addr_str, &addr, sizeof(addr_str)),
+              target->prefix_length, (unsigned)lifetime);
+        if (gnrc_rpl_sr_add(&addr, &parent, lifetime) < 0) {
+            DEBUG("RPL: could not add source route\n");
+        }
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (target)) +
+                 sizeof(gnrc_rpl_opt_t) + target->length);
+    } while (target->type == GNRC_RPL_OPT_TARGET);
+}
+#endif
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -517,6 +577,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     first_target = target;
                 }
 
+#ifdef MODULE_GNRC_RPL_SR
+                if (_is_sr_root(dodag)) {
+                    /* the route is stored with the transit option */
+                    break;
+                }
+#endif
+
                 DEBUG("RPL: adding FT entry %s/%d\n",
                       ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
                       target->prefix_length);
@@ -537,6 +604,14 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
+#ifdef MODULE_GNRC_RPL_SR
+                if (_is_sr_root(dodag)) {
+                    _sr_add_targets(dodag, first_target, transit);
+                    first_target = NULL;
+                    break;
+                }
+#endif
+
                 do {
                     DEBUG("RPL: updating FT entry %s/%d\n",
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
@@ -833,12 +908,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   const ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
+    size_t size = sizeof(gnrc_rpl_opt_transit_t) + (parent ? sizeof(ipv6_addr_t) : 0);
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, size, GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -851,6 +927,11 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent) {
+        /* non-storing mode */
+        transit->length += sizeof(ipv6_addr_t);
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
@@ -875,13 +956,18 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
 #endif
 
-    if (destination == NULL) {
+    /* in non-storing mode DAOs go to the root and name the parent */
+    bool non_storing = (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE);
+
+    if ((destination == NULL) || non_storing) {
         if (dodag->parents == NULL) {
             DEBUG("RPL: dodag has no preferred parent\n");
             return;
         }
+    }
 
-        destination = &(dodag->parents->addr);
+    if (destination == NULL) {
+        destination = non_storing ? &dodag->dodag_id : &(dodag->parents->addr);
     }
 
     gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
@@ -899,14 +985,27 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
     me = &netif->ipv6.addrs[idx];
 
+    if (non_storing) {
+        /* the parent's global address in the DODAG prefix */
+        ipv6_addr_t parent = dodag->dodag_id;
+
+        memcpy(&parent.u8[8], &dodag->parents->addr.u8[8], 8);
+        DEBUG("RPL: Send DAO - building transit option, parent %s\n",
+              ipv6_addr_to_str(addr_str, &parent, sizeof(addr_str)));
+        if ((pkt = _dao_transit_build(NULL, lifetime, false, &parent)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return;
+        }
+    }
+
     /* add external and RPL FT entries */
     /* TODO: nib: dropped support for external transit options for now */
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
-    while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
+    while(!non_storing && gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
         DEBUG("RPL: Send DAO - building transit option\n");
 
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
+        if ((pkt = _dao_transit_build(pkt, lifetime, false, NULL)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
             return;
         }
@@ -1077,6 +1176,12 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         return;
     }
 
+    /* in non-storing mode only the root keeps routes */
+    if ((dodag->instance->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+        (dodag->node_status != GNRC_RPL_ROOT_NODE)) {
+        return;
+    }
+
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop == GNRC_RPL_P2P_MOP) {
         return;
@@ -315,6 +315,15 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
     LL_SORT(dodag->parents, dodag->instance->of->parent_cmp);
     new_best = dodag->parents;
 
+    /* the objective function may keep the current parent, e.g. to avoid
+     * switching for a marginal improvement */
+    if ((new_best != old_best) &&
+        (dodag->instance->of->which_parent(old_best, new_best) == old_best)) {
+        LL_DELETE(dodag->parents, old_best);
+        LL_PREPEND(dodag->parents, old_best);
+        new_best = old_best;
+    }
+
     if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
         return NULL;
     }
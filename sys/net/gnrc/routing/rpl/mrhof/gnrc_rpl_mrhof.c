@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static int parent_cmp(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    parent_cmp,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+static bool _get_stats(gnrc_netif_t *netif, const ipv6_addr_t *addr,
+                       netstats_nb_t *nb)
+{
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];
+    gnrc_ipv6_nib_nc_t nce;
+    void *state = NULL;
+    int res;
+
+    /* parents are link-local, their IID is usually based on the link-layer
+     * address */
+    if ((netif->flags & GNRC_NETIF_FLAGS_HAS_L2ADDR) &&
+        ((res = gnrc_netif_ipv6_iid_to_addr(netif, (eui64_t *)&addr->u64[1],
+                                            l2addr)) > 0) &&
+        netstats_nb_get(&netif->neighbors, l2addr, res, nb)) {
+        return true;
+    }
+    /* otherwise the neighbor cache knows it */
+    while (gnrc_ipv6_nib_nc_iter(netif->pid, &state, &nce)) {
+        if (ipv6_addr_equal(&nce.ipv6, addr)) {
+            return netstats_nb_get(&netif->neighbors, nce.l2addr,
+                                   nce.l2addr_len, nb);
+        }
+    }
+    return false;
+}
+
+static uint16_t _link_metric(gnrc_rpl_parent_t *parent)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(parent->dodag->iface);
+    netstats_nb_t nb;
+
+    if ((netif == NULL) || !_get_stats(netif, &parent->addr, &nb) ||
+        (nb.etx == 0)) {
+        return GNRC_RPL_MRHOF_DEFAULT_ETX;
+    }
+    return nb.etx;
+}
+
+static uint16_t _path_cost(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint16_t add, min_inc = parent->dodag->instance->min_hop_rank_inc;
+    uint32_t cost;
+
+    add = _link_metric(parent);
+    if (add > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    /* the rank increases by at least MinHopRankIncrease */
+    if (add < min_inc) {
+        add = min_inc;
+    }
+    cost = base_rank + add;
+    if (cost > GNRC_RPL_MRHOF_MAX_PATH_COST) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    return cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* nothing to do, the link statistics belong to the interface */
+    (void) dodag;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    if (parent == NULL) {
+        if ((base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE) < base_rank) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        return base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    return _path_cost(parent, base_rank);
+}
+
+/* p1 is the current preferred parent, which is kept unless p2 is clearly
+ * better */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    uint32_t cost1 = _path_cost(p1, p1->rank);
+    uint32_t cost2 = _path_cost(p2, p2->rank);
+
+    if ((cost2 + GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD) < cost1) {
+        DEBUG("RPL MRHOF: switch to %s, path cost %u instead of %u\n",
+              ipv6_addr_to_str(addr_str, &p2->addr, sizeof(addr_str)),
+              (unsigned)cost2, (unsigned)cost1);
+        return p2;
+    }
+    return p1;
+}
+
+int parent_cmp(gnrc_rpl_parent_t *parent1, gnrc_rpl_parent_t *parent2)
+{
+    uint16_t cost1 = _path_cost(parent1, parent1->rank);
+    uint16_t cost2 = _path_cost(parent2, parent2->rank);
+
+    if (cost1 < cost2) {
+        return -1;
+    }
+    else if (cost1 > cost2) {
+        return 1;
+    }
+    return 0;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
+
+/** @} */
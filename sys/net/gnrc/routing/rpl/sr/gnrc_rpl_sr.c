@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/rpl/sr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_RPL_SR_BUCKETS & (GNRC_RPL_SR_BUCKETS - 1))
+#error "GNRC_RPL_SR_BUCKETS must be a power of 2"
+#endif
+
+/* special parent and next values */
+#define SR_NONE         (UINT16_MAX)        /* unused entry, end of bucket */
+#define SR_ROOT         (UINT16_MAX - 1)    /* parent is the root */
+#define SR_UNKNOWN      (UINT16_MAX - 2)    /* parent not known yet */
+
+/* the prefix is taken from the DODAG ID */
+#define PREFIX_LEN      (sizeof(ipv6_addr_t) - sizeof(eui64_t))
+
+static gnrc_rpl_sr_entry_t _entries[GNRC_RPL_SR_NUMOF];
+static uint16_t _buckets[GNRC_RPL_SR_BUCKETS];
+static ipv6_addr_t _dodag_id;
+/* KERNEL_PID_UNDEF until gnrc_rpl_sr_init() set up the table */
+static kernel_pid_t _iface = KERNEL_PID_UNDEF;
+static unsigned _numof;
+static mutex_t _mutex = MUTEX_INIT;
+
+static inline const eui64_t *_iid(const ipv6_addr_t *addr)
+{
+    return (const eui64_t *)&addr->u8[PREFIX_LEN];
+}
+
+static unsigned _hash(const eui64_t *iid)
+{
+    /* the last bytes of an IID differ the most within a deployment */
+    uint16_t h = (iid->uint8[6] << 8) | iid->uint8[7];
+
+    h ^= (iid->uint8[4] << 8) | iid->uint8[5];
+    h ^= h >> 7;
+    return h & (GNRC_RPL_SR_BUCKETS - 1);
+}
+
+static uint16_t _find(const eui64_t *iid)
+{
+    uint16_t idx = _buckets[_hash(iid)];
+
+    /* the IID inside an address may not be aligned */
+    while ((idx != SR_NONE) &&
+           memcmp(&_entries[idx].iid, iid, sizeof(eui64_t))) {
+        idx = _entries[idx].next;
+    }
+    return idx;
+}
+
+static uint16_t _alloc(const eui64_t *iid)
+{
+    for (uint16_t idx = 0; idx < GNRC_RPL_SR_NUMOF; idx++) {
+        gnrc_rpl_sr_entry_t *e = &_entries[idx];
+
+        if (e->parent == SR_NONE) {
+            unsigned b = _hash(iid);
+
+            memcpy(&e->iid, iid, sizeof(eui64_t));
+            e->parent = SR_UNKNOWN;
+            e->lifetime = 0;
+            e->next = _buckets[b];
+            _buckets[b] = idx;
+            _numof++;
+            return idx;
+        }
+    }
+    return SR_NONE;
+}
+
+static void _remove(uint16_t idx)
+{
+    uint16_t *pos = &_buckets[_hash(&_entries[idx].iid)];
+
+    while (*pos != idx) {
+        pos = &_entries[*pos].next;
+    }
+    *pos = _entries[idx].next;
+    _entries[idx].parent = SR_NONE;
+    _numof--;
+
+    /* the routes of the children are unknown until they send a new DAO */
+    for (unsigned i = 0; i < GNRC_RPL_SR_NUMOF; i++) {
+        if (_entries[i].parent == idx) {
+            _entries[i].parent = SR_UNKNOWN;
+        }
+    }
+}
+
+static bool _in_dodag(const ipv6_addr_t *addr)
+{
+    return (_iface != KERNEL_PID_UNDEF) &&
+           (memcmp(addr, &_dodag_id, PREFIX_LEN) == 0);
+}
+
+void gnrc_rpl_sr_init(const ipv6_addr_t *dodag_id, kernel_pid_t iface)
+{
+    mutex_lock(&_mutex);
+    _dodag_id = *dodag_id;
+    _iface = iface;
+    _numof = 0;
+    for (unsigned i = 0; i < GNRC_RPL_SR_NUMOF; i++) {
+        _entries[i].parent = SR_NONE;
+    }
+    for (unsigned i = 0; i < GNRC_RPL_SR_BUCKETS; i++) {
+        _buckets[i] = SR_NONE;
+    }
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_sr_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                    uint16_t lifetime)
+{
+    uint16_t idx, pidx;
+    int res = 0;
+
+    if (!_in_dodag(target) || !_in_dodag(parent)) {
+        return -EINVAL;
+    }
+    if (lifetime == 0) {
+        gnrc_rpl_sr_del(target);
+        return 0;
+    }
+
+    mutex_lock(&_mutex);
+    if (((idx = _find(_iid(target))) == SR_NONE) &&
+        ((idx = _alloc(_iid(target))) == SR_NONE)) {
+        res = -ENOMEM;
+        goto out;
+    }
+
+    if (ipv6_addr_equal(parent, &_dodag_id)) {
+        pidx = SR_ROOT;
+    }
+    else if (((pidx = _find(_iid(parent))) == SR_NONE) &&
+             ((pidx = _alloc(_iid(parent))) != SR_NONE)) {
+        /* placeholder until the parent reports its own route */
+        _entries[pidx].lifetime = lifetime;
+    }
+    if (pidx == SR_NONE) {
+        res = -ENOMEM;
+        pidx = SR_UNKNOWN;
+    }
+    _entries[idx].parent = pidx;
+    _entries[idx].lifetime = lifetime;
+
+    DEBUG("RPL SR: entry %u, parent %u, lifetime %u\n", idx, pidx, lifetime);
+
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_sr_del(const ipv6_addr_t *target)
+{
+    if (!_in_dodag(target)) {
+        return;
+    }
+
+    mutex_lock(&_mutex);
+    uint16_t idx = _find(_iid(target));
+    if (idx != SR_NONE) {
+        _remove(idx);
+    }
+    mutex_unlock(&_mutex);
+}
+
+int gnrc_rpl_sr_get_route(const ipv6_addr_t *dst, ipv6_addr_t *route,
+                          unsigned max, kernel_pid_t *iface)
+{
+    uint16_t hops[GNRC_RPL_SR_MAX_DEPTH];
+    unsigned n = 0;
+    int res;
+
+    if (!_in_dodag(dst) || ipv6_addr_equal(dst, &_dodag_id)) {
+        return -ENOENT;
+    }
+    if (max > GNRC_RPL_SR_MAX_DEPTH) {
+        max = GNRC_RPL_SR_MAX_DEPTH;
+    }
+
+    mutex_lock(&_mutex);
+    uint16_t idx = _find(_iid(dst));
+    if (idx == SR_NONE) {
+        res = -ENOENT;
+        goto out;
+    }
+    /* collect the route upwards */
+    while (idx != SR_ROOT) {
+        if (idx == SR_UNKNOWN) {
+            res = -EHOSTUNREACH;
+            goto out;
+        }
+        if (n == max) {
+            res = -ELOOP;
+            goto out;
+        }
+        hops[n++] = idx;
+        idx = _entries[idx].parent;
+    }
+    /* and write it downwards */
+    for (unsigned i = 0; i < n; i++) {
+        memcpy(&route[i], &_dodag_id, PREFIX_LEN);
+        memcpy(&route[i].u8[PREFIX_LEN], &_entries[hops[n - 1 - i]].iid,
+               sizeof(eui64_t));
+    }
+    if (iface) {
+        *iface = _iface;
+    }
+    res = n;
+
+out:
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_sr_update(uint16_t elapsed)
+{
+    mutex_lock(&_mutex);
+    if (_iface == KERNEL_PID_UNDEF) {
+        /* not a non-storing root, the entries are not set up */
+        mutex_unlock(&_mutex);
+        return;
+    }
+    for (uint16_t idx = 0; idx < GNRC_RPL_SR_NUMOF; idx++) {
+        gnrc_rpl_sr_entry_t *e = &_entries[idx];
+
+        if ((e->parent == SR_NONE) || (e->lifetime == GNRC_RPL_SR_LIFETIME_INF)) {
+            continue;
+        }
+        if (e->lifetime <= elapsed) {
+            DEBUG("RPL SR: entry %u expired\n", idx);
+            _remove(idx);
+        }
+        else {
+            e->lifetime -= elapsed;
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+unsigned gnrc_rpl_sr_numof(void)
+{
+    return _numof;
+}
+
+/** @} */
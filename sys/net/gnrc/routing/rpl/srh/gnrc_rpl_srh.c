@@ -15,10 +15,13 @@
  * @author Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <string.h>
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/ext/rh.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/rpl/srh.h"
+#include "net/protnum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -29,6 +32,17 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_SRH_COMPRE(X)      (X & 0x0F)
 #define GNRC_RPL_SRH_COMPRI(X)      ((X & 0xF0) >> 4)
 
+/* prefix octets of @p addr equal to @p ref, at most 15 can be elided */
+static unsigned _common_prefix(const ipv6_addr_t *addr, const ipv6_addr_t *ref)
+{
+    unsigned i = 0;
+
+    while ((i < 15) && (addr->u8[i] == ref->u8[i])) {
+        i++;
+    }
+    return i;
+}
+
 /* checks if multiple addresses within the source routing header exist on my
  * interfaces */
 static bool _contains_multiple_of_my_addr(const ipv6_addr_t *dst,
@@ -121,4 +135,68 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh)
     return GNRC_IPV6_EXT_RH_FORWARDED;
 }
 
+int gnrc_rpl_srh_insert(gnrc_pktsnip_t *ipv6, const ipv6_addr_t *route,
+                        unsigned num)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    const ipv6_addr_t *last = &route[num - 1];
+    unsigned compri = 15, compre, size, pad;
+
+    assert(num >= 2);
+
+    /* the intermediate hops are restored from the destination address
+     * while the packet travels along the route */
+    for (unsigned i = 1; i < num - 1; i++) {
+        unsigned c = _common_prefix(&route[i], &route[0]);
+        if (c < compri) {
+            compri = c;
+        }
+    }
+    compre = _common_prefix(last, &route[0]);
+    if (num == 2) {
+        compri = compre;
+    }
+    else if (compre > compri) {
+        /* the last hop is restored from the address of the one before */
+        compre = compri;
+    }
+    size = (num - 2) * (sizeof(ipv6_addr_t) - compri) +
+           (sizeof(ipv6_addr_t) - compre);
+    pad = (8 - ((sizeof(gnrc_rpl_srh_t) + size) & 0x7)) & 0x7;
+
+    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(ipv6->next, NULL,
+                                           sizeof(gnrc_rpl_srh_t) + size + pad,
+                                           GNRC_NETTYPE_IPV6_EXT);
+    if (snip == NULL) {
+        DEBUG("RPL SRH: no space left in packet buffer\n");
+        return -ENOMEM;
+    }
+
+    gnrc_rpl_srh_t *rh = snip->data;
+    uint8_t *addr_vec = (uint8_t *)(rh + 1);
+
+    rh->nh = hdr->nh;
+    rh->len = (snip->size - 8) / 8;
+    rh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    rh->seg_left = num - 1;
+    rh->compr = (compri << 4) | compre;
+    rh->pad_resv = pad << 4;
+    rh->resv = 0;
+    for (unsigned i = 1; i < num - 1; i++) {
+        memcpy(addr_vec, &route[i].u8[compri], sizeof(ipv6_addr_t) - compri);
+        addr_vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(addr_vec, &last->u8[compre], sizeof(ipv6_addr_t) - compre);
+    memset(addr_vec + sizeof(ipv6_addr_t) - compre, 0, pad);
+
+    ipv6->next = snip;
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + snip->size);
+    memcpy(&hdr->dst, &route[0], sizeof(hdr->dst));
+
+    DEBUG("RPL SRH: %u hops, CmprI %u, CmprE %u\n", num, compri, compre);
+
+    return 0;
+}
+
 /** @} */
@@ -21,7 +21,9 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <string.h>
 
+#include "thread.h"
 #include "xtimer.h"
 #include "random.h"
 #include "net/netdev.h"
@@ -63,11 +65,15 @@ static inline uint32_t choose_backoff_period(int be,
     if (be > conf->max_be) {
         be = conf->max_be;
     }
-    uint32_t max_backoff = ((1 << be) - 1) * CSMA_SENDER_BACKOFF_PERIOD_UNIT;
+    uint32_t max_backoff = ((1 << be) - 1) * conf->backoff_period;
+
+    if (max_backoff <= conf->backoff_period) {
+        return conf->backoff_period;
+    }
 
     uint32_t period = random_uint32() % max_backoff;
-    if (period < CSMA_SENDER_BACKOFF_PERIOD_UNIT) {
-        period = CSMA_SENDER_BACKOFF_PERIOD_UNIT;
+    if (period < conf->backoff_period) {
+        period = conf->backoff_period;
     }
 
     return period;
@@ -162,7 +168,7 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
 
     int nb = 0, be = conf->min_be;
 
-    while (nb <= conf->max_be) {
+    while (nb <= conf->max_backoffs) {
         /* delay for an adequate random backoff period */
         uint32_t bp = choose_backoff_period(be, conf);
         xtimer_usleep(bp);
@@ -237,3 +243,151 @@ int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist)
 
     return res;
 }
+
+#ifdef MODULE_CSMA_SENDER_ASYNC
+/* returns true if the transceiver does CSMA/CA when sending */
+static bool _hw_csma(netdev_t *dev)
+{
+    netopt_enable_t hwfeat;
+
+    return (dev->driver->get(dev, NETOPT_CSMA, &hwfeat, sizeof(hwfeat)) > 0) &&
+           (hwfeat == NETOPT_ENABLE);
+}
+
+static iolist_t *_pop(csma_sender_t *csma)
+{
+    iolist_t *iolist = csma->queue[csma->head];
+
+    csma->head = (csma->head + 1) % CSMA_SENDER_QUEUE_SIZE;
+    csma->len--;
+    return iolist;
+}
+
+static void _send(csma_sender_t *csma)
+{
+    iolist_t *iolist = _pop(csma);
+    int res = csma->dev->driver->send(csma->dev, iolist);
+
+    if (res >= 0) {
+        csma->stats.tx++;
+    }
+    csma->cb(csma, iolist, res);
+    csma->burst++;
+}
+
+static void _count_busy(csma_sender_t *csma)
+{
+    unsigned idx = csma->nb;
+
+    if (idx >= CSMA_SENDER_STATS_BUSY_NUMOF) {
+        idx = CSMA_SENDER_STATS_BUSY_NUMOF - 1;
+    }
+    csma->stats.busy[idx]++;
+}
+
+/* starts the channel access for the first queued frame */
+static void _start(csma_sender_t *csma)
+{
+    if (csma->len == 0) {
+        return;
+    }
+    if (_hw_csma(csma->dev)) {
+        DEBUG("csma: Network device does hardware CSMA/CA\n");
+        csma->burst = 0;
+        while (csma->len > 0) {
+            _send(csma);
+        }
+        return;
+    }
+    csma->nb = 0;
+    csma->be = csma->conf->min_be;
+    xtimer_set_msg(&csma->timer, choose_backoff_period(csma->be, csma->conf),
+                   &csma->msg, csma->pid);
+}
+
+/* drops the first queued frame and continues with the next one */
+static void _drop(csma_sender_t *csma, int res)
+{
+    iolist_t *iolist = _pop(csma);
+
+    csma->burst = 0;
+    csma->cb(csma, iolist, res);
+    _start(csma);
+}
+
+void csma_sender_init(csma_sender_t *csma, netdev_t *dev,
+                      const csma_sender_conf_t *conf, csma_sender_cb_t cb)
+{
+    assert((csma != NULL) && (dev != NULL) && (cb != NULL));
+    memset(csma, 0, sizeof(csma_sender_t));
+    csma->dev = dev;
+    csma->conf = (conf != NULL) ? conf : &CSMA_SENDER_CONF_DEFAULT;
+    csma->cb = cb;
+    csma->pid = thread_getpid();
+    csma->msg.type = CSMA_SENDER_MSG_TYPE_BACKOFF;
+    csma->msg.content.ptr = csma;
+}
+
+int csma_sender_queue(csma_sender_t *csma, iolist_t *iolist)
+{
+    assert((csma != NULL) && (iolist != NULL));
+    if (csma->len >= CSMA_SENDER_QUEUE_SIZE) {
+        DEBUG("csma: send queue full\n");
+        csma->stats.queue_full++;
+        return -ENOBUFS;
+    }
+    csma->queue[(csma->head + csma->len) % CSMA_SENDER_QUEUE_SIZE] = iolist;
+    if (++csma->len == 1) {
+        /* otherwise the backoff for the first frame is running already */
+        _start(csma);
+    }
+    return 0;
+}
+
+void csma_sender_handle_msg(msg_t *msg)
+{
+    csma_sender_t *csma = msg->content.ptr;
+    netopt_enable_t clear;
+
+    assert(msg->type == CSMA_SENDER_MSG_TYPE_BACKOFF);
+    if (csma->len == 0) {
+        return;
+    }
+    csma->stats.cca++;
+    if (csma->dev->driver->get(csma->dev, NETOPT_IS_CHANNEL_CLR, &clear,
+                               sizeof(clear)) < 0) {
+        DEBUG("csma: !!! DEVICE DRIVER FAILURE! TRANSMISSION ABORTED!\n");
+        _drop(csma, -ECANCELED);
+        return;
+    }
+    if (clear != NETOPT_ENABLE) {
+        DEBUG("csma: Radio medium busy.\n");
+        csma->stats.cca_busy++;
+        if (++csma->nb > csma->conf->max_backoffs) {
+            DEBUG("csma: Software CSMA/CA failure: medium never available.\n");
+            _count_busy(csma);
+            csma->stats.tx_failed++;
+            _drop(csma, -EBUSY);
+            return;
+        }
+        if (csma->be < csma->conf->max_be) {
+            csma->be++;
+        }
+        xtimer_set_msg(&csma->timer,
+                       choose_backoff_period(csma->be, csma->conf),
+                       &csma->msg, csma->pid);
+        return;
+    }
+    DEBUG("csma: Radio medium available: sending %u queued frames.\n",
+          csma->len);
+    _count_busy(csma);
+    csma->burst = 0;
+    _send(csma);
+    /* the channel is ours for the following frames, too */
+    for (unsigned i = 1; (i < CSMA_SENDER_BURST_MAX) && (csma->len > 0); i++) {
+        csma->stats.tx_burst++;
+        _send(csma);
+    }
+    _start(csma);
+}
+#endif /* MODULE_CSMA_SENDER_ASYNC */
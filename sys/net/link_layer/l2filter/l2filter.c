@@ -22,6 +22,13 @@
 
 #include "assert.h"
 #include "net/l2filter.h"
+#ifdef MODULE_L2FILTER_HASH
+#include "hashes.h"
+
+#if (L2FILTER_LISTSIZE & (L2FILTER_LISTSIZE - 1))
+#error "L2FILTER_LISTSIZE must be a power of 2 with l2filter_hash"
+#endif
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -42,6 +49,91 @@ void l2filter_init(l2filter_t *list)
     }
 }
 
+#ifdef MODULE_L2FILTER_HASH
+#define MASK    (L2FILTER_LISTSIZE - 1)
+
+static inline unsigned _home(const void *addr, size_t addr_len)
+{
+    return fnv_hash(addr, addr_len) & MASK;
+}
+
+/* an address is stored at its hash slot or in one of the occupied slots
+ * directly behind it, so the search ends at the first slot with addr_len 0 */
+static int _find(const l2filter_t *list, const void *addr, size_t addr_len)
+{
+    unsigned pos = _home(addr, addr_len);
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        if (list[pos].addr_len == 0) {
+            break;
+        }
+        if (match(&list[pos], addr, addr_len)) {
+            return pos;
+        }
+        pos = (pos + 1) & MASK;
+    }
+    return -1;
+}
+
+int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len)
+{
+    assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
+
+    unsigned pos = _home(addr, addr_len);
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        if (list[pos].addr_len == 0) {
+            list[pos].addr_len = addr_len;
+            memcpy(list[pos].addr, addr, addr_len);
+            return 0;
+        }
+        if (match(&list[pos], addr, addr_len)) {
+            return 0;
+        }
+        pos = (pos + 1) & MASK;
+    }
+    return -ENOMEM;
+}
+
+int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len)
+{
+    assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
+
+    int pos = _find(list, addr, addr_len);
+
+    if (pos < 0) {
+        return -ENOENT;
+    }
+    /* an emptied slot would hide addresses stored behind it from _find(), so
+     * pull each following address into the gap unless its hash slot lies
+     * between the gap and its current slot */
+    unsigned gap = pos;
+    unsigned next = pos;
+    while (1) {
+        next = (next + 1) & MASK;
+        if ((list[next].addr_len == 0) || (next == (unsigned)pos)) {
+            break;
+        }
+        unsigned home = _home(list[next].addr, list[next].addr_len);
+        if (((next - home) & MASK) >= ((next - gap) & MASK)) {
+            list[gap] = list[next];
+            gap = next;
+        }
+    }
+    list[gap].addr_len = 0;
+    return 0;
+}
+#else
+static int _find(const l2filter_t *list, const void *addr, size_t addr_len)
+{
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        if (match(&list[i], addr, addr_len)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 int l2filter_add(l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
@@ -64,44 +156,37 @@ int l2filter_rm(l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
-    int res = -ENOENT;
+    int pos = _find(list, addr, addr_len);
 
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            list[i].addr_len = 0;
-            res = 0;
-            break;
-        }
+    if (pos < 0) {
+        return -ENOENT;
     }
-
-    return res;
+    list[pos].addr_len = 0;
+    return 0;
 }
+#endif
 
 bool l2filter_pass(const l2filter_t *list, const void *addr, size_t addr_len)
 {
     assert(list && addr && (addr_len <= L2FILTER_ADDR_MAXLEN));
 
+    bool found = (_find(list, addr, addr_len) >= 0);
+
 #ifdef MODULE_L2FILTER_WHITELIST
-    bool res = false;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] whitelist: address match -> packet passes\n");
-            res = true;
-            break;
-        }
+    if (found) {
+        DEBUG("[l2filter] whitelist: address match -> packet passes\n");
     }
-    DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
+    else {
+        DEBUG("[l2filter] whitelist: no match -> packet dropped\n");
+    }
+    return found;
 #else
-    bool res = true;
-    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
-        if (match(&list[i], addr, addr_len)) {
-            DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
-            res = false;
-            break;
-        }
+    if (found) {
+        DEBUG("[l2filter] blacklist: address match -> packet dropped\n");
+    }
+    else {
+        DEBUG("[l2filter] blacklist: no match -> packet passes\n");
     }
-    DEBUG("[l2fitler] blacklist: no match -> packet passes\n");
+    return !found;
 #endif
-
-    return res;
 }
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "hashes.h"
+#include "net/ipv6/lpm.h"
+
+static void _key(ipv6_addr_t *key, const ipv6_addr_t *addr, uint8_t len)
+{
+    memset(key, 0, sizeof(*key));
+    ipv6_addr_init_prefix(key, addr, len);
+}
+
+static unsigned _home(const ipv6_lpm_t *lpm, const ipv6_addr_t *key,
+                      uint8_t len)
+{
+    return (fnv_hash(key->u8, (len + 7) / 8) ^ len) & (lpm->size - 1);
+}
+
+static inline bool _match(const ipv6_lpm_entry_t *entry,
+                          const ipv6_addr_t *key, uint8_t len)
+{
+    return entry->used && (entry->prefix_len == len) &&
+           ipv6_addr_equal(&entry->prefix, key);
+}
+
+/* the hash covers prefix and length, so every prefix length in use has its
+ * own probe sequences and a lookup for one length ends at the first unused
+ * entry */
+static int _find(const ipv6_lpm_t *lpm, const ipv6_addr_t *key, uint8_t len)
+{
+    unsigned pos = _home(lpm, key, len);
+
+    for (unsigned i = 0; i < lpm->size; i++) {
+        if (!lpm->entries[pos].used) {
+            break;
+        }
+        if (_match(&lpm->entries[pos], key, len)) {
+            return pos;
+        }
+        pos = (pos + 1) & (lpm->size - 1);
+    }
+    return -1;
+}
+
+void ipv6_lpm_init(ipv6_lpm_t *lpm, ipv6_lpm_entry_t *entries, unsigned size)
+{
+    assert((size > 0) && ((size & (size - 1)) == 0));
+    memset(lpm, 0, sizeof(*lpm));
+    memset(entries, 0, size * sizeof(*entries));
+    lpm->entries = entries;
+    lpm->size = size;
+}
+
+int ipv6_lpm_add(ipv6_lpm_t *lpm, const ipv6_addr_t *prefix,
+                 uint8_t prefix_len)
+{
+    ipv6_addr_t key;
+    unsigned pos;
+
+    if (prefix_len > 128) {
+        return -EINVAL;
+    }
+    _key(&key, prefix, prefix_len);
+    pos = _home(lpm, &key, prefix_len);
+    for (unsigned i = 0; i < lpm->size; i++) {
+        ipv6_lpm_entry_t *entry = &lpm->entries[pos];
+
+        if (!entry->used) {
+            entry->prefix = key;
+            entry->prefix_len = prefix_len;
+            entry->hits = 0;
+            entry->used = true;
+            lpm->numof++;
+            bf_set(lpm->lens, prefix_len);
+            return 0;
+        }
+        if (_match(entry, &key, prefix_len)) {
+            return 0;
+        }
+        pos = (pos + 1) & (lpm->size - 1);
+    }
+    return -ENOMEM;
+}
+
+int ipv6_lpm_del(ipv6_lpm_t *lpm, const ipv6_addr_t *prefix,
+                 uint8_t prefix_len)
+{
+    const unsigned mask = lpm->size - 1;
+    ipv6_addr_t key;
+    unsigned gap, next;
+    int pos;
+
+    if (prefix_len > 128) {
+        return -ENOENT;
+    }
+    _key(&key, prefix, prefix_len);
+    if ((pos = _find(lpm, &key, prefix_len)) < 0) {
+        return -ENOENT;
+    }
+    /* entries are moved whole, hit counter included: each following entry
+     * whose home (hashed from its own prefix and length) is not between the
+     * gap and its position fills the gap, so no unused entry splits a probe
+     * sequence */
+    gap = next = pos;
+    while (1) {
+        ipv6_lpm_entry_t *entry;
+
+        next = (next + 1) & mask;
+        entry = &lpm->entries[next];
+        if (!entry->used || (next == (unsigned)pos)) {
+            break;
+        }
+        unsigned home = _home(lpm, &entry->prefix, entry->prefix_len);
+        if (((next - home) & mask) >= ((next - gap) & mask)) {
+            lpm->entries[gap] = *entry;
+            gap = next;
+        }
+    }
+    lpm->entries[gap].used = false;
+    lpm->numof--;
+    for (unsigned i = 0; i < lpm->size; i++) {
+        if (lpm->entries[i].used &&
+            (lpm->entries[i].prefix_len == prefix_len)) {
+            return 0;
+        }
+    }
+    bf_unset(lpm->lens, prefix_len);
+    return 0;
+}
+
+ipv6_lpm_entry_t *ipv6_lpm_match(const ipv6_lpm_t *lpm,
+                                 const ipv6_addr_t *addr)
+{
+    if (lpm->numof == 0) {
+        return NULL;
+    }
+    /* walk the prefix lengths in use from the longest, skipping 8 at once */
+    for (int byte = sizeof(lpm->lens) - 1; byte >= 0; byte--) {
+        if (lpm->lens[byte] == 0) {
+            continue;
+        }
+        for (int bit = 7; bit >= 0; bit--) {
+            uint8_t len = (byte * 8) + bit;
+            ipv6_addr_t key;
+            int pos;
+
+            if (!(lpm->lens[byte] & (1 << bit))) {
+                continue;
+            }
+            _key(&key, addr, len);
+            if ((pos = _find(lpm, &key, len)) >= 0) {
+                return &lpm->entries[pos];
+            }
+        }
+    }
+    return NULL;
+}
+
+/** @} */
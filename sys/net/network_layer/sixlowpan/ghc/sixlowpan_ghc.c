@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/sixlowpan/ghc.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* bytecodes (see https://tools.ietf.org/html/rfc7400#section-2) */
+#define GHC_LIT_MAX         (95U)   /* 0kkkkkkk: k literal bytes, k < 96 */
+#define GHC_ZEROS           (0x80)  /* 1000nnnn: n + 2 zero bytes */
+#define GHC_ZEROS_MASK      (0xf0)
+#define GHC_ZEROS_MAX       (17U)
+#define GHC_STOP            (0x90)  /* 10010000: stop code */
+#define GHC_EXT             (0xa0)  /* 101nssss: sa += ssss << 3, na += n << 3 */
+#define GHC_EXT_MASK        (0xe0)
+#define GHC_EXT_SA_MAX      (15U)
+#define GHC_BREF            (0xc0)  /* 11nnnkkk: n = na + nnn + 2,
+                                     * s = kkk + sa + n */
+#define GHC_BREF_MASK       (0xc0)
+
+#define GHC_STATIC_OFFSET   (2 * sizeof(ipv6_addr_t))
+
+static const uint8_t _static_dict[] = {
+    0x16, 0xfe, 0xfd, 0x17, 0xfe, 0xfd, 0x00, 0x01,
+    0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+};
+
+void sixlowpan_ghc_dict_init(uint8_t *dict, const ipv6_addr_t *src,
+                             const ipv6_addr_t *dst)
+{
+    memcpy(dict, src, sizeof(ipv6_addr_t));
+    memcpy(dict + sizeof(ipv6_addr_t), dst, sizeof(ipv6_addr_t));
+    memcpy(dict + GHC_STATIC_OFFSET, _static_dict, sizeof(_static_dict));
+}
+
+/* number of extension codes a back-reference of n bytes from s bytes back
+ * needs */
+static size_t _bref_ext(size_t n, size_t s)
+{
+    size_t na = (n - 2) >> 3;
+    size_t sa = (((s - n) >> 3) + GHC_EXT_SA_MAX - 1) / GHC_EXT_SA_MAX;
+
+    return (na > sa) ? na : sa;
+}
+
+static int _put_lit(const uint8_t *lit, size_t lit_len, uint8_t *out,
+                    size_t *out_pos, size_t out_len)
+{
+    if (lit_len == 0) {
+        return 0;
+    }
+    if ((*out_pos + 1 + lit_len) > out_len) {
+        return -ENOBUFS;
+    }
+    out[(*out_pos)++] = lit_len;
+    memcpy(&out[*out_pos], lit, lit_len);
+    *out_pos += lit_len;
+    return 0;
+}
+
+int sixlowpan_ghc_compress(const uint8_t *buf, size_t len,
+                           uint8_t *out, size_t out_len)
+{
+    size_t pos = SIXLOWPAN_GHC_DICT_LEN, lit = pos, out_pos = 0;
+    const size_t end = SIXLOWPAN_GHC_DICT_LEN + len;
+
+    while (pos < end) {
+        size_t zeros = 0, zeros_gain = 0, bref_n = 0, bref_s = 0;
+        size_t bref_gain = 0;
+
+        while (((pos + zeros) < end) && (zeros < GHC_ZEROS_MAX) &&
+               (buf[pos + zeros] == 0)) {
+            zeros++;
+        }
+        if (zeros >= 2) {
+            zeros_gain = zeros - 1;
+        }
+        /* find the back-reference that saves most */
+        for (size_t start = 0; start < pos; start++) {
+            size_t n = 0, max_n = end - pos, cost;
+
+            if (max_n > (pos - start)) {
+                max_n = pos - start;
+            }
+            while ((n < max_n) && (buf[start + n] == buf[pos + n])) {
+                n++;
+            }
+            if (n < 2) {
+                continue;
+            }
+            cost = 1 + _bref_ext(n, pos - start);
+            if ((n > cost) && ((n - cost) > bref_gain)) {
+                bref_gain = n - cost;
+                bref_n = n;
+                bref_s = pos - start;
+            }
+        }
+        if ((bref_gain == 0) && (zeros_gain == 0)) {
+            /* no saving => literal byte */
+            pos++;
+            if ((pos - lit) == GHC_LIT_MAX) {
+                if (_put_lit(&buf[lit], pos - lit, out, &out_pos,
+                             out_len) < 0) {
+                    return -ENOBUFS;
+                }
+                lit = pos;
+            }
+            continue;
+        }
+        if (_put_lit(&buf[lit], pos - lit, out, &out_pos, out_len) < 0) {
+            return -ENOBUFS;
+        }
+        if (bref_gain >= zeros_gain) {
+            size_t na = (bref_n - 2) >> 3, sa = (bref_s - bref_n) >> 3;
+
+            if ((out_pos + 1 + _bref_ext(bref_n, bref_s)) > out_len) {
+                return -ENOBUFS;
+            }
+            while ((na > 0) || (sa > 0)) {
+                uint8_t ssss = (sa > GHC_EXT_SA_MAX) ? GHC_EXT_SA_MAX : sa;
+                uint8_t n = (na > 0) ? 1 : 0;
+
+                out[out_pos++] = GHC_EXT | (n << 4) | ssss;
+                na -= n;
+                sa -= ssss;
+            }
+            out[out_pos++] = GHC_BREF | (((bref_n - 2) & 0x7) << 3) |
+                             ((bref_s - bref_n) & 0x7);
+            pos += bref_n;
+        }
+        else {
+            if (out_pos >= out_len) {
+                return -ENOBUFS;
+            }
+            out[out_pos++] = GHC_ZEROS | (zeros - 2);
+            pos += zeros;
+        }
+        lit = pos;
+    }
+    if (_put_lit(&buf[lit], pos - lit, out, &out_pos, out_len) < 0) {
+        return -ENOBUFS;
+    }
+    DEBUG("ghc: compressed %u to %u bytes\n", (unsigned)len,
+          (unsigned)out_pos);
+    return out_pos;
+}
+
+int sixlowpan_ghc_decompress(const uint8_t *dict, const uint8_t *in,
+                             size_t in_len, uint8_t *out, size_t out_len)
+{
+    size_t len = 0, sa = 0, na = 0;
+
+    for (size_t i = 0; i < in_len;) {
+        uint8_t code = in[i++];
+        size_t n;
+
+        if (code <= GHC_LIT_MAX) {
+            n = code;
+            if ((i + n) > in_len) {
+                return -EINVAL;
+            }
+            if (out != NULL) {
+                if ((len + n) > out_len) {
+                    return -ENOBUFS;
+                }
+                memcpy(&out[len], &in[i], n);
+            }
+            i += n;
+        }
+        else if (code == GHC_STOP) {
+            break;
+        }
+        else if ((code & GHC_ZEROS_MASK) == GHC_ZEROS) {
+            n = (code & 0x0f) + 2;
+            if (out != NULL) {
+                if ((len + n) > out_len) {
+                    return -ENOBUFS;
+                }
+                memset(&out[len], 0, n);
+            }
+        }
+        else if ((code & GHC_EXT_MASK) == GHC_EXT) {
+            sa += (code & 0x0f) << 3;
+            na += (code & 0x10) >> 1;
+            continue;
+        }
+        else if ((code & GHC_BREF_MASK) == GHC_BREF) {
+            size_t s;
+
+            n = na + ((code >> 3) & 0x7) + 2;
+            s = (code & 0x7) + sa + n;
+            sa = 0;
+            na = 0;
+            if (s > (SIXLOWPAN_GHC_DICT_LEN + len)) {
+                return -EINVAL;
+            }
+            if (out != NULL) {
+                size_t from = SIXLOWPAN_GHC_DICT_LEN + len - s;
+
+                if ((len + n) > out_len) {
+                    return -ENOBUFS;
+                }
+                for (size_t j = 0; j < n; j++, from++) {
+                    out[len + j] = (from < SIXLOWPAN_GHC_DICT_LEN) ?
+                                   dict[from] :
+                                   out[from - SIXLOWPAN_GHC_DICT_LEN];
+                }
+            }
+        }
+        else {
+            /* reserved bytecode */
+            return -EINVAL;
+        }
+        len += n;
+    }
+    return len;
+}
+
+/** @} */
@@ -55,18 +55,21 @@ static void reset_link_set_entry(iib_link_set_entry_t *ls_entry, timex_t *now, u
 static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_entry_t *nb_elt,
                                              timex_t *now, uint64_t val_time,
                                              uint8_t sym, uint8_t lost);
+static void set_link_tuple_addresses(iib_link_set_entry_t *ls_entry,
+                                     nhdp_addr_entry_t *addr_list);
 static void release_link_tuple_addresses(iib_link_set_entry_t *ls_entry);
 
-static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                              timex_t *now, uint64_t val_time);
-static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                             nhdp_addr_t *th_addr, timex_t *now, uint64_t val_time);
-static void rem_two_hop_entry(iib_base_entry_t *base_entry, iib_two_hop_set_entry_t *th_entry);
+static int update_two_hop_set(iib_link_set_entry_t *ls_entry, timex_t *now, uint64_t val_time);
+static int add_two_hop_entry(iib_link_set_entry_t *ls_entry, nhdp_addr_t *th_addr,
+                             timex_t *now, uint64_t val_time);
+static void set_two_hop_entry(iib_two_hop_set_entry_t *th_entry, timex_t *now,
+                              uint64_t val_time);
+static void rem_two_hop_entry(iib_link_set_entry_t *ls_entry, iib_two_hop_set_entry_t *th_entry);
+static void rem_two_hop_entries(iib_link_set_entry_t *ls_entry);
 
 static void wr_update_ls_status(iib_base_entry_t *base_entry,
                                 iib_link_set_entry_t *ls_elt, timex_t *now);
-static void update_nb_tuple_symmetry(iib_base_entry_t *base_entry,
-                                     iib_link_set_entry_t *ls_entry, timex_t *now);
+static void update_nb_tuple_symmetry(iib_link_set_entry_t *ls_entry, timex_t *now);
 static void rem_not_heard_nb_tuple(iib_link_set_entry_t *ls_entry, timex_t *now);
 
 static inline timex_t get_max_timex(timex_t time_one, timex_t time_two);
@@ -93,7 +96,6 @@ int iib_register_if(kernel_pid_t pid)
 
     new_entry->if_pid = pid;
     new_entry->link_set_head = NULL;
-    new_entry->two_hop_set_head = NULL;
     LL_PREPEND(iib_base_entry_head, new_entry);
 
     return 0;
@@ -127,7 +129,7 @@ iib_link_set_entry_t *iib_process_hello(kernel_pid_t if_pid, nib_entry_t *nb_elt
 
         /* Create new two hop tuples for signaled symmetric neighbors */
         if (ls_entry) {
-            update_two_hop_set(base_elt, ls_entry, &now, validity_time);
+            update_two_hop_set(ls_entry, &now, validity_time);
         }
     }
 
@@ -166,7 +168,8 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_SYMMETRIC,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_SYM;
+                                    nhdp_set_address_tmp_usg(addr_elt->address,
+                                                             NHDP_ADDR_TMP_SYM);
                                     break;
 
                                 case IIB_LT_STATUS_HEARD:
@@ -175,7 +178,8 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_HEARD,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                                    nhdp_set_address_tmp_usg(addr_elt->address,
+                                                             NHDP_ADDR_TMP_ANY);
                                     break;
 
                                 case IIB_LT_STATUS_UNKNOWN:
@@ -187,7 +191,8 @@ void iib_fill_wr_addresses(kernel_pid_t if_pid, struct rfc5444_writer *wr)
                                                          RFC5444_LINKSTATUS_LOST,
                                                          rfc5444_metric_encode(ls_elt->metric_in),
                                                          rfc5444_metric_encode(ls_elt->metric_out));
-                                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_ANY;
+                                    nhdp_set_address_tmp_usg(addr_elt->address,
+                                                             NHDP_ADDR_TMP_ANY);
                                     break;
 
                                 case IIB_LT_STATUS_PENDING:
@@ -364,36 +369,32 @@ void iib_process_metric_refresh(void)
  */
 static void cleanup_link_sets(void)
 {
-    iib_base_entry_t *base_elt;
+    nhdp_addr_t *addr_elt;
 
-    /* Loop through all link sets */
-    LL_FOREACH(iib_base_entry_head, base_elt) {
-        /* Loop through all link tuples of the link set */
-        iib_link_set_entry_t *ls_elt, *ls_tmp;
-        LL_FOREACH_SAFE(base_elt->link_set_head, ls_elt, ls_tmp) {
-            /* Loop through all addresses of the link tuples */
-            nhdp_addr_entry_t *lt_elt, *lt_tmp;
-            LL_FOREACH_SAFE(ls_elt->address_list_head, lt_elt, lt_tmp) {
-                if (NHDP_ADDR_TMP_IN_REM_LIST(lt_elt->address)) {
-                    /* Remove link tuple address if included in the Removed Addr List */
-                    LL_DELETE(ls_elt->address_list_head, lt_elt);
-                    nhdp_free_addr_entry(lt_elt);
-                }
-            }
+    /* Loop through the addresses of the Removed Addr List */
+    LL_FOREACH2(nhdp_get_addr_tmp_head(), addr_elt, tmp_next) {
+        iib_link_set_entry_t *ls_elt = addr_elt->ls_elt;
+        nhdp_addr_entry_t *lt_elt;
 
-            /* Remove link tuples with empty address list */
-            if (!ls_elt->address_list_head) {
-                if (ls_elt->last_status == IIB_LT_STATUS_SYM) {
-                    /* Remove all two hop entries for the corresponding link tuple */
-                    iib_two_hop_set_entry_t *th_elt, *th_tmp;
-                    LL_FOREACH_SAFE(base_elt->two_hop_set_head, th_elt, th_tmp) {
-                        if (th_elt->ls_elt == ls_elt) {
-                            rem_two_hop_entry(base_elt, th_elt);
-                        }
-                    }
-                }
+        if (!NHDP_ADDR_TMP_IN_REM_LIST(addr_elt) || !ls_elt) {
+            continue;
+        }
+
+        /* Remove link tuple address */
+        LL_SEARCH_SCALAR(ls_elt->address_list_head, lt_elt, address, addr_elt);
+        LL_DELETE(ls_elt->address_list_head, lt_elt);
+        addr_elt->ls_elt = NULL;
+        nhdp_free_addr_entry(lt_elt);
+
+        /* Remove link tuples with empty address list */
+        if (!ls_elt->address_list_head) {
+            iib_base_entry_t *base_elt;
 
-                rem_link_set_entry(base_elt, ls_elt);
+            LL_FOREACH(iib_base_entry_head, base_elt) {
+                if (base_elt->if_pid == ls_elt->if_pid) {
+                    rem_link_set_entry(base_elt, ls_elt);
+                    break;
+                }
             }
         }
     }
@@ -406,39 +407,40 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
                                              timex_t *now, uint64_t val_time,
                                              uint8_t sym, uint8_t lost)
 {
-    iib_link_set_entry_t *ls_elt, *ls_tmp;
     iib_link_set_entry_t *matching_lt = NULL;
-    nhdp_addr_entry_t *lt_elt;
+    nhdp_addr_entry_t *addr_list;
+    nhdp_addr_t *addr_elt;
     timex_t v_time, l_hold;
     uint8_t matches = 0;
 
-    /* Loop through every link tuple of the interface to update the link set */
-    LL_FOREACH_SAFE(base_entry->link_set_head, ls_elt, ls_tmp) {
-        /* Loop through all addresses of the link tuple */
-        LL_FOREACH(ls_elt->address_list_head, lt_elt) {
-            if (NHDP_ADDR_TMP_IN_SEND_LIST(lt_elt->address)) {
-                /* If link tuple address matches a sending addr we found a fitting tuple */
-                matches++;
-
-                if (matches > 1) {
-                    /* Multiple matching link tuples, delete the previous one */
-                    if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-                        update_nb_tuple_symmetry(base_entry, matching_lt, now);
-                    }
+    /* Loop through the sending addresses to find the link tuples listing them */
+    LL_FOREACH2(nhdp_get_addr_tmp_head(), addr_elt, tmp_next) {
+        iib_link_set_entry_t *ls_elt = addr_elt->ls_elt;
 
-                    rem_link_set_entry(base_entry, matching_lt);
-                }
+        if (!NHDP_ADDR_TMP_IN_SEND_LIST(addr_elt) || !ls_elt || (ls_elt == matching_lt)
+            || (ls_elt->if_pid != base_entry->if_pid)) {
+            continue;
+        }
+
+        /* If link tuple address matches a sending addr we found a fitting tuple */
+        matches++;
 
-                matching_lt = ls_elt;
-                break;
+        if (matches > 1) {
+            /* Multiple matching link tuples, delete the previous one */
+            if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
+                update_nb_tuple_symmetry(matching_lt, now);
             }
+
+            rem_link_set_entry(base_entry, matching_lt);
         }
+
+        matching_lt = ls_elt;
     }
 
     if (matches > 1) {
         /* Multiple matching link tuples, reset the last one for reuse */
         if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, matching_lt, now);
+            update_nb_tuple_symmetry(matching_lt, now);
         }
 
         reset_link_set_entry(matching_lt, now, val_time);
@@ -461,14 +463,16 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
     l_hold = timex_from_uint64(((uint64_t)NHDP_L_HOLD_TIME_MS) * US_PER_MS);
 
     /* Set Sending Address List as this tuples address list */
-    matching_lt->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_SEND_LIST);
+    addr_list = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_SEND_LIST);
 
-    if (!matching_lt->address_list_head) {
+    if (!addr_list) {
         /* Insufficient memory */
         rem_link_set_entry(base_entry, matching_lt);
         return NULL;
     }
 
+    set_link_tuple_addresses(matching_lt, addr_list);
+
     matching_lt->nb_elt = nb_elt;
 
     /* Set values dependent on link status */
@@ -488,7 +492,7 @@ static iib_link_set_entry_t *update_link_set(iib_base_entry_t *base_entry, nib_e
         matching_lt->sym_time.seconds = 0;
 
         if (matching_lt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, matching_lt, now);
+            update_nb_tuple_symmetry(matching_lt, now);
         }
 
         if (get_tuple_status(matching_lt, now) == IIB_LT_STATUS_HEARD) {
@@ -530,7 +534,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
     if (timex_cmp(ls_elt->exp_time, *now) != 1) {
         /* Entry expired and has to be removed */
         if (ls_elt->last_status == IIB_LT_STATUS_SYM) {
-            update_nb_tuple_symmetry(base_entry, ls_elt, now);
+            update_nb_tuple_symmetry(ls_elt, now);
         }
 
         rem_not_heard_nb_tuple(ls_elt, now);
@@ -539,7 +543,7 @@ static void wr_update_ls_status(iib_base_entry_t *base_entry,
     else if ((ls_elt->last_status == IIB_LT_STATUS_SYM)
              && (timex_cmp(ls_elt->sym_time, *now) != 1)) {
         /* Status changed from SYMMETRIC to HEARD */
-        update_nb_tuple_symmetry(base_entry, ls_elt, now);
+        update_nb_tuple_symmetry(ls_elt, now);
         ls_elt->last_status = IIB_LT_STATUS_HEARD;
 
         if (timex_cmp(ls_elt->heard_time, *now) != 1) {
@@ -574,6 +578,8 @@ static iib_link_set_entry_t *add_default_link_set_entry(iib_base_entry_t *base_e
     }
 
     new_entry->address_list_head = NULL;
+    new_entry->two_hop_set_head = NULL;
+    new_entry->if_pid = base_entry->if_pid;
     reset_link_set_entry(new_entry, now, val_time);
     LL_PREPEND(base_entry->link_set_head, new_entry);
 
@@ -617,24 +623,45 @@ static void reset_link_set_entry(iib_link_set_entry_t *ls_entry, timex_t *now, u
 static void rem_link_set_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry)
 {
     LL_DELETE(base_entry->link_set_head, ls_entry);
+    rem_two_hop_entries(ls_entry);
     release_link_tuple_addresses(ls_entry);
     free(ls_entry);
 }
 
+/**
+ * Set the address list of a link tuple
+ */
+static void set_link_tuple_addresses(iib_link_set_entry_t *ls_entry,
+                                     nhdp_addr_entry_t *addr_list)
+{
+    nhdp_addr_entry_t *addr_elt;
+
+    ls_entry->address_list_head = addr_list;
+    LL_FOREACH(addr_list, addr_elt) {
+        addr_elt->address->ls_elt = ls_entry;
+    }
+}
+
 /**
  * Free all address entries of a link tuple
  */
 static void release_link_tuple_addresses(iib_link_set_entry_t *ls_entry)
 {
+    nhdp_addr_entry_t *addr_elt;
+
+    LL_FOREACH(ls_entry->address_list_head, addr_elt) {
+        if (addr_elt->address->ls_elt == ls_entry) {
+            addr_elt->address->ls_elt = NULL;
+        }
+    }
     nhdp_free_addr_list(ls_entry->address_list_head);
     ls_entry->address_list_head = NULL;
 }
 
 /**
- * Update the 2-Hop Set during HELLO message processing
+ * Update the 2-Hop Tuples of a link tuple during HELLO message processing
  */
-static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                              timex_t *now, uint64_t val_time)
+static int update_two_hop_set(iib_link_set_entry_t *ls_entry, timex_t *now, uint64_t val_time)
 {
     /* Check whether a corresponding link tuple was created */
     if (ls_entry == NULL) {
@@ -646,24 +673,25 @@ static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t
         iib_two_hop_set_entry_t *ths_elt, *ths_tmp;
         nhdp_addr_t *addr_elt;
 
-        /* Loop through all the two hop tuples of the two hop set */
-        LL_FOREACH_SAFE(base_entry->two_hop_set_head, ths_elt, ths_tmp) {
-            if (timex_cmp(ths_elt->exp_time, *now) != 1) {
-                /* Entry is expired, remove it */
-                rem_two_hop_entry(base_entry, ths_elt);
+        /* Loop through the two hop tuples of the link tuple */
+        LL_FOREACH_SAFE(ls_entry->two_hop_set_head, ths_elt, ths_tmp) {
+            if ((timex_cmp(ths_elt->exp_time, *now) != 1)
+                || NHDP_ADDR_TMP_IN_TH_REM_LIST(ths_elt->th_nb_addr)) {
+                /* Entry is expired or the neighbor is lost, remove it */
+                rem_two_hop_entry(ls_entry, ths_elt);
             }
-            else if (ths_elt->ls_elt == ls_entry) {
-                if (ths_elt->th_nb_addr->in_tmp_table &
-                    (NHDP_ADDR_TMP_TH_REM_LIST | NHDP_ADDR_TMP_TH_SYM_LIST)) {
-                    rem_two_hop_entry(base_entry, ths_elt);
-                }
+            else if (NHDP_ADDR_TMP_IN_TH_SYM_LIST(ths_elt->th_nb_addr)) {
+                /* Neighbor is still symmetric, refresh the entry in place */
+                set_two_hop_entry(ths_elt, now, val_time);
+                ths_elt->th_nb_addr->in_tmp_table |= NHDP_ADDR_TMP_TH_REFRESHED;
             }
         }
 
-        /* Add a new entry for every signaled symmetric neighbor address */
-        LL_FOREACH(nhdp_get_addr_db_head(), addr_elt) {
-            if (NHDP_ADDR_TMP_IN_TH_SYM_LIST(addr_elt)) {
-                if (add_two_hop_entry(base_entry, ls_entry, addr_elt, now, val_time)) {
+        /* Add a new entry for every newly signaled symmetric neighbor address */
+        LL_FOREACH2(nhdp_get_addr_tmp_head(), addr_elt, tmp_next) {
+            if (NHDP_ADDR_TMP_IN_TH_SYM_LIST(addr_elt)
+                && !NHDP_ADDR_TMP_TH_IS_REFRESHED(addr_elt)) {
+                if (add_two_hop_entry(ls_entry, addr_elt, now, val_time)) {
                     /* No more memory available, return error */
                     return -1;
                 }
@@ -677,11 +705,10 @@ static int update_two_hop_set(iib_base_entry_t *base_entry, iib_link_set_entry_t
 /**
  * Add a 2-Hop Tuple for a given address
  */
-static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t *ls_entry,
-                             nhdp_addr_t *th_addr, timex_t *now, uint64_t val_time)
+static int add_two_hop_entry(iib_link_set_entry_t *ls_entry, nhdp_addr_t *th_addr,
+                             timex_t *now, uint64_t val_time)
 {
     iib_two_hop_set_entry_t *new_entry;
-    timex_t v_time = timex_from_uint64(val_time * US_PER_MS);
 
     new_entry = (iib_two_hop_set_entry_t *) malloc(sizeof(iib_two_hop_set_entry_t));
 
@@ -694,48 +721,65 @@ static int add_two_hop_entry(iib_base_entry_t *base_entry, iib_link_set_entry_t
     th_addr->usg_count++;
     new_entry->th_nb_addr = th_addr;
     new_entry->ls_elt = ls_entry;
-    new_entry->exp_time = timex_add(*now, v_time);
+    set_two_hop_entry(new_entry, now, val_time);
+
+    LL_PREPEND(ls_entry->two_hop_set_head, new_entry);
+
+    return 0;
+}
+
+/**
+ * Set expiration time and metric values of a 2-Hop Tuple from the current HELLO
+ */
+static void set_two_hop_entry(iib_two_hop_set_entry_t *th_entry, timex_t *now,
+                              uint64_t val_time)
+{
+    timex_t v_time = timex_from_uint64(val_time * US_PER_MS);
+    nhdp_addr_t *th_addr = th_entry->th_nb_addr;
+
+    th_entry->exp_time = timex_add(*now, v_time);
     if (th_addr->tmp_metric_val != NHDP_METRIC_UNKNOWN) {
-        new_entry->metric_in = rfc5444_metric_decode(th_addr->tmp_metric_val);
-        new_entry->metric_out = rfc5444_metric_decode(th_addr->tmp_metric_val);
+        th_entry->metric_in = rfc5444_metric_decode(th_addr->tmp_metric_val);
+        th_entry->metric_out = rfc5444_metric_decode(th_addr->tmp_metric_val);
     }
     else {
-        new_entry->metric_in = NHDP_METRIC_UNKNOWN;
-        new_entry->metric_out = NHDP_METRIC_UNKNOWN;
+        th_entry->metric_in = NHDP_METRIC_UNKNOWN;
+        th_entry->metric_out = NHDP_METRIC_UNKNOWN;
     }
-
-    LL_PREPEND(base_entry->two_hop_set_head, new_entry);
-
-    return 0;
 }
 
 /**
  * Remove a given 2-Hop Tuple
  */
-static void rem_two_hop_entry(iib_base_entry_t *base_entry, iib_two_hop_set_entry_t *th_entry)
+static void rem_two_hop_entry(iib_link_set_entry_t *ls_entry, iib_two_hop_set_entry_t *th_entry)
 {
-    LL_DELETE(base_entry->two_hop_set_head, th_entry);
+    LL_DELETE(ls_entry->two_hop_set_head, th_entry);
     nhdp_decrement_addr_usage(th_entry->th_nb_addr);
     free(th_entry);
 }
 
+/**
+ * Remove all 2-Hop Tuples of a given link tuple
+ */
+static void rem_two_hop_entries(iib_link_set_entry_t *ls_entry)
+{
+    iib_two_hop_set_entry_t *th_elt, *th_tmp;
+
+    LL_FOREACH_SAFE(ls_entry->two_hop_set_head, th_elt, th_tmp) {
+        rem_two_hop_entry(ls_entry, th_elt);
+    }
+}
+
 /**
  * Remove all corresponding two hop entries for a given link tuple that lost symmetry status.
  * Additionally reset the neighbor tuple's symmmetry flag (for the neighbor tuple this link
  * tuple is represented in), if no more corresponding symmetric link tuples are left.
  * Implements section 13.2 of RFC 6130
  */
-static void update_nb_tuple_symmetry(iib_base_entry_t *base_entry,
-                                     iib_link_set_entry_t *ls_entry, timex_t *now)
+static void update_nb_tuple_symmetry(iib_link_set_entry_t *ls_entry, timex_t *now)
 {
-    iib_two_hop_set_entry_t *th_elt, *th_tmp;
-
     /* First remove all two hop entries for the corresponding link tuple */
-    LL_FOREACH_SAFE(base_entry->two_hop_set_head, th_elt, th_tmp) {
-        if (th_elt->ls_elt == ls_entry) {
-            rem_two_hop_entry(base_entry, th_elt);
-        }
-    }
+    rem_two_hop_entries(ls_entry);
 
     /* Afterwards check the neighbor tuple containing the link tuple's addresses */
     if ((ls_entry->nb_elt != NULL) && (ls_entry->nb_elt->symmetric == 1)) {
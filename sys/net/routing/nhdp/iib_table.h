@@ -43,9 +43,14 @@ typedef enum {
 
 /**
  * @brief   Link Set entry (link tuple)
+ *
+ * The 2-Hop Tuples of a link tuple are kept in a list of their own, so processing
+ * a HELLO only touches the 2-Hop Tuples of the originating neighbor.
  */
 typedef struct iib_link_set_entry {
     nhdp_addr_entry_t *address_list_head;       /**< Pointer to head of this tuple's addresses */
+    struct iib_two_hop_set_entry *two_hop_set_head; /**< Pointer to this tuple's 2-hop tuples */
+    kernel_pid_t if_pid;                        /**< PID of the interface of the link set */
     timex_t heard_time;                         /**< Time at which entry leaves heard status */
     timex_t sym_time;                           /**< Time at which entry leaves symmetry status */
     uint8_t pending;                            /**< Flag whether link is pending */
@@ -85,7 +90,6 @@ typedef struct iib_two_hop_set_entry {
 typedef struct iib_base_entry {
     kernel_pid_t if_pid;                                /**< PID of the interface */
     iib_link_set_entry_t *link_set_head;                /**< Pointer to this if's link tuples */
-    iib_two_hop_set_entry_t *two_hop_set_head;          /**< Pointer to this if's 2-hop tuples */
     struct iib_base_entry *next;                        /**< Pointer to next list entry */
 } iib_base_entry_t;
 
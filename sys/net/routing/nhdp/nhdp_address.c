@@ -18,15 +18,24 @@
  * @}
  */
 
+#include "hashes.h"
 #include "mutex.h"
 #include "utlist.h"
 
 #include "nhdp.h"
 #include "nhdp_address.h"
 
+#if (NHDP_ADDR_DB_BUCKETS & (NHDP_ADDR_DB_BUCKETS - 1))
+#error "NHDP_ADDR_DB_BUCKETS must be a power of 2"
+#endif
+
 /* Internal variables */
 static mutex_t mtx_addr_access = MUTEX_INIT;
-static nhdp_addr_t *nhdp_addr_db_head = NULL;
+static nhdp_addr_t *nhdp_addr_db[NHDP_ADDR_DB_BUCKETS];
+static nhdp_addr_t *nhdp_addr_tmp_head = NULL;
+
+/* Internal function prototypes */
+static inline nhdp_addr_t **get_bucket(uint8_t *addr, size_t addr_size);
 
 
 /*---------------------------------------------------------------------------*
@@ -35,11 +44,12 @@ static nhdp_addr_t *nhdp_addr_db_head = NULL;
 
 nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t addr_type)
 {
+    nhdp_addr_t **bucket = get_bucket(addr, addr_size);
     nhdp_addr_t *addr_elt;
 
     mutex_lock(&mtx_addr_access);
 
-    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+    LL_FOREACH(*bucket, addr_elt) {
         if ((addr_elt->addr_size == addr_size) && (addr_elt->addr_type == addr_type)) {
             if (memcmp(addr_elt->addr, addr, addr_size) == 0) {
                 /* Found a matching entry */
@@ -54,6 +64,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
 
         if (!addr_elt) {
             /* Insufficient memory */
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -63,6 +74,7 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         if (!addr_elt->addr) {
             /* Insufficient memory */
             free(addr_elt);
+            mutex_unlock(&mtx_addr_access);
             return NULL;
         }
 
@@ -72,7 +84,10 @@ nhdp_addr_t *nhdp_addr_db_get_address(uint8_t *addr, size_t addr_size, uint8_t a
         addr_elt->usg_count = 0;
         addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
         addr_elt->tmp_metric_val = NHDP_METRIC_UNKNOWN;
-        LL_PREPEND(nhdp_addr_db_head, addr_elt);
+        addr_elt->nb_elt = NULL;
+        addr_elt->ls_elt = NULL;
+        addr_elt->tmp_next = NULL;
+        LL_PREPEND(*bucket, addr_elt);
     }
 
     addr_elt->usg_count++;
@@ -91,7 +106,10 @@ void nhdp_decrement_addr_usage(nhdp_addr_t *addr)
         addr->usg_count--;
         if (addr->usg_count == 0) {
             /* Free address space if address is no longer used */
-            LL_DELETE(nhdp_addr_db_head, addr);
+            LL_DELETE(*get_bucket(addr->addr, addr->addr_size), addr);
+            if (addr->in_tmp_table) {
+                LL_DELETE2(nhdp_addr_tmp_head, addr, tmp_next);
+            }
             free(addr->addr);
             free(addr);
         }
@@ -114,13 +132,22 @@ void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry)
     free(addr_entry);
 }
 
+void nhdp_set_address_tmp_usg(nhdp_addr_t *addr, uint8_t tmp_type)
+{
+    if (!addr->in_tmp_table && tmp_type) {
+        /* Remember the address for the processing of the current message */
+        LL_PREPEND2(nhdp_addr_tmp_head, addr, tmp_next);
+    }
+    addr->in_tmp_table = tmp_type;
+}
+
 nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type)
 {
     nhdp_addr_entry_t *new_list_head;
     nhdp_addr_t *addr_elt;
 
     new_list_head = NULL;
-    LL_FOREACH(nhdp_addr_db_head, addr_elt) {
+    LL_FOREACH2(nhdp_addr_tmp_head, addr_elt, tmp_next) {
         if (addr_elt->in_tmp_table & tmp_type) {
             nhdp_addr_entry_t *new_entry = (nhdp_addr_entry_t *) malloc(sizeof(nhdp_addr_entry_t));
 
@@ -144,18 +171,32 @@ void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg)
 {
     nhdp_addr_t *addr_elt, *addr_tmp;
 
-    LL_FOREACH_SAFE(nhdp_addr_db_head, addr_elt, addr_tmp) {
+    /* Only addresses of the current message can have in_tmp_table set */
+    LL_FOREACH_SAFE2(nhdp_addr_tmp_head, addr_elt, addr_tmp, tmp_next) {
         addr_elt->tmp_metric_val = NHDP_METRIC_UNKNOWN;
-        if (addr_elt->in_tmp_table) {
-            addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
-            if (decr_usg) {
-                nhdp_decrement_addr_usage(addr_elt);
-            }
+        addr_elt->in_tmp_table = NHDP_ADDR_TMP_NONE;
+        addr_elt->tmp_next = NULL;
+        if (decr_usg) {
+            nhdp_decrement_addr_usage(addr_elt);
         }
     }
+    nhdp_addr_tmp_head = NULL;
+}
+
+nhdp_addr_t *nhdp_get_addr_tmp_head(void)
+{
+    return nhdp_addr_tmp_head;
 }
 
-nhdp_addr_t *nhdp_get_addr_db_head(void)
+
+/*------------------------------------------------------------------------------------*/
+/*                                Internal functions                                  */
+/*------------------------------------------------------------------------------------*/
+
+/**
+ * Get the hash bucket of the central address storage for the given address data
+ */
+static inline nhdp_addr_t **get_bucket(uint8_t *addr, size_t addr_size)
 {
-    return nhdp_addr_db_head;
+    return &nhdp_addr_db[fnv_hash(addr, addr_size) & (NHDP_ADDR_DB_BUCKETS - 1)];
 }
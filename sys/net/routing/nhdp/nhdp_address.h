@@ -23,6 +23,18 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets of the central address storage
+ *
+ * Must be a power of 2.
+ */
+#ifndef NHDP_ADDR_DB_BUCKETS
+#define NHDP_ADDR_DB_BUCKETS        (32)
+#endif
+
+struct nib_entry;
+struct iib_link_set_entry;
+
 /**
  * @brief   NHDP address representation
  */
@@ -33,7 +45,10 @@ typedef struct nhdp_addr {
     uint8_t usg_count;                  /**< Usage count in information bases */
     uint8_t in_tmp_table;               /**< Signals usage in a writers temp table */
     uint16_t tmp_metric_val;            /**< Encoded metric value used during HELLO processing */
-    struct nhdp_addr *next;             /**< Pointer to next address (used in central storage) */
+    struct nib_entry *nb_elt;           /**< Neighbor Tuple listing this address */
+    struct iib_link_set_entry *ls_elt;  /**< Link Tuple listing this address */
+    struct nhdp_addr *tmp_next;         /**< Pointer to next address with in_tmp_table set */
+    struct nhdp_addr *next;             /**< Pointer to next address in the same hash bucket */
 } nhdp_addr_t;
 
 /**
@@ -57,6 +72,7 @@ typedef struct nhdp_addr_entry {
 #define NHDP_ADDR_TMP_TH_SYM_LIST   (0x10)
 #define NHDP_ADDR_TMP_NB_LIST       (0x20)
 #define NHDP_ADDR_TMP_SEND_LIST     (0x60)
+#define NHDP_ADDR_TMP_TH_REFRESHED  (0x80)
 
 #define NHDP_ADDR_TMP_IN_ANY(addr)          ((addr->in_tmp_table & 0x01))
 #define NHDP_ADDR_TMP_IN_SYM(addr)          ((addr->in_tmp_table & 0x02) >> 1)
@@ -65,6 +81,7 @@ typedef struct nhdp_addr_entry {
 #define NHDP_ADDR_TMP_IN_TH_SYM_LIST(addr)  ((addr->in_tmp_table & 0x10) >> 4)
 #define NHDP_ADDR_TMP_IN_NB_LIST(addr)      ((addr->in_tmp_table & 0x20) >> 5)
 #define NHDP_ADDR_TMP_IN_SEND_LIST(addr)    ((addr->in_tmp_table & 0x40) >> 6)
+#define NHDP_ADDR_TMP_TH_IS_REFRESHED(addr) ((addr->in_tmp_table & 0x80) >> 7)
 /** @} */
 
 /**
@@ -107,6 +124,21 @@ void nhdp_free_addr_list(nhdp_addr_entry_t *list_head);
  */
 void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry);
 
+/**
+ * @brief                   Set the in_tmp_table flag of a NHDP address
+ *
+ * The address is remembered for nhdp_generate_addr_list_from_tmp(),
+ * nhdp_get_addr_tmp_head() and nhdp_reset_addresses_tmp_usg(), so these only
+ * handle the addresses of the currently processed message.
+ *
+ * @note
+ * Must not be called from outside the NHDP writer's or reader's message creation process.
+ *
+ * @param[in] addr          Pointer to the NHDP address
+ * @param[in] tmp_type      New value of the in_tmp_table flag
+ */
+void nhdp_set_address_tmp_usg(nhdp_addr_t *addr, uint8_t tmp_type);
+
 /**
  * @brief                   Construct an addr list containing all addresses with
  *                          the given tmp_type
@@ -127,12 +159,15 @@ nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type);
 void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg);
 
 /**
- * @brief                   Get a pointer to the head of the address storage list
+ * @brief                   Get a pointer to the head of the list of addresses with
+ *                          in_tmp_table set
+ *
+ * The list is linked by the tmp_next member of the addresses.
  *
- * @return                  Pointer to the head of the central storage address list
- * @return                  NULL if no addresses are registered
+ * @return                  Pointer to the head of the temporary address list
+ * @return                  NULL if no address is in a temporary table
  */
-nhdp_addr_t *nhdp_get_addr_db_head(void);
+nhdp_addr_t *nhdp_get_addr_tmp_head(void);
 
 #ifdef __cplusplus
 }
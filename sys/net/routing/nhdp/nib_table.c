@@ -38,6 +38,7 @@ static nib_lost_address_entry_t *nib_lost_address_entry_head = NULL;
 
 /* Internal function prototypes */
 static nib_entry_t *add_nib_entry_for_nb_addr_list(void);
+static int set_nb_addresses(nib_entry_t *nib_entry);
 static void rem_nib_entry(nib_entry_t *nib_entry, timex_t *now);
 static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now);
 static int add_lost_neighbor_address(nhdp_addr_t *lost_addr, timex_t *now);
@@ -51,7 +52,7 @@ static void rem_ln_entry(nib_lost_address_entry_t *ln_entry);
 nib_entry_t *nib_process_hello(void)
 {
     nib_entry_t *nb_match = NULL;
-    nib_entry_t *nib_elt, *nib_tmp;
+    nhdp_addr_t *addr_elt;
     timex_t now;
     uint8_t matches = 0;
 
@@ -59,23 +60,24 @@ nib_entry_t *nib_process_hello(void)
 
     xtimer_now_timex(&now);
 
-    LL_FOREACH_SAFE(nib_entry_head, nib_elt, nib_tmp) {
-        nhdp_addr_entry_t *list_elt;
-        LL_FOREACH(nib_elt->address_list_head, list_elt) {
-            if (NHDP_ADDR_TMP_IN_NB_LIST(list_elt->address)) {
-                /* Matching neighbor tuple */
-                matches++;
-
-                if (matches > 1) {
-                    /* Multiple matching nb tuples, delete the previous one */
-                    iib_propagate_nb_entry_change(nb_match, nib_elt);
-                    rem_nib_entry(nb_match, &now);
-                }
+    /* Loop through the neighbor's addresses to find the nb tuples listing them */
+    LL_FOREACH2(nhdp_get_addr_tmp_head(), addr_elt, tmp_next) {
+        nib_entry_t *nib_elt = addr_elt->nb_elt;
 
-                nb_match = nib_elt;
-                break;
-            }
+        if (!NHDP_ADDR_TMP_IN_NB_LIST(addr_elt) || !nib_elt || (nib_elt == nb_match)) {
+            continue;
+        }
+
+        /* Matching neighbor tuple */
+        matches++;
+
+        if (matches > 1) {
+            /* Multiple matching nb tuples, delete the previous one */
+            iib_propagate_nb_entry_change(nb_match, nib_elt);
+            rem_nib_entry(nb_match, &now);
         }
+
+        nb_match = nib_elt;
     }
 
     /* Add or update nb tuple */
@@ -87,9 +89,7 @@ nib_entry_t *nib_process_hello(void)
             nb_match->symmetric = 0;
         }
 
-        nb_match->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_NB_LIST);
-
-        if (!nb_match->address_list_head) {
+        if (set_nb_addresses(nb_match)) {
             /* Insufficient memory */
             LL_DELETE(nib_entry_head, nb_match);
             free(nb_match);
@@ -125,7 +125,7 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
                                          RFC5444_OTHERNEIGHB_SYMMETRIC,
                                          rfc5444_metric_encode(nib_elt->metric_in),
                                          rfc5444_metric_encode(nib_elt->metric_out));
-                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_SYM;
+                    nhdp_set_address_tmp_usg(addr_elt->address, NHDP_ADDR_TMP_SYM);
                 }
             }
         }
@@ -153,6 +153,13 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
 
 void nib_rem_nb_entry(nib_entry_t *nib_entry)
 {
+    nhdp_addr_entry_t *addr_elt;
+
+    LL_FOREACH(nib_entry->address_list_head, addr_elt) {
+        if (addr_elt->address->nb_elt == nib_entry) {
+            addr_elt->address->nb_elt = NULL;
+        }
+    }
     nhdp_free_addr_list(nib_entry->address_list_head);
     LL_DELETE(nib_entry_head, nib_entry);
     free(nib_entry);
@@ -209,9 +216,7 @@ static nib_entry_t *add_nib_entry_for_nb_addr_list(void)
     }
 
     /* Copy neighbor address list to new neighbor tuple */
-    new_elem->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_NB_LIST);
-
-    if (!new_elem->address_list_head) {
+    if (set_nb_addresses(new_elem)) {
         /* Insufficient memory */
         free(new_elem);
         return NULL;
@@ -225,6 +230,27 @@ static nib_entry_t *add_nib_entry_for_nb_addr_list(void)
     return new_elem;
 }
 
+/**
+ * Set the neighbor address list of a Neighbor Tuple to the addresses of the received HELLO
+ */
+static int set_nb_addresses(nib_entry_t *nib_entry)
+{
+    nhdp_addr_entry_t *addr_elt;
+
+    nib_entry->address_list_head = nhdp_generate_addr_list_from_tmp(NHDP_ADDR_TMP_NB_LIST);
+
+    if (!nib_entry->address_list_head) {
+        /* Insufficient memory */
+        return -1;
+    }
+
+    LL_FOREACH(nib_entry->address_list_head, addr_elt) {
+        addr_elt->address->nb_elt = nib_entry;
+    }
+
+    return 0;
+}
+
 /**
  * Remove a given Neighbor Tuple
  */
@@ -244,11 +270,16 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
     nhdp_addr_entry_t *nib_elt, *nib_tmp;
 
     LL_FOREACH_SAFE(nib_entry->address_list_head, nib_elt, nib_tmp) {
+        if (nib_elt->address->nb_elt == nib_entry) {
+            nib_elt->address->nb_elt = NULL;
+        }
+
         /* Check whether address is still present in the new neighbor address list */
         if (!NHDP_ADDR_TMP_IN_NB_LIST(nib_elt->address)) {
             /* Address is not in the newly received address list of the neighbor */
             /* Add it to the Removed Address List */
-            nib_elt->address->in_tmp_table |= NHDP_ADDR_TMP_REM_LIST;
+            nhdp_set_address_tmp_usg(nib_elt->address,
+                                     nib_elt->address->in_tmp_table | NHDP_ADDR_TMP_REM_LIST);
             /* Increment usage counter of address in central NHDP address storage */
             nib_elt->address->usg_count++;
 
@@ -15,6 +15,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "net/gnrc/ipv6/blacklist.h"
@@ -23,10 +24,10 @@ static void _usage(char *cmd)
 {
     printf("usage: * %s\n", cmd);
     puts("         Lists all addresses in the blacklist.");
-    printf("       * %s add <addr>\n", cmd);
-    puts("         Adds <addr> to the blacklist.");
-    printf("       * %s del <addr>\n", cmd);
-    puts("         Deletes <addr> from the blacklist.");
+    printf("       * %s add <addr>[/<prefix_len>]\n", cmd);
+    puts("         Adds <addr> or a prefix to the blacklist.");
+    printf("       * %s del <addr>[/<prefix_len>]\n", cmd);
+    puts("         Deletes <addr> or a prefix from the blacklist.");
     printf("       * %s help\n", cmd);
     puts("         Print this.");
 }
@@ -34,21 +35,31 @@ static void _usage(char *cmd)
 int _blacklist(int argc, char **argv)
 {
     ipv6_addr_t addr;
+    unsigned prefix_len = 128;
     if (argc < 2) {
         gnrc_ipv6_blacklist_print();
         return 0;
     }
     else if (argc > 2) {
-        if (ipv6_addr_from_str(&addr, argv[2]) == NULL) {
+        char *len_str = strchr(argv[2], '/');
+        if (len_str != NULL) {
+            *(len_str++) = '\0';
+            prefix_len = atoi(len_str);
+        }
+        if ((ipv6_addr_from_str(&addr, argv[2]) == NULL) ||
+            (prefix_len > 128)) {
             _usage(argv[0]);
             return 1;
         }
     }
     if (strcmp("add", argv[1]) == 0) {
-        gnrc_ipv6_blacklist_add(&addr);
+        if (gnrc_ipv6_blacklist_add_prefix(&addr, prefix_len) < 0) {
+            puts("error: unable to add prefix to blacklist");
+            return 1;
+        }
     }
     else if (strcmp("del", argv[1]) == 0) {
-        gnrc_ipv6_blacklist_del(&addr);
+        gnrc_ipv6_blacklist_del_prefix(&addr, prefix_len);
     }
     else if (strcmp("help", argv[1]) == 0) {
         _usage(argv[0]);
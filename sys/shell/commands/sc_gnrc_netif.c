@@ -27,12 +27,27 @@
 #include "net/gnrc/netif/hdr.h"
 #include "net/lora.h"
 
-#ifdef MODULE_NETSTATS
+#if defined(MODULE_NETSTATS) || defined(MODULE_CSMA_SENDER_ASYNC) || \
+    defined(MODULE_GNRC_MAC_DUTYCYCLE)
 #include "net/netstats.h"
 #endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
+#ifdef MODULE_CSMA_SENDER_ASYNC
+#include "net/csma_sender.h"
+#endif
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+#include "net/gnrc/mac/dutycycle.h"
+#include "xtimer.h"
+#endif
 #ifdef MODULE_L2FILTER
 #include "net/l2filter.h"
 #endif
+#if defined(MODULE_L2FILTER) && defined(MODULE_VFS)
+#include <fcntl.h>
+#include "vfs.h"
+#endif
 
 /**
  * @brief   The default IPv6 prefix length if not specified.
@@ -102,6 +117,8 @@ static const char *_netstats_module_to_str(uint8_t module)
             return "Layer 2";
         case NETSTATS_IPV6:
             return "IPv6";
+        case NETSTATS_CSMA:
+            return "CSMA/CA";
         case NETSTATS_ALL:
             return "all";
         default:
@@ -141,6 +158,96 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
 }
 #endif /* MODULE_NETSTATS */
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+static void _netif_stats_nb(kernel_pid_t iface)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
+    int count = 0;
+
+    if (netif == NULL) {
+        return;
+    }
+    puts("          Statistics for neighbors");
+    for (unsigned i = 0; i < NETSTATS_NB_NUMOF; i++) {
+        netstats_nb_t nb = netif->neighbors.entries[i];
+        char hwaddr_str[NETSTATS_NB_L2ADDR_MAXLEN * 3];
+
+        if ((nb.l2addr_len == 0) ||
+            !netstats_nb_get(&netif->neighbors, nb.l2addr, nb.l2addr_len,
+                             &nb)) {
+            continue;
+        }
+        printf("            %-23s ETX %u.%02u  TX %u  failed %u  busy %u\n",
+               gnrc_netif_addr_to_str(nb.l2addr, nb.l2addr_len, hwaddr_str),
+               nb.etx / NETSTATS_NB_ETX_DIVISOR,
+               (nb.etx % NETSTATS_NB_ETX_DIVISOR) * 100 / NETSTATS_NB_ETX_DIVISOR,
+               nb.tx_count, nb.tx_failed, nb.tx_busy);
+        count++;
+    }
+    if (count == 0) {
+        puts("            --- none ---");
+    }
+}
+#endif
+
+#ifdef MODULE_CSMA_SENDER_ASYNC
+static int _netif_stats_csma(kernel_pid_t iface, bool reset)
+{
+    csma_sender_stats_t *stats;
+    int res = gnrc_netapi_get(iface, NETOPT_STATS, NETSTATS_CSMA, &stats,
+                              sizeof(&stats));
+
+    if (res < 0) {
+        return res;
+    }
+    if (reset) {
+        memset(stats, 0, sizeof(csma_sender_stats_t));
+        puts("Reset statistics for module CSMA/CA!");
+        return 0;
+    }
+    printf("          Statistics for CSMA/CA\n"
+           "            CCA %u  busy %u (%u%%)\n"
+           "            TX %u (burst: %u)  failed %u  queue full %u\n"
+           "            busy CCAs before access:",
+           (unsigned)stats->cca, (unsigned)stats->cca_busy,
+           (stats->cca > 0) ? (unsigned)((stats->cca_busy * 100ULL) / stats->cca)
+                            : 0U,
+           (unsigned)stats->tx, (unsigned)stats->tx_burst,
+           (unsigned)stats->tx_failed, (unsigned)stats->queue_full);
+    for (unsigned i = 0; i < CSMA_SENDER_STATS_BUSY_NUMOF; i++) {
+        printf("  %u%s: %u", i,
+               (i == (CSMA_SENDER_STATS_BUSY_NUMOF - 1)) ? "+" : "",
+               (unsigned)stats->busy[i]);
+    }
+    puts("");
+    return 0;
+}
+#endif
+
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+static void _netif_stats_dutycycle(kernel_pid_t iface)
+{
+    gnrc_mac_dutycycle_t *dc;
+    gnrc_mac_dutycycle_stats_t stats;
+
+    if (gnrc_netapi_get(iface, NETOPT_STATS, NETSTATS_DUTYCYCLE, &dc,
+                        sizeof(&dc)) < 0) {
+        return;
+    }
+    gnrc_mac_dutycycle_get_stats(dc, xtimer_now_usec(), &stats);
+    printf("          Statistics for duty cycle\n"
+           "            wake-up period %" PRIu32 " us  "
+           "load %u.%02u frames/period\n"
+           "            duty cycle %u.%u%%  energy %" PRIu32 " mJ\n"
+           "            expected latency %" PRIu32 " us  "
+           "TX latency %" PRIu32 " us\n",
+           stats.period_us, stats.load / 100U, stats.load % 100U,
+           stats.duty_cycle / 10U, stats.duty_cycle % 10U,
+           (uint32_t)(stats.energy_uj / 1000U),
+           stats.latency_us, stats.tx_latency_us);
+}
+#endif
+
 static void _set_usage(char *cmd_name)
 {
     printf("usage: %s <if_id> set <key> <value>\n", cmd_name);
@@ -201,7 +308,11 @@ static void _del_usage(char *cmd_name)
 #ifdef MODULE_NETSTATS
 static void _stats_usage(char *cmd_name)
 {
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    printf("usage: %s <if_id> stats [l2|ipv6|csma] [reset]\n", cmd_name);
+#else
     printf("usage: %s <if_id> stats [l2|ipv6] [reset]\n", cmd_name);
+#endif
     puts("       reset can be only used if the module is specified.");
 }
 #endif
@@ -593,6 +704,15 @@ static void _netif_list(kernel_pid_t iface)
 #endif
 #ifdef MODULE_NETSTATS_IPV6
     _netif_stats(iface, NETSTATS_IPV6, false);
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    _netif_stats_nb(iface);
+#endif
+#ifdef MODULE_CSMA_SENDER_ASYNC
+    _netif_stats_csma(iface, false);
+#endif
+#ifdef MODULE_GNRC_MAC_DUTYCYCLE
+    _netif_stats_dutycycle(iface);
 #endif
     puts("");
 }
@@ -974,9 +1094,116 @@ static int _netif_addrm_l2filter(kernel_pid_t iface, char *val, bool add)
     return 0;
 }
 
+#ifdef MODULE_VFS
+/* length of the longest valid address string, e.g. "aa:bb:cc:dd:ee:ff:00:11" */
+#define L2FILTER_STR_MAXLEN     ((L2FILTER_ADDR_MAXLEN * 3) - 1)
+
+/* adds the address on a line of a filter list file, ignoring comments
+ * starting with '#' and empty lines */
+static int _netif_load_l2filter_line(kernel_pid_t iface, char *line)
+{
+    char *end = strchr(line, '#');
+    /* gnrc_netif_addr_from_str() writes one byte per started pair of
+     * characters, e.g. for "a:b:c", so at most half of L2FILTER_STR_MAXLEN
+     * rounded up */
+    uint8_t addr[(L2FILTER_STR_MAXLEN + 1) / 2];
+    size_t addr_len;
+
+    if (end == NULL) {
+        end = line + strlen(line);
+    }
+    while ((end > line) && ((end[-1] == ' ') || (end[-1] == '\t') ||
+                            (end[-1] == '\r'))) {
+        end--;
+    }
+    *end = '\0';
+    while ((*line == ' ') || (*line == '\t')) {
+        line++;
+    }
+    if (*line == '\0') {
+        return 0;
+    }
+    if ((size_t)(end - line) > L2FILTER_STR_MAXLEN) {
+        printf("error: invalid address \"%s\"\n", line);
+        return -EINVAL;
+    }
+    addr_len = gnrc_netif_addr_from_str(line, addr);
+    if ((addr_len == 0) || (addr_len > L2FILTER_ADDR_MAXLEN)) {
+        printf("error: invalid address \"%s\"\n", line);
+        return -EINVAL;
+    }
+    if (gnrc_netapi_set(iface, NETOPT_L2FILTER, 0, addr, addr_len) < 0) {
+        printf("error: unable to add %s to filter\n", line);
+        return -ENOMEM;
+    }
+    return 1;
+}
+
+static int _netif_load_l2filter(kernel_pid_t iface, const char *path)
+{
+    /* long enough for an address with delimiters and a short comment */
+    char line[L2FILTER_ADDR_MAXLEN * 3 + 32];
+    char buf[64];
+    unsigned line_len = 0, added = 0, failed = 0;
+    bool overlong = false;
+    int fd = vfs_open(path, O_RDONLY, 0);
+    ssize_t res;
+
+    if (fd < 0) {
+        printf("error: unable to open %s\n", path);
+        return 1;
+    }
+    do {
+        ssize_t len = res = vfs_read(fd, buf, sizeof(buf));
+
+        if ((res <= 0) && ((line_len > 0) || overlong)) {
+            /* terminate the last line if the file does not */
+            buf[0] = '\n';
+            len = 1;
+        }
+        for (ssize_t i = 0; i < len; i++) {
+            if (buf[i] != '\n') {
+                if (line_len < (sizeof(line) - 1)) {
+                    line[line_len++] = buf[i];
+                }
+                else {
+                    overlong = true;
+                }
+                continue;
+            }
+            line[line_len] = '\0';
+            if (overlong) {
+                puts("error: line too long");
+                failed++;
+            }
+            else {
+                int r = _netif_load_l2filter_line(iface, line);
+                if (r > 0) {
+                    added++;
+                }
+                else if (r < 0) {
+                    failed++;
+                }
+            }
+            line_len = 0;
+            overlong = false;
+        }
+    } while (res > 0);
+    vfs_close(fd);
+    if (res < 0) {
+        printf("error: unable to read %s\n", path);
+    }
+    printf("added %u addresses to filter, %u failed\n", added, failed);
+    return ((res < 0) || (failed > 0)) ? 1 : 0;
+}
+#endif
+
 static void _l2filter_usage(const char *cmd)
 {
     printf("usage: %s <if_id> l2filter {add|del} <addr>\n", cmd);
+#ifdef MODULE_VFS
+    printf("       %s <if_id> l2filter load <file>\n", cmd);
+#endif
 }
 #endif
 
@@ -1312,6 +1539,11 @@ int _gnrc_netif_config(int argc, char **argv)
                 else if (strcmp(argv[3], "del") == 0) {
                     return _netif_addrm_l2filter(iface, argv[4], false);
                 }
+#ifdef MODULE_VFS
+                else if (strcmp(argv[3], "load") == 0) {
+                    return _netif_load_l2filter(iface, argv[4]);
+                }
+#endif
                 else {
                     _l2filter_usage(argv[2]);
                 }
@@ -1333,6 +1565,11 @@ int _gnrc_netif_config(int argc, char **argv)
                 else if (strcmp(argv[3], "ipv6") == 0) {
                     module = NETSTATS_IPV6;
                 }
+#ifdef MODULE_CSMA_SENDER_ASYNC
+                else if (strcmp(argv[3], "csma") == 0) {
+                    module = NETSTATS_CSMA;
+                }
+#endif
                 else {
                     printf("Module %s doesn't exist or does not provide statistics.\n", argv[3]);
 
@@ -1349,6 +1586,13 @@ int _gnrc_netif_config(int argc, char **argv)
                 if (module & NETSTATS_IPV6) {
                     _netif_stats((kernel_pid_t) iface, NETSTATS_IPV6, reset);
                 }
+#ifdef MODULE_CSMA_SENDER_ASYNC
+                if (((module == NETSTATS_ALL) || (module == NETSTATS_CSMA)) &&
+                    (_netif_stats_csma((kernel_pid_t) iface, reset) < 0) &&
+                    (module == NETSTATS_CSMA)) {
+                    puts("           Device doesn't use CSMA/CA.");
+                }
+#endif
 
                 return 1;
             }
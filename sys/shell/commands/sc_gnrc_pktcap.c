@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell commands for the packet capture
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktcap.h"
+
+static void _usage(char *cmd)
+{
+#ifdef MODULE_VFS
+    printf("usage: * %s start <file>\n", cmd);
+    puts("         Captures the frames of all interfaces to <file>.");
+    printf("       * %s stop\n", cmd);
+#else
+    printf("usage: * %s stop\n", cmd);
+#endif
+    puts("         Stops the capture and closes the file.");
+    printf("       * %s stats\n", cmd);
+    puts("         Shows the statistics of the current or last capture.");
+}
+
+int _gnrc_pktcap(int argc, char **argv)
+{
+    if ((argc == 2) && (strcmp(argv[1], "stop") == 0)) {
+        gnrc_pktcap_stop();
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "stats") == 0)) {
+        gnrc_pktcap_stats_t stats;
+
+        gnrc_pktcap_get_stats(&stats);
+        printf("%s, %" PRIu32 " frames, %" PRIu32 " bytes written, "
+               "%" PRIu32 " frames dropped\n",
+               gnrc_pktcap_running() ? "capturing" : "stopped", stats.frames,
+               stats.bytes, stats.dropped);
+        return 0;
+    }
+#ifdef MODULE_VFS
+    if ((argc == 3) && (strcmp(argv[1], "start") == 0)) {
+        int res = gnrc_pktcap_start_vfs(argv[2]);
+
+        if (res < 0) {
+            printf("error: cannot capture to %s: %s\n", argv[2],
+                   strerror(-res));
+            return 1;
+        }
+        return 0;
+    }
+#endif
+    _usage(argv[0]);
+    return 1;
+}
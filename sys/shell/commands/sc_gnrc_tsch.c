@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell commands for the slotframe MAC
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tsch/tsch.h"
+
+static const char *_states[] = { "scanning", "synchronized", "coordinator" };
+
+static void _usage(char *cmd)
+{
+    printf("usage: * %s\n", cmd);
+    puts("         Lists schedule and cell statistics of all interfaces.");
+    printf("       * %s <if> coord\n", cmd);
+    puts("         Starts a network with <if> as coordinator.");
+    printf("       * %s <if> add <slot> <ch_offset> <options> [<addr>]\n", cmd);
+    puts("         Adds a cell, <options> are any of t (transmit), r (receive)");
+    puts("         and s (shared). Transmit cells with <addr> are dedicated");
+    puts("         to the neighbor <addr>.");
+    printf("       * %s <if> del <slot> <ch_offset>\n", cmd);
+    puts("         Removes a cell.");
+    printf("       * %s <if> hop <channel> [<channel> ...]\n", cmd);
+    puts("         Sets the hopping sequence.");
+    printf("       * %s <if> reset\n", cmd);
+    puts("         Resets the cell statistics.");
+}
+
+static void _print(gnrc_netif_t *netif)
+{
+    static gnrc_tsch_info_t info;
+
+    if (gnrc_tsch_get_info(netif, &info) < 0) {
+        return;
+    }
+    printf("Iface %2d  %s  ASN: %" PRIu32 "  join priority: %u\n",
+           netif->pid, _states[info.state], info.asn,
+           (unsigned)info.join_prio);
+    printf("          hopping:");
+    for (unsigned i = 0; i < info.schedule.hopping_len; i++) {
+        printf(" %u", (unsigned)info.schedule.hopping[i]);
+    }
+    puts("");
+    puts("          slot choff opt neighbor                       tx"
+         "     fail       rx     idle");
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        const gnrc_tsch_cell_t *cell = &info.schedule.cells[i];
+        char addr[GNRC_NETIF_L2ADDR_MAXLEN * 3];
+
+        if (cell->flags == 0) {
+            continue;
+        }
+        if (cell->addr_len > 0) {
+            gnrc_netif_addr_to_str(cell->addr, cell->addr_len, addr);
+        }
+        else {
+            strcpy(addr, "*");
+        }
+        printf("          %4u %5u %c%c%c %-23s %8" PRIu32 " %8" PRIu32
+               " %8" PRIu32 " %8" PRIu32 "\n",
+               (unsigned)cell->slot, (unsigned)cell->channel_offset,
+               (cell->flags & GNRC_TSCH_CELL_TX) ? 't' : '-',
+               (cell->flags & GNRC_TSCH_CELL_RX) ? 'r' : '-',
+               (cell->flags & GNRC_TSCH_CELL_SHARED) ? 's' : '-',
+               addr, cell->stats.tx, cell->stats.tx_fail, cell->stats.rx,
+               cell->stats.idle);
+    }
+}
+
+static int _add(gnrc_netif_t *netif, int argc, char **argv)
+{
+    gnrc_tsch_cell_t cell;
+
+    if (argc < 6) {
+        return -EINVAL;
+    }
+    memset(&cell, 0, sizeof(cell));
+    cell.slot = atoi(argv[3]);
+    cell.channel_offset = atoi(argv[4]);
+    for (const char *opt = argv[5]; *opt != '\0'; opt++) {
+        switch (*opt) {
+            case 't':
+                cell.flags |= GNRC_TSCH_CELL_TX;
+                break;
+            case 'r':
+                cell.flags |= GNRC_TSCH_CELL_RX;
+                break;
+            case 's':
+                cell.flags |= GNRC_TSCH_CELL_SHARED;
+                break;
+            default:
+                return -EINVAL;
+        }
+    }
+    if (argc > 6) {
+        uint8_t addr[GNRC_NETIF_L2ADDR_MAXLEN];
+
+        cell.addr_len = gnrc_netif_addr_from_str(argv[6], addr);
+        if ((cell.addr_len == 0) || (cell.addr_len > sizeof(cell.addr))) {
+            return -EINVAL;
+        }
+        memcpy(cell.addr, addr, cell.addr_len);
+    }
+    return gnrc_tsch_cell_add(netif, &cell);
+}
+
+static int _hop(gnrc_netif_t *netif, int argc, char **argv)
+{
+    uint8_t seq[GNRC_TSCH_HOPPING_LEN_MAX];
+    unsigned len = argc - 3;
+
+    if ((len == 0) || (len > sizeof(seq))) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < len; i++) {
+        seq[i] = atoi(argv[3 + i]);
+    }
+    return gnrc_tsch_set_hopping(netif, seq, len);
+}
+
+int _gnrc_tsch(int argc, char **argv)
+{
+    gnrc_netif_t *netif = NULL;
+    int res;
+
+    if (argc < 2) {
+        while ((netif = gnrc_netif_iter(netif))) {
+            _print(netif);
+        }
+        return 0;
+    }
+    if ((argc < 3) || (strcmp(argv[1], "help") == 0)) {
+        _usage(argv[0]);
+        return 1;
+    }
+    netif = gnrc_netif_get_by_pid(atoi(argv[1]));
+    if (netif == NULL) {
+        puts("error: invalid interface given");
+        return 1;
+    }
+    if (strcmp(argv[2], "coord") == 0) {
+        res = gnrc_tsch_start_coordinator(netif);
+    }
+    else if (strcmp(argv[2], "add") == 0) {
+        res = _add(netif, argc, argv);
+    }
+    else if ((strcmp(argv[2], "del") == 0) && (argc > 4)) {
+        res = gnrc_tsch_cell_del(netif, atoi(argv[3]), atoi(argv[4]));
+    }
+    else if (strcmp(argv[2], "hop") == 0) {
+        res = _hop(netif, argc, argv);
+    }
+    else if (strcmp(argv[2], "reset") == 0) {
+        res = gnrc_tsch_reset_stats(netif);
+    }
+    else {
+        _usage(argv[0]);
+        return 1;
+    }
+    if (res < 0) {
+        printf("error: %s failed (%d)\n", argv[2], res);
+        return 1;
+    }
+    puts("success");
+    return 0;
+}
@@ -14,6 +14,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "net/gnrc/ipv6/whitelist.h"
@@ -22,10 +23,10 @@ static void _usage(char *cmd)
 {
     printf("usage: * %s\n", cmd);
     puts("         Lists all addresses in the whitelist.");
-    printf("       * %s add <addr>\n", cmd);
-    puts("         Adds <addr> to the whitelist.");
-    printf("       * %s del <addr>\n", cmd);
-    puts("         Deletes <addr> from the whitelist.");
+    printf("       * %s add <addr>[/<prefix_len>]\n", cmd);
+    puts("         Adds <addr> or a prefix to the whitelist.");
+    printf("       * %s del <addr>[/<prefix_len>]\n", cmd);
+    puts("         Deletes <addr> or a prefix from the whitelist.");
     printf("       * %s help\n", cmd);
     puts("         Print this.");
 }
@@ -33,21 +34,31 @@ static void _usage(char *cmd)
 int _whitelist(int argc, char **argv)
 {
     ipv6_addr_t addr;
+    unsigned prefix_len = 128;
     if (argc < 2) {
         gnrc_ipv6_whitelist_print();
         return 0;
     }
     else if (argc > 2) {
-        if (ipv6_addr_from_str(&addr, argv[2]) == NULL) {
+        char *len_str = strchr(argv[2], '/');
+        if (len_str != NULL) {
+            *(len_str++) = '\0';
+            prefix_len = atoi(len_str);
+        }
+        if ((ipv6_addr_from_str(&addr, argv[2]) == NULL) ||
+            (prefix_len > 128)) {
             _usage(argv[0]);
             return 1;
         }
     }
     if (strcmp("add", argv[1]) == 0) {
-        gnrc_ipv6_whitelist_add(&addr);
+        if (gnrc_ipv6_whitelist_add_prefix(&addr, prefix_len) < 0) {
+            puts("error: unable to add prefix to whitelist");
+            return 1;
+        }
     }
     else if (strcmp("del", argv[1]) == 0) {
-        gnrc_ipv6_whitelist_del(&addr);
+        gnrc_ipv6_whitelist_del_prefix(&addr, prefix_len);
     }
     else if (strcmp("help", argv[1]) == 0) {
         _usage(argv[0]);
@@ -112,10 +112,18 @@ extern int _blacklist(int argc, char **argv);
 extern int _gnrc_pktbuf_cmd(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTCAP
+extern int _gnrc_pktcap(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_RPL
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_TSCH
+extern int _gnrc_tsch(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN_CTX
 #ifdef MODULE_GNRC_IPV6_NIB_6LBR
 extern int _gnrc_6ctx(int argc, char **argv);
@@ -210,9 +218,15 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_PKTBUF_CMD
     {"pktbuf", "prints internal stats of the packet buffer", _gnrc_pktbuf_cmd },
 #endif
+#ifdef MODULE_GNRC_PKTCAP
+    {"pcap", "captures frames to a pcapng file ('pcap help' for more information)", _gnrc_pktcap },
+#endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
+#ifdef MODULE_GNRC_TSCH
+    {"tsch", "slotframe MAC schedule and statistics ('tsch help' for more information)", _gnrc_tsch },
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_CTX
 #ifdef MODULE_GNRC_IPV6_NIB_6LBR
     {"6ctx", "6LoWPAN context configuration tool", _gnrc_6ctx },
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_threadstat
+ * @{
+ *
+ * @file
+ * @brief       Thread statistics implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "sched.h"
+#include "threadstat.h"
+#include "timex.h"
+
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+#define USE_DWT
+#include "periph_conf.h"
+#include "xtimer.h"
+#elif defined(CPU_NATIVE)
+#include <time.h>
+#include "native_internal.h"
+#else
+#include "xtimer.h"
+#endif
+
+typedef struct {
+    threadstat_t stat;
+    uint64_t laststart;     /**< time the thread was last switched to */
+    uint64_t readysince;    /**< time the thread was woken up */
+    bool ready;             /**< woken up, but did not run yet */
+} _thread_t;
+
+static _thread_t _threads[KERNEL_PID_LAST + 1];
+static threadstat_isr_t _isr;
+static uint64_t _isr_start;
+static unsigned _isr_nesting;
+
+#if defined(USE_DWT)
+/* the counter is extended at least twice per wrap-around */
+#define DWT_UPDATE_US   (((UINT32_MAX / CLOCK_CORECLOCK) / 2) * US_PER_SEC)
+
+static xtimer_t _dwt_timer;
+#endif
+
+/* must be called with interrupts disabled */
+static uint64_t _now(void)
+{
+#if defined(USE_DWT)
+    static bool started;
+    static uint32_t last;
+    static uint32_t high;
+
+    if (!started) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        started = true;
+    }
+
+    uint32_t now = DWT->CYCCNT;
+
+    if (now < last) {
+        high++;
+    }
+    last = now;
+    return ((uint64_t)high << 32) | now;
+#elif defined(CPU_NATIVE)
+    struct timespec ts;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000LU + ts.tv_nsec;
+#else
+    return xtimer_now64().ticks64;
+#endif
+}
+
+#if defined(USE_DWT)
+static void _dwt_update(void *arg)
+{
+    (void)arg;
+
+    unsigned state = irq_disable();
+    _now();
+    irq_restore(state);
+    xtimer_set(&_dwt_timer, DWT_UPDATE_US);
+}
+#endif
+
+void threadstat_init(void)
+{
+#if defined(USE_DWT)
+    _dwt_timer.callback = _dwt_update;
+    _dwt_update(NULL);
+#endif
+}
+
+uint32_t threadstat_hz(void)
+{
+#if defined(USE_DWT)
+    return CLOCK_CORECLOCK;
+#elif defined(CPU_NATIVE)
+    return 1000000000LU;
+#else
+    return XTIMER_HZ;
+#endif
+}
+
+uint64_t threadstat_usec(uint64_t cycles)
+{
+    uint32_t hz = threadstat_hz();
+
+    /* split to not overflow for long times */
+    return (cycles / hz) * US_PER_SEC + ((cycles % hz) * US_PER_SEC) / hz;
+}
+
+uint64_t threadstat_now(void)
+{
+    unsigned state = irq_disable();
+    uint64_t now = _now();
+
+    irq_restore(state);
+    return now;
+}
+
+void threadstat_switch(thread_t *active, thread_t *next)
+{
+    uint64_t now = _now();
+    _thread_t *t;
+
+    if (active != NULL) {
+        t = &_threads[active->pid];
+        t->stat.runtime += now - t->laststart;
+    }
+
+    t = &_threads[next->pid];
+    t->laststart = now;
+    t->stat.switches++;
+    if (t->ready) {
+        uint64_t latency = now - t->readysince;
+
+        t->ready = false;
+        t->stat.latency_sum += latency;
+        if (latency > t->stat.latency_max) {
+            t->stat.latency_max = (latency > UINT32_MAX) ? UINT32_MAX : latency;
+        }
+        t->stat.wakeups++;
+    }
+}
+
+void threadstat_set_status(thread_t *thread, unsigned status)
+{
+    _thread_t *t = &_threads[thread->pid];
+
+    if ((thread->status == STATUS_STOPPED) && (status != STATUS_STOPPED)) {
+        /* a new thread with the PID of an earlier one */
+        memset(t, 0, sizeof(*t));
+    }
+    if ((status >= STATUS_ON_RUNQUEUE) &&
+        (thread->status < STATUS_ON_RUNQUEUE)) {
+        t->readysince = _now();
+        t->ready = true;
+    }
+}
+
+void threadstat_isr_enter(void)
+{
+    if (_isr_nesting++ == 0) {
+        _isr_start = _now();
+    }
+}
+
+void threadstat_isr_exit(void)
+{
+    if (--_isr_nesting > 0) {
+        return;
+    }
+
+    uint64_t time = _now() - _isr_start;
+
+    _isr.runtime += time;
+    if (time > _isr.max) {
+        _isr.max = (time > UINT32_MAX) ? UINT32_MAX : time;
+    }
+    _isr.count++;
+    if (sched_active_thread != NULL) {
+        /* do not account the handler to the interrupted thread */
+        _threads[sched_active_pid].laststart += time;
+    }
+}
+
+int threadstat_get(kernel_pid_t pid, threadstat_t *stat)
+{
+    if ((pid < KERNEL_PID_FIRST) || (pid > KERNEL_PID_LAST)) {
+        return -ENOENT;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread == NULL) {
+        irq_restore(state);
+        return -ENOENT;
+    }
+    *stat = _threads[pid].stat;
+    if (pid == sched_active_pid) {
+        stat->runtime += _now() - _threads[pid].laststart;
+    }
+    irq_restore(state);
+
+    stat->stack_size = thread->stack_size;
+    stat->stack_used = thread->stack_size -
+                       thread_measure_stack_free(thread->stack_start);
+    return 0;
+}
+
+void threadstat_get_isr(threadstat_isr_t *stat)
+{
+    unsigned state = irq_disable();
+
+    *stat = _isr;
+    irq_restore(state);
+}
+
+void threadstat_reset(void)
+{
+    unsigned state = irq_disable();
+    uint64_t now = _now();
+
+    for (unsigned i = 0; i <= KERNEL_PID_LAST; i++) {
+        _thread_t *t = &_threads[i];
+
+        memset(&t->stat, 0, sizeof(t->stat));
+        /* the active thread runs from now on, woken up threads are ready */
+        t->laststart = now;
+        if (t->ready) {
+            t->readysince = now;
+        }
+    }
+    memset(&_isr, 0, sizeof(_isr));
+    irq_restore(state);
+}
@@ -28,6 +28,9 @@
 #include "thread.h"
 #include "kernel_types.h"
 #include "clist.h"
+#ifdef MODULE_VFS_STAT_CACHE
+#include "hashes.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -55,10 +58,75 @@ static vfs_file_t _vfs_open_files[VFS_MAX_OPEN_FILES];
  * @brief List handle for list of all currently mounted file systems
  *
  * This singly linked list is used to dispatch vfs calls to the appropriate file
- * system driver.
+ * system driver. It is kept sorted by descending mount point length, so the
+ * first matching entry is always the longest matching prefix.
  */
 static clist_node_t _vfs_mounts_list;
 
+#if defined(MODULE_VFS_STAT_CACHE) || defined(DOXYGEN)
+/**
+ * @internal
+ * @brief Entry of the stat cache
+ */
+typedef struct {
+    const vfs_mount_t *mp;  /**< mount of the entry, NULL if unused */
+    uint32_t hash;          /**< hash of @p path */
+    struct stat st;         /**< cached stat result */
+    char path[VFS_STAT_CACHE_PATH_MAX]; /**< mount point relative path */
+} _stat_cache_entry_t;
+
+/**
+ * @internal
+ * @brief Results of recent successful vfs_stat calls
+ */
+static _stat_cache_entry_t _stat_cache[VFS_STAT_CACHE_SIZE];
+
+/**
+ * @internal
+ * @brief Next entry to replace in _stat_cache
+ */
+static unsigned _stat_cache_next;
+
+/**
+ * @internal
+ * @brief Look up @p rel_path on @p mountp in the stat cache
+ *
+ * @param[in]  mountp    mount the path belongs to
+ * @param[in]  rel_path  mount point relative path
+ * @param[in]  hash      hash of @p rel_path
+ * @param[out] buf       stat buffer to fill on a hit
+ *
+ * @return 0 on hit
+ * @return -ENOENT on miss
+ */
+static int _stat_cache_get(const vfs_mount_t *mountp, const char *rel_path,
+                           uint32_t hash, struct stat *buf);
+
+/**
+ * @internal
+ * @brief Store a stat result in the stat cache
+ *
+ * Paths longer than VFS_STAT_CACHE_PATH_MAX - 1 are not cached.
+ *
+ * @param[in]  mountp    mount the path belongs to
+ * @param[in]  rel_path  mount point relative path
+ * @param[in]  hash      hash of @p rel_path
+ * @param[in]  buf       stat result to store
+ */
+static void _stat_cache_put(const vfs_mount_t *mountp, const char *rel_path,
+                            uint32_t hash, const struct stat *buf);
+
+/**
+ * @internal
+ * @brief Drop all stat cache entries belonging to @p mountp
+ *
+ * @param[in]  mountp    mount whose contents changed
+ */
+static void _stat_cache_invalidate(const vfs_mount_t *mountp);
+#else
+#define _stat_cache_invalidate(mountp) (void)(mountp)
+#endif
+
 /**
  * @internal
  * @brief Find an unused entry in the _vfs_open_files array and mark it as used
@@ -118,6 +186,19 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
  */
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path);
 
+/**
+ * @internal
+ * @brief Order mounts by descending mount point length for clist_sort
+ *
+ * @param[in]  a     list entry of the first mount
+ * @param[in]  b     list entry of the second mount
+ *
+ * @return <0 if @p a has the longer mount point
+ * @return >0 if @p b has the longer mount point
+ * @return 0 if both are of equal length
+ */
+static int _mount_cmp(clist_node_t *a, clist_node_t *b);
+
 /**
  * @internal
  * @brief Check that a given fd number is valid
@@ -131,6 +212,9 @@ static inline int _fd_is_valid(int fd);
 
 static mutex_t _mount_mutex = MUTEX_INIT;
 static mutex_t _open_mutex = MUTEX_INIT;
+#ifdef MODULE_VFS_STAT_CACHE
+static mutex_t _stat_cache_mutex = MUTEX_INIT;
+#endif
 
 int vfs_close(int fd)
 {
@@ -145,6 +229,10 @@ int vfs_close(int fd)
          * system driver close() call below */
         res = filp->f_op->close(filp);
     }
+    if ((filp->mp != NULL) && ((filp->flags & O_ACCMODE) != O_RDONLY)) {
+        /* some file systems only update the file metadata on close */
+        _stat_cache_invalidate(filp->mp);
+    }
     _free_fd(fd);
     return res;
 }
@@ -276,6 +364,10 @@ int vfs_open(const char *name, int flags, mode_t mode)
     vfs_file_t *filp = &_vfs_open_files[fd];
     if (filp->f_op->open != NULL) {
         res = filp->f_op->open(filp, rel_path, flags, mode, name);
+        if ((flags & (O_ACCMODE | O_CREAT | O_TRUNC)) != O_RDONLY) {
+            /* file may have been created or truncated */
+            _stat_cache_invalidate(mountp);
+        }
         if (res < 0) {
             /* something went wrong during open */
             DEBUG("vfs_open: open: ERR %d!\n", res);
@@ -330,7 +422,101 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
         /* driver does not implement write() */
         return -EINVAL;
     }
+#ifdef MODULE_VFS_STAT_CACHE
+    ssize_t written = filp->f_op->write(filp, src, count);
+    if (filp->mp != NULL) {
+        _stat_cache_invalidate(filp->mp);
+    }
+    return written;
+#else
     return filp->f_op->write(filp, src, count);
+#endif
+}
+
+ssize_t vfs_readv(int fd, const iolist_t *iolist)
+{
+    DEBUG("vfs_readv: %d, %p\n", fd, (void *)iolist);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (((filp->flags & O_ACCMODE) != O_RDONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for reading */
+        return -EBADF;
+    }
+    if (filp->f_op->readv != NULL) {
+        return filp->f_op->readv(filp, iolist);
+    }
+    if (filp->f_op->read == NULL) {
+        /* driver does not implement read() */
+        return -EINVAL;
+    }
+    ssize_t total = 0;
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        if (iol->iol_len == 0) {
+            continue;
+        }
+        if (iol->iol_base == NULL) {
+            return (total > 0) ? total : -EFAULT;
+        }
+        ssize_t n = filp->f_op->read(filp, iol->iol_base, iol->iol_len);
+        if (n < 0) {
+            /* report the data already transferred, like readv(2) does */
+            return (total > 0) ? total : n;
+        }
+        total += n;
+        if ((size_t)n < iol->iol_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t vfs_writev(int fd, const iolist_t *iolist)
+{
+    DEBUG_NOT_STDOUT(fd, "vfs_writev: %d, %p\n", fd, (void *)iolist);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (((filp->flags & O_ACCMODE) != O_WRONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for writing */
+        return -EBADF;
+    }
+    ssize_t total = 0;
+    if (filp->f_op->writev != NULL) {
+        total = filp->f_op->writev(filp, iolist);
+    }
+    else if (filp->f_op->write == NULL) {
+        /* driver does not implement write() */
+        return -EINVAL;
+    }
+    else {
+        for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+            if (iol->iol_len == 0) {
+                continue;
+            }
+            if (iol->iol_base == NULL) {
+                total = (total > 0) ? total : -EFAULT;
+                break;
+            }
+            ssize_t n = filp->f_op->write(filp, iol->iol_base, iol->iol_len);
+            if (n < 0) {
+                total = (total > 0) ? total : n;
+                break;
+            }
+            total += n;
+            if ((size_t)n < iol->iol_len) {
+                break;
+            }
+        }
+    }
+    if (filp->mp != NULL) {
+        _stat_cache_invalidate(filp->mp);
+    }
+    return total;
 }
 
 int vfs_opendir(vfs_DIR *dirp, const char *dirname)
@@ -430,6 +616,11 @@ static int check_mount(vfs_mount_t *mountp)
         return -EINVAL;
     }
     mountp->mount_point_len = strlen(mountp->mount_point);
+    /* "/mnt/" and "/mnt" name the same mount point */
+    while ((mountp->mount_point_len > 1) &&
+           (mountp->mount_point[mountp->mount_point_len - 1] == '/')) {
+        --mountp->mount_point_len;
+    }
     mutex_lock(&_mount_mutex);
     /* Check for the same mount in the list of mounts to avoid loops */
     clist_node_t *found = clist_find(&_vfs_mounts_list, &mountp->list_entry);
@@ -451,6 +642,7 @@ int vfs_format(vfs_mount_t *mountp)
         return ret;
     }
     mutex_unlock(&_mount_mutex);
+    _stat_cache_invalidate(mountp);
 
     if (mountp->fs->fs_op != NULL) {
         if (mountp->fs->fs_op->format != NULL) {
@@ -481,8 +673,11 @@ int vfs_mount(vfs_mount_t *mountp)
             }
         }
     }
-    /* insert last in list */
-    clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    /* insert first in list and restore the longest prefix first order, the
+     * sort is stable so the latest mount comes first among equal length mount
+     * points, i.e. it hides earlier mounts on the same mount point */
+    clist_lpush(&_vfs_mounts_list, &mountp->list_entry);
+    clist_sort(&_vfs_mounts_list, _mount_cmp);
     mutex_unlock(&_mount_mutex);
     DEBUG("vfs_mount: mount done\n");
     return 0;
@@ -530,6 +725,7 @@ int vfs_umount(vfs_mount_t *mountp)
         return -EINVAL;
     }
     mutex_unlock(&_mount_mutex);
+    _stat_cache_invalidate(mountp);
     return 0;
 }
 
@@ -575,6 +771,7 @@ int vfs_rename(const char *from_path, const char *to_path)
         return -EXDEV;
     }
     res = mountp->fs->fs_op->rename(mountp, rel_from, rel_to);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_rename: rename %p, \"%s\" -> \"%s\"", (void *)mountp, rel_from, rel_to);
     if (res < 0) {
         /* something went wrong during rename */
@@ -615,6 +812,7 @@ int vfs_unlink(const char *name)
         return -EPERM;
     }
     res = mountp->fs->fs_op->unlink(mountp, rel_path);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_unlink: unlink %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during unlink */
@@ -652,6 +850,7 @@ int vfs_mkdir(const char *name, mode_t mode)
         return -EPERM;
     }
     res = mountp->fs->fs_op->mkdir(mountp, rel_path, mode);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_mkdir: mkdir %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during mkdir */
@@ -689,6 +888,7 @@ int vfs_rmdir(const char *name)
         return -EPERM;
     }
     res = mountp->fs->fs_op->rmdir(mountp, rel_path);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_rmdir: rmdir %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during rmdir */
@@ -725,7 +925,21 @@ int vfs_stat(const char *restrict path, struct stat *restrict buf)
         atomic_fetch_sub(&mountp->open_files, 1);
         return -EPERM;
     }
+#ifdef MODULE_VFS_STAT_CACHE
+    uint32_t hash = djb2_hash((const uint8_t *)rel_path, strlen(rel_path));
+    res = _stat_cache_get(mountp, rel_path, hash, buf);
+    if (res == 0) {
+        DEBUG("vfs_stat: cache hit\n");
+        atomic_fetch_sub(&mountp->open_files, 1);
+        return 0;
+    }
+#endif
     res = mountp->fs->fs_op->stat(mountp, rel_path, buf);
+#ifdef MODULE_VFS_STAT_CACHE
+    if (res == 0) {
+        _stat_cache_put(mountp, rel_path, hash, buf);
+    }
+#endif
     /* remember to decrement the open_files count */
     atomic_fetch_sub(&mountp->open_files, 1);
     return res;
@@ -924,7 +1138,6 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
 
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path)
 {
-    size_t longest_match = 0;
     size_t name_len = strlen(name);
     mutex_lock(&_mount_mutex);
 
@@ -934,15 +1147,13 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         mutex_unlock(&_mount_mutex);
         return -ENOENT;
     }
+    /* the list is sorted by descending mount point length, so the first
+     * match is the longest one */
     vfs_mount_t *mountp = NULL;
     do {
         node = node->next;
         vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
         size_t len = it->mount_point_len;
-        if (len < longest_match) {
-            /* Already found a longer prefix */
-            continue;
-        }
         if (len > name_len) {
             /* path name is shorter than the mount point name */
             continue;
@@ -953,11 +1164,8 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         }
         if (strncmp(name, it->mount_point, len) == 0) {
             /* mount_point is a prefix of name */
-            /* special check for mount_point == "/" */
-            if (len > 1) {
-                longest_match = len;
-            }
             mountp = it;
+            break;
         }
     } while (node != _vfs_mounts_list.next);
     if (mountp == NULL) {
@@ -970,11 +1178,76 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
     mutex_unlock(&_mount_mutex);
     *mountpp = mountp;
     if (rel_path != NULL) {
-        *rel_path = name + longest_match;
+        /* special case for mount_point == "/" */
+        *rel_path = (mountp->mount_point_len > 1) ? name + mountp->mount_point_len
+                                                  : name;
+    }
+    return 0;
+}
+
+static int _mount_cmp(clist_node_t *a, clist_node_t *b)
+{
+    size_t a_len = container_of(a, vfs_mount_t, list_entry)->mount_point_len;
+    size_t b_len = container_of(b, vfs_mount_t, list_entry)->mount_point_len;
+
+    /* longest first */
+    if (a_len > b_len) {
+        return -1;
+    }
+    else if (a_len < b_len) {
+        return 1;
     }
     return 0;
 }
 
+#ifdef MODULE_VFS_STAT_CACHE
+static int _stat_cache_get(const vfs_mount_t *mountp, const char *rel_path,
+                           uint32_t hash, struct stat *buf)
+{
+    int res = -ENOENT;
+    mutex_lock(&_stat_cache_mutex);
+    for (unsigned i = 0; i < VFS_STAT_CACHE_SIZE; i++) {
+        _stat_cache_entry_t *entry = &_stat_cache[i];
+        if ((entry->mp == mountp) && (entry->hash == hash) &&
+            (strcmp(entry->path, rel_path) == 0)) {
+            *buf = entry->st;
+            res = 0;
+            break;
+        }
+    }
+    mutex_unlock(&_stat_cache_mutex);
+    return res;
+}
+
+static void _stat_cache_put(const vfs_mount_t *mountp, const char *rel_path,
+                            uint32_t hash, const struct stat *buf)
+{
+    size_t len = strlen(rel_path);
+    if (len >= VFS_STAT_CACHE_PATH_MAX) {
+        return;
+    }
+    mutex_lock(&_stat_cache_mutex);
+    _stat_cache_entry_t *entry = &_stat_cache[_stat_cache_next];
+    _stat_cache_next = (_stat_cache_next + 1) % VFS_STAT_CACHE_SIZE;
+    entry->mp = mountp;
+    entry->hash = hash;
+    entry->st = *buf;
+    memcpy(entry->path, rel_path, len + 1);
+    mutex_unlock(&_stat_cache_mutex);
+}
+
+static void _stat_cache_invalidate(const vfs_mount_t *mountp)
+{
+    mutex_lock(&_stat_cache_mutex);
+    for (unsigned i = 0; i < VFS_STAT_CACHE_SIZE; i++) {
+        if (_stat_cache[i].mp == mountp) {
+            _stat_cache[i].mp = NULL;
+        }
+    }
+    mutex_unlock(&_stat_cache_mutex);
+}
+#endif
+
 static inline int _fd_is_valid(int fd)
 {
     if ((unsigned int)fd >= VFS_MAX_OPEN_FILES) {
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_vfs_aio
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous VFS I/O worker
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "irq.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "vfs_aio.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static char _stack[VFS_AIO_STACKSIZE];
+static event_queue_t _queue;
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+    event_loop(&_queue);
+    /* never reached */
+    return NULL;
+}
+
+static void _handler(event_t *event)
+{
+    vfs_aio_t *req = (vfs_aio_t *)event;
+    /* the submitter may reuse the request as soon as res is set */
+    event_queue_t *queue = req->queue;
+    event_t *done = req->done;
+    thread_t *thread = req->thread;
+    ssize_t res;
+
+    DEBUG("vfs_aio: %s fd=%d\n", (req->op == VFS_AIO_WRITE) ? "write" : "read",
+          req->fd);
+
+    if (req->op == VFS_AIO_WRITE) {
+        res = vfs_writev(req->fd, req->iolist);
+    }
+    else {
+        res = vfs_readv(req->fd, req->iolist);
+    }
+    req->res = res;
+
+    if (queue != NULL) {
+        event_post(queue, done);
+    }
+    if (thread != NULL) {
+        thread_flags_set(thread, VFS_AIO_THREAD_FLAG);
+    }
+}
+
+void vfs_aio_init(void)
+{
+    event_queue_init(&_queue);
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), VFS_AIO_PRIO,
+                                     THREAD_CREATE_STACKTEST, _worker, NULL,
+                                     "vfs_aio");
+    /* the queue belongs to the worker, set it here so that requests can be
+     * posted before the worker ran for the first time */
+    _queue.waiter = (thread_t *)thread_get(pid);
+}
+
+int vfs_aio_submit(vfs_aio_t *req)
+{
+    if ((req == NULL) ||
+        ((req->op != VFS_AIO_READ) && (req->op != VFS_AIO_WRITE)) ||
+        ((req->queue != NULL) && (req->done == NULL))) {
+        return -EINVAL;
+    }
+
+    unsigned state = irq_disable();
+    if (req->res == -EINPROGRESS) {
+        irq_restore(state);
+        return -EBUSY;
+    }
+    req->res = -EINPROGRESS;
+    irq_restore(state);
+
+    req->super.handler = _handler;
+    event_post(&_queue, &req->super);
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the ISO-TP throughput between two channels
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "can/can.h"
+#include "can/common.h"
+#include "can/isotp.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_MSGS
+#define BENCH_MSGS          (10U)
+#endif
+
+#ifndef BENCH_MSG_LEN
+#define BENCH_MSG_LEN       (4000U)
+#endif
+
+#define RX_IFNUM            (0)
+#define TX_IFNUM            (1)
+
+/* sent messages are split in a header and a payload */
+#define HDR_LEN             (16U)
+
+#define QUEUE_SIZE          (16U)
+#define MSG_TIMEOUT         (10U * US_PER_SEC)
+
+enum {
+    COPY,
+    ZERO_COPY,
+};
+
+static msg_t _queue[QUEUE_SIZE];
+
+static struct isotp _tx_chan = {
+    .opt = { .tx_id = 0x700, .rx_id = 0x708 },
+};
+static struct isotp _rx_chan = {
+    .opt = { .tx_id = 0x708, .rx_id = 0x700 },
+};
+
+static uint8_t _tx_buf[BENCH_MSG_LEN];
+static uint8_t _rx_buf[BENCH_MSG_LEN];
+
+static iolist_t _tx_payload = {
+    .iol_base = _tx_buf + HDR_LEN,
+    .iol_len = BENCH_MSG_LEN - HDR_LEN,
+};
+static iolist_t _tx_iol = {
+    .iol_next = &_tx_payload,
+    .iol_base = _tx_buf,
+    .iol_len = HDR_LEN,
+};
+
+/* reassemble in two parts as well, split at a different offset */
+static iolist_t _rx_payload = {
+    .iol_base = _rx_buf + HDR_LEN / 2,
+    .iol_len = BENCH_MSG_LEN - HDR_LEN / 2,
+};
+static iolist_t _rx_iol = {
+    .iol_next = &_rx_payload,
+    .iol_base = _rx_buf,
+    .iol_len = HDR_LEN / 2,
+};
+
+static int _bind(void)
+{
+    can_reg_entry_t entry = { .target.pid = thread_getpid() };
+    int res;
+
+    entry.ifnum = TX_IFNUM;
+    res = isotp_bind(&_tx_chan, &entry, &_tx_chan);
+    if (res < 0) {
+        return res;
+    }
+    entry.ifnum = RX_IFNUM;
+    return isotp_bind(&_rx_chan, &entry, &_rx_chan);
+}
+
+/* waits for the TX confirmation and the reception of one message */
+static int _wait(int mode)
+{
+    bool sent = false, received = false;
+    msg_t msg;
+
+    while (!sent || !received) {
+        if (xtimer_msg_receive_timeout(&msg, MSG_TIMEOUT) < 0) {
+            puts("timeout");
+            return -1;
+        }
+        switch (msg.type) {
+        case CAN_MSG_TX_CONFIRMATION:
+            sent = true;
+            break;
+        case CAN_MSG_TX_ERROR:
+            puts("TX error");
+            return -1;
+        case CAN_MSG_RX_INDICATION: {
+            can_rx_data_t *rx = msg.content.ptr;
+            gnrc_pktsnip_t *snip = rx->data.iov_base;
+            size_t len = rx->data.iov_len;
+
+            if (mode == COPY) {
+                len = snip->size;
+                if (len <= sizeof(_rx_buf)) {
+                    memcpy(_rx_buf, snip->data, len);
+                }
+            }
+            isotp_free_rx(rx);
+            if ((len != BENCH_MSG_LEN) ||
+                memcmp(_rx_buf, _tx_buf, BENCH_MSG_LEN)) {
+                puts("data mismatch");
+                return -1;
+            }
+            received = true;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return 0;
+}
+
+static int _run(const char *name, int mode, int flags, uint8_t bs, uint8_t stmin)
+{
+    _rx_chan.opt.flags = flags;
+    isotp_set_rx_fc(&_rx_chan, bs, stmin);
+
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned n = 0; n < BENCH_MSGS; n++) {
+        int res;
+
+        for (unsigned i = 0; i < BENCH_MSG_LEN; i++) {
+            _tx_buf[i] = n + i * 7;
+        }
+        memset(_rx_buf, 0, sizeof(_rx_buf));
+
+        if (mode == COPY) {
+            res = isotp_send(&_tx_chan, _tx_buf, BENCH_MSG_LEN, 0);
+        }
+        else {
+            isotp_set_rx_iolist(&_rx_chan, &_rx_iol);
+            res = isotp_send_iolist(&_tx_chan, &_tx_iol, 0);
+        }
+        if ((res < 0) || (_wait(mode) < 0)) {
+            printf("%s: FAILED at message %u\n", name, n);
+            return -1;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("%-28s bs=%3u stmin=0x%02x: %7lu us, %6lu B/s\n", name,
+           _rx_chan.rxfc.bs, _rx_chan.rxfc.stmin, (unsigned long)duration,
+           (unsigned long)((uint64_t)BENCH_MSGS * BENCH_MSG_LEN * US_PER_SEC /
+                           duration));
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_queue, QUEUE_SIZE);
+
+    puts("ISO-TP throughput\n");
+    printf("%u messages of %u bytes\n", BENCH_MSGS, BENCH_MSG_LEN);
+
+    if (_bind() < 0) {
+        puts("bind: FAILED");
+        return 1;
+    }
+    puts("bind: OK");
+
+    if ((_run("copy", COPY, 0, 8, 0x01) < 0) ||
+        (_run("zero-copy", ZERO_COPY, 0, 8, 0x01) < 0) ||
+        (_run("zero-copy, no flow control", ZERO_COPY, 0, 0, 0) < 0) ||
+        (_run("zero-copy, adaptive", ZERO_COPY, CAN_ISOTP_RX_DYN_FC, 8, 0x01) < 0)) {
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the RX throughput of the CAN router
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "can/can.h"
+#include "can/common.h"
+#include "can/raw.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_FRAMES
+#define BENCH_FRAMES        (10000U)
+#endif
+
+#define RX_IFNUM            (0)
+#define TX_IFNUM            (1)
+
+#define IDS_NUMOF           (24U)
+#define HOT_NUMOF           (3U)
+
+#define QUEUE_SIZE          (64U)
+#define RX_TIMEOUT          (US_PER_SEC)
+
+static msg_t _queue[QUEUE_SIZE];
+static struct can_filter _filters[IDS_NUMOF + 1];
+
+static unsigned _rx;
+static unsigned _tx_conf;
+
+/* spread the subscribed IDs, so they end up in different buckets */
+static canid_t _id(unsigned i)
+{
+    return 0x100 + i * 0x13;
+}
+
+static int _subscribe(void)
+{
+    for (unsigned i = 0; i < IDS_NUMOF; i++) {
+        _filters[i].can_id = _id(i);
+        _filters[i].can_mask = CAN_SFF_MASK;
+    }
+    /* one wildcard filter for 0x700 - 0x7ff */
+    _filters[IDS_NUMOF].can_id = 0x700;
+    _filters[IDS_NUMOF].can_mask = 0x700;
+
+    for (unsigned i = 0; i < IDS_NUMOF + 1; i++) {
+        int res = raw_can_subscribe_rx(RX_IFNUM, &_filters[i], thread_getpid(), NULL);
+        if (res < 0) {
+            printf("subscribing to 0x%03lx failed: %d\n",
+                   (unsigned long)_filters[i].can_id, res);
+            return res;
+        }
+    }
+    return 0;
+}
+
+/* the mix of IDs: 70 % hot, 15 % other subscribed, 5 % wildcard,
+ * 10 % not subscribed */
+static canid_t _next_id(unsigned n, unsigned *expected)
+{
+    unsigned slot = n % 20;
+
+    if (slot < 14) {
+        (*expected)++;
+        return _id(n % HOT_NUMOF);
+    }
+    else if (slot < 17) {
+        (*expected)++;
+        return _id(HOT_NUMOF + (n / 20) % (IDS_NUMOF - HOT_NUMOF));
+    }
+    else if (slot < 18) {
+        (*expected)++;
+        return 0x700 | (n & 0xff);
+    }
+    return 0x080 + (n & 0x3f);
+}
+
+static void _handle(msg_t *msg)
+{
+    switch (msg->type) {
+    case CAN_MSG_RX_INDICATION:
+        _rx++;
+        raw_can_free_frame(msg->content.ptr);
+        break;
+    case CAN_MSG_TX_CONFIRMATION:
+    case CAN_MSG_TX_ERROR:
+        _tx_conf++;
+        break;
+    default:
+        break;
+    }
+}
+
+int main(void)
+{
+    msg_t msg;
+    unsigned expected = 0;
+
+    msg_init_queue(_queue, QUEUE_SIZE);
+
+    puts("CAN router throughput\n");
+#ifdef MODULE_CAN_ROUTER_OFFLOAD
+    puts("can_router_offload: enabled");
+#else
+    puts("can_router_offload: disabled");
+#endif
+
+    if (_subscribe() < 0) {
+        puts("subscribe: FAILED");
+        return 1;
+    }
+    puts("subscribe: OK");
+
+    struct can_frame frame = { .can_dlc = 8 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned n = 0; n < BENCH_FRAMES; n++) {
+        frame.can_id = _next_id(n, &expected);
+        frame.data[0] = n;
+        if (raw_can_send(TX_IFNUM, &frame, thread_getpid()) < 0) {
+            printf("send: FAILED at frame %u\n", n);
+            return 1;
+        }
+        /* keep at most one frame in flight, so no queue overflows */
+        while (_tx_conf <= n) {
+            msg_receive(&msg);
+            _handle(&msg);
+        }
+    }
+    while ((_rx < expected) &&
+           (xtimer_msg_receive_timeout(&msg, RX_TIMEOUT) >= 0)) {
+        _handle(&msg);
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("frames sent: %u, received: %u, expected: %u\n",
+           BENCH_FRAMES, _rx, expected);
+    printf("duration: %lu us, %lu frames/s\n", (unsigned long)duration,
+           (unsigned long)((uint64_t)BENCH_FRAMES * US_PER_SEC / duration));
+
+    if (_rx != expected) {
+        puts("receive: FAILED");
+        return 1;
+    }
+    puts("receive: OK");
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
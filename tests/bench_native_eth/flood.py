@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Sends broadcast Ethernet frames into tap or veth interfaces.
+
+The frames are sent round robin over all given interfaces. Sending on raw
+sockets requires root privileges (or CAP_NET_RAW).
+"""
+
+import argparse
+import socket
+import time
+
+# IEEE 802 local experimental ethertype
+ETHERTYPE = 0x88b5
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", "--count", type=int, default=100000,
+                        help="number of frames to send")
+    parser.add_argument("-s", "--size", type=int, default=64,
+                        help="payload size of the frames")
+    parser.add_argument("interfaces", nargs="+", help="host interfaces")
+    args = parser.parse_args()
+
+    socks = []
+    for interface in args.interfaces:
+        sock = socket.socket(socket.AF_PACKET, socket.SOCK_RAW)
+        sock.bind((interface, 0))
+        socks.append(sock)
+    frame = (b"\xff" * 6 + b"\x02\x00\x00\x00\x00\x01" +
+             ETHERTYPE.to_bytes(2, "big") + b"\x55" * args.size)
+
+    start = time.monotonic()
+    for i in range(args.count):
+        socks[i % len(socks)].send(frame)
+    duration = time.monotonic() - start
+    print("sent {} frames in {:.0f} ms ({:.0f} frames/s)"
+          .format(args.count, duration * 1000, args.count / duration))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of native's Ethernet devices
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "shell.h"
+#include "shell_commands.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+
+#define SINK_QUEUE_SIZE (16U)
+
+#define FLOOD_SIZE_MAX  (1400U)
+
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static char _flood_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _flood_payload[FLOOD_SIZE_MAX];
+static unsigned _flood_count, _flood_size;
+static volatile bool _flooding;
+static msg_t _sink_queue[SINK_QUEUE_SIZE];
+static unsigned _received;
+static uint32_t _first, _last;
+
+static void *_sink(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_sink_queue, SINK_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            uint32_t now = xtimer_now_usec();
+
+            if (_received++ == 0) {
+                _first = now;
+            }
+            _last = now;
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return NULL;
+}
+
+static int _count(int argc, char **argv)
+{
+    uint32_t duration = _last - _first;
+
+    (void)argc;
+    (void)argv;
+    printf("received %u frames in %u ms", _received,
+           (unsigned)(duration / US_PER_MS));
+    if (duration > 0) {
+        printf(" (%u frames/s)",
+               (unsigned)((uint64_t)(_received - 1) * US_PER_SEC / duration));
+    }
+    puts("");
+    _received = 0;
+    return 0;
+}
+
+static gnrc_pktsnip_t *_flood_frame(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _flood_payload, _flood_size,
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, hdr);
+    return pkt;
+}
+
+/* runs above the network interfaces, so their queues fill up like they do
+ * on a busy router */
+static void *_flood(void *arg)
+{
+    gnrc_netif_t *netif = NULL;
+    unsigned sent = 0;
+    uint32_t start, duration;
+    uint16_t mtu;
+
+    (void)arg;
+    start = xtimer_now_usec();
+    while (sent < _flood_count) {
+        gnrc_pktsnip_t *pkt = _flood_frame();
+
+        if (pkt == NULL) {
+            /* packet buffer exhausted, let the interfaces catch up */
+            xtimer_usleep(100);
+            continue;
+        }
+        netif = gnrc_netif_iter(netif);
+        if (netif == NULL) {
+            netif = gnrc_netif_iter(NULL);
+        }
+        if (gnrc_netapi_send(netif->pid, pkt) < 1) {
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+        sent++;
+    }
+    /* the interfaces handle their queue in order, so all frames were handed
+     * to the host when they answer */
+    netif = NULL;
+    while ((netif = gnrc_netif_iter(netif))) {
+        gnrc_netapi_get(netif->pid, NETOPT_MAX_PACKET_SIZE, 0, &mtu,
+                        sizeof(mtu));
+    }
+    duration = xtimer_now_usec() - start;
+    printf("sent %u frames in %u ms", sent, (unsigned)(duration / US_PER_MS));
+    if (duration > 0) {
+        printf(" (%u frames/s)",
+               (unsigned)((uint64_t)sent * US_PER_SEC / duration));
+    }
+    puts("");
+    _flooding = false;
+    return NULL;
+}
+
+static int _flood_cmd(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <frames> [<payload size>]\n", argv[0]);
+        return 1;
+    }
+    _flood_count = atoi(argv[1]);
+    _flood_size = (argc > 2) ? (unsigned)atoi(argv[2]) : 64;
+    if (_flood_size > FLOOD_SIZE_MAX) {
+        printf("payload size exceeds %u\n", FLOOD_SIZE_MAX);
+        return 1;
+    }
+    if (gnrc_netif_iter(NULL) == NULL) {
+        puts("no network interface");
+        return 1;
+    }
+    if (_flooding) {
+        puts("still flooding");
+        return 1;
+    }
+    _flooding = true;
+    thread_create(_flood_stack, sizeof(_flood_stack), GNRC_NETIF_PRIO - 1,
+                  THREAD_CREATE_STACKTEST, _flood, NULL, "flood");
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "count", "prints and resets the received frames", _count },
+    { "flood", "sends broadcast frames on all interfaces", _flood_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    static gnrc_netreg_entry_t sink;
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    kernel_pid_t pid;
+
+    puts("native Ethernet benchmark");
+    pid = thread_create(_sink_stack, sizeof(_sink_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _sink, NULL, "sink");
+    /* the frames of flood.py carry an unknown ethertype */
+    gnrc_netreg_entry_init_pid(&sink, GNRC_NETREG_DEMUX_CTX_ALL, pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &sink);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the HELLO processing of NHDP for dense neighborhoods
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "xtimer.h"
+
+#include "rfc5444/rfc5444.h"
+#include "rfc5444/rfc5444_iana.h"
+#include "rfc5444/rfc5444_reader.h"
+#include "rfc5444/rfc5444_writer.h"
+
+#include "iib_table.h"
+#include "lib_table.h"
+#include "nhdp.h"
+#include "nhdp_address.h"
+#include "nhdp_reader.h"
+
+#ifndef BENCH_NEIGHBORS
+#define BENCH_NEIGHBORS         (50U)
+#endif
+
+/* symmetric neighbors reported in the HELLO of each neighbor */
+#ifndef BENCH_NEIGHBOR_NBS
+#define BENCH_NEIGHBOR_NBS      (20U)
+#endif
+
+#define BENCH_ROUNDS            (4U)
+
+/* the simulated MANET interface */
+#define IF_PID                  (1)
+#define HELLO_INT_MS            (2000U)
+#define VALIDITY_MS             (3 * HELLO_INT_MS)
+#define PKT_BUF_SIZE            (2048U)
+
+/* the local node has id 0, the neighbors 1 to BENCH_NEIGHBORS, the nodes
+ * above are 2-hop neighbors only */
+#define NODES_NUMOF             (2 * BENCH_NEIGHBORS)
+
+static uint8_t _msg_buf[PKT_BUF_SIZE];
+static uint8_t _addrtlv_buf[8 * PKT_BUF_SIZE];
+static uint8_t _pkt_buf[PKT_BUF_SIZE];
+static uint8_t _hello[PKT_BUF_SIZE];
+static size_t _hello_len;
+
+/* the HELLO currently constructed */
+static unsigned _sender, _round;
+static uint16_t _seq_no;
+
+static struct rfc5444_writer _writer;
+static struct rfc5444_writer_target _target;
+
+static void _add_hello_msg_header(struct rfc5444_writer *wr,
+                                  struct rfc5444_writer_message *msg);
+static void _add_msg_tlvs(struct rfc5444_writer *wr);
+static void _add_addresses(struct rfc5444_writer *wr);
+
+static struct rfc5444_writer_tlvtype _addrtlvs[] = {
+    [RFC5444_ADDRTLV_LOCAL_IF] = { .type = RFC5444_ADDRTLV_LOCAL_IF },
+    [RFC5444_ADDRTLV_LINK_STATUS] = { .type = RFC5444_ADDRTLV_LINK_STATUS },
+    [RFC5444_ADDRTLV_OTHER_NEIGHB] = { .type = RFC5444_ADDRTLV_OTHER_NEIGHB },
+    [RFC5444_ADDRTLV_LINK_METRIC] = { .type = RFC5444_ADDRTLV_LINK_METRIC, .exttype = NHDP_METRIC }
+};
+
+static struct rfc5444_writer_content_provider _provider = {
+    .msg_type = RFC5444_MSGTYPE_HELLO,
+    .addMessageTLVs = _add_msg_tlvs,
+    .addAddresses = _add_addresses,
+};
+
+static void _node_addr(struct netaddr *addr, unsigned node)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->_type = AF_INET6;
+    addr->_prefix_len = 128;
+    addr->_addr[0] = 0xfe;
+    addr->_addr[1] = 0x80;
+    addr->_addr[11] = 0xff;
+    addr->_addr[12] = 0xfe;
+    addr->_addr[14] = node >> 8;
+    addr->_addr[15] = node & 0xff;
+}
+
+/* the neighbors of a neighbor are the following nodes, one of them changes
+ * every round */
+static unsigned _neighbor_nb(unsigned node, unsigned i)
+{
+    if (i == BENCH_NEIGHBOR_NBS - 1) {
+        i += _round;
+    }
+    return ((node + i) % NODES_NUMOF) + 1;
+}
+
+static void _add_addr(struct rfc5444_writer *wr, unsigned node,
+                      enum rfc5444_addrtlv_iana type, uint8_t value)
+{
+    struct rfc5444_writer_address *wr_addr;
+    struct netaddr addr;
+
+    _node_addr(&addr, node);
+    wr_addr = rfc5444_writer_add_address(wr, _provider.creator, &addr,
+                                         type == RFC5444_ADDRTLV_LOCAL_IF);
+    rfc5444_writer_add_addrtlv(wr, wr_addr, &_addrtlvs[type], &value,
+                               sizeof(value), false);
+}
+
+static void _add_hello_msg_header(struct rfc5444_writer *wr,
+                                  struct rfc5444_writer_message *msg)
+{
+    rfc5444_writer_set_msg_header(wr, msg, false, false, false, false);
+}
+
+static void _add_msg_tlvs(struct rfc5444_writer *wr)
+{
+    uint8_t validity_time = rfc5444_timetlv_encode(VALIDITY_MS);
+    uint8_t interval_time = rfc5444_timetlv_encode(HELLO_INT_MS);
+
+    rfc5444_writer_add_messagetlv(wr, RFC5444_MSGTLV_VALIDITY_TIME, 0,
+                                  &validity_time, sizeof(validity_time));
+    rfc5444_writer_add_messagetlv(wr, RFC5444_MSGTLV_INTERVAL_TIME, 0,
+                                  &interval_time, sizeof(interval_time));
+}
+
+static void _add_addresses(struct rfc5444_writer *wr)
+{
+    _add_addr(wr, _sender, RFC5444_ADDRTLV_LOCAL_IF, RFC5444_LOCALIF_THIS_IF);
+    if (_round > 0) {
+        /* the neighbor heard our first HELLO */
+        _add_addr(wr, 0, RFC5444_ADDRTLV_LINK_STATUS,
+                  RFC5444_LINKSTATUS_SYMMETRIC);
+    }
+    for (unsigned i = 0; i < BENCH_NEIGHBOR_NBS; i++) {
+        _add_addr(wr, _neighbor_nb(_sender, i), RFC5444_ADDRTLV_OTHER_NEIGHB,
+                  RFC5444_OTHERNEIGHB_SYMMETRIC);
+    }
+}
+
+static void _add_pkt_header(struct rfc5444_writer *wr,
+                            struct rfc5444_writer_target *target)
+{
+    rfc5444_writer_set_pkt_header(wr, target, true);
+    rfc5444_writer_set_pkt_seqno(wr, target, ++_seq_no);
+}
+
+static void _store_pkt(struct rfc5444_writer *wr,
+                       struct rfc5444_writer_target *target,
+                       void *buffer, size_t length)
+{
+    (void)wr;
+    (void)target;
+    memcpy(_hello, buffer, length);
+    _hello_len = length;
+}
+
+static void _init(void)
+{
+    struct rfc5444_writer_message *hello;
+    struct netaddr own;
+    nhdp_addr_t *addr;
+
+    _writer.msg_buffer = _msg_buf;
+    _writer.msg_size = sizeof(_msg_buf);
+    _writer.addrtlv_buffer = _addrtlv_buf;
+    _writer.addrtlv_size = sizeof(_addrtlv_buf);
+    rfc5444_writer_init(&_writer);
+    rfc5444_writer_register_msgcontentprovider(&_writer, &_provider, _addrtlvs,
+                                               ARRAYSIZE(_addrtlvs));
+    hello = rfc5444_writer_register_message(&_writer, RFC5444_MSGTYPE_HELLO,
+                                            false, 16);
+    hello->addMessageHeader = _add_hello_msg_header;
+    _target.packet_buffer = _pkt_buf;
+    _target.packet_size = sizeof(_pkt_buf);
+    _target.sendPacket = _store_pkt;
+    _target.addPacketHeader = _add_pkt_header;
+    rfc5444_writer_register_target(&_writer, &_target);
+
+    /* register the local node's interface like nhdp_register_if() does */
+    nhdp_reader_init();
+    _node_addr(&own, 0);
+    addr = nhdp_addr_db_get_address(own._addr, 16, AF_INET6);
+    lib_add_if_addr(IF_PID, addr);
+    nhdp_decrement_addr_usage(addr);
+    iib_register_if(IF_PID);
+}
+
+static int _bench_round(void)
+{
+    uint32_t total = 0;
+
+    for (_sender = 1; _sender <= BENCH_NEIGHBORS; _sender++) {
+        uint32_t start;
+        int res;
+
+        rfc5444_writer_create_message(&_writer, RFC5444_MSGTYPE_HELLO,
+                                      rfc5444_writer_singletarget_selector,
+                                      &_target);
+        rfc5444_writer_flush(&_writer, &_target, false);
+
+        start = xtimer_now_usec();
+        res = nhdp_reader_handle_packet(IF_PID, _hello, _hello_len);
+        total += xtimer_now_usec() - start;
+        if (res != RFC5444_OKAY) {
+            printf("HELLO of neighbor %u not processed (%d)\n", _sender, res);
+            return -1;
+        }
+    }
+    printf("round %u: %u HELLOs, %lu us per HELLO\n", _round,
+           (unsigned)BENCH_NEIGHBORS, (unsigned long)(total / BENCH_NEIGHBORS));
+    return 0;
+}
+
+int main(void)
+{
+    puts("NHDP HELLO processing benchmark");
+    printf("neighbors: %u, 2-hop addresses per HELLO: %u\n",
+           (unsigned)BENCH_NEIGHBORS, (unsigned)BENCH_NEIGHBOR_NBS);
+
+    _init();
+    for (_round = 0; _round < BENCH_ROUNDS; _round++) {
+        if (_bench_round() < 0) {
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the source route table of a non-storing RPL root
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl/sr.h"
+#include "net/gnrc/rpl/srh.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#ifndef BENCH_NODES
+#define BENCH_NODES         (GNRC_RPL_SR_NUMOF)
+#endif
+
+/* children per node of the simulated DODAG */
+#ifndef BENCH_FANOUT
+#define BENCH_FANOUT        (3U)
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000U)
+#endif
+
+#define PAYLOAD_LEN         (32U)
+#define LIFETIME            (600U)
+
+static const ipv6_addr_t _dodag_id = {{
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+}};
+
+static ipv6_addr_t _route[GNRC_RPL_SR_MAX_DEPTH];
+
+/* node i has the parent (i / BENCH_FANOUT) - 1, the first BENCH_FANOUT nodes
+ * are neighbors of the root */
+static void _addr(ipv6_addr_t *addr, unsigned node)
+{
+    *addr = _dodag_id;
+    addr->u8[1 + 8] = 0x12;
+    addr->u8[6 + 8] = node >> 8;
+    addr->u8[7 + 8] = node & 0xff;
+}
+
+static int _parent(ipv6_addr_t *addr, unsigned node)
+{
+    if (node < BENCH_FANOUT) {
+        *addr = _dodag_id;
+        return -1;
+    }
+    node = (node / BENCH_FANOUT) - 1;
+    _addr(addr, node);
+    return node;
+}
+
+static unsigned _depth(unsigned node)
+{
+    ipv6_addr_t addr;
+    unsigned depth = 1;
+    int parent = node;
+
+    while ((parent = _parent(&addr, parent)) >= 0) {
+        depth++;
+    }
+    return depth;
+}
+
+static int _build(void)
+{
+    ipv6_addr_t target, parent;
+
+    gnrc_rpl_sr_init(&_dodag_id, KERNEL_PID_UNDEF);
+    /* the DAOs of the leaves arrive first, so the parents are placeholders
+     * for a while */
+    for (unsigned i = BENCH_NODES; i > 0; i--) {
+        _addr(&target, i - 1);
+        _parent(&parent, i - 1);
+        if (gnrc_rpl_sr_add(&target, &parent, LIFETIME) < 0) {
+            return -1;
+        }
+    }
+    return (gnrc_rpl_sr_numof() == BENCH_NODES) ? 0 : -1;
+}
+
+static gnrc_pktsnip_t *_pkt(const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *payload, *ipv6;
+    ipv6_hdr_t *hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(PAYLOAD_LEN);
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = 64;
+    hdr->src = _dodag_id;
+    hdr->dst = *dst;
+    return ipv6;
+}
+
+static int _bench(unsigned node)
+{
+    ipv6_addr_t dst;
+    uint32_t route_time, srh_time, start;
+    int num = 0;
+
+    _addr(&dst, node);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        num = gnrc_rpl_sr_get_route(&dst, _route, GNRC_RPL_SR_MAX_DEPTH, NULL);
+    }
+    route_time = xtimer_now_usec() - start;
+    if (num != (int)_depth(node)) {
+        printf("node %u: route of %d hops, expected %u\n", node, num,
+               _depth(node));
+        return -1;
+    }
+
+    srh_time = 0;
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        gnrc_pktsnip_t *pkt = _pkt(&dst);
+        int res;
+
+        if (pkt == NULL) {
+            puts("packet buffer full");
+            return -1;
+        }
+        start = xtimer_now_usec();
+        num = gnrc_rpl_sr_get_route(&dst, _route, GNRC_RPL_SR_MAX_DEPTH, NULL);
+        res = (num > 1) ? gnrc_rpl_srh_insert(pkt, _route, num) : 0;
+        srh_time += xtimer_now_usec() - start;
+        if (res < 0) {
+            gnrc_pktbuf_release(pkt);
+            printf("node %u: SRH insertion failed\n", node);
+            return -1;
+        }
+        if ((i == 0) && (pkt->next->type == GNRC_NETTYPE_IPV6_EXT)) {
+            printf("depth %2d: SRH %2u bytes, ", num,
+                   (unsigned)pkt->next->size);
+        }
+        else if (i == 0) {
+            printf("depth %2d: no SRH,       ", num);
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+
+    printf("route %4lu ns, route + SRH %5lu ns per packet\n",
+           (unsigned long)((uint64_t)route_time * NS_PER_US / BENCH_RUNS),
+           (unsigned long)((uint64_t)srh_time * NS_PER_US / BENCH_RUNS));
+    return 0;
+}
+
+static int _unreachable(void)
+{
+    ipv6_addr_t node, child, parent;
+
+    /* the first child of node 0 loses its route with node 0 */
+    _addr(&node, 0);
+    _addr(&child, BENCH_FANOUT);
+    gnrc_rpl_sr_del(&node);
+    if (gnrc_rpl_sr_get_route(&child, _route, GNRC_RPL_SR_MAX_DEPTH,
+                              NULL) != -EHOSTUNREACH) {
+        return -1;
+    }
+    /* until both send their DAO again */
+    _parent(&parent, 0);
+    gnrc_rpl_sr_add(&node, &parent, LIFETIME);
+    gnrc_rpl_sr_add(&child, &node, LIFETIME);
+    if (gnrc_rpl_sr_get_route(&child, _route, GNRC_RPL_SR_MAX_DEPTH,
+                              NULL) != 2) {
+        return -1;
+    }
+    /* routes expire */
+    gnrc_rpl_sr_update(LIFETIME);
+    return (gnrc_rpl_sr_numof() == 0) ? 0 : -1;
+}
+
+int main(void)
+{
+    puts("RPL non-storing mode source routes\n");
+    printf("%u nodes, fanout %u\n", (unsigned)BENCH_NODES, BENCH_FANOUT);
+
+    if (_build() < 0) {
+        puts("DODAG: FAILED");
+        return 1;
+    }
+    puts("DODAG: OK");
+
+    size_t size = sizeof(gnrc_rpl_sr_entry_t) * GNRC_RPL_SR_NUMOF +
+                  sizeof(uint16_t) * GNRC_RPL_SR_BUCKETS;
+    printf("table: %u bytes, %u bytes per node\n", (unsigned)size,
+           (unsigned)(size / GNRC_RPL_SR_NUMOF));
+
+    /* the first node of each level of the DODAG */
+    for (unsigned node = 0; node < BENCH_NODES;
+         node = (node + 1) * BENCH_FANOUT) {
+        if (_bench(node) < 0) {
+            puts("benchmark: FAILED");
+            return 1;
+        }
+    }
+
+    if (_unreachable() < 0) {
+        puts("unreachable: FAILED");
+        return 1;
+    }
+    puts("unreachable: OK");
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
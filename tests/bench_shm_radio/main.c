@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of the shared memory radio medium
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+
+#ifndef FRAMES_NUMOF
+#define FRAMES_NUMOF    (100U)
+#endif
+
+#ifndef FRAMES_GAP_MS
+#define FRAMES_GAP_MS   (10U)
+#endif
+
+/**
+ * @brief   Time for the other nodes to start up before sending
+ */
+#define START_DELAY     (2U * US_PER_SEC)
+
+/**
+ * @brief   Time for the frames of the other nodes to arrive after sending
+ */
+#define DRAIN_DELAY     (2U * US_PER_SEC)
+
+#define SINK_QUEUE_SIZE (32U)
+
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _sink_queue[SINK_QUEUE_SIZE];
+static unsigned _received;
+
+static void *_sink(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_sink_queue, SINK_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            _received++;
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return NULL;
+}
+
+static int _send(gnrc_netif_t *netif, unsigned seq)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, &seq, sizeof(seq), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    LL_PREPEND(pkt, hdr);
+    if (gnrc_netapi_send(netif->pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    static gnrc_netreg_entry_t sink;
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    xtimer_ticks32_t last;
+    uint32_t start, duration;
+    unsigned sent = 0;
+    kernel_pid_t pid;
+
+    puts("shm_radio benchmark");
+    pid = thread_create(_sink_stack, sizeof(_sink_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _sink, NULL, "sink");
+    /* without 6LoWPAN the payload of received frames is undefined */
+    gnrc_netreg_entry_init_pid(&sink, GNRC_NETREG_DEMUX_CTX_ALL, pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &sink);
+
+    xtimer_usleep(START_DELAY);
+    start = xtimer_now_usec();
+    last = xtimer_now();
+    for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+        if (_send(netif, i) == 0) {
+            sent++;
+        }
+        xtimer_periodic_wakeup(&last, FRAMES_GAP_MS * US_PER_MS);
+    }
+    duration = xtimer_now_usec() - start;
+    xtimer_usleep(DRAIN_DELAY);
+    printf("sent %u received %u in %u ms\n", sent, _received,
+           (unsigned)(duration / US_PER_MS));
+    return 0;
+}
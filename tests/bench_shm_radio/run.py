@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Starts NODES instances of the benchmark on one medium and sums up the
+frames they exchanged."""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+NODES = int(os.environ.get("NODES", 100))
+RESULT = re.compile(r"sent (\d+) received (\d+) in (\d+) ms")
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    elf = os.path.join(here, "bin", "native", "bench_shm_radio.elf")
+    tool = os.path.join(here, "..", "..", "dist", "tools", "shm_radio",
+                        "shm_radio.py")
+    medium = os.path.join(tempfile.mkdtemp(), "medium")
+
+    subprocess.check_call([tool, "-n", str(NODES), medium])
+    nodes = [subprocess.Popen([elf, "--shm-radio=%s:%d" % (medium, i)],
+                              stdout=subprocess.PIPE,
+                              universal_newlines=True)
+             for i in range(NODES)]
+    sent = received = duration = 0
+    try:
+        for node in nodes:
+            for line in node.stdout:
+                match = RESULT.search(line)
+                if match:
+                    sent += int(match.group(1))
+                    received += int(match.group(2))
+                    duration = max(duration, int(match.group(3)))
+                    break
+            else:
+                sys.exit("an instance exited early")
+    finally:
+        for node in nodes:
+            node.kill()
+            node.wait()
+        os.unlink(medium)
+
+    expected = sent * (NODES - 1)
+    print("%d nodes sent %d frames, received %d of %d" %
+          (NODES, sent, received, expected))
+    if duration > 0:
+        print("%d frames/s delivered" % (received * 1000 // duration))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the 6LoWPAN header compression
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_PACKETS
+#define BENCH_PACKETS       (10000U)
+#endif
+
+/* number of destinations the packets are sent to in turn */
+#ifndef BENCH_FLOWS
+#define BENCH_FLOWS         (4U)
+#endif
+
+/* packets passed to the interface before it gets to send them, must be less
+ * than its message queue */
+#define BENCH_BATCH         (4U)
+
+#define PAYLOAD_LEN         (32U)
+#define PORT                (0xf0b1)
+#define CTX_ID              (1U)
+#define MSG_QUEUE_SIZE      (8U)
+#define MAX_PACKET_SIZE     (127U)
+
+static const uint8_t _local_l2addr[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+};
+static const uint8_t _remote_l2addr[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+};
+/* fd01::/64 */
+static const ipv6_addr_t _prefix = {{
+    0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+}};
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static netdev_test_t _dev;
+static gnrc_netreg_entry_t _ipv6_reg;
+static gnrc_netif_t *_netif;
+static unsigned _sent;
+/* a compressed frame of the benchmark, without the link-layer header */
+static uint8_t _frame[MAX_PACKET_SIZE];
+static size_t _frame_len;
+static bool _capture;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = MAX_PACKET_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = sizeof(_local_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    memcpy(value, _local_l2addr, sizeof(_local_l2addr));
+    return sizeof(_local_l2addr);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    if (_capture && (iolist->iol_next != NULL)) {
+        _capture = false;
+        _frame_len = 0;
+        /* skip the IEEE 802.15.4 header */
+        for (const iolist_t *iol = iolist->iol_next; iol != NULL;
+             iol = iol->iol_next) {
+            memcpy(&_frame[_frame_len], iol->iol_base, iol->iol_len);
+            _frame_len += iol->iol_len;
+        }
+    }
+    _sent++;
+    return iolist_size(iolist);
+}
+
+static void _addr(ipv6_addr_t *addr, const uint8_t *l2addr)
+{
+    *addr = _prefix;
+    memcpy(&addr->u8[8], l2addr, 8);
+    addr->u8[8] ^= 0x02;
+}
+
+static void _remote(uint8_t *l2addr, ipv6_addr_t *addr, unsigned flow)
+{
+    memcpy(l2addr, _remote_l2addr, sizeof(_remote_l2addr));
+    l2addr[7] += flow;
+    _addr(addr, l2addr);
+}
+
+static int _init(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    netdev_test_set_send_cb(&_dev, _send);
+    /* the interface has the priority of this thread, so it only sends when
+     * this thread yields */
+    _netif = gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                          THREAD_PRIORITY_MAIN, "bench",
+                                          (netdev_t *)&_dev);
+    if (_netif == NULL) {
+        return -1;
+    }
+    thread_yield();
+    if (gnrc_sixlowpan_ctx_update(CTX_ID, &_prefix, 64, UINT16_MAX,
+                                  true) == NULL) {
+        return -1;
+    }
+
+    /* the decompressed packets come to this thread instead of the IPv6
+     * thread */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6,
+                           gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                              GNRC_NETREG_DEMUX_CTX_ALL));
+    gnrc_netreg_entry_init_pid(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+    return gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+}
+
+static gnrc_pktsnip_t *_build(unsigned flow)
+{
+    struct {
+        gnrc_netif_hdr_t hdr;
+        uint8_t dst[8];
+    } netif_hdr;
+    gnrc_pktsnip_t *pkt, *ipv6;
+    ipv6_hdr_t *hdr;
+    ipv6_addr_t src, dst;
+
+    _addr(&src, _local_l2addr);
+    _remote(netif_hdr.dst, &dst, flow);
+    gnrc_netif_hdr_init(&netif_hdr.hdr, 0, sizeof(netif_hdr.dst));
+    netif_hdr.hdr.if_pid = _netif->pid;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    memset(pkt->data, flow, PAYLOAD_LEN);
+    if ((ipv6 = gnrc_udp_hdr_build(pkt, PORT, PORT)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = ipv6;
+    if ((ipv6 = gnrc_ipv6_hdr_build(pkt, &src, &dst)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(PAYLOAD_LEN + sizeof(udp_hdr_t));
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = 64;
+    pkt = gnrc_pktbuf_add(ipv6, &netif_hdr, sizeof(netif_hdr),
+                          GNRC_NETTYPE_NETIF);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(ipv6);
+    }
+    return pkt;
+}
+
+static void _print(const char *name, uint32_t usec)
+{
+    printf("%s: %lu packets/s (%lu ns/packet)\n", name,
+           (unsigned long)(((uint64_t)BENCH_PACKETS * US_PER_SEC) / usec),
+           (unsigned long)(((uint64_t)usec * 1000) / BENCH_PACKETS));
+}
+
+/* run: 0 only builds the packets, 1 sends them, 2 sends them with an empty
+ * cache */
+static int _bench_send(unsigned run)
+{
+    uint32_t start = xtimer_now_usec();
+
+    _sent = 0;
+    _capture = (run == 1);
+    for (unsigned i = 0; i < BENCH_PACKETS; i++) {
+        gnrc_pktsnip_t *pkt = _build(i % BENCH_FLOWS);
+
+        if (pkt == NULL) {
+            return -1;
+        }
+        if (run == 0) {
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+        if (run == 2) {
+            gnrc_sixlowpan_iphc_cache_flush();
+        }
+#endif
+        gnrc_sixlowpan_iphc_send(pkt, NULL, 0);
+        if ((i % BENCH_BATCH) == (BENCH_BATCH - 1)) {
+            thread_yield();
+        }
+    }
+    thread_yield();
+    start = xtimer_now_usec() - start;
+    if ((run > 0) && (_sent < BENCH_PACKETS)) {
+        printf("only %u of %u packets sent\n", _sent, BENCH_PACKETS);
+        return -1;
+    }
+    _print((run == 0) ? "build" : (run == 1) ? "send" : "send (cache miss)",
+           start);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_recv_pkt(void)
+{
+    struct {
+        gnrc_netif_hdr_t hdr;
+        uint8_t src[8];
+        uint8_t dst[8];
+    } netif_hdr;
+    gnrc_pktsnip_t *pkt;
+
+    gnrc_netif_hdr_init(&netif_hdr.hdr, sizeof(netif_hdr.src),
+                        sizeof(netif_hdr.dst));
+    memcpy(netif_hdr.src, _local_l2addr, sizeof(netif_hdr.src));
+    memcpy(netif_hdr.dst, _remote_l2addr, sizeof(netif_hdr.dst));
+    netif_hdr.hdr.if_pid = _netif->pid;
+
+    pkt = gnrc_pktbuf_add(NULL, &netif_hdr, sizeof(netif_hdr),
+                          GNRC_NETTYPE_NETIF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    return gnrc_pktbuf_add(pkt, _frame, _frame_len, GNRC_NETTYPE_SIXLOWPAN);
+}
+
+static int _bench_recv(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BENCH_PACKETS; i++) {
+        gnrc_pktsnip_t *pkt = _recv_pkt();
+        msg_t msg;
+
+        if (pkt == NULL) {
+            return -1;
+        }
+        gnrc_sixlowpan_iphc_recv(pkt, NULL, 0);
+        if (msg_try_receive(&msg) < 0) {
+            return -1;
+        }
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    _print("recv", xtimer_now_usec() - start);
+    return 0;
+}
+
+static int _check_recv(void)
+{
+    gnrc_pktsnip_t *pkt = _recv_pkt();
+    ipv6_addr_t src, dst;
+    uint8_t l2addr[8];
+    ipv6_hdr_t *hdr;
+    msg_t msg;
+    int res = 0;
+
+    if (pkt == NULL) {
+        return -1;
+    }
+    gnrc_sixlowpan_iphc_recv(pkt, NULL, 0);
+    if (msg_try_receive(&msg) < 0) {
+        return -1;
+    }
+    pkt = msg.content.ptr;
+    hdr = pkt->data;
+    _addr(&src, _local_l2addr);
+    _remote(l2addr, &dst, 0);
+    if (!ipv6_addr_equal(&hdr->src, &src) || !ipv6_addr_equal(&hdr->dst, &dst) ||
+        (hdr->nh != PROTNUM_UDP) || (hdr->hl != 64) ||
+        (byteorder_ntohs(hdr->len) != (PAYLOAD_LEN + sizeof(udp_hdr_t)))) {
+        res = -1;
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+int main(void)
+{
+    puts("6LoWPAN header compression\n");
+
+    if (_init() < 0) {
+        puts("init: FAILED");
+        return 1;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    printf("cache: %u entries\n", GNRC_SIXLOWPAN_IPHC_CACHE_SIZE);
+#else
+    puts("cache: off");
+#endif
+    printf("%u packets to %u destinations\n", BENCH_PACKETS, BENCH_FLOWS);
+
+    if ((_bench_send(0) < 0) || (_bench_send(1) < 0)) {
+        puts("benchmark: FAILED");
+        return 1;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    if (_bench_send(2) < 0) {
+        puts("benchmark: FAILED");
+        return 1;
+    }
+#endif
+    printf("compressed frame: %u bytes\n", (unsigned)_frame_len);
+    if (_bench_recv() < 0) {
+        puts("benchmark: FAILED");
+        return 1;
+    }
+    if (_check_recv() < 0) {
+        puts("decompression: FAILED");
+        return 1;
+    }
+    puts("decompression: OK");
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the frames per datagram of 6LoWPAN next header and
+ *              generic header compression
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/udp.h"
+#include "net/icmpv6.h"
+#include "net/ipv6/ext.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/ndp.h"
+#include "net/netstats.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS        (16U)
+#endif
+
+/* time the stack gets to send all fragments of a datagram */
+#define BENCH_WAIT          (20U * US_PER_MS)
+
+#define PAYLOAD_LEN         (80U)
+#define PORT                (5683U)
+#define CTX_ID              (0U)
+#define L2ADDR_LEN          (8U)
+
+#define RPL_HBH_OPT_TYPE    (0x63)  /* RFC 6553 */
+#define RPL_HBH_OPT_LEN     (4U)
+#define RPL_DIO_CODE        (0x01)
+#define SRH_HOPS            (3U)
+#define SRH_LEN             (IPV6_EXT_LEN_UNIT + (SRH_HOPS * 8))
+
+typedef struct {
+    const char *name;
+    gnrc_pktsnip_t *(*build)(void);
+} bench_datagram_t;
+
+static const uint8_t _remote_l2addr[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+};
+/* fd01::/64 */
+static const ipv6_addr_t _prefix = {{
+    0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+}};
+/* ff02::1a */
+static const ipv6_addr_t _all_rpl_nodes = {{
+    0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1a
+}};
+
+static gnrc_netif_t *_netif;
+static netstats_t *_stats;
+
+static void _addr(ipv6_addr_t *addr, const ipv6_addr_t *prefix,
+                  const uint8_t *l2addr, uint8_t node)
+{
+    *addr = *prefix;
+    memcpy(&addr->u8[8], l2addr, L2ADDR_LEN);
+    addr->u8[8] ^= 0x02;
+    addr->u8[15] += node;
+}
+
+static void _local(ipv6_addr_t *addr)
+{
+    _addr(addr, &_prefix, _netif->l2addr, 0);
+}
+
+static void _remote(ipv6_addr_t *addr)
+{
+    _addr(addr, &_prefix, _remote_l2addr, 0);
+}
+
+static gnrc_pktsnip_t *_netif_hdr(gnrc_pktsnip_t *ipv6, bool mcast)
+{
+    struct {
+        gnrc_netif_hdr_t hdr;
+        uint8_t dst[L2ADDR_LEN];
+    } netif_hdr;
+    gnrc_pktsnip_t *pkt;
+
+    gnrc_netif_hdr_init(&netif_hdr.hdr, 0, (mcast) ? 0 : L2ADDR_LEN);
+    memcpy(netif_hdr.dst, _remote_l2addr, sizeof(netif_hdr.dst));
+    netif_hdr.hdr.if_pid = _netif->pid;
+    if (mcast) {
+        netif_hdr.hdr.flags |= GNRC_NETIF_HDR_FLAGS_MULTICAST;
+    }
+    pkt = gnrc_pktbuf_add(ipv6, &netif_hdr,
+                          sizeof(gnrc_netif_hdr_t) + netif_hdr.hdr.dst_l2addr_len,
+                          GNRC_NETTYPE_NETIF);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(ipv6);
+    }
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_ipv6_hdr(gnrc_pktsnip_t *next, const ipv6_addr_t *src,
+                                 const ipv6_addr_t *dst, uint8_t nh,
+                                 uint8_t hl)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_ipv6_hdr_build(next, src, dst);
+    ipv6_hdr_t *hdr;
+
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(next);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(gnrc_pkt_len(next));
+    hdr->nh = nh;
+    hdr->hl = hl;
+    return ipv6;
+}
+
+static gnrc_pktsnip_t *_ext_hdr(gnrc_pktsnip_t *next, const uint8_t *data,
+                                size_t len)
+{
+    gnrc_pktsnip_t *ext = gnrc_pktbuf_add(next, data, len,
+                                          GNRC_NETTYPE_IPV6_EXT);
+
+    if (ext == NULL) {
+        gnrc_pktbuf_release(next);
+    }
+    return ext;
+}
+
+static gnrc_pktsnip_t *_udp(void)
+{
+    gnrc_pktsnip_t *pkt, *udp;
+    uint8_t *payload;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    payload = pkt->data;
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+    if ((udp = gnrc_udp_hdr_build(pkt, PORT, PORT)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((udp_hdr_t *)udp->data)->length = byteorder_htons(gnrc_pkt_len(udp));
+    return udp;
+}
+
+/* RFC 6553 RPL option in a hop-by-hop options header */
+static gnrc_pktsnip_t *_rpl_hbh(gnrc_pktsnip_t *next, uint8_t nh)
+{
+    const uint8_t hbh[] = {
+        nh, 0, RPL_HBH_OPT_TYPE, RPL_HBH_OPT_LEN,
+        0x00,           /* flags */
+        0x00,           /* RPLInstanceID */
+        0x02, 0x00,     /* SenderRank */
+    };
+
+    return _ext_hdr(next, hbh, sizeof(hbh));
+}
+
+static gnrc_pktsnip_t *_finish(gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *l4,
+                               bool mcast)
+{
+    if (ipv6 == NULL) {
+        return NULL;
+    }
+    if (l4->type == GNRC_NETTYPE_UDP) {
+        gnrc_udp_calc_csum(l4, ipv6);
+    }
+    else {
+        gnrc_icmpv6_calc_csum(l4, ipv6);
+    }
+    return _netif_hdr(ipv6, mcast);
+}
+
+static gnrc_pktsnip_t *_build_udp(void)
+{
+    gnrc_pktsnip_t *udp = _udp();
+    ipv6_addr_t src, dst;
+
+    if (udp == NULL) {
+        return NULL;
+    }
+    _local(&src);
+    _remote(&dst);
+    return _finish(_ipv6_hdr(udp, &src, &dst, PROTNUM_UDP, 64), udp, false);
+}
+
+static gnrc_pktsnip_t *_build_udp_hbh(void)
+{
+    gnrc_pktsnip_t *udp = _udp(), *pkt;
+    ipv6_addr_t src, dst;
+
+    if ((udp == NULL) || ((pkt = _rpl_hbh(udp, PROTNUM_UDP)) == NULL)) {
+        return NULL;
+    }
+    _local(&src);
+    _remote(&dst);
+    return _finish(_ipv6_hdr(pkt, &src, &dst, PROTNUM_IPV6_EXT_HOPOPT, 64),
+                   udp, false);
+}
+
+/* RFC 6554 source routing header with SRH_HOPS hops of which the prefix is
+ * elided */
+static gnrc_pktsnip_t *_build_udp_srh(void)
+{
+    gnrc_pktsnip_t *udp = _udp(), *pkt;
+    ipv6_addr_t src, dst;
+    uint8_t *srh;
+
+    if (udp == NULL) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(udp, NULL, SRH_LEN, GNRC_NETTYPE_IPV6_EXT);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    srh = pkt->data;
+    memset(srh, 0, SRH_LEN);
+    srh[0] = PROTNUM_UDP;
+    srh[1] = (SRH_LEN / IPV6_EXT_LEN_UNIT) - 1;
+    srh[2] = IPV6_EXT_RH_TYPE_RPL_SRH;
+    srh[3] = SRH_HOPS;                  /* segments left */
+    srh[4] = (8 << 4) | 8;              /* CmprI, CmprE */
+    for (unsigned i = 0; i < SRH_HOPS; i++) {
+        _addr(&dst, &_prefix, _remote_l2addr, i + 1);
+        memcpy(&srh[8 + (i * 8)], &dst.u8[8], 8);
+    }
+    _local(&src);
+    _remote(&dst);
+    return _finish(_ipv6_hdr(pkt, &src, &dst, PROTNUM_IPV6_EXT_RH, 64), udp,
+                   false);
+}
+
+/* a RPL router forwarding a datagram of another node in IPv6-in-IPv6 to add
+ * the RPL option */
+static gnrc_pktsnip_t *_build_ipv6_ipv6(void)
+{
+    gnrc_pktsnip_t *udp = _udp(), *pkt;
+    ipv6_addr_t src, dst;
+
+    if (udp == NULL) {
+        return NULL;
+    }
+    _addr(&src, &_prefix, _remote_l2addr, 1);
+    _remote(&dst);
+    if ((pkt = _ipv6_hdr(udp, &src, &dst, PROTNUM_UDP, 63)) == NULL) {
+        return NULL;
+    }
+    gnrc_udp_calc_csum(udp, pkt);
+    if ((pkt = _rpl_hbh(pkt, PROTNUM_IPV6)) == NULL) {
+        return NULL;
+    }
+    _local(&src);
+    pkt = _ipv6_hdr(pkt, &src, &dst, PROTNUM_IPV6_EXT_HOPOPT, 64);
+    return (pkt != NULL) ? _netif_hdr(pkt, false) : NULL;
+}
+
+static gnrc_pktsnip_t *_icmpv6(uint8_t type, uint8_t code, const uint8_t *body,
+                               size_t len)
+{
+    gnrc_pktsnip_t *icmpv6 = gnrc_icmpv6_build(NULL, type, code,
+                                               sizeof(icmpv6_hdr_t) + len);
+
+    if (icmpv6 != NULL) {
+        memcpy((uint8_t *)icmpv6->data + sizeof(icmpv6_hdr_t), body, len);
+    }
+    return icmpv6;
+}
+
+/* DIO with DODAG configuration and prefix information option */
+static gnrc_pktsnip_t *_build_rpl_dio(void)
+{
+    uint8_t dio[] = {
+        /* DIO base object */
+        0x00, 0x00, 0x02, 0x00, 0x90, 0x00, 0x00, 0x00,
+        0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        /* DODAG configuration */
+        0x04, 0x0e, 0x00, 0x14, 0x03, 0x0a, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+        /* prefix information */
+        0x08, 0x1e, 0x40, 0x40, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+        0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    gnrc_pktsnip_t *icmpv6 = _icmpv6(ICMPV6_RPL_CTRL, RPL_DIO_CODE, dio,
+                                     sizeof(dio));
+    ipv6_addr_t src;
+
+    if (icmpv6 == NULL) {
+        return NULL;
+    }
+    _addr(&src, &ipv6_addr_link_local_prefix, _netif->l2addr, 0);
+    return _finish(_ipv6_hdr(icmpv6, &src, &_all_rpl_nodes, PROTNUM_ICMPV6,
+                             255), icmpv6, true);
+}
+
+/* RFC 6775 address registration with a neighbor solicitation */
+static gnrc_pktsnip_t *_build_nd_ns(void)
+{
+    uint8_t ns[4 + sizeof(ipv6_addr_t) + 16 + 16] = {
+        0x00, 0x00, 0x00, 0x00,
+    };
+    uint8_t *opt = &ns[4 + sizeof(ipv6_addr_t)];
+    gnrc_pktsnip_t *icmpv6;
+    ipv6_addr_t src, dst;
+
+    _local(&src);
+    memcpy(&ns[4], &src, sizeof(src));
+    /* source link-layer address option */
+    opt[0] = NDP_OPT_SL2A;
+    opt[1] = 2;
+    memcpy(&opt[2], _netif->l2addr, L2ADDR_LEN);
+    /* address registration option */
+    opt += 16;
+    opt[0] = NDP_OPT_AR;
+    opt[1] = 2;
+    opt[7] = 15;        /* lifetime in minutes */
+    memcpy(&opt[8], _netif->l2addr, L2ADDR_LEN);
+    if ((icmpv6 = _icmpv6(ICMPV6_NBR_SOL, 0, ns, sizeof(ns))) == NULL) {
+        return NULL;
+    }
+    _addr(&dst, &ipv6_addr_link_local_prefix, _remote_l2addr, 0);
+    return _finish(_ipv6_hdr(icmpv6, &src, &dst, PROTNUM_ICMPV6, 255), icmpv6,
+                   false);
+}
+
+static const bench_datagram_t _datagrams[] = {
+    { "UDP", _build_udp },
+    { "UDP + RPL option", _build_udp_hbh },
+    { "UDP + RPL SRH", _build_udp_srh },
+    { "IPv6-in-IPv6 UDP", _build_ipv6_ipv6 },
+    { "RPL DIO", _build_rpl_dio },
+    { "ND NS + ARO", _build_nd_ns },
+};
+
+static int _bench(const bench_datagram_t *datagram)
+{
+    uint32_t frames, bytes, start;
+    size_t len = 0;
+
+    frames = _stats->tx_unicast_count + _stats->tx_mcast_count;
+    bytes = _stats->tx_bytes;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_ROUNDS; i++) {
+        gnrc_pktsnip_t *pkt = datagram->build();
+
+        if (pkt == NULL) {
+            return -1;
+        }
+        len = gnrc_pkt_len(pkt->next);
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            gnrc_pktbuf_release(pkt);
+            return -1;
+        }
+        xtimer_usleep(BENCH_WAIT);
+    }
+    frames = _stats->tx_unicast_count + _stats->tx_mcast_count - frames;
+    bytes = _stats->tx_bytes - bytes;
+    start = xtimer_now_usec() - start - (BENCH_ROUNDS * BENCH_WAIT);
+    printf("%s: %u bytes, %u.%02u frames/datagram, %u L2 bytes/datagram "
+           "(%lu us/datagram)\n", datagram->name, (unsigned)len,
+           (unsigned)(frames / BENCH_ROUNDS),
+           (unsigned)(((frames % BENCH_ROUNDS) * 100) / BENCH_ROUNDS),
+           (unsigned)(bytes / BENCH_ROUNDS),
+           (unsigned long)(start / BENCH_ROUNDS));
+    return 0;
+}
+
+int main(void)
+{
+    puts("6LoWPAN next header compression\n");
+
+    _netif = gnrc_netif_iter(NULL);
+    if ((_netif == NULL) ||
+        (gnrc_netapi_get(_netif->pid, NETOPT_STATS, NETSTATS_LAYER2, &_stats,
+                         sizeof(&_stats)) < 0) ||
+        (_netif->l2addr_len != L2ADDR_LEN) ||
+        (gnrc_sixlowpan_ctx_update(CTX_ID, &_prefix, 64, UINT16_MAX,
+                                   true) == NULL)) {
+        puts("init: FAILED");
+        return 1;
+    }
+#if !defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC)
+    puts("compression: IPHC");
+#elif !defined(MODULE_GNRC_SIXLOWPAN_IPHC_GHC)
+    puts("compression: IPHC, NHC");
+#else
+    puts("compression: IPHC, NHC, GHC");
+#endif
+    printf("maximum fragment size: %u bytes\n",
+           (unsigned)_netif->sixlo.max_frag_size);
+    for (unsigned i = 0; i < (sizeof(_datagrams) / sizeof(_datagrams[0])); i++) {
+        if (_bench(&_datagrams[i]) < 0) {
+            printf("%s: FAILED\n", _datagrams[i].name);
+            return 1;
+        }
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
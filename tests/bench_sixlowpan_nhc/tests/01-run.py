@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r'compression: IPHC(, NHC)?(, GHC)?')
+    for name in ('UDP', r'UDP \+ RPL option', r'UDP \+ RPL SRH',
+                 'IPv6-in-IPv6 UDP', 'RPL DIO', r'ND NS \+ ARO'):
+        child.expect(name + r': \d+ bytes, \d+\.\d+ frames/datagram')
+    child.expect_exact('[SUCCESS]', timeout=60)
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the runtime of path based VFS calls
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "benchmark.h"
+#include "board.h"
+#include "mtd.h"
+#include "vfs.h"
+#include "fs/constfs.h"
+#include "fs/littlefs_fs.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+/* number of additional mounts to populate the mount table with */
+#define FILLER_MOUNTS       (6U)
+
+/* keep format and mount of littlefs on the native MTD fast */
+#define LFS_BLOCKS          (32U)
+
+static const uint8_t _data[] = "0123456789abcdef";
+
+static const constfs_file_t _files[] = {
+    {
+        .path = "/log.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+    {
+        .path = "/config.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+};
+
+static const constfs_t _constfs = {
+    .files = _files,
+    .nfiles = sizeof(_files) / sizeof(_files[0]),
+};
+
+static const char *_filler_names[FILLER_MOUNTS] = {
+    "/mnt0", "/mnt1", "/const/a", "/const/b", "/data", "/lfs/ro",
+};
+
+static vfs_mount_t _filler_mounts[FILLER_MOUNTS];
+
+static vfs_mount_t _constfs_mount = {
+    .mount_point = "/const",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&_constfs,
+};
+
+static littlefs_desc_t _lfs_desc;
+
+static vfs_mount_t _lfs_mount = {
+    .mount_point = "/lfs",
+    .fs = &littlefs_file_system,
+    .private_data = &_lfs_desc,
+};
+
+static struct stat _st;
+
+static void _open_close(const char *path)
+{
+    int fd = vfs_open(path, O_RDONLY, 0);
+    if (fd >= 0) {
+        vfs_close(fd);
+    }
+}
+
+static int _append(const char *path)
+{
+    int fd = vfs_open(path, O_WRONLY | O_CREAT | O_APPEND, 0);
+    if (fd < 0) {
+        return fd;
+    }
+    int res = vfs_write(fd, _data, sizeof(_data));
+    vfs_close(fd);
+    return res;
+}
+
+static int _check_stat_after_write(void)
+{
+    if (vfs_stat("/lfs/log0.txt", &_st) < 0) {
+        return -1;
+    }
+    off_t size = _st.st_size;
+    /* stat again so the result is cached */
+    vfs_stat("/lfs/log0.txt", &_st);
+
+    if (_append("/lfs/log0.txt") < 0) {
+        return -1;
+    }
+    if ((vfs_stat("/lfs/log0.txt", &_st) < 0) ||
+        (_st.st_size != size + (off_t)sizeof(_data))) {
+        return -1;
+    }
+
+    if ((vfs_unlink("/lfs/log3.txt") < 0) ||
+        (vfs_stat("/lfs/log3.txt", &_st) != -ENOENT)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int _setup(void)
+{
+    for (unsigned i = 0; i < FILLER_MOUNTS; i++) {
+        _filler_mounts[i].mount_point = _filler_names[i];
+        _filler_mounts[i].fs = &constfs_file_system;
+        _filler_mounts[i].private_data = (void *)&_constfs;
+        if (vfs_mount(&_filler_mounts[i]) < 0) {
+            return -1;
+        }
+    }
+    if (vfs_mount(&_constfs_mount) < 0) {
+        return -1;
+    }
+
+    _lfs_desc.dev = MTD_0;
+    _lfs_desc.config.block_count = LFS_BLOCKS;
+    if ((vfs_format(&_lfs_mount) < 0) || (vfs_mount(&_lfs_mount) < 0)) {
+        return -1;
+    }
+    char path[] = "/lfs/logX.txt";
+    for (unsigned i = 0; i < 4; i++) {
+        path[8] = '0' + i;
+        if (_append(path) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    puts("Runtime of path based VFS calls\n");
+
+#ifdef MODULE_VFS_STAT_CACHE
+    puts("vfs_stat_cache: enabled");
+#else
+    puts("vfs_stat_cache: disabled");
+#endif
+
+    if (_setup() < 0) {
+        puts("error: setting up the file systems failed");
+        return 1;
+    }
+
+    if (_check_stat_after_write() < 0) {
+        puts("stat after write: FAILED");
+        return 1;
+    }
+    puts("stat after write: OK\n");
+
+    BENCHMARK_FUNC("stat constfs", BENCH_RUNS,
+                   vfs_stat("/const/log.txt", &_st));
+    BENCHMARK_FUNC("stat constfs (no entry)", BENCH_RUNS,
+                   vfs_stat("/const/none.txt", &_st));
+    BENCHMARK_FUNC("stat littlefs", BENCH_RUNS,
+                   vfs_stat("/lfs/log1.txt", &_st));
+    BENCHMARK_FUNC("stat littlefs (2 files)", BENCH_RUNS,
+                   vfs_stat((i & 1) ? "/lfs/log1.txt" : "/lfs/log2.txt", &_st));
+    puts("");
+    BENCHMARK_FUNC("open/close constfs", BENCH_RUNS,
+                   _open_close("/const/log.txt"));
+    BENCHMARK_FUNC("open/close littlefs", BENCH_RUNS,
+                   _open_close("/lfs/log1.txt"));
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Fuzz targets for the parsers of network packets
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "native_fuzzing.h"
+
+#ifdef PARSER_COAP
+#include "net/nanocoap.h"
+#endif
+#ifdef PARSER_NHDP
+#include "iib_table.h"
+#include "lib_table.h"
+#include "nhdp.h"
+#include "nhdp_address.h"
+#include "nhdp_reader.h"
+#endif
+#if defined(PARSER_IPHC) || defined(PARSER_IPV6_EXT) || defined(PARSER_RPL)
+#define PARSER_GNRC
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/icmpv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "thread.h"
+#endif
+#ifdef PARSER_IPHC
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/sixlowpan.h"
+#endif
+#ifdef PARSER_RPL
+#include "net/gnrc/rpl.h"
+#endif
+
+#ifdef PARSER_COAP
+#define PARSER_NAME         "coap"
+
+static uint8_t _resp[256];
+
+static ssize_t _echo_handler(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                             void *context)
+{
+    (void)context;
+    return coap_reply_simple(pkt, COAP_CODE_CONTENT, buf, len,
+                             coap_get_content_type(pkt), pkt->payload,
+                             (pkt->payload_len > UINT8_MAX) ?
+                             UINT8_MAX : pkt->payload_len);
+}
+
+/* must be sorted by path */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+    { "/echo", COAP_GET | COAP_POST | COAP_PUT, _echo_handler, NULL },
+};
+
+const unsigned coap_resources_numof = sizeof(coap_resources) /
+                                      sizeof(coap_resources[0]);
+
+static int _init(void)
+{
+    return 0;
+}
+
+static void _target(uint8_t *data, size_t len)
+{
+    uint8_t uri[NANOCOAP_URI_MAX];
+    coap_block1_t block;
+    coap_pkt_t pkt;
+
+    if (coap_parse(&pkt, data, len) < 0) {
+        return;
+    }
+    /* the options are only parsed when they are looked for */
+    coap_get_uri_path(&pkt, uri);
+    coap_get_block1(&pkt, &block);
+    coap_get_block2(&pkt, &block);
+    coap_handle_req(&pkt, _resp, sizeof(_resp));
+}
+#endif /* PARSER_COAP */
+
+#ifdef PARSER_NHDP
+#define PARSER_NAME         "nhdp"
+
+/* the simulated MANET interface */
+#define IF_PID              (1)
+
+static int _init(void)
+{
+    struct netaddr own;
+    nhdp_addr_t *addr;
+
+    /* register the local node's interface like nhdp_register_if() does */
+    nhdp_reader_init();
+    memset(&own, 0, sizeof(own));
+    own._type = AF_INET6;
+    own._prefix_len = 128;
+    own._addr[0] = 0xfe;
+    own._addr[1] = 0x80;
+    own._addr[15] = 0x01;
+    addr = nhdp_addr_db_get_address(own._addr, 16, AF_INET6);
+    if (addr == NULL) {
+        return -1;
+    }
+    lib_add_if_addr(IF_PID, addr);
+    nhdp_decrement_addr_usage(addr);
+    iib_register_if(IF_PID);
+    return 0;
+}
+
+static void _target(uint8_t *data, size_t len)
+{
+    nhdp_reader_handle_packet(IF_PID, data, len);
+}
+#endif /* PARSER_NHDP */
+
+#ifdef PARSER_GNRC
+#define MSG_QUEUE_SIZE      (8U)
+#define MAX_PACKET_SIZE     (127U)
+
+static const uint8_t _local_l2addr[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+};
+static const uint8_t _remote_l2addr[] = {
+    0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+};
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = MAX_PACKET_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = sizeof(_local_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    memcpy(value, _local_l2addr, sizeof(_local_l2addr));
+    return sizeof(_local_l2addr);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    /* whatever the stack sends in reply is dropped */
+    return iolist_size(iolist);
+}
+
+static int _init_netif(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    netdev_test_set_send_cb(&_dev, _send);
+    _netif = gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                          GNRC_NETIF_PRIO, "fuzz",
+                                          (netdev_t *)&_dev);
+    return (_netif == NULL) ? -1 : 0;
+}
+
+/* the link-layer header of a frame from the remote node */
+static gnrc_pktsnip_t *_netif_hdr(void)
+{
+    struct {
+        gnrc_netif_hdr_t hdr;
+        uint8_t src[8];
+        uint8_t dst[8];
+    } netif_hdr;
+
+    gnrc_netif_hdr_init(&netif_hdr.hdr, sizeof(netif_hdr.src),
+                        sizeof(netif_hdr.dst));
+    memcpy(netif_hdr.src, _remote_l2addr, sizeof(netif_hdr.src));
+    memcpy(netif_hdr.dst, _local_l2addr, sizeof(netif_hdr.dst));
+    netif_hdr.hdr.if_pid = _netif->pid;
+    return gnrc_pktbuf_add(NULL, &netif_hdr, sizeof(netif_hdr),
+                           GNRC_NETTYPE_NETIF);
+}
+
+#if defined(PARSER_IPV6_EXT) || defined(PARSER_RPL)
+/* an IPv6 header from the link-local address of the remote node */
+static void _ipv6_hdr(ipv6_hdr_t *hdr, const ipv6_addr_t *dst, uint8_t nh,
+                      size_t len)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(len);
+    hdr->nh = nh;
+    hdr->hl = 255;
+    ipv6_addr_set_link_local_prefix(&hdr->src);
+    memcpy(&hdr->src.u8[8], _remote_l2addr, sizeof(_remote_l2addr));
+    hdr->src.u8[8] ^= 0x02;
+    hdr->dst = *dst;
+}
+#endif
+#endif /* PARSER_GNRC */
+
+#ifdef PARSER_IPHC
+#define PARSER_NAME         "iphc"
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_reg;
+
+static int _init(void)
+{
+    if (_init_netif() < 0) {
+        return -1;
+    }
+    /* the decompressed packets come to this thread instead of the IPv6
+     * thread */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6,
+                           gnrc_netreg_lookup(GNRC_NETTYPE_IPV6,
+                                              GNRC_NETREG_DEMUX_CTX_ALL));
+    gnrc_netreg_entry_init_pid(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+    return gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+}
+
+static void _target(uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t *pkt, *sixlo;
+    msg_t msg;
+
+    /* the 6LoWPAN thread only passes frames with an IPHC dispatch */
+    if (len == 0) {
+        return;
+    }
+    data[0] = SIXLOWPAN_IPHC1_DISP | (data[0] & ~SIXLOWPAN_IPHC1_DISP_MASK);
+
+    if ((pkt = _netif_hdr()) == NULL) {
+        return;
+    }
+    if ((sixlo = gnrc_pktbuf_add(pkt, data, len,
+                                 GNRC_NETTYPE_SIXLOWPAN)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_sixlowpan_iphc_recv(sixlo, NULL, 0);
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+#endif /* PARSER_IPHC */
+
+#ifdef PARSER_IPV6_EXT
+#define PARSER_NAME         "ipv6_ext"
+
+/* the first byte of an input selects the first extension header */
+static const uint8_t _ext_nh[] = {
+    PROTNUM_IPV6_EXT_HOPOPT, PROTNUM_IPV6_EXT_DST, PROTNUM_IPV6_EXT_RH,
+    PROTNUM_IPV6_EXT_FRAG, PROTNUM_IPV6_EXT_AH, PROTNUM_IPV6_EXT_ESP,
+    PROTNUM_IPV6_EXT_MOB,
+};
+
+static int _init(void)
+{
+    return _init_netif();
+}
+
+static void _target(uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t *pkt, *ipv6;
+
+    if (len == 0) {
+        return;
+    }
+    if ((pkt = _netif_hdr()) == NULL) {
+        return;
+    }
+    if ((ipv6 = gnrc_pktbuf_add(pkt, NULL, sizeof(ipv6_hdr_t) + len - 1,
+                                GNRC_NETTYPE_IPV6)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _ipv6_hdr(ipv6->data, &ipv6_addr_all_nodes_link_local,
+              _ext_nh[data[0] % sizeof(_ext_nh)], len - 1);
+    memcpy((uint8_t *)ipv6->data + sizeof(ipv6_hdr_t), &data[1], len - 1);
+    /* the IPv6 thread has a higher priority, so the packet is processed
+     * before this returns */
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, ipv6)) {
+        gnrc_pktbuf_release(ipv6);
+    }
+}
+#endif /* PARSER_IPV6_EXT */
+
+#ifdef PARSER_RPL
+#define PARSER_NAME         "rpl"
+
+static int _init(void)
+{
+    if (_init_netif() < 0) {
+        return -1;
+    }
+    return (gnrc_rpl_init(_netif->pid) == KERNEL_PID_UNDEF) ? -1 : 0;
+}
+
+static void _target(uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t *pkt, *ipv6, *icmpv6;
+
+    /* the ICMPv6 code selects the control message */
+    if (len < sizeof(icmpv6_hdr_t)) {
+        return;
+    }
+    data[0] = ICMPV6_RPL_CTRL;
+
+    if ((pkt = _netif_hdr()) == NULL) {
+        return;
+    }
+    if ((ipv6 = gnrc_pktbuf_add(pkt, NULL, sizeof(ipv6_hdr_t),
+                                GNRC_NETTYPE_IPV6)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _ipv6_hdr(ipv6->data, &ipv6_addr_all_rpl_nodes, PROTNUM_ICMPV6, len);
+    if ((icmpv6 = gnrc_pktbuf_add(ipv6, data, len,
+                                  GNRC_NETTYPE_ICMPV6)) == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return;
+    }
+    /* like the ICMPv6 demultiplexer, the RPL thread has a higher priority
+     * and processes the message before this returns */
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_ICMPV6, ICMPV6_RPL_CTRL,
+                                      icmpv6)) {
+        gnrc_pktbuf_release(icmpv6);
+    }
+}
+#endif /* PARSER_RPL */
+
+#ifndef PARSER_NAME
+#error "unknown PARSER, see the Makefile"
+#endif
+
+int main(void)
+{
+    puts("fuzz target: " PARSER_NAME);
+
+    if (_init() < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    native_fuzzing_run(_target);
+}
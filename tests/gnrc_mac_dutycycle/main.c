@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Simulation of the adaptive duty cycle of a receiver with
+ *              several senders and time-varying traffic
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/mac/dutycycle.h"
+
+#define BASE_US         (200000U)   /* base wake-up period */
+#define EXP_MAX         (2U)
+#define LATENCY_US      (50000U)
+#define LISTEN_US       (10000U)    /* listening per wake-up */
+#define FRAME_US        (4000U)     /* WR, WA, data and ACK of a frame */
+#define SENDERS_NUMOF   (3U)
+#define QUEUE_SIZE      (8U)
+#define PHASE_US        (10000000U)
+#define PHASES_NUMOF    (4U)
+
+typedef struct {
+    uint32_t queue[QUEUE_SIZE];     /* arrival times */
+    unsigned head;
+    unsigned numof;
+    uint32_t next;                  /* next arrival */
+} sender_t;
+
+typedef struct {
+    uint64_t latency_us;
+    uint64_t on_us;
+    uint32_t latency_max_us;
+    unsigned frames;
+    unsigned drops;
+    uint8_t exp_max;
+    uint8_t exp_end;
+} result_t;
+
+/* frames per 10 s per sender */
+static const unsigned _rates[PHASES_NUMOF] = { 2, 150, 20, 0 };
+static const char *_names[PHASES_NUMOF] = {
+    "light", "burst", "steady", "idle"
+};
+
+static sender_t _senders[SENDERS_NUMOF];
+static gnrc_mac_dutycycle_t _dc;
+static uint32_t _rnd;
+
+static uint32_t _random(uint32_t max)
+{
+    _rnd = (_rnd * 1103515245) + 12345;
+    return (_rnd >> 8) % max;
+}
+
+static uint32_t _next_arrival(uint32_t last)
+{
+    unsigned phase = last / PHASE_US;
+
+    while ((phase < PHASES_NUMOF) && (_rates[phase] == 0)) {
+        last = ++phase * PHASE_US;
+    }
+    if (phase >= PHASES_NUMOF) {
+        return UINT32_MAX;
+    }
+    return last + 1 + _random(2 * (PHASE_US / _rates[phase]));
+}
+
+static void _arrivals(uint32_t now, result_t *res)
+{
+    for (unsigned i = 0; i < SENDERS_NUMOF; i++) {
+        sender_t *s = &_senders[i];
+
+        while (s->next <= now) {
+            unsigned phase = s->next / PHASE_US;
+
+            if (s->numof < QUEUE_SIZE) {
+                s->queue[(s->head + s->numof) % QUEUE_SIZE] = s->next;
+                s->numof++;
+            }
+            else {
+                res[phase].drops++;
+            }
+            s->next = _next_arrival(s->next);
+        }
+    }
+}
+
+static void _run(uint8_t exp_max, result_t *res)
+{
+    uint32_t now = 0;
+
+    _rnd = 1;
+    memset(res, 0, PHASES_NUMOF * sizeof(*res));
+    memset(_senders, 0, sizeof(_senders));
+    for (unsigned i = 0; i < SENDERS_NUMOF; i++) {
+        _senders[i].next = _next_arrival(0);
+    }
+    gnrc_mac_dutycycle_init(&_dc, now, BASE_US, exp_max, LATENCY_US);
+    while (now < (PHASES_NUMOF * PHASE_US)) {
+        unsigned phase = now / PHASE_US;
+        uint32_t on = now;
+        uint8_t exp;
+
+        /* same order as LWMAC: adapt on wake-up, then listen */
+        exp = gnrc_mac_dutycycle_wakeup(&_dc, now);
+        if (exp > res[phase].exp_max) {
+            res[phase].exp_max = exp;
+        }
+        res[phase].exp_end = exp;
+        gnrc_mac_dutycycle_radio(&_dc, now, true);
+        _arrivals(now, res);
+        /* every sender with frames catches the wake-up and sends one frame,
+         * with the pending bit if it has more */
+        for (unsigned i = 0; i < SENDERS_NUMOF; i++) {
+            sender_t *s = &_senders[i];
+            uint32_t latency;
+
+            if (s->numof == 0) {
+                continue;
+            }
+            on += FRAME_US;
+            latency = on - s->queue[s->head];
+            s->head = (s->head + 1) % QUEUE_SIZE;
+            s->numof--;
+            gnrc_mac_dutycycle_rx(&_dc, s->numof > 0);
+            res[phase].frames++;
+            res[phase].latency_us += latency;
+            if (latency > res[phase].latency_max_us) {
+                res[phase].latency_max_us = latency;
+            }
+        }
+        on += LISTEN_US;
+        gnrc_mac_dutycycle_radio(&_dc, on, false);
+        res[phase].on_us += on - now;
+        now += gnrc_mac_dutycycle_period(&_dc);
+    }
+}
+
+static void _print(const char *name, unsigned phase, const result_t *res)
+{
+    unsigned dc = (unsigned)((res->on_us * 1000) / PHASE_US);
+    unsigned latency = (res->frames > 0)
+                     ? (unsigned)(res->latency_us / res->frames / 1000)
+                     : 0;
+
+    printf("%s %s: frames %u drops %u duty cycle %u.%u%% "
+           "latency %u ms (max %u ms) exp %u..%u\n",
+           name, _names[phase], res->frames, res->drops, dc / 10, dc % 10,
+           latency, (unsigned)(res->latency_max_us / 1000),
+           res->exp_max, res->exp_end);
+}
+
+int main(void)
+{
+    static result_t fixed[PHASES_NUMOF], adaptive[PHASES_NUMOF];
+    gnrc_mac_dutycycle_stats_t stats;
+
+    puts("Adaptive duty cycle simulation");
+    printf("%u senders, base period %u ms, latency target %u ms\n",
+           SENDERS_NUMOF, BASE_US / 1000, LATENCY_US / 1000);
+    _run(0, fixed);
+    _run(EXP_MAX, adaptive);
+    for (unsigned i = 0; i < PHASES_NUMOF; i++) {
+        _print("fixed", i, &fixed[i]);
+        _print("adaptive", i, &adaptive[i]);
+    }
+    gnrc_mac_dutycycle_get_stats(&_dc, PHASES_NUMOF * PHASE_US, &stats);
+    printf("stats: period %u ms duty cycle %u.%u%% energy %u mJ\n",
+           (unsigned)(stats.period_us / 1000),
+           stats.duty_cycle / 10, stats.duty_cycle % 10,
+           (unsigned)(stats.energy_uj / 1000));
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+EXP_MAX = 2
+RESULT = (r'{} {}: frames (\d+) drops (\d+) duty cycle (\d+)\.\d% '
+          r'latency (\d+) ms \(max \d+ ms\) exp (\d+)\.\.(\d+)')
+
+
+def _result(child, run, phase):
+    child.expect(RESULT.format(run, phase))
+    return {key: int(child.match.group(i + 1))
+            for i, key in enumerate(('frames', 'drops', 'dc', 'latency',
+                                     'exp_max', 'exp_end'))}
+
+
+def testfunc(child):
+    child.expect_exact('Adaptive duty cycle simulation')
+    res = {}
+    for phase in ('light', 'burst', 'steady', 'idle'):
+        res[phase] = (_result(child, 'fixed', phase),
+                      _result(child, 'adaptive', phase))
+    fixed, adaptive = res['burst']
+    # the receiver wakes up faster under load, so senders keep up and wait
+    # less
+    assert adaptive['exp_max'] == EXP_MAX
+    assert adaptive['drops'] < fixed['drops']
+    assert adaptive['latency'] < fixed['latency']
+    fixed, adaptive = res['idle']
+    # and falls back to the base period without traffic
+    assert adaptive['exp_end'] == 0
+    assert adaptive['dc'] <= fixed['dc'] + 1
+    child.expect(r'stats: period (\d+) ms duty cycle \d+\.\d% energy \d+ mJ')
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTTOOLS'], 'testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the slotframe MAC
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "shell.h"
+#include "shell_commands.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+
+#define FRAME_SIZE      (32U)
+#define SINK_QUEUE_SIZE (8U)
+
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _sink_queue[SINK_QUEUE_SIZE];
+static unsigned _received;
+static uint32_t _first, _last;
+
+static void *_sink(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_sink_queue, SINK_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            uint32_t now = xtimer_now_usec();
+
+            if (_received++ == 0) {
+                _first = now;
+            }
+            _last = now;
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+    return NULL;
+}
+
+static int _flood(int argc, char **argv)
+{
+    uint8_t addr[GNRC_NETIF_L2ADDR_MAXLEN];
+    uint8_t payload[FRAME_SIZE];
+    size_t addr_len;
+    kernel_pid_t iface;
+    unsigned count, interval;
+
+    if (argc < 5) {
+        printf("usage: %s <if> <L2 addr> <count> <interval in ms>\n", argv[0]);
+        return 1;
+    }
+    iface = atoi(argv[1]);
+    addr_len = gnrc_netif_addr_from_str(argv[2], addr);
+    count = atoi(argv[3]);
+    interval = atoi(argv[4]);
+    if ((gnrc_netif_get_by_pid(iface) == NULL) || (addr_len == 0)) {
+        puts("error: invalid interface or address given");
+        return 1;
+    }
+    memset(payload, 0x55, sizeof(payload));
+    for (unsigned i = 0; i < count; i++) {
+        gnrc_pktsnip_t *pkt, *hdr;
+
+        pkt = gnrc_pktbuf_add(NULL, payload, sizeof(payload),
+                              GNRC_NETTYPE_UNDEF);
+        hdr = gnrc_netif_hdr_build(NULL, 0, addr, addr_len);
+        if ((pkt == NULL) || (hdr == NULL)) {
+            puts("error: packet buffer full");
+            gnrc_pktbuf_release(pkt);
+            return 1;
+        }
+        LL_PREPEND(pkt, hdr);
+        if (gnrc_netapi_send(iface, pkt) < 1) {
+            puts("error: unable to send");
+            gnrc_pktbuf_release(pkt);
+            return 1;
+        }
+        xtimer_usleep(interval * US_PER_MS);
+    }
+    printf("sent %u frames\n", count);
+    return 0;
+}
+
+static int _count(int argc, char **argv)
+{
+    uint32_t duration = _last - _first;
+
+    (void)argc;
+    (void)argv;
+    printf("received %u frames in %u ms", _received,
+           (unsigned)(duration / US_PER_MS));
+    if (duration > 0) {
+        printf(" (%u frames/s)",
+               (unsigned)((uint64_t)(_received - 1) * US_PER_SEC / duration));
+    }
+    puts("");
+    _received = 0;
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "flood", "sends frames to a neighbor", _flood },
+    { "count", "prints and resets the received frames", _count },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    static gnrc_netreg_entry_t sink;
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    kernel_pid_t pid;
+
+    puts("Slotframe MAC test application");
+    pid = thread_create(_sink_stack, sizeof(_sink_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _sink, NULL, "sink");
+    gnrc_netreg_entry_init_pid(&sink, GNRC_NETREG_DEMUX_CTX_ALL, pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &sink);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
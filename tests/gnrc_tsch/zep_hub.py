@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Broadcast hub for native instances using socket_zep.
+
+Every datagram is forwarded to all other peers, i.e. the given ports and all
+nodes that have sent to the hub.
+Frames on the same channel that arrive within the collision window are all
+dropped, so that nodes sharing a channel interfere like they would over the
+air.
+"""
+
+import argparse
+import select
+import socket
+import time
+
+ZEP_CHAN_OFFSET = 4
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--port", type=int, default=17754,
+                        help="UDP port to listen on")
+    parser.add_argument("--window", type=float, default=2.0,
+                        help="collision window in ms, 0 disables collisions")
+    parser.add_argument("peers", type=int, nargs="*",
+                        help="ZEP ports of the nodes on ::1")
+    args = parser.parse_args()
+
+    window = args.window / 1000
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    sock.bind(("::1", args.port))
+    peers = set(("::1", port, 0, 0) for port in args.peers)
+    pending = {}        # channel -> [deadline, sender, data, collided]
+    forwarded = collided = 0
+
+    try:
+        while True:
+            timeout = None
+            if pending:
+                timeout = max(0, min(p[0] for p in pending.values()) -
+                              time.monotonic())
+            if select.select([sock], [], [], timeout)[0]:
+                data, addr = sock.recvfrom(2048)
+                peers.add(addr)
+                if len(data) <= ZEP_CHAN_OFFSET:
+                    continue
+                chan = data[ZEP_CHAN_OFFSET]
+                if window == 0:
+                    pending[chan] = [0, addr, data, False]
+                elif chan in pending:
+                    pending[chan][3] = True
+                else:
+                    pending[chan] = [time.monotonic() + window, addr, data,
+                                     False]
+            now = time.monotonic()
+            for chan in [c for c, p in pending.items() if p[0] <= now]:
+                _, sender, data, collision = pending.pop(chan)
+                if collision:
+                    collided += 1
+                    continue
+                forwarded += 1
+                for peer in peers - {sender}:
+                    sock.sendto(data, peer)
+    except KeyboardInterrupt:
+        print("forwarded: {}, collided: {}".format(forwarded, collided))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the latency of periph_timer callbacks
+ *
+ * @}
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "mutex.h"
+#include "periph/timer.h"
+
+#ifndef TIM_DEV
+#define TIM_DEV         (TIMER_DEV(0))
+#endif
+
+#ifndef TIMER_CHANNELS
+#define TIMER_CHANNELS  (1U)
+#endif
+
+/**
+ * @brief   Rounds per offset, all channels are set in each round
+ */
+#ifndef ROUNDS
+#define ROUNDS          (200U)
+#endif
+
+/**
+ * @brief   Latencies of up to HIST_SIZE - 1 ticks are counted in the
+ *          histogram, later ones in its last bucket
+ */
+#define HIST_SIZE       (1024U)
+
+static const unsigned _offsets[] = { 10, 20, 50, 100, 200, 500, 1000, 5000 };
+
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static volatile unsigned _pending;
+static unsigned _target[TIMER_CHANNELS];
+static uint32_t _hist[HIST_SIZE];
+static unsigned _early;
+static unsigned _min, _max, _count;
+static uint64_t _sum;
+
+static void _cb(void *arg, int chan)
+{
+    int32_t latency = (int32_t)(timer_read(TIM_DEV) - _target[chan]);
+
+    (void)arg;
+    if (latency < 0) {
+        _early++;
+        latency = 0;
+    }
+    if ((unsigned)latency < _min) {
+        _min = latency;
+    }
+    if ((unsigned)latency > _max) {
+        _max = latency;
+    }
+    _sum += latency;
+    _count++;
+    _hist[((unsigned)latency < HIST_SIZE) ? (unsigned)latency : HIST_SIZE - 1]++;
+    if (--_pending == 0) {
+        mutex_unlock(&_done);
+    }
+}
+
+static unsigned _percentile(unsigned permille)
+{
+    uint32_t needed = ((uint64_t)_count * permille + 999) / 1000;
+    uint32_t seen = 0;
+
+    for (unsigned i = 0; i < HIST_SIZE; i++) {
+        seen += _hist[i];
+        if (seen >= needed) {
+            return i;
+        }
+    }
+    return HIST_SIZE - 1;
+}
+
+static void _measure(unsigned offset)
+{
+    _min = UINT_MAX;
+    _max = 0;
+    _sum = 0;
+    _count = 0;
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        /* the channels fire one after another, spread over one offset */
+        _pending = TIMER_CHANNELS;
+        for (unsigned chan = 0; chan < TIMER_CHANNELS; chan++) {
+            unsigned chan_offset = offset + ((offset * chan) / TIMER_CHANNELS);
+
+            /* relative, so short offsets can not be passed before they are
+             * set */
+            _target[chan] = timer_read(TIM_DEV) + chan_offset;
+            timer_set(TIM_DEV, chan, chan_offset);
+        }
+        mutex_lock(&_done);
+    }
+    printf("offset %5u: min %4u avg %4u max %6u ticks\n", offset, _min,
+           (unsigned)(_sum / _count), _max);
+}
+
+int main(void)
+{
+    uint32_t total = 0;
+
+    puts("periph_timer jitter test");
+    if (timer_init(TIM_DEV, TIMER_SPEED, _cb, NULL) < 0) {
+        puts("error: timer_init() failed");
+        return 1;
+    }
+    printf("Running %u rounds on %u channels\n", ROUNDS,
+           (unsigned)TIMER_CHANNELS);
+
+    for (unsigned i = 0; i < sizeof(_offsets) / sizeof(_offsets[0]); i++) {
+        _measure(_offsets[i]);
+        total += _count;
+    }
+    _count = total;
+    printf("early: %u\n", _early);
+    printf("p50: %u p99: %u p999: %u ticks\n", _percentile(500),
+           _percentile(990), _percentile(999));
+    puts("DONE");
+    return 0;
+}
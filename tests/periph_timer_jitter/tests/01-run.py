@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+from testrunner import run
+
+
+JITTER_LIMIT = int(os.environ.get('JITTER_LIMIT', 100))
+
+
+def testfunc(child):
+    child.expect(r'Running (\d+) rounds on (\d+) channels')
+    child.expect(r'early: (\d+)')
+    early = int(child.match.group(1))
+    child.expect(r'p50: (\d+) p99: (\d+) p999: (\d+) ticks')
+    p99 = int(child.match.group(2))
+    child.expect_exact('DONE')
+    if early > 0:
+        print('{} callbacks fired before their target'.format(early))
+        sys.exit(1)
+    if p99 > JITTER_LIMIT:
+        print('99th percentile of {} ticks exceeds the limit of {} ticks'
+              .format(p99, JITTER_LIMIT))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the thread statistics
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "threadstat.h"
+#include "xtimer.h"
+
+#define ROUNDS      (20U)
+#define LOAD        (10000U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+        volatile uint8_t buf[128];
+
+        msg_receive(&msg);
+        /* some CPU time and stack usage to account */
+        for (unsigned i = 0; i < LOAD; i++) {
+            buf[i % sizeof(buf)] = i;
+        }
+    }
+    return NULL;
+}
+
+static void _print(kernel_pid_t pid, const threadstat_t *stat)
+{
+    uint64_t latency = stat->wakeups ? stat->latency_sum / stat->wakeups : 0;
+
+    printf("pid %2d: runtime %8" PRIu32 " us, %4" PRIu32 " switches, "
+           "%4" PRIu32 " wake-ups, latency %5" PRIu32 "/%5" PRIu32 " us, "
+           "stack %5" PRIu32 "/%5" PRIu32 "\n", pid,
+           (uint32_t)threadstat_usec(stat->runtime), stat->switches,
+           stat->wakeups, (uint32_t)threadstat_usec(latency),
+           (uint32_t)threadstat_usec(stat->latency_max), stat->stack_used,
+           stat->stack_size);
+}
+
+int main(void)
+{
+    threadstat_t stat;
+    threadstat_isr_t isr;
+    kernel_pid_t worker;
+    uint64_t start;
+    int res = 0;
+
+    worker = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                           THREAD_CREATE_STACKTEST, _worker, NULL, "worker");
+
+    threadstat_reset();
+    start = threadstat_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        msg_t msg;
+
+        xtimer_usleep(10 * US_PER_MS);
+        msg_send(&msg, worker);
+    }
+    printf("%" PRIu32 " us at %" PRIu32 " Hz\n",
+           (uint32_t)threadstat_usec(threadstat_now() - start),
+           threadstat_hz());
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        if (threadstat_get(pid, &stat) == 0) {
+            _print(pid, &stat);
+        }
+    }
+    threadstat_get_isr(&isr);
+    printf("isr:    runtime %8" PRIu32 " us, %4" PRIu32 " interrupts, "
+           "max %5" PRIu32 " us\n", (uint32_t)threadstat_usec(isr.runtime),
+           isr.count, (uint32_t)threadstat_usec(isr.max));
+
+    threadstat_get(worker, &stat);
+    if (stat.wakeups != ROUNDS) {
+        puts("error: wrong number of wake-ups");
+        res = 1;
+    }
+    if (stat.runtime == 0) {
+        puts("error: no time accounted");
+        res = 1;
+    }
+    if ((stat.stack_used < sizeof(uint8_t[128])) ||
+        (stat.stack_used >= stat.stack_size)) {
+        puts("error: wrong stack usage");
+        res = 1;
+    }
+    if (threadstat_get(KERNEL_PID_LAST, &stat) != -ENOENT) {
+        puts("error: statistics of a thread that does not exist");
+        res = 1;
+    }
+    puts(res ? "FAILURE" : "SUCCESS");
+    return res;
+}
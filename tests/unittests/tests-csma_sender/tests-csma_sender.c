@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/csma_sender.h"
+
+#include "tests-csma_sender.h"
+
+#define FRAMES_NUMOF    (CSMA_SENDER_QUEUE_SIZE + 1)
+
+static const csma_sender_conf_t _conf = {
+    .min_be = 1,
+    .max_be = 2,
+    .max_backoffs = 2,
+    .backoff_period = 100,
+};
+
+static netdev_t _dev;
+static csma_sender_t _csma;
+static iolist_t _frames[FRAMES_NUMOF];
+static const iolist_t *_sent[FRAMES_NUMOF];
+static unsigned _sent_numof;
+static const iolist_t *_done[FRAMES_NUMOF];
+static int _done_res[FRAMES_NUMOF];
+static unsigned _done_burst[FRAMES_NUMOF];
+static unsigned _done_numof;
+static unsigned _busy;      /* number of CCAs that find the channel busy */
+static bool _hw_csma;
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _sent[_sent_numof++] = iolist;
+    return 0;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    switch (opt) {
+        case NETOPT_CSMA:
+            *((netopt_enable_t *)value) = (_hw_csma) ? NETOPT_ENABLE
+                                                     : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        case NETOPT_IS_CHANNEL_CLR:
+            *((netopt_enable_t *)value) = (_busy > 0) ? NETOPT_DISABLE
+                                                      : NETOPT_ENABLE;
+            if (_busy > 0) {
+                _busy--;
+            }
+            return sizeof(netopt_enable_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .get = _get,
+};
+
+static void _cb(csma_sender_t *csma, iolist_t *iolist, int res)
+{
+    TEST_ASSERT(csma == &_csma);
+    _done[_done_numof] = iolist;
+    _done_burst[_done_numof] = csma->burst;
+    _done_res[_done_numof++] = res;
+}
+
+static void set_up(void)
+{
+    memset(_sent, 0, sizeof(_sent));
+    memset(_done, 0, sizeof(_done));
+    _sent_numof = 0;
+    _done_numof = 0;
+    _busy = 0;
+    _hw_csma = false;
+    _dev.driver = &_driver;
+    csma_sender_init(&_csma, &_dev, &_conf, _cb);
+}
+
+/* handles backoff timer messages until numof frames are done */
+static void _run(unsigned numof)
+{
+    while (_done_numof < numof) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        TEST_ASSERT_EQUAL_INT(CSMA_SENDER_MSG_TYPE_BACKOFF, msg.type);
+        csma_sender_handle_msg(&msg);
+    }
+}
+
+static void test_csma_sender_queue__burst(void)
+{
+    for (unsigned i = 0; i < CSMA_SENDER_BURST_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[i]));
+    }
+    /* nothing is sent before the backoff */
+    TEST_ASSERT_EQUAL_INT(0, _sent_numof);
+    _run(CSMA_SENDER_BURST_MAX);
+    TEST_ASSERT_EQUAL_INT(CSMA_SENDER_BURST_MAX, _sent_numof);
+    for (unsigned i = 0; i < CSMA_SENDER_BURST_MAX; i++) {
+        TEST_ASSERT(_sent[i] == &_frames[i]);
+        TEST_ASSERT(_done[i] == &_frames[i]);
+        TEST_ASSERT_EQUAL_INT(0, _done_res[i]);
+        TEST_ASSERT_EQUAL_INT(i, _done_burst[i]);
+    }
+    /* all after one CCA */
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.cca);
+    TEST_ASSERT_EQUAL_INT(0, _csma.stats.cca_busy);
+    TEST_ASSERT_EQUAL_INT(CSMA_SENDER_BURST_MAX, _csma.stats.tx);
+    TEST_ASSERT_EQUAL_INT(CSMA_SENDER_BURST_MAX - 1, _csma.stats.tx_burst);
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.busy[0]);
+}
+
+static void test_csma_sender_queue__busy(void)
+{
+    _busy = _conf.max_backoffs;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[0]));
+    _run(1);
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _done_res[0]);
+    TEST_ASSERT_EQUAL_INT(_conf.max_backoffs + 1, _csma.stats.cca);
+    TEST_ASSERT_EQUAL_INT(_conf.max_backoffs, _csma.stats.cca_busy);
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.busy[_conf.max_backoffs]);
+}
+
+static void test_csma_sender_queue__fail(void)
+{
+    _busy = _conf.max_backoffs + 1;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[0]));
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[1]));
+    _run(2);
+    /* the first frame is dropped, the second gets its own channel access */
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT(_sent[0] == &_frames[1]);
+    TEST_ASSERT(_done[0] == &_frames[0]);
+    TEST_ASSERT_EQUAL_INT(-EBUSY, _done_res[0]);
+    TEST_ASSERT_EQUAL_INT(0, _done_res[1]);
+    TEST_ASSERT_EQUAL_INT(0, _done_burst[1]);
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.tx_failed);
+    TEST_ASSERT_EQUAL_INT(0, _csma.stats.tx_burst);
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.busy[0]);
+}
+
+static void test_csma_sender_queue__full(void)
+{
+    for (unsigned i = 0; i < CSMA_SENDER_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          csma_sender_queue(&_csma,
+                                            &_frames[CSMA_SENDER_QUEUE_SIZE]));
+    TEST_ASSERT_EQUAL_INT(1, _csma.stats.queue_full);
+    _run(CSMA_SENDER_QUEUE_SIZE);
+    TEST_ASSERT_EQUAL_INT(CSMA_SENDER_QUEUE_SIZE, _sent_numof);
+}
+
+static void test_csma_sender_queue__hw_csma(void)
+{
+    _hw_csma = true;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_queue(&_csma, &_frames[0]));
+    /* sent right away */
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(1, _done_numof);
+    TEST_ASSERT_EQUAL_INT(0, _csma.stats.cca);
+}
+
+static Test *tests_csma_sender_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_csma_sender_queue__burst),
+        new_TestFixture(test_csma_sender_queue__busy),
+        new_TestFixture(test_csma_sender_queue__fail),
+        new_TestFixture(test_csma_sender_queue__full),
+        new_TestFixture(test_csma_sender_queue__hw_csma),
+    };
+
+    EMB_UNIT_TESTCALLER(csma_sender_tests, set_up, NULL, fixtures);
+
+    return (Test *)&csma_sender_tests;
+}
+
+void tests_csma_sender(void)
+{
+    TESTS_RUN(tests_csma_sender_tests());
+}
+/** @} */
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mutex.h"
+#include "net/netdev.h"
+#include "net/gnrc/pktcap.h"
+
+#include "tests-gnrc_pktcap.h"
+
+#define IFACE_PID       (5)
+#define IFACE_NAME      "if5"
+#define SINK_SIZE       (4 * GNRC_PKTCAP_BUF_SIZE)
+
+/* three records of this size do not fit into the ring and two leave no room
+ * for a third one at its end, so every third record wraps around */
+#define WRAP_LEN        (GNRC_PKTCAP_BUF_SIZE * 3 / 8)
+#define WRAP_NUMOF      (5U)
+#define FULL_NUMOF      (8U)
+
+#define PCAPNG_SHB      (0x0A0D0D0AU)
+#define PCAPNG_IDB      (0x00000001U)
+#define PCAPNG_EPB      (0x00000006U)
+#define PCAPNG_BOM      (0x1A2B3C4DU)
+#define LINKTYPE_IEEE802_15_4_NOFCS (230U)
+#define EPB_INBOUND     (0x1U)
+#define EPB_OUTBOUND    (0x2U)
+
+#define ALIGN4(x)       (((x) + 3U) & ~3U)
+
+static uint8_t _sink_buf[SINK_SIZE];
+static size_t _sink_len;
+static unsigned _sink_closed;
+/* locked by a test to stop the writer in the sink */
+static mutex_t _sink_block = MUTEX_INIT;
+static gnrc_netif_t _netif;
+static uint8_t _frame[GNRC_PKTCAP_SNAPLEN + 16];
+
+static ssize_t _sink_write(void *arg, const void *data, size_t len)
+{
+    (void)arg;
+    mutex_lock(&_sink_block);
+    mutex_unlock(&_sink_block);
+    if ((_sink_len + len) > sizeof(_sink_buf)) {
+        return -ENOSPC;
+    }
+    memcpy(&_sink_buf[_sink_len], data, len);
+    _sink_len += len;
+    return len;
+}
+
+static void _sink_close(void *arg)
+{
+    (void)arg;
+    _sink_closed++;
+}
+
+static const gnrc_pktcap_sink_t _sink = {
+    .write = _sink_write,
+    .close = _sink_close,
+};
+
+static void set_up(void)
+{
+    memset(_sink_buf, 0, sizeof(_sink_buf));
+    _sink_len = 0;
+    _sink_closed = 0;
+    _netif.pid = IFACE_PID;
+    _netif.device_type = NETDEV_TYPE_IEEE802154;
+    gnrc_pktcap_init();
+}
+
+static uint32_t _u32(size_t off)
+{
+    uint32_t val;
+
+    memcpy(&val, &_sink_buf[off], sizeof(val));
+    return val;
+}
+
+static uint16_t _u16(size_t off)
+{
+    uint16_t val;
+
+    memcpy(&val, &_sink_buf[off], sizeof(val));
+    return val;
+}
+
+/* checks the section header and the description of the interface, sets off
+ * to the first EPB */
+static void _check_header(size_t *off)
+{
+    uint32_t len = 16 + 4 + ALIGN4(sizeof(IFACE_NAME) - 1) + 4 + 4;
+
+    *off = 28;
+    TEST_ASSERT((*off + len) <= _sink_len);
+    TEST_ASSERT_EQUAL_INT(PCAPNG_SHB, _u32(0));
+    TEST_ASSERT_EQUAL_INT(28, _u32(4));
+    TEST_ASSERT_EQUAL_INT(PCAPNG_BOM, _u32(8));
+    TEST_ASSERT_EQUAL_INT(1, _u16(12));
+    TEST_ASSERT_EQUAL_INT(0, _u16(14));
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, _u32(16));
+    TEST_ASSERT_EQUAL_INT(UINT32_MAX, _u32(20));
+    TEST_ASSERT_EQUAL_INT(28, _u32(24));
+
+    TEST_ASSERT_EQUAL_INT(PCAPNG_IDB, _u32(*off));
+    TEST_ASSERT_EQUAL_INT(len, _u32(*off + 4));
+    TEST_ASSERT_EQUAL_INT(LINKTYPE_IEEE802_15_4_NOFCS, _u16(*off + 8));
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTCAP_SNAPLEN, _u32(*off + 12));
+    TEST_ASSERT_EQUAL_INT(2, _u16(*off + 16));      /* if_name */
+    TEST_ASSERT_EQUAL_INT(sizeof(IFACE_NAME) - 1, _u16(*off + 18));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_sink_buf[*off + 20], IFACE_NAME,
+                                    sizeof(IFACE_NAME) - 1));
+    TEST_ASSERT_EQUAL_INT(0, _u32(*off + len - 8)); /* opt_endofopt */
+    TEST_ASSERT_EQUAL_INT(len, _u32(*off + len - 4));
+    *off += len;
+}
+
+/* checks an EPB of interface 0 at off, sets off to the next block */
+static void _check_epb(size_t *off, const uint8_t *data, size_t caplen,
+                       size_t len, uint32_t flags)
+{
+    uint32_t blen = 28 + ALIGN4(caplen) + 8 + 4 + 4;
+    size_t opt = *off + 28 + ALIGN4(caplen);
+
+    TEST_ASSERT((*off + blen) <= _sink_len);
+    TEST_ASSERT_EQUAL_INT(PCAPNG_EPB, _u32(*off));
+    TEST_ASSERT_EQUAL_INT(blen, _u32(*off + 4));
+    TEST_ASSERT_EQUAL_INT(0, _u32(*off + 8));
+    TEST_ASSERT_EQUAL_INT(caplen, _u32(*off + 20));
+    TEST_ASSERT_EQUAL_INT(len, _u32(*off + 24));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_sink_buf[*off + 28], data, caplen));
+    TEST_ASSERT_EQUAL_INT(2, _u16(opt));            /* epb_flags */
+    TEST_ASSERT_EQUAL_INT(4, _u16(opt + 2));
+    TEST_ASSERT_EQUAL_INT(flags, _u32(opt + 4));
+    TEST_ASSERT_EQUAL_INT(0, _u32(opt + 8));        /* opt_endofopt */
+    TEST_ASSERT_EQUAL_INT(blen, _u32(opt + 12));
+    *off += blen;
+}
+
+static void _fill(size_t len, uint8_t val)
+{
+    for (size_t i = 0; i < len; i++) {
+        _frame[i] = val + i;
+    }
+}
+
+static void test_gnrc_pktcap_start__already(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktcap_start(&_sink));
+    TEST_ASSERT(gnrc_pktcap_running());
+    TEST_ASSERT_EQUAL_INT(-EALREADY, gnrc_pktcap_start(&_sink));
+    gnrc_pktcap_stop();
+    TEST_ASSERT(!gnrc_pktcap_running());
+    TEST_ASSERT_EQUAL_INT(1, _sink_closed);
+    /* only the section header */
+    TEST_ASSERT_EQUAL_INT(28, _sink_len);
+}
+
+static void test_gnrc_pktcap_rx_tx(void)
+{
+    static const uint8_t rx[] = { 0x41, 0xd8, 0x01, 0xff, 0xff };
+    static const uint8_t tx[] = { 0x41, 0xcc, 0x02, 0x23, 0x00, 0xaa, 0xbb };
+    iolist_t tx2 = { NULL, (void *)&tx[5], 2 };
+    iolist_t tx1 = { &tx2, (void *)&tx[3], 2 };
+    iolist_t tx0 = { &tx1, (void *)&tx[0], 3 };
+    gnrc_pktcap_stats_t stats;
+    size_t off;
+
+    /* nothing is captured before the start */
+    gnrc_pktcap_rx(&_netif, rx, sizeof(rx));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktcap_start(&_sink));
+    gnrc_pktcap_rx(&_netif, rx, sizeof(rx));
+    gnrc_pktcap_tx(&_netif, &tx0);
+    gnrc_pktcap_stop();
+    gnrc_pktcap_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.frames);
+    TEST_ASSERT_EQUAL_INT(0, stats.dropped);
+    TEST_ASSERT_EQUAL_INT(_sink_len, stats.bytes);
+
+    _check_header(&off);
+    _check_epb(&off, rx, sizeof(rx), sizeof(rx), EPB_INBOUND);
+    _check_epb(&off, tx, sizeof(tx), sizeof(tx), EPB_OUTBOUND);
+    TEST_ASSERT_EQUAL_INT(_sink_len, off);
+}
+
+static void test_gnrc_pktcap_rx__snaplen(void)
+{
+    size_t off;
+
+    _fill(sizeof(_frame), 0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktcap_start(&_sink));
+    gnrc_pktcap_rx(&_netif, _frame, sizeof(_frame));
+    gnrc_pktcap_stop();
+
+    _check_header(&off);
+    _check_epb(&off, _frame, GNRC_PKTCAP_SNAPLEN, sizeof(_frame),
+               EPB_INBOUND);
+    TEST_ASSERT_EQUAL_INT(_sink_len, off);
+}
+
+static void test_gnrc_pktcap_rx__wrap(void)
+{
+    gnrc_pktcap_stats_t stats;
+    size_t off;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktcap_start(&_sink));
+    for (unsigned i = 0; i < WRAP_NUMOF; i++) {
+        _fill(WRAP_LEN, i);
+        gnrc_pktcap_rx(&_netif, _frame, WRAP_LEN);
+    }
+    gnrc_pktcap_stop();
+    gnrc_pktcap_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(WRAP_NUMOF, stats.frames);
+    TEST_ASSERT_EQUAL_INT(0, stats.dropped);
+
+    /* the pad records in front of the wrapped ones are not written */
+    _check_header(&off);
+    for (unsigned i = 0; i < WRAP_NUMOF; i++) {
+        _fill(WRAP_LEN, i);
+        _check_epb(&off, _frame, WRAP_LEN, WRAP_LEN, EPB_INBOUND);
+    }
+    TEST_ASSERT_EQUAL_INT(_sink_len, off);
+}
+
+static void test_gnrc_pktcap_rx__full(void)
+{
+    gnrc_pktcap_stats_t stats;
+    size_t off;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktcap_start(&_sink));
+    /* the writer blocks in the sink with the first frame */
+    mutex_lock(&_sink_block);
+    for (unsigned i = 0; i < FULL_NUMOF; i++) {
+        _fill(WRAP_LEN, i);
+        gnrc_pktcap_rx(&_netif, _frame, WRAP_LEN);
+    }
+    gnrc_pktcap_get_stats(&stats);
+    TEST_ASSERT(stats.dropped > 0);
+    TEST_ASSERT(stats.dropped < FULL_NUMOF);
+    mutex_unlock(&_sink_block);
+    gnrc_pktcap_stop();
+    gnrc_pktcap_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(FULL_NUMOF, stats.frames + stats.dropped);
+
+    /* the frames that made it into the ring are written in order */
+    _check_header(&off);
+    for (unsigned i = 0; i < stats.frames; i++) {
+        _fill(WRAP_LEN, i);
+        _check_epb(&off, _frame, WRAP_LEN, WRAP_LEN, EPB_INBOUND);
+    }
+    TEST_ASSERT_EQUAL_INT(_sink_len, off);
+}
+
+static Test *tests_gnrc_pktcap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_pktcap_start__already),
+        new_TestFixture(test_gnrc_pktcap_rx_tx),
+        new_TestFixture(test_gnrc_pktcap_rx__snaplen),
+        new_TestFixture(test_gnrc_pktcap_rx__wrap),
+        new_TestFixture(test_gnrc_pktcap_rx__full),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_pktcap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_pktcap_tests;
+}
+
+void tests_gnrc_pktcap(void)
+{
+    TESTS_RUN(tests_gnrc_pktcap_tests());
+}
+/** @} */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/rpl/sr.h"
+
+#include "tests-gnrc_rpl_sr.h"
+
+#define IFACE       (5)
+
+static const ipv6_addr_t _root = {{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                    0, 0, 0, 0, 0, 0, 0, 0x01 }};
+static const ipv6_addr_t _node1 = {{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0x02 }};
+static const ipv6_addr_t _node2 = {{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0x03 }};
+static const ipv6_addr_t _other = {{ 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0x04 }};
+
+/* must run first, before any gnrc_rpl_sr_init() */
+static void test_gnrc_rpl_sr_update__no_init(void)
+{
+    ipv6_addr_t route[GNRC_RPL_SR_MAX_DEPTH];
+
+    gnrc_rpl_sr_update(1);
+    gnrc_rpl_sr_update(UINT16_MAX);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_numof());
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_sr_add(&_node1, &_root, 60));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_rpl_sr_get_route(&_node1, route,
+                                                         GNRC_RPL_SR_MAX_DEPTH,
+                                                         NULL));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_numof());
+}
+
+static void test_gnrc_rpl_sr_add__invalid(void)
+{
+    gnrc_rpl_sr_init(&_root, IFACE);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_sr_add(&_other, &_root, 60));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_sr_add(&_node1, &_other, 60));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_numof());
+}
+
+static void test_gnrc_rpl_sr_get_route(void)
+{
+    ipv6_addr_t route[GNRC_RPL_SR_MAX_DEPTH];
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+
+    gnrc_rpl_sr_init(&_root, IFACE);
+    /* the parent is added as a placeholder first */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_add(&_node2, &_node1, 60));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_sr_numof());
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          gnrc_rpl_sr_get_route(&_node2, route,
+                                                GNRC_RPL_SR_MAX_DEPTH, NULL));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_add(&_node1, &_root, 60));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_sr_get_route(&_node2, route,
+                                                   GNRC_RPL_SR_MAX_DEPTH,
+                                                   &iface));
+    TEST_ASSERT(ipv6_addr_equal(&_node1, &route[0]));
+    TEST_ASSERT(ipv6_addr_equal(&_node2, &route[1]));
+    TEST_ASSERT_EQUAL_INT(IFACE, iface);
+    TEST_ASSERT_EQUAL_INT(-ELOOP, gnrc_rpl_sr_get_route(&_node2, route, 1,
+                                                        NULL));
+}
+
+static void test_gnrc_rpl_sr_update(void)
+{
+    ipv6_addr_t route[GNRC_RPL_SR_MAX_DEPTH];
+
+    gnrc_rpl_sr_init(&_root, IFACE);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_add(&_node1, &_root, 30));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_add(&_node2, &_node1, 60));
+    gnrc_rpl_sr_update(20);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_rpl_sr_numof());
+    gnrc_rpl_sr_update(20);
+    /* the route of the child of an expired node is unknown */
+    TEST_ASSERT_EQUAL_INT(1, gnrc_rpl_sr_numof());
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          gnrc_rpl_sr_get_route(&_node2, route,
+                                                GNRC_RPL_SR_MAX_DEPTH, NULL));
+    gnrc_rpl_sr_update(20);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_sr_numof());
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          gnrc_rpl_sr_get_route(&_node2, route,
+                                                GNRC_RPL_SR_MAX_DEPTH, NULL));
+}
+
+static Test *tests_gnrc_rpl_sr_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_rpl_sr_update__no_init),
+        new_TestFixture(test_gnrc_rpl_sr_add__invalid),
+        new_TestFixture(test_gnrc_rpl_sr_get_route),
+        new_TestFixture(test_gnrc_rpl_sr_update),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_rpl_sr_tests, NULL, NULL, fixtures);
+
+    return (Test *)&gnrc_rpl_sr_tests;
+}
+
+void tests_gnrc_rpl_sr(void)
+{
+    TESTS_RUN(tests_gnrc_rpl_sr_tests());
+}
+/** @} */
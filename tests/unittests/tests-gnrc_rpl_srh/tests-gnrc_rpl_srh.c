@@ -23,6 +23,8 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/rpl/srh.h"
 #include "net/gnrc/ipv6/ext/rh.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
 
 #include "unittests-constants.h"
 #include "tests-gnrc_rpl_srh.h"
@@ -58,6 +60,7 @@ static void set_up(void)
 {
     memset(&hdr, 0, sizeof(hdr));
     memset(buf, 0, sizeof(buf));
+    gnrc_pktbuf_init();
 }
 
 static inline void _init_hdrs(gnrc_rpl_srh_t **srh, uint8_t **vec,
@@ -180,6 +183,48 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void test_rpl_srh_insert(void)
+{
+    static const ipv6_addr_t route[] = { IPV6_ADDR1, IPV6_ADDR2, IPV6_DST };
+    gnrc_pktsnip_t *pkt, *ipv6;
+    ipv6_hdr_t *ipv6_hdr;
+    gnrc_rpl_srh_t *srh;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    ipv6 = gnrc_pktbuf_add(pkt, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    ipv6_hdr = ipv6->data;
+    memset(ipv6_hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->len = byteorder_htons(8);
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_insert(ipv6, route, 3));
+    TEST_ASSERT_EQUAL_INT(PROTNUM_IPV6_EXT_RH, ipv6_hdr->nh);
+    TEST_ASSERT(ipv6_addr_equal(&ipv6_hdr->dst, &route[0]));
+    TEST_ASSERT_NOT_NULL(ipv6->next);
+    TEST_ASSERT(ipv6->next->next == pkt);
+    TEST_ASSERT_EQUAL_INT(0, ipv6->next->size & 0x7);
+    TEST_ASSERT_EQUAL_INT(8 + ipv6->next->size, byteorder_ntohs(ipv6_hdr->len));
+
+    srh = ipv6->next->data;
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, srh->nh);
+    TEST_ASSERT_EQUAL_INT(IPV6_EXT_RH_TYPE_RPL_SRH, srh->type);
+    TEST_ASSERT_EQUAL_INT(2, srh->seg_left);
+    /* only the last byte of the addresses differs */
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 15, srh->compr);
+
+    /* the route is restored hop by hop */
+    for (unsigned i = 1; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(GNRC_IPV6_EXT_RH_FORWARDED,
+                              gnrc_rpl_srh_process(ipv6_hdr, srh));
+        TEST_ASSERT(ipv6_addr_equal(&ipv6_hdr->dst, &route[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, srh->seg_left);
+    gnrc_pktbuf_release(ipv6);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -188,6 +233,7 @@ static Test *tests_rpl_srh_tests(void)
         new_TestFixture(test_rpl_srh_too_many_seg_left),
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+        new_TestFixture(test_rpl_srh_insert),
     };
 
     EMB_UNIT_TESTCALLER(rpl_srh_tests, set_up, NULL, fixtures);
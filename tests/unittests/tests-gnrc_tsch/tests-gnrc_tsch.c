@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/tsch/schedule.h"
+
+#include "tests-gnrc_tsch.h"
+
+#define ADDR_LEN    (8U)
+
+static const uint8_t _addr1[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+static const uint8_t _addr2[] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0 };
+static gnrc_tsch_schedule_t _sched;
+
+static void set_up(void)
+{
+    gnrc_tsch_schedule_init(&_sched);
+}
+
+static void _cell(gnrc_tsch_cell_t *cell, uint16_t slot, uint8_t choff,
+                  uint8_t flags, const uint8_t *addr)
+{
+    memset(cell, 0, sizeof(*cell));
+    cell->slot = slot;
+    cell->channel_offset = choff;
+    cell->flags = flags;
+    if (addr != NULL) {
+        memcpy(cell->addr, addr, ADDR_LEN);
+        cell->addr_len = ADDR_LEN;
+    }
+}
+
+static void test_gnrc_tsch_schedule_init(void)
+{
+    const gnrc_tsch_cell_t *cell = gnrc_tsch_schedule_iter(&_sched, 0, NULL);
+
+    TEST_ASSERT_NOT_NULL(cell);
+    TEST_ASSERT_EQUAL_INT(0, cell->channel_offset);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX |
+                          GNRC_TSCH_CELL_SHARED, cell->flags);
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_iter(&_sched, 0, cell));
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_iter(&_sched, 1, NULL));
+    TEST_ASSERT(_sched.hopping_len > 0);
+}
+
+static void test_gnrc_tsch_schedule_add__invalid(void)
+{
+    gnrc_tsch_cell_t cell;
+
+    _cell(&cell, GNRC_TSCH_SLOTFRAME_LEN, 0, GNRC_TSCH_CELL_TX, NULL);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_schedule_add(&_sched, &cell));
+    _cell(&cell, 1, 0, GNRC_TSCH_CELL_SHARED, NULL);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_schedule_add(&_sched, &cell));
+    _cell(&cell, 0, 0, GNRC_TSCH_CELL_RX, NULL);
+    TEST_ASSERT_EQUAL_INT(-EEXIST, gnrc_tsch_schedule_add(&_sched, &cell));
+}
+
+static void test_gnrc_tsch_schedule_add__full(void)
+{
+    gnrc_tsch_cell_t cell;
+
+    /* the minimal cell occupies one entry */
+    for (unsigned i = 1; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        _cell(&cell, i % GNRC_TSCH_SLOTFRAME_LEN, i, GNRC_TSCH_CELL_RX, NULL);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+    }
+    _cell(&cell, 1, 0, GNRC_TSCH_CELL_RX, NULL);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_tsch_schedule_add(&_sched, &cell));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_del(&_sched, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+}
+
+static void test_gnrc_tsch_schedule_del(void)
+{
+    gnrc_tsch_cell_t cell;
+
+    _cell(&cell, 3, 2, GNRC_TSCH_CELL_RX, NULL);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_schedule_del(&_sched, 3, 1));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_del(&_sched, 3, 2));
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_iter(&_sched, 3, NULL));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_schedule_del(&_sched, 3, 2));
+}
+
+static void test_gnrc_tsch_schedule_iter(void)
+{
+    gnrc_tsch_cell_t cell;
+    const gnrc_tsch_cell_t *res;
+
+    _cell(&cell, 2, 0, GNRC_TSCH_CELL_TX, _addr1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+    _cell(&cell, 5, 0, GNRC_TSCH_CELL_RX, NULL);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+    _cell(&cell, 2, 1, GNRC_TSCH_CELL_RX, NULL);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+
+    res = gnrc_tsch_schedule_iter(&_sched, 2, NULL);
+    TEST_ASSERT_NOT_NULL(res);
+    TEST_ASSERT_EQUAL_INT(0, res->channel_offset);
+    res = gnrc_tsch_schedule_iter(&_sched, 2, res);
+    TEST_ASSERT_NOT_NULL(res);
+    TEST_ASSERT_EQUAL_INT(1, res->channel_offset);
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_iter(&_sched, 2, res));
+}
+
+static void test_gnrc_tsch_schedule_find_tx(void)
+{
+    gnrc_tsch_cell_t cell;
+    const gnrc_tsch_cell_t *res;
+
+    _cell(&cell, 4, 0, GNRC_TSCH_CELL_RX, _addr2);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+    _cell(&cell, 6, 3, GNRC_TSCH_CELL_TX, _addr1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_add(&_sched, &cell));
+
+    res = gnrc_tsch_schedule_find_tx(&_sched, _addr1, ADDR_LEN);
+    TEST_ASSERT_NOT_NULL(res);
+    TEST_ASSERT_EQUAL_INT(6, res->slot);
+    TEST_ASSERT_EQUAL_INT(3, res->channel_offset);
+    /* receive cells are no transmit cells */
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_find_tx(&_sched, _addr2, ADDR_LEN));
+    TEST_ASSERT_NULL(gnrc_tsch_schedule_find_tx(&_sched, _addr1, 2));
+}
+
+static void test_gnrc_tsch_schedule_channel(void)
+{
+    const uint8_t seq[] = { 11, 15, 20 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_tsch_schedule_set_hopping(&_sched,
+                                                                  seq, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_schedule_set_hopping(&_sched, seq,
+                                                            sizeof(seq)));
+    TEST_ASSERT_EQUAL_INT(11, gnrc_tsch_schedule_channel(&_sched, 0, 0));
+    TEST_ASSERT_EQUAL_INT(15, gnrc_tsch_schedule_channel(&_sched, 0, 1));
+    TEST_ASSERT_EQUAL_INT(20, gnrc_tsch_schedule_channel(&_sched, 4, 1));
+    TEST_ASSERT_EQUAL_INT(11, gnrc_tsch_schedule_channel(&_sched, 5, 1));
+}
+
+static void test_gnrc_tsch_schedule_reset_stats(void)
+{
+    gnrc_tsch_cell_t *cell = gnrc_tsch_schedule_iter(&_sched, 0, NULL);
+
+    cell->stats.tx = 7;
+    cell->stats.idle = 3;
+    gnrc_tsch_schedule_reset_stats(&_sched);
+    TEST_ASSERT_EQUAL_INT(0, cell->stats.tx);
+    TEST_ASSERT_EQUAL_INT(0, cell->stats.idle);
+}
+
+static Test *tests_gnrc_tsch_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tsch_schedule_init),
+        new_TestFixture(test_gnrc_tsch_schedule_add__invalid),
+        new_TestFixture(test_gnrc_tsch_schedule_add__full),
+        new_TestFixture(test_gnrc_tsch_schedule_del),
+        new_TestFixture(test_gnrc_tsch_schedule_iter),
+        new_TestFixture(test_gnrc_tsch_schedule_find_tx),
+        new_TestFixture(test_gnrc_tsch_schedule_channel),
+        new_TestFixture(test_gnrc_tsch_schedule_reset_stats),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tsch_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tsch_tests;
+}
+
+void tests_gnrc_tsch(void)
+{
+    TESTS_RUN(tests_gnrc_tsch_tests());
+}
+/** @} */
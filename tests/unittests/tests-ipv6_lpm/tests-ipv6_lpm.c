@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/ipv6/lpm.h"
+
+#include "tests-ipv6_lpm.h"
+
+#define ENTRIES_NUMOF   (16U)
+#define CHURN_ROUNDS    (500U)
+
+/* 2001:db8:0:1::1 */
+static const ipv6_addr_t _addr = {{
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+}};
+
+static ipv6_lpm_entry_t _entries[ENTRIES_NUMOF];
+static ipv6_lpm_t _lpm;
+
+static void set_up(void)
+{
+    ipv6_lpm_init(&_lpm, _entries, ENTRIES_NUMOF);
+}
+
+static void test_ipv6_lpm_match__empty(void)
+{
+    TEST_ASSERT_NULL(ipv6_lpm_match(&_lpm, &_addr));
+}
+
+static void test_ipv6_lpm_match__longest(void)
+{
+    ipv6_addr_t addr = _addr;
+    ipv6_lpm_entry_t *entry;
+
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 32));
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 64));
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 128));
+    TEST_ASSERT_EQUAL_INT(3, _lpm.numof);
+
+    entry = ipv6_lpm_match(&_lpm, &addr);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(128, entry->prefix_len);
+
+    addr.u8[15] = 0x02;
+    entry = ipv6_lpm_match(&_lpm, &addr);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(64, entry->prefix_len);
+
+    addr.u8[7] = 0x02;
+    entry = ipv6_lpm_match(&_lpm, &addr);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(32, entry->prefix_len);
+    /* the bits after the prefix are cleared */
+    TEST_ASSERT_EQUAL_INT(0, entry->prefix.u8[15]);
+
+    addr.u8[3] = 0x00;
+    TEST_ASSERT_NULL(ipv6_lpm_match(&_lpm, &addr));
+}
+
+static void test_ipv6_lpm_match__odd_len(void)
+{
+    ipv6_addr_t addr = _addr;
+
+    /* 2001:db8::/29 */
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 29));
+    addr.u8[3] = 0xbf;
+    TEST_ASSERT_NOT_NULL(ipv6_lpm_match(&_lpm, &addr));
+    addr.u8[3] = 0xc0;
+    TEST_ASSERT_NULL(ipv6_lpm_match(&_lpm, &addr));
+}
+
+static void test_ipv6_lpm_match__default(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 0));
+    TEST_ASSERT_NOT_NULL(ipv6_lpm_match(&_lpm, &ipv6_addr_loopback));
+}
+
+static void test_ipv6_lpm_add__invalid(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ipv6_lpm_add(&_lpm, &_addr, 129));
+}
+
+static void test_ipv6_lpm_add__twice(void)
+{
+    ipv6_lpm_entry_t *entry;
+
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 64));
+    entry = ipv6_lpm_match(&_lpm, &_addr);
+    TEST_ASSERT_NOT_NULL(entry);
+    entry->hits = 5;
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 64));
+    TEST_ASSERT_EQUAL_INT(1, _lpm.numof);
+    TEST_ASSERT_EQUAL_INT(5, ipv6_lpm_match(&_lpm, &_addr)->hits);
+}
+
+static void test_ipv6_lpm_add__full(void)
+{
+    ipv6_addr_t addr = _addr;
+
+    for (unsigned i = 0; i < ENTRIES_NUMOF; i++) {
+        addr.u8[15] = i;
+        TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &addr, 128));
+    }
+    addr.u8[15] = ENTRIES_NUMOF;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, ipv6_lpm_add(&_lpm, &addr, 128));
+    TEST_ASSERT_NULL(ipv6_lpm_match(&_lpm, &addr));
+}
+
+static void test_ipv6_lpm_del(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 64));
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &_addr, 128));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, ipv6_lpm_del(&_lpm, &_addr, 48));
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_del(&_lpm, &_addr, 128));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, ipv6_lpm_del(&_lpm, &_addr, 128));
+    TEST_ASSERT_EQUAL_INT(64, ipv6_lpm_match(&_lpm, &_addr)->prefix_len);
+    TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_del(&_lpm, &_addr, 64));
+    TEST_ASSERT_NULL(ipv6_lpm_match(&_lpm, &_addr));
+    TEST_ASSERT_EQUAL_INT(0, _lpm.numof);
+}
+
+static void test_ipv6_lpm_churn(void)
+{
+    /* random adds and removes of up to 3/4 * ENTRIES_NUMOF addresses
+     * compared against a plain membership array */
+    bool in_lpm[ENTRIES_NUMOF * 2];
+    ipv6_addr_t addr = _addr;
+    uint32_t rnd = 1;
+    unsigned numof = 0;
+
+    memset(in_lpm, 0, sizeof(in_lpm));
+    for (unsigned round = 0; round < CHURN_ROUNDS; round++) {
+        unsigned i;
+
+        rnd = (rnd * 1103515245) + 12345;
+        i = (rnd >> 16) % (ENTRIES_NUMOF * 2);
+        addr.u8[15] = i;
+        if (in_lpm[i]) {
+            TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_del(&_lpm, &addr, 128));
+            in_lpm[i] = false;
+            numof--;
+        }
+        else if (numof < ((ENTRIES_NUMOF * 3) / 4)) {
+            TEST_ASSERT_EQUAL_INT(0, ipv6_lpm_add(&_lpm, &addr, 128));
+            in_lpm[i] = true;
+            numof++;
+        }
+        for (unsigned j = 0; j < (ENTRIES_NUMOF * 2); j++) {
+            addr.u8[15] = j;
+            TEST_ASSERT_EQUAL_INT(in_lpm[j],
+                                  ipv6_lpm_match(&_lpm, &addr) != NULL);
+        }
+    }
+}
+
+static Test *tests_ipv6_lpm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_lpm_match__empty),
+        new_TestFixture(test_ipv6_lpm_match__longest),
+        new_TestFixture(test_ipv6_lpm_match__odd_len),
+        new_TestFixture(test_ipv6_lpm_match__default),
+        new_TestFixture(test_ipv6_lpm_add__invalid),
+        new_TestFixture(test_ipv6_lpm_add__twice),
+        new_TestFixture(test_ipv6_lpm_add__full),
+        new_TestFixture(test_ipv6_lpm_del),
+        new_TestFixture(test_ipv6_lpm_churn),
+    };
+
+    EMB_UNIT_TESTCALLER(ipv6_lpm_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ipv6_lpm_tests;
+}
+
+void tests_ipv6_lpm(void)
+{
+    TESTS_RUN(tests_ipv6_lpm_tests());
+}
+/** @} */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/l2filter.h"
+
+#include "tests-l2filter.h"
+
+#define CHURN_ROUNDS    (1000U)
+
+static l2filter_t _list[L2FILTER_LISTSIZE];
+
+static void _addr(uint8_t *addr, unsigned i)
+{
+    /* long addresses differing only in the last bytes */
+    memset(addr, 0, L2FILTER_ADDR_MAXLEN);
+    addr[0] = 0x02;
+    addr[6] = i >> 8;
+    addr[7] = i;
+}
+
+static void set_up(void)
+{
+    memset(_list, 0, sizeof(_list));
+}
+
+static void test_l2filter_add_rm(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+    uint8_t addr_short[] = { 0xab, 0xcd };
+
+    _addr(addr, 1);
+    TEST_ASSERT(l2filter_pass(_list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr_short,
+                                          sizeof(addr_short)));
+    TEST_ASSERT(!l2filter_pass(_list, addr, sizeof(addr)));
+    TEST_ASSERT(!l2filter_pass(_list, addr_short, sizeof(addr_short)));
+    /* same bytes, different length */
+    TEST_ASSERT(l2filter_pass(_list, addr, sizeof(addr) - 1));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_rm(_list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, l2filter_rm(_list, addr, sizeof(addr)));
+    TEST_ASSERT(l2filter_pass(_list, addr, sizeof(addr)));
+    TEST_ASSERT(!l2filter_pass(_list, addr_short, sizeof(addr_short)));
+}
+
+static void test_l2filter_add__twice(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    _addr(addr, 1);
+    TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, l2filter_rm(_list, addr, sizeof(addr)));
+    TEST_ASSERT(l2filter_pass(_list, addr, sizeof(addr)));
+}
+
+static void test_l2filter_add__full(void)
+{
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr, sizeof(addr)));
+    }
+    _addr(addr, L2FILTER_LISTSIZE);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, l2filter_add(_list, addr, sizeof(addr)));
+    TEST_ASSERT(l2filter_pass(_list, addr, sizeof(addr)));
+    /* remove every other address, the others must still be found */
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i += 2) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(0, l2filter_rm(_list, addr, sizeof(addr)));
+    }
+    for (unsigned i = 0; i < L2FILTER_LISTSIZE; i++) {
+        _addr(addr, i);
+        TEST_ASSERT_EQUAL_INT(i & 1, !l2filter_pass(_list, addr, sizeof(addr)));
+    }
+}
+
+static void test_l2filter_churn(void)
+{
+    /* random adds and removes of up to 3/4 * L2FILTER_LISTSIZE addresses
+     * compared against a plain membership array */
+    static bool in_list[L2FILTER_LISTSIZE];
+    uint8_t addr[L2FILTER_ADDR_MAXLEN];
+    uint32_t rnd = 1;
+    unsigned numof = 0;
+
+    memset(in_list, 0, sizeof(in_list));
+    for (unsigned round = 0; round < CHURN_ROUNDS; round++) {
+        unsigned i;
+
+        rnd = (rnd * 1103515245) + 12345;
+        i = (rnd >> 16) % L2FILTER_LISTSIZE;
+        _addr(addr, i * 7919);
+        if (in_list[i]) {
+            TEST_ASSERT_EQUAL_INT(0, l2filter_rm(_list, addr, sizeof(addr)));
+            in_list[i] = false;
+            numof--;
+        }
+        else if (numof < ((L2FILTER_LISTSIZE * 3) / 4)) {
+            TEST_ASSERT_EQUAL_INT(0, l2filter_add(_list, addr, sizeof(addr)));
+            in_list[i] = true;
+            numof++;
+        }
+        for (unsigned j = 0; j < L2FILTER_LISTSIZE; j++) {
+            _addr(addr, j * 7919);
+            TEST_ASSERT_EQUAL_INT(in_list[j],
+                                  !l2filter_pass(_list, addr, sizeof(addr)));
+        }
+    }
+}
+
+static Test *tests_l2filter_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_l2filter_add_rm),
+        new_TestFixture(test_l2filter_add__twice),
+        new_TestFixture(test_l2filter_add__full),
+        new_TestFixture(test_l2filter_churn),
+    };
+
+    EMB_UNIT_TESTCALLER(l2filter_tests, set_up, NULL, fixtures);
+
+    return (Test *)&l2filter_tests;
+}
+
+void tests_l2filter(void)
+{
+    TESTS_RUN(tests_l2filter_tests());
+}
+/** @} */
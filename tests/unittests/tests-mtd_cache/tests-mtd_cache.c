@@ -0,0 +1,400 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "board.h"
+
+#include "tests-mtd_cache.h"
+
+#define CACHE_LINES         (3U)
+#ifndef CACHE_PAGE_SIZE_MAX
+#define CACHE_PAGE_SIZE_MAX (256U)
+#endif
+#define CHUNK_SIZE          (16U)
+
+/* Define MTD_0 in board.h to run the tests on top of the board mtd if any */
+#ifdef MTD_0
+#define backend (MTD_0)
+#else
+/* Test mock object implementing a simple RAM-based mtd */
+#define SECTOR_COUNT        4
+#define PAGE_PER_SECTOR     4
+#define PAGE_SIZE           128
+
+static uint8_t dummy_memory[PAGE_PER_SECTOR * PAGE_SIZE * SECTOR_COUNT];
+
+static int _ram_init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    memset(dummy_memory, 0xff, sizeof(dummy_memory));
+    return 0;
+}
+
+static int _ram_read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    memcpy(buff, dummy_memory + addr, size);
+    return size;
+}
+
+static int _ram_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                      uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(dummy_memory)) {
+        return -EOVERFLOW;
+    }
+    if (((addr % PAGE_SIZE) + size) > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    memcpy(dummy_memory + addr, buff, size);
+    return size;
+}
+
+static int _ram_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((size % (PAGE_PER_SECTOR * PAGE_SIZE) != 0) ||
+        (addr % (PAGE_PER_SECTOR * PAGE_SIZE) != 0) ||
+        (addr + size > sizeof(dummy_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(dummy_memory + addr, 0xff, size);
+    return 0;
+}
+
+static int _ram_power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t _ram_driver = {
+    .init = _ram_init,
+    .read = _ram_read,
+    .write = _ram_write,
+    .erase = _ram_erase,
+    .power = _ram_power,
+};
+
+static mtd_dev_t _ram_dev = {
+    .driver = &_ram_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+#define backend (&_ram_dev)
+#endif /* MTD_0 */
+
+/* pass-through device counting the accesses reaching the backend */
+typedef struct {
+    mtd_dev_t base;
+    unsigned reads;
+    unsigned writes;
+} counting_mtd_t;
+
+static int _cnt_init(mtd_dev_t *dev)
+{
+    int res = mtd_init(backend);
+
+    dev->sector_count = backend->sector_count;
+    dev->pages_per_sector = backend->pages_per_sector;
+    dev->page_size = backend->page_size;
+    return res;
+}
+
+static int _cnt_read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    ((counting_mtd_t *)dev)->reads++;
+    return mtd_read(backend, buff, addr, size);
+}
+
+static int _cnt_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                      uint32_t size)
+{
+    ((counting_mtd_t *)dev)->writes++;
+    return mtd_write(backend, buff, addr, size);
+}
+
+static int _cnt_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    return mtd_erase(backend, addr, size);
+}
+
+static int _cnt_power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    return mtd_power(backend, power);
+}
+
+static const mtd_desc_t _cnt_driver = {
+    .init = _cnt_init,
+    .read = _cnt_read,
+    .write = _cnt_write,
+    .erase = _cnt_erase,
+    .power = _cnt_power,
+};
+
+static counting_mtd_t _counting = {
+    .base = { .driver = &_cnt_driver },
+};
+
+static mtd_cache_line_t _lines[CACHE_LINES];
+static uint8_t _lines_buf[CACHE_LINES * CACHE_PAGE_SIZE_MAX];
+
+static mtd_cache_t _cache = {
+    .base = { .driver = &mtd_cache_driver },
+    .parent = &_counting.base,
+    .lines = _lines,
+    .buf = _lines_buf,
+    .buf_size = sizeof(_lines_buf),
+    .lines_numof = CACHE_LINES,
+};
+
+static mtd_dev_t *dev = &_cache.base;
+
+static uint8_t _pattern[CACHE_PAGE_SIZE_MAX];
+static uint8_t _buf[CACHE_PAGE_SIZE_MAX];
+
+static void set_up(void)
+{
+    mtd_init(dev);
+    mtd_erase(backend, 0, backend->pages_per_sector * backend->page_size);
+    for (unsigned i = 0; i < sizeof(_pattern); i++) {
+        _pattern[i] = (uint8_t)i;
+    }
+    _counting.reads = 0;
+    _counting.writes = 0;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(dev));
+    TEST_ASSERT_EQUAL_INT(backend->sector_count, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(backend->pages_per_sector, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(backend->page_size, dev->page_size);
+    TEST_ASSERT_EQUAL_INT(0, _cache.stats.hits);
+    TEST_ASSERT_EQUAL_INT(0, _cache.stats.misses);
+}
+
+static void test_mtd_cache_read_small(void)
+{
+    /* first access loads the page and reads ahead the next one */
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE, mtd_read(dev, _buf, 0, CHUNK_SIZE));
+    TEST_ASSERT_EQUAL_INT(2, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.readahead);
+
+    /* the rest of the page comes from the cache */
+    for (unsigned i = 1; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(CHUNK_SIZE,
+                              mtd_read(dev, _buf, i * CHUNK_SIZE, CHUNK_SIZE));
+    }
+    TEST_ASSERT_EQUAL_INT(2, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.hits);
+
+    /* so does the page read ahead */
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE,
+                          mtd_read(dev, _buf, dev->page_size, CHUNK_SIZE));
+    TEST_ASSERT_EQUAL_INT(2, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.readahead_hits);
+}
+
+static void test_mtd_cache_read_random(void)
+{
+    TEST_ASSERT_EQUAL_INT(CHUNK_SIZE,
+                          mtd_read(dev, _buf, 2 * dev->page_size + 8,
+                                   CHUNK_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(0, _cache.stats.readahead);
+}
+
+static void test_mtd_cache_write_coalesce(void)
+{
+    const uint32_t page_size = dev->page_size;
+
+    for (uint32_t off = 0; off < page_size; off += CHUNK_SIZE) {
+        TEST_ASSERT_EQUAL_INT(0, _counting.writes);
+        TEST_ASSERT_EQUAL_INT(CHUNK_SIZE,
+                              mtd_write(dev, _pattern + off, page_size + off,
+                                        CHUNK_SIZE));
+    }
+    /* the completed page was written back in a single operation */
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+    TEST_ASSERT_EQUAL_INT(0, _counting.reads);
+
+    TEST_ASSERT_EQUAL_INT(page_size, mtd_read(backend, _buf, page_size,
+                                              page_size));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, page_size));
+}
+
+static void test_mtd_cache_write_flush(void)
+{
+    const uint32_t addr = 2 * dev->page_size + 5;
+
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern, addr, 10));
+    TEST_ASSERT_EQUAL_INT(0, _counting.writes);
+
+    /* pending data can be read back without touching the device */
+    TEST_ASSERT_EQUAL_INT(10, mtd_read(dev, _buf, addr, 10));
+    TEST_ASSERT_EQUAL_INT(0, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, 10));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+    TEST_ASSERT_EQUAL_INT(10, mtd_read(backend, _buf, addr, 10));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, 10));
+
+    /* nothing left to write */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+}
+
+static void test_mtd_cache_write_read_partial(void)
+{
+    const uint8_t empty[] = { 0xff, 0xff, 0xff, 0xff, 0xff };
+    const uint32_t page = 2 * dev->page_size;
+
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern, page + 5, 10));
+
+    /* reading beyond the pending data merges it with the device contents */
+    TEST_ASSERT_EQUAL_INT(20, mtd_read(dev, _buf, page, 20));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+    TEST_ASSERT_EQUAL_INT(1, _counting.reads);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(empty, _buf, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf + 5, 10));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(empty, _buf + 15, 5));
+}
+
+static void test_mtd_cache_write_gap(void)
+{
+    const uint32_t page = 3 * dev->page_size;
+
+    TEST_ASSERT_EQUAL_INT(8, mtd_write(dev, _pattern, page, 8));
+    TEST_ASSERT_EQUAL_INT(8, mtd_write(dev, _pattern + 8, page + 8, 8));
+    TEST_ASSERT_EQUAL_INT(0, _counting.writes);
+
+    /* not adjacent to the pending range */
+    TEST_ASSERT_EQUAL_INT(8, mtd_write(dev, _pattern, page + 32, 8));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(2, _counting.writes);
+
+    TEST_ASSERT_EQUAL_INT(16, mtd_read(backend, _buf, page, 16));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, 16));
+    TEST_ASSERT_EQUAL_INT(8, mtd_read(backend, _buf, page + 32, 8));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, 8));
+}
+
+static void test_mtd_cache_evict(void)
+{
+    for (unsigned i = 0; i < CACHE_LINES; i++) {
+        TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern,
+                                            i * dev->page_size, 10));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _counting.writes);
+
+    /* the least recently used line (page 0) has to go */
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern,
+                                        CACHE_LINES * dev->page_size, 10));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+    TEST_ASSERT_EQUAL_INT(10, mtd_read(backend, _buf, 0, 10));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, 10));
+}
+
+static void test_mtd_cache_erase(void)
+{
+    const uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+    uint8_t expected[10];
+
+    memset(expected, 0xff, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern, 0, 10));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, 0, sector_size));
+
+    /* pending data of erased pages is dropped */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _counting.writes);
+    TEST_ASSERT_EQUAL_INT(10, mtd_read(dev, _buf, 0, 10));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, _buf, 10));
+
+    /* unaligned erase is rejected and keeps the cache intact */
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern, 0, 10));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, dev->page_size,
+                                                sector_size));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+}
+
+static void test_mtd_cache_power_down(void)
+{
+    TEST_ASSERT_EQUAL_INT(10, mtd_write(dev, _pattern, 0, 10));
+    mtd_power(dev, MTD_POWER_DOWN);
+    TEST_ASSERT_EQUAL_INT(1, _counting.writes);
+}
+
+static void test_mtd_cache_bounds(void)
+{
+    const uint32_t size = dev->sector_count * dev->pages_per_sector *
+                          dev->page_size;
+
+    /* pages overlap write */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, _pattern,
+                                                dev->page_size - 4, 8));
+    /* out of bounds */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, _pattern, size, 8));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_read(dev, _buf, size - 4, 8));
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_read_small),
+        new_TestFixture(test_mtd_cache_read_random),
+        new_TestFixture(test_mtd_cache_write_coalesce),
+        new_TestFixture(test_mtd_cache_write_flush),
+        new_TestFixture(test_mtd_cache_write_read_partial),
+        new_TestFixture(test_mtd_cache_write_gap),
+        new_TestFixture(test_mtd_cache_evict),
+        new_TestFixture(test_mtd_cache_erase),
+        new_TestFixture(test_mtd_cache_power_down),
+        new_TestFixture(test_mtd_cache_bounds),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_tests());
+}
+/** @} */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/netstats/neighbor.h"
+
+#include "tests-netstats_neighbor.h"
+
+#define ETX(x)      ((x) * NETSTATS_NB_ETX_DIVISOR)
+
+static const uint8_t _addr1[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static const uint8_t _addr2[] = { 0xab, 0xcd };
+
+static netstats_nb_table_t _table;
+
+static void set_up(void)
+{
+    netstats_nb_init(&_table);
+}
+
+static void _send(const uint8_t *addr, uint8_t len, netstats_nb_result_t result,
+                  unsigned retries)
+{
+    netstats_nb_record(&_table, addr, len);
+    netstats_nb_update_tx(&_table, result, retries);
+}
+
+static void test_netstats_nb_get__empty(void)
+{
+    netstats_nb_t nb;
+
+    TEST_ASSERT(!netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+}
+
+static void test_netstats_nb_update_tx__first(void)
+{
+    netstats_nb_t nb;
+
+    _send(_addr1, sizeof(_addr1), NETSTATS_NB_SUCCESS, 2);
+    TEST_ASSERT(netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+    TEST_ASSERT_EQUAL_INT(ETX(3), nb.etx);
+    TEST_ASSERT_EQUAL_INT(1, nb.tx_count);
+    TEST_ASSERT_EQUAL_INT(0, nb.tx_failed);
+    /* same address bytes, different length */
+    TEST_ASSERT(!netstats_nb_get(&_table, _addr1, sizeof(_addr2), &nb));
+}
+
+static void test_netstats_nb_update_tx__average(void)
+{
+    netstats_nb_t nb;
+
+    _send(_addr1, sizeof(_addr1), NETSTATS_NB_SUCCESS, 0);
+    _send(_addr2, sizeof(_addr2), NETSTATS_NB_SUCCESS, 0);
+    _send(_addr1, sizeof(_addr1), NETSTATS_NB_NOACK, 3);
+    TEST_ASSERT(netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+    TEST_ASSERT_EQUAL_INT((ETX(1) * (100 - NETSTATS_NB_EWMA_ALPHA) +
+                           ETX(NETSTATS_NB_ETX_NOACK_PENALTY) *
+                           NETSTATS_NB_EWMA_ALPHA) / 100, nb.etx);
+    TEST_ASSERT_EQUAL_INT(2, nb.tx_count);
+    TEST_ASSERT_EQUAL_INT(1, nb.tx_failed);
+    /* the other neighbor is not affected */
+    TEST_ASSERT(netstats_nb_get(&_table, _addr2, sizeof(_addr2), &nb));
+    TEST_ASSERT_EQUAL_INT(ETX(1), nb.etx);
+
+    /* a good link converges to an ETX of 1 */
+    for (unsigned i = 0; i < 100; i++) {
+        _send(_addr1, sizeof(_addr1), NETSTATS_NB_SUCCESS, 0);
+    }
+    TEST_ASSERT(netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+    TEST_ASSERT(nb.etx < ETX(1) + ETX(1) / 10);
+}
+
+static void test_netstats_nb_update_tx__busy(void)
+{
+    netstats_nb_t nb;
+
+    _send(_addr1, sizeof(_addr1), NETSTATS_NB_BUSY, 0);
+    TEST_ASSERT(netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+    TEST_ASSERT_EQUAL_INT(0, nb.etx);
+    TEST_ASSERT_EQUAL_INT(0, nb.tx_count);
+    TEST_ASSERT_EQUAL_INT(1, nb.tx_busy);
+}
+
+static void test_netstats_nb_update_tx__multicast(void)
+{
+    netstats_nb_t nb;
+
+    netstats_nb_record(&_table, _addr1, sizeof(_addr1));
+    /* a multicast frame replaces the pending destination */
+    netstats_nb_record(&_table, NULL, 0);
+    netstats_nb_update_tx(&_table, NETSTATS_NB_SUCCESS, 0);
+    TEST_ASSERT(netstats_nb_get(&_table, _addr1, sizeof(_addr1), &nb));
+    TEST_ASSERT_EQUAL_INT(0, nb.tx_count);
+}
+
+static void test_netstats_nb_record__replace(void)
+{
+    uint8_t addr[sizeof(_addr1)];
+    netstats_nb_t nb;
+
+    memcpy(addr, _addr1, sizeof(addr));
+    for (unsigned i = 0; i < NETSTATS_NB_NUMOF; i++) {
+        addr[7] = i;
+        _send(addr, sizeof(addr), NETSTATS_NB_SUCCESS, 0);
+    }
+    /* use the first one again, so the second one is the oldest */
+    addr[7] = 0;
+    _send(addr, sizeof(addr), NETSTATS_NB_SUCCESS, 0);
+    _send(_addr2, sizeof(_addr2), NETSTATS_NB_SUCCESS, 0);
+
+    TEST_ASSERT(netstats_nb_get(&_table, _addr2, sizeof(_addr2), &nb));
+    TEST_ASSERT(netstats_nb_get(&_table, addr, sizeof(addr), &nb));
+    addr[7] = 1;
+    TEST_ASSERT(!netstats_nb_get(&_table, addr, sizeof(addr), &nb));
+    addr[7] = 2;
+    TEST_ASSERT(netstats_nb_get(&_table, addr, sizeof(addr), &nb));
+}
+
+static Test *tests_netstats_neighbor_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netstats_nb_get__empty),
+        new_TestFixture(test_netstats_nb_update_tx__first),
+        new_TestFixture(test_netstats_nb_update_tx__average),
+        new_TestFixture(test_netstats_nb_update_tx__busy),
+        new_TestFixture(test_netstats_nb_update_tx__multicast),
+        new_TestFixture(test_netstats_nb_record__replace),
+    };
+
+    EMB_UNIT_TESTCALLER(netstats_neighbor_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netstats_neighbor_tests;
+}
+
+void tests_netstats_neighbor(void)
+{
+    TESTS_RUN(tests_netstats_neighbor_tests());
+}
+/** @} */
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/sixlowpan/ghc.h"
+
+#include "tests-sixlowpan_ghc.h"
+
+#define DATA_LEN    (80U)
+
+/* fe80::1 */
+static const ipv6_addr_t _src = {{
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+}};
+/* fe80::2 */
+static const ipv6_addr_t _dst = {{
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+}};
+
+static uint8_t _buf[SIXLOWPAN_GHC_DICT_LEN + DATA_LEN];
+static uint8_t _out[DATA_LEN];
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    memset(_out, 0, sizeof(_out));
+    sixlowpan_ghc_dict_init(_buf, &_src, &_dst);
+}
+
+static void test_sixlowpan_ghc_dict_init(void)
+{
+    static const uint8_t exp[] = {
+        0x16, 0xfe, 0xfd, 0x17, 0xfe, 0xfd, 0x00, 0x01,
+        0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_src, &_buf[0], sizeof(_src)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_dst, &_buf[16], sizeof(_dst)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, &_buf[32], sizeof(exp)));
+}
+
+static void test_sixlowpan_ghc_decompress(void)
+{
+    static const uint8_t in[] = {
+        0x02, 'a', 'b', /* 2 literal bytes */
+        0x81,           /* 3 zeros */
+        0xa3, 0xf5,     /* 8 bytes 37 bytes back: prefix of the destination */
+        0x90,           /* stop code */
+        0xff,
+    };
+    static const uint8_t exp[] = {
+        'a', 'b', 0x00, 0x00, 0x00,
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          sixlowpan_ghc_decompress(_buf, in, sizeof(in),
+                                                   NULL, 0));
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          sixlowpan_ghc_decompress(_buf, in, sizeof(in),
+                                                   _out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, _out, sizeof(exp)));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_decompress(_buf, in, sizeof(in),
+                                                   _out, sizeof(exp) - 1));
+}
+
+static void test_sixlowpan_ghc_decompress__invalid(void)
+{
+    static const uint8_t reserved[] = { 0x91 };
+    static const uint8_t short_literal[] = { 0x05, 'a' };
+    static const uint8_t bref_too_far[] = { 0xaf, 0xaf, 0xc0 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, reserved,
+                                                   sizeof(reserved),
+                                                   _out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, short_literal,
+                                                   sizeof(short_literal),
+                                                   _out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, bref_too_far,
+                                                   sizeof(bref_too_far),
+                                                   _out, sizeof(_out)));
+}
+
+static void test_sixlowpan_ghc_compress(void)
+{
+    uint8_t *data = &_buf[SIXLOWPAN_GHC_DICT_LEN];
+    uint8_t comp[DATA_LEN];
+    int res;
+
+    /* a RPL DIO-like message: addresses, zeros, and repetitions */
+    memcpy(&data[8], &_dst, sizeof(_dst));
+    memset(&data[40], 0xff, 8);
+    memcpy(&data[56], &_src, 8);
+    for (unsigned i = 72; i < DATA_LEN; i++) {
+        data[i] = i;
+    }
+    res = sixlowpan_ghc_compress(_buf, DATA_LEN, comp, sizeof(comp));
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT(res < (int)(DATA_LEN / 2));
+    TEST_ASSERT_EQUAL_INT(DATA_LEN,
+                          sixlowpan_ghc_decompress(_buf, comp, res,
+                                                   _out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, _out, DATA_LEN));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_compress(_buf, DATA_LEN, comp, 2));
+}
+
+static void test_sixlowpan_ghc_compress__incompressible(void)
+{
+    uint8_t *data = &_buf[SIXLOWPAN_GHC_DICT_LEN];
+    uint8_t comp[DATA_LEN + 2];
+    int res;
+
+    for (unsigned i = 0; i < DATA_LEN; i++) {
+        data[i] = 0x20 + i;
+    }
+    res = sixlowpan_ghc_compress(_buf, DATA_LEN, comp, sizeof(comp));
+    /* only the length of the literal run is added */
+    TEST_ASSERT_EQUAL_INT(DATA_LEN + 1, res);
+    TEST_ASSERT_EQUAL_INT(DATA_LEN,
+                          sixlowpan_ghc_decompress(_buf, comp, res,
+                                                   _out, sizeof(_out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, _out, DATA_LEN));
+}
+
+static Test *tests_sixlowpan_ghc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_ghc_dict_init),
+        new_TestFixture(test_sixlowpan_ghc_decompress),
+        new_TestFixture(test_sixlowpan_ghc_decompress__invalid),
+        new_TestFixture(test_sixlowpan_ghc_compress),
+        new_TestFixture(test_sixlowpan_ghc_compress__incompressible),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_ghc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&sixlowpan_ghc_tests;
+}
+
+void tests_sixlowpan_ghc(void)
+{
+    TESTS_RUN(tests_sixlowpan_ghc_tests());
+}
+/** @} */
@@ -67,6 +67,23 @@ static vfs_mount_t _test_vfs_mount = {
     .private_data = (void *)&fs_data,
 };
 
+static vfs_mount_t _test_vfs_mount_nested = {
+    .mount_point = "/test/sub/",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&fs_data,
+};
+
+static const constfs_t fs_data_str = {
+    .files = _files,
+    .nfiles = 1,
+};
+
+static vfs_mount_t _test_vfs_mount_same = {
+    .mount_point = "/test",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&fs_data_str,
+};
+
 static void test_vfs_mount_umount(void)
 {
     int res;
@@ -171,6 +188,99 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void test_vfs_constfs_readv(void)
+{
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    char head[4];
+    char mid[6];
+    char tail[64];
+    memset(tail, '\0', sizeof(tail));
+    iolist_t iol_tail = { .iol_next = NULL, .iol_base = tail, .iol_len = sizeof(tail) };
+    iolist_t iol_empty = { .iol_next = &iol_tail, .iol_base = NULL, .iol_len = 0 };
+    iolist_t iol_mid = { .iol_next = &iol_empty, .iol_base = mid, .iol_len = sizeof(mid) };
+    iolist_t iol_head = { .iol_next = &iol_mid, .iol_base = head, .iol_len = sizeof(head) };
+
+    ssize_t nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(sizeof(str_data), nbytes);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(head, &str_data[0], sizeof(head)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(mid, &str_data[sizeof(head)], sizeof(mid)));
+    TEST_ASSERT_EQUAL_STRING((const char *)&str_data[sizeof(head) + sizeof(mid)],
+                             (const char *)&tail[0]);
+
+    /* end of file */
+    nbytes = vfs_readv(fd, &iol_head);
+    TEST_ASSERT_EQUAL_INT(0, nbytes);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_constfs_nested(void)
+{
+    struct stat st;
+    int res;
+    /* mount the inner file system first, the longest prefix must win
+     * regardless of the mount order */
+    res = vfs_mount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_stat("/test/sub/test.txt", &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(sizeof(str_data), st.st_size);
+    res = vfs_stat("/test/data.bin", &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), st.st_size);
+    /* no separator after the mount point name */
+    res = vfs_stat("/test/subtest.txt", &st);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, res);
+    /* only found on the outer file system */
+    res = vfs_stat("/test/sub/sub/test.txt", &st);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, res);
+
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_stat("/test/sub/data.bin", &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_stat("/test/data.bin", &st);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, res);
+    res = vfs_umount(&_test_vfs_mount_nested);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_constfs_same_mount_point(void)
+{
+    struct stat st;
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_mount(&_test_vfs_mount_same);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    /* the later mount hides the earlier one */
+    res = vfs_stat("/test/test.txt", &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_stat("/test/data.bin", &st);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, res);
+
+    res = vfs_umount(&_test_vfs_mount_same);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_stat("/test/data.bin", &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_umount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -210,6 +320,9 @@ Test *tests_vfs_mount_constfs_tests(void)
         new_TestFixture(test_vfs_umount__invalid_mount),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_constfs_readv),
+        new_TestFixture(test_vfs_constfs_nested),
+        new_TestFixture(test_vfs_constfs_same_mount_point),
 #if MODULE_NEWLIB || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for asynchronous VFS I/O
+ *
+ * A logger writes chunks of "samples" with vfs_aio while it keeps on sampling,
+ * then reads the file back asynchronously and compares the contents.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+
+#include "board.h"
+#include "event.h"
+#include "mtd.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "vfs_aio.h"
+#include "fs/littlefs_fs.h"
+
+#define CHUNKS              (8U)
+#define SAMPLES             (16U)
+/* keep format and mount of littlefs on the native MTD fast */
+#define LFS_BLOCKS          (32U)
+
+static littlefs_desc_t _lfs_desc;
+
+static vfs_mount_t _lfs_mount = {
+    .mount_point = "/lfs",
+    .fs = &littlefs_file_system,
+    .private_data = &_lfs_desc,
+};
+
+/* double buffered samples: one chunk is sampled while the other is written */
+static uint16_t _samples[2][SAMPLES];
+static uint8_t _header[2];
+static vfs_aio_t _req;
+
+static event_queue_t _queue;
+static event_t _done;
+static unsigned _done_count;
+
+static void _done_handler(event_t *event)
+{
+    (void)event;
+    _done_count++;
+}
+
+static void _sample(uint16_t *buf, unsigned chunk)
+{
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        buf[i] = (chunk << 8) | i;
+    }
+}
+
+static int _write_log(void)
+{
+    int fd = vfs_open("/lfs/log.bin", O_WRONLY | O_CREAT | O_TRUNC, 0);
+    if (fd < 0) {
+        return fd;
+    }
+
+    iolist_t data = { .iol_next = NULL };
+    iolist_t head = { .iol_next = &data, .iol_base = _header,
+                      .iol_len = sizeof(_header) };
+
+    _req.thread = (thread_t *)sched_active_thread;
+    _sample(_samples[0], 0);
+    for (unsigned chunk = 0; chunk < CHUNKS; chunk++) {
+        _header[0] = chunk;
+        _header[1] = SAMPLES;
+        data.iol_base = _samples[chunk & 1];
+        data.iol_len = sizeof(_samples[0]);
+        if (vfs_aio_writev(&_req, fd, &head) < 0) {
+            break;
+        }
+        /* the next chunk is sampled while the previous one is written */
+        if (chunk + 1 < CHUNKS) {
+            _sample(_samples[(chunk + 1) & 1], chunk + 1);
+        }
+        thread_flags_wait_any(VFS_AIO_THREAD_FLAG);
+        if (_req.res != (ssize_t)(sizeof(_header) + sizeof(_samples[0]))) {
+            printf("chunk %u: write returned %d\n", chunk, (int)_req.res);
+            vfs_close(fd);
+            return -EIO;
+        }
+    }
+    _req.thread = NULL;
+
+    return vfs_close(fd);
+}
+
+static int _check_log(void)
+{
+    int fd = vfs_open("/lfs/log.bin", O_RDONLY, 0);
+    if (fd < 0) {
+        return fd;
+    }
+
+    uint8_t header[2];
+    uint16_t samples[SAMPLES];
+    iolist_t data = { .iol_next = NULL, .iol_base = samples,
+                      .iol_len = sizeof(samples) };
+    iolist_t head = { .iol_next = &data, .iol_base = header,
+                      .iol_len = sizeof(header) };
+    int res = 0;
+
+    _req.queue = &_queue;
+    _req.done = &_done;
+    for (unsigned chunk = 0; chunk < CHUNKS; chunk++) {
+        if (vfs_aio_readv(&_req, fd, &head) < 0) {
+            res = -EIO;
+            break;
+        }
+        /* wait for and run the completion event */
+        event_t *event = event_wait(&_queue);
+        event->handler(event);
+
+        uint16_t expected[SAMPLES];
+        _sample(expected, chunk);
+        if ((_req.res != (ssize_t)(sizeof(header) + sizeof(samples))) ||
+            (header[0] != chunk) || (header[1] != SAMPLES) ||
+            memcmp(samples, expected, sizeof(samples))) {
+            printf("chunk %u: read back failed\n", chunk);
+            res = -EIO;
+            break;
+        }
+    }
+    /* end of file */
+    if ((res == 0) && (vfs_aio_readv(&_req, fd, &head) == 0)) {
+        event_t *event = event_wait(&_queue);
+        event->handler(event);
+        if (_req.res != 0) {
+            res = -EIO;
+        }
+    }
+
+    vfs_close(fd);
+    return res;
+}
+
+int main(void)
+{
+    puts("vfs_aio test application\n");
+
+    event_queue_init(&_queue);
+    _done.handler = _done_handler;
+
+    _lfs_desc.dev = MTD_0;
+    _lfs_desc.config.block_count = LFS_BLOCKS;
+    if ((vfs_format(&_lfs_mount) < 0) || (vfs_mount(&_lfs_mount) < 0)) {
+        puts("error: mounting littlefs failed");
+        return 1;
+    }
+
+    if (_write_log() < 0) {
+        puts("write: FAILED");
+        return 1;
+    }
+    puts("write: OK");
+
+    if ((_check_log() < 0) || (_done_count != CHUNKS + 1)) {
+        puts("read: FAILED");
+        return 1;
+    }
+    puts("read: OK");
+
+    vfs_umount(&_lfs_mount);
+
+    puts("\n[SUCCESS]");
+    return 0;
+}